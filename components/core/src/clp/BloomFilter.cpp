@@ -0,0 +1,82 @@
+#include "BloomFilter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "math_utils.hpp"
+
+namespace clp {
+namespace {
+constexpr size_t cNumBitsPerWord = 64;
+constexpr uint32_t cMaxNumHashFunctions = 16;
+
+/**
+ * Mixes the bits of the given value (the finalizer of the SplitMix64 generator)
+ * @param value
+ * @return The mixed value
+ */
+uint64_t mix(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+}  // namespace
+
+BloomFilter::BloomFilter(size_t num_expected_values, double false_positive_rate) {
+    if (false == (false_positive_rate > 0 && false_positive_rate < 1)) {
+        throw OperationFailed(ErrorCode_BadParam, __FILENAME__, __LINE__);
+    }
+
+    // Use the optimal number of bits and hash functions for the given number of values
+    auto const num_values = static_cast<double>(std::max<size_t>(num_expected_values, 1));
+    auto const ln2 = std::log(2.0);
+    auto const num_bits = std::ceil(-num_values * std::log(false_positive_rate) / (ln2 * ln2));
+    m_num_bits = int_round_up_to_multiple(
+            std::max<uint64_t>(static_cast<uint64_t>(num_bits), 1),
+            uint64_t{cNumBitsPerWord}
+    );
+    m_num_hash_functions = std::clamp<uint32_t>(
+            static_cast<uint32_t>(std::lround(static_cast<double>(m_num_bits) / num_values * ln2)),
+            1,
+            cMaxNumHashFunctions
+    );
+    m_bit_array.resize(m_num_bits / cNumBitsPerWord, 0);
+}
+
+BloomFilter::BloomFilter(uint32_t num_hash_functions, std::vector<uint64_t> bit_array)
+        : m_num_hash_functions{num_hash_functions},
+          m_num_bits{bit_array.size() * cNumBitsPerWord},
+          m_bit_array{std::move(bit_array)} {
+    if (0 == m_num_hash_functions || m_num_hash_functions > cMaxNumHashFunctions
+        || m_bit_array.empty())
+    {
+        throw OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
+    }
+}
+
+void BloomFilter::add(uint64_t value) {
+    // Derive the hash functions from two hashes (double hashing)
+    auto const hash1 = mix(value);
+    auto const hash2 = mix(hash1) | 1;
+    for (uint32_t i = 0; i < m_num_hash_functions; ++i) {
+        auto const bit_ix = (hash1 + i * hash2) % m_num_bits;
+        m_bit_array[bit_ix / cNumBitsPerWord] |= (1ULL << (bit_ix % cNumBitsPerWord));
+    }
+}
+
+bool BloomFilter::may_contain(uint64_t value) const {
+    auto const hash1 = mix(value);
+    auto const hash2 = mix(hash1) | 1;
+    for (uint32_t i = 0; i < m_num_hash_functions; ++i) {
+        auto const bit_ix = (hash1 + i * hash2) % m_num_bits;
+        if (0 == (m_bit_array[bit_ix / cNumBitsPerWord] & (1ULL << (bit_ix % cNumBitsPerWord)))) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace clp
@@ -0,0 +1,68 @@
+#ifndef CLP_BLOOMFILTER_HPP
+#define CLP_BLOOMFILTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ErrorCode.hpp"
+#include "TraceableException.hpp"
+
+namespace clp {
+/**
+ * A Bloom filter over 64-bit values. Checking whether the filter contains a value may give false
+ * positives but never gives false negatives.
+ */
+class BloomFilter {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        // Methods
+        char const* what() const noexcept override { return "BloomFilter operation failed"; }
+    };
+
+    // Constructors
+    /**
+     * Constructs an empty filter sized to hold the given number of values with (at most) roughly
+     * the given false positive rate
+     * @param num_expected_values
+     * @param false_positive_rate
+     * @throw BloomFilter::OperationFailed if the false positive rate isn't in (0, 1)
+     */
+    BloomFilter(size_t num_expected_values, double false_positive_rate);
+
+    /**
+     * Constructs a filter from the state of a previously constructed filter
+     * @param num_hash_functions
+     * @param bit_array
+     * @throw BloomFilter::OperationFailed if the state is invalid
+     */
+    BloomFilter(uint32_t num_hash_functions, std::vector<uint64_t> bit_array);
+
+    // Methods
+    void add(uint64_t value);
+
+    /**
+     * @param value
+     * @return Whether the filter may contain the given value
+     */
+    bool may_contain(uint64_t value) const;
+
+    uint32_t get_num_hash_functions() const { return m_num_hash_functions; }
+
+    std::vector<uint64_t> const& get_bit_array() const { return m_bit_array; }
+
+private:
+    // Variables
+    uint32_t m_num_hash_functions;
+    uint64_t m_num_bits;
+    std::vector<uint64_t> m_bit_array;
+};
+}  // namespace clp
+
+#endif  // CLP_BLOOMFILTER_HPP
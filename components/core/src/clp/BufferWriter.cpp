@@ -0,0 +1,46 @@
+#include "BufferWriter.hpp"
+
+#include <sys/types.h>
+
+#include <algorithm>
+#include <cstddef>
+
+#include "ErrorCode.hpp"
+
+namespace clp {
+auto BufferWriter::write(char const* data, size_t data_length) -> void {
+    if (0 == data_length) {
+        return;
+    }
+    if (nullptr == data) {
+        throw OperationFailed(ErrorCode_BadParam, __FILENAME__, __LINE__);
+    }
+
+    auto const end_pos = m_pos + data_length;
+    if (end_pos > m_buf.size()) {
+        m_buf.resize(end_pos);
+    }
+    std::copy_n(data, data_length, m_buf.begin() + static_cast<std::ptrdiff_t>(m_pos));
+    m_pos = end_pos;
+}
+
+auto BufferWriter::try_seek_from_begin(size_t pos) -> ErrorCode {
+    if (pos > m_buf.size()) {
+        return ErrorCode_OutOfBounds;
+    }
+    m_pos = pos;
+    return ErrorCode_Success;
+}
+
+auto BufferWriter::try_seek_from_current(off_t offset) -> ErrorCode {
+    if (offset < 0 && static_cast<size_t>(-offset) > m_pos) {
+        return ErrorCode_OutOfBounds;
+    }
+    return try_seek_from_begin(m_pos + offset);
+}
+
+auto BufferWriter::try_get_pos(size_t& pos) const -> ErrorCode {
+    pos = m_pos;
+    return ErrorCode_Success;
+}
+}  // namespace clp
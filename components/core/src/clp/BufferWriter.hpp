@@ -0,0 +1,88 @@
+#ifndef CLP_BUFFERWRITER_HPP
+#define CLP_BUFFERWRITER_HPP
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "ErrorCode.hpp"
+#include "TraceableException.hpp"
+#include "WriterInterface.hpp"
+
+namespace clp {
+/**
+ * Class for writing to an in-memory buffer that grows as data is written to it
+ */
+class BufferWriter : public WriterInterface {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        // Methods
+        [[nodiscard]] auto what() const noexcept -> char const* override {
+            return "BufferWriter operation failed";
+        }
+    };
+
+    // Methods implementing the WriterInterface
+    /**
+     * Writes the given data at the current position, overwriting any existing data and growing the
+     * buffer as necessary
+     * @param data
+     * @param data_length
+     * @throw BufferWriter::OperationFailed if data is nullptr and data_length is non-zero
+     */
+    auto write(char const* data, size_t data_length) -> void override;
+
+    /**
+     * Does nothing since all data is written directly to the buffer
+     */
+    auto flush() -> void override {}
+
+    /**
+     * Tries to seek from the beginning of the buffer to the given position
+     * @param pos
+     * @return ErrorCode_OutOfBounds if the position is beyond the end of the buffer
+     * @return ErrorCode_Success on success
+     */
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> ErrorCode override;
+
+    /**
+     * Tries to offset from the current position by the given amount
+     * @param offset
+     * @return ErrorCode_OutOfBounds if the resulting position is outside the buffer
+     * @return ErrorCode_Success on success
+     */
+    [[nodiscard]] auto try_seek_from_current(off_t offset) -> ErrorCode override;
+
+    /**
+     * @param pos Returns the position of the write head
+     * @return ErrorCode_Success
+     */
+    [[nodiscard]] auto try_get_pos(size_t& pos) const -> ErrorCode override;
+
+    // Methods
+    [[nodiscard]] auto get_buffer() const -> std::span<char const> { return m_buf; }
+
+    /**
+     * Empties the buffer and moves the write head back to the beginning
+     */
+    auto clear() -> void {
+        m_buf.clear();
+        m_pos = 0;
+    }
+
+private:
+    // Variables
+    std::vector<char> m_buf;
+    size_t m_pos{0};
+};
+}  // namespace clp
+
+#endif  // CLP_BUFFERWRITER_HPP
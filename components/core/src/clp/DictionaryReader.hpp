@@ -6,6 +6,7 @@
 
 #include <boost/algorithm/string.hpp>
 #include <string_utils/string_utils.hpp>
+#include <string_utils/WildcardMatcher.hpp>
 
 #include "dictionary_utils.hpp"
 #include "DictionaryEntry.hpp"
@@ -47,8 +48,13 @@ public:
      * Opens dictionary for reading
      * @param dictionary_path
      * @param segment_index_path
+     * @param zstd_dictionary zstd dictionary the dictionary was compressed with, or nullptr if none
      */
-    void open(std::string const& dictionary_path, std::string const& segment_index_path);
+    void open(
+            std::string const& dictionary_path,
+            std::string const& segment_index_path,
+            streaming_compression::zstd::Dictionary const* zstd_dictionary = nullptr
+    );
     /**
      * Closes the dictionary
      */
@@ -125,7 +131,8 @@ protected:
 template <typename DictionaryIdType, typename EntryType>
 void DictionaryReader<DictionaryIdType, EntryType>::open(
         std::string const& dictionary_path,
-        std::string const& segment_index_path
+        std::string const& segment_index_path,
+        [[maybe_unused]] streaming_compression::zstd::Dictionary const* zstd_dictionary
 ) {
     if (m_is_open) {
         throw OperationFailed(ErrorCode_NotReady, __FILENAME__, __LINE__);
@@ -137,6 +144,9 @@ void DictionaryReader<DictionaryIdType, EntryType>::open(
 
     // Skip header and then open the decompressor
     m_dictionary_file_reader->seek_from_begin(sizeof(uint64_t));
+#if USE_ZSTD_COMPRESSION
+    m_dictionary_decompressor.set_dictionary(zstd_dictionary);
+#endif
     m_dictionary_decompressor.open(*m_dictionary_file_reader, cDecompressorFileReadBufferCapacity);
 
     m_segment_index_file_reader = make_unique<FileReader>(segment_index_path);
@@ -261,13 +271,9 @@ void DictionaryReader<DictionaryIdType, EntryType>::get_entries_matching_wildcar
         bool ignore_case,
         std::unordered_set<EntryType const*>& entries
 ) const {
+    string_utils::WildcardMatcher const matcher{wildcard_string, false == ignore_case};
     for (auto const& entry : m_entries) {
-        if (string_utils::wildcard_match_unsafe(
-                    entry.get_value(),
-                    wildcard_string,
-                    false == ignore_case
-            ))
-        {
+        if (matcher.matches(entry.get_value())) {
             entries.insert(&entry);
         }
     }
@@ -44,11 +44,15 @@ public:
      * Opens dictionary for writing
      * @param dictionary_path
      * @param segment_index_path
+     * @param max_id
+     * @param zstd_dictionary zstd dictionary to compress the dictionary with, or nullptr to
+     * compress without one
      */
     void open(
             std::string const& dictionary_path,
             std::string const& segment_index_path,
-            DictionaryIdType max_id
+            DictionaryIdType max_id,
+            streaming_compression::zstd::Dictionary const* zstd_dictionary = nullptr
     );
     /**
      * Closes the dictionary
@@ -114,7 +118,8 @@ template <typename DictionaryIdType, typename EntryType>
 void DictionaryWriter<DictionaryIdType, EntryType>::open(
         std::string const& dictionary_path,
         std::string const& segment_index_path,
-        DictionaryIdType max_id
+        DictionaryIdType max_id,
+        [[maybe_unused]] streaming_compression::zstd::Dictionary const* zstd_dictionary
 ) {
     if (m_is_open) {
         throw OperationFailed(ErrorCode_NotReady, __FILENAME__, __LINE__);
@@ -124,7 +129,15 @@ void DictionaryWriter<DictionaryIdType, EntryType>::open(
     // Write header
     m_dictionary_file_writer.write_numeric_value<uint64_t>(0);
     // Open compressor
+#if USE_PASSTHROUGH_COMPRESSION
     m_dictionary_compressor.open(m_dictionary_file_writer);
+#elif USE_ZSTD_COMPRESSION
+    if (nullptr == zstd_dictionary) {
+        m_dictionary_compressor.open(m_dictionary_file_writer);
+    } else {
+        m_dictionary_compressor.open(m_dictionary_file_writer, *zstd_dictionary);
+    }
+#endif
 
     m_segment_index_file_writer.open(segment_index_path, FileWriter::OpenMode::CREATE_FOR_WRITING);
     // Write header
@@ -381,10 +381,10 @@ bool EncodedVariableInterpreter::encode_and_search_dictionary(
     encoded_variable_t encoded_var;
     if (convert_string_to_representable_integer_var(var_str, encoded_var)) {
         LogTypeDictionaryEntry::add_int_var(logtype);
-        sub_query.add_non_dict_var(encoded_var);
+        sub_query.add_non_dict_var(encoded_var, VariablePlaceholder::Integer);
     } else if (convert_string_to_representable_float_var(var_str, encoded_var)) {
         LogTypeDictionaryEntry::add_float_var(logtype);
-        sub_query.add_non_dict_var(encoded_var);
+        sub_query.add_non_dict_var(encoded_var, VariablePlaceholder::Float);
     } else {
         auto entry = var_dict.get_entry_matching_value(var_str, ignore_case);
         if (nullptr == entry) {
@@ -19,7 +19,6 @@ using clp::streaming_archive::reader::Message;
 using clp::string_utils::clean_up_wildcard_search_string;
 using clp::string_utils::is_alphabet;
 using clp::string_utils::is_wildcard;
-using clp::string_utils::wildcard_match_unsafe;
 using std::string;
 using std::vector;
 
@@ -490,7 +489,7 @@ SubQueryMatchabilityResult generate_logtypes_and_vars_for_subquery(
 
     // Calculate the IDs of the segments that may contain results for the sub-query now that we've
     // calculated the matching logtypes and variables
-    sub_query.calculate_ids_of_matching_segments();
+    sub_query.calculate_ids_of_matching_segments(archive.get_non_dict_var_segment_index());
 
     return SubQueryMatchabilityResult::MayMatch;
 }
@@ -942,11 +941,7 @@ size_t Grep::search_and_output(
             || (query.contains_sub_queries() == false && query.search_string_matches_all() == false
             ))
         {
-            bool matched = wildcard_match_unsafe(
-                    decompressed_msg,
-                    query.get_search_string(),
-                    query.get_ignore_case() == false
-            );
+            bool matched = query.search_string_matches(decompressed_msg);
             if (!matched) {
                 continue;
             }
@@ -999,11 +994,7 @@ bool Grep::search_and_decompress(
             || (query.contains_sub_queries() == false && query.search_string_matches_all() == false
             ))
         {
-            matched = wildcard_match_unsafe(
-                    decompressed_msg,
-                    query.get_search_string(),
-                    query.get_ignore_case() == false
-            );
+            matched = query.search_string_matches(decompressed_msg);
         } else {
             matched = true;
         }
@@ -1048,11 +1039,7 @@ size_t Grep::search(Query const& query, size_t limit, Archive& archive, File& co
                 break;
             }
 
-            bool matched = wildcard_match_unsafe(
-                    decompressed_msg,
-                    query.get_search_string(),
-                    query.get_ignore_case() == false
-            );
+            bool matched = query.search_string_matches(decompressed_msg);
             if (!matched) {
                 continue;
             }
@@ -96,26 +96,16 @@ bool MessageParser::parse_line(ParsedMessage& message) {
     bool message_completed = false;
 
     // Parse timestamp and content
-    TimestampPattern const* timestamp_pattern = message.get_ts_patt();
     epochtime_t timestamp = 0;
     size_t timestamp_begin_pos;
     size_t timestamp_end_pos;
-    if (nullptr == timestamp_pattern
-        || false
-                   == timestamp_pattern->parse_timestamp(
-                           m_line,
-                           timestamp,
-                           timestamp_begin_pos,
-                           timestamp_end_pos
-                   ))
-    {
-        timestamp_pattern = TimestampPattern::search_known_ts_patterns(
-                m_line,
-                timestamp,
-                timestamp_begin_pos,
-                timestamp_end_pos
-        );
-    }
+    auto const* timestamp_pattern = TimestampPattern::search_known_ts_patterns(
+            m_line,
+            message.get_ts_patt(),
+            timestamp,
+            timestamp_begin_pos,
+            timestamp_end_pos
+    );
 
     if (nullptr != timestamp_pattern) {
         // A timestamp was parsed
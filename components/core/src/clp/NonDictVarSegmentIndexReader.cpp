@@ -0,0 +1,128 @@
+#include "NonDictVarSegmentIndexReader.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+#include "FileReader.hpp"
+#include "streaming_compression/passthrough/Decompressor.hpp"
+#include "streaming_compression/zstd/Decompressor.hpp"
+
+namespace clp {
+void NonDictVarSegmentIndexReader::read(std::string const& index_path) {
+    m_segment_summaries.clear();
+    if (false == std::filesystem::exists(index_path)) {
+        return;
+    }
+
+    constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KB
+
+    FileReader file_reader{index_path};
+    uint64_t num_segments{0};
+    file_reader.read_numeric_value(num_segments, false);
+#if USE_PASSTHROUGH_COMPRESSION
+    streaming_compression::passthrough::Decompressor decompressor;
+#elif USE_ZSTD_COMPRESSION
+    streaming_compression::zstd::Decompressor decompressor;
+#else
+    static_assert(false, "Unsupported compression mode.");
+#endif
+    decompressor.open(file_reader, cDecompressorFileReadBufferCapacity);
+    for (uint64_t i = 0; i < num_segments; ++i) {
+        segment_id_t segment_id;
+        decompressor.read_numeric_value(segment_id, false);
+        SegmentSummary segment_summary;
+        segment_summary.int_vars = read_var_summary(decompressor);
+        segment_summary.float_vars = read_var_summary(decompressor);
+        m_segment_summaries.insert_or_assign(segment_id, std::move(segment_summary));
+    }
+    decompressor.close();
+}
+
+bool NonDictVarSegmentIndexReader::segment_may_contain_var(
+        segment_id_t segment_id,
+        ir::VariablePlaceholder placeholder,
+        encoded_variable_t var
+) const {
+    auto const it = m_segment_summaries.find(segment_id);
+    if (m_segment_summaries.cend() == it) {
+        return true;
+    }
+
+    std::optional<VarSummary> const* var_summary;
+    switch (placeholder) {
+        case ir::VariablePlaceholder::Integer:
+            var_summary = &it->second.int_vars;
+            break;
+        case ir::VariablePlaceholder::Float:
+            var_summary = &it->second.float_vars;
+            break;
+        default:
+            return true;
+    }
+    if (false == var_summary->has_value()) {
+        return false;
+    }
+
+    auto const& [min_var, max_var, bloom_filter] = var_summary->value();
+    if (var < min_var || var > max_var) {
+        return false;
+    }
+    return false == bloom_filter.has_value()
+           || bloom_filter->may_contain(static_cast<uint64_t>(var));
+}
+
+std::optional<NonDictVarSegmentIndexReader::VarSummary>
+NonDictVarSegmentIndexReader::read_var_summary(ReaderInterface& reader) {
+    uint8_t contains_vars;
+    reader.read_numeric_value(contains_vars, false);
+    if (0 == contains_vars) {
+        return std::nullopt;
+    }
+
+    VarSummary var_summary;
+    reader.read_numeric_value(var_summary.min_var, false);
+    reader.read_numeric_value(var_summary.max_var, false);
+    if (var_summary.min_var > var_summary.max_var) {
+        throw OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
+    }
+
+    uint32_t num_hash_functions;
+    reader.read_numeric_value(num_hash_functions, false);
+    if (num_hash_functions > 0) {
+        uint64_t num_words;
+        reader.read_numeric_value(num_words, false);
+
+        // Grow the bit array as its words are read so that a corrupt word count can't cause an
+        // allocation larger than the rest of the index
+        constexpr uint64_t cMaxNumWordsPerRead = 64 * 1024;
+        std::vector<uint64_t> bit_array;
+        while (bit_array.size() < num_words) {
+            auto const num_words_read = bit_array.size();
+            auto const num_words_to_read
+                    = std::min<uint64_t>(num_words - num_words_read, cMaxNumWordsPerRead);
+            bit_array.resize(num_words_read + num_words_to_read);
+            auto const error_code = reader.try_read_exact_length(
+                    reinterpret_cast<char*>(bit_array.data() + num_words_read),
+                    num_words_to_read * sizeof(uint64_t)
+            );
+            if (ErrorCode_Success != error_code) {
+                throw OperationFailed(
+                        ErrorCode_EndOfFile == error_code || ErrorCode_Truncated == error_code
+                                ? ErrorCode_Corrupt
+                                : error_code,
+                        __FILENAME__,
+                        __LINE__
+                );
+            }
+        }
+        try {
+            var_summary.bloom_filter.emplace(num_hash_functions, std::move(bit_array));
+        } catch (BloomFilter::OperationFailed const&) {
+            throw OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
+        }
+    }
+    return var_summary;
+}
+}  // namespace clp
@@ -0,0 +1,89 @@
+#ifndef CLP_NONDICTVARSEGMENTINDEXREADER_HPP
+#define CLP_NONDICTVARSEGMENTINDEXREADER_HPP
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "BloomFilter.hpp"
+#include "Defs.h"
+#include "ir/types.hpp"
+#include "ReaderInterface.hpp"
+#include "TraceableException.hpp"
+
+namespace clp {
+/**
+ * Class for reading an index of the non-dictionary variables in each segment (see
+ * NonDictVarSegmentIndexWriter). Archives written before the index existed don't have one.
+ */
+class NonDictVarSegmentIndexReader {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        // Methods
+        char const* what() const noexcept override {
+            return "NonDictVarSegmentIndexReader operation failed";
+        }
+    };
+
+    // Methods
+    /**
+     * Reads the index at the given path, if it exists
+     * @param index_path
+     * @throw NonDictVarSegmentIndexReader::OperationFailed if the index is corrupt
+     * @throw FileReader::OperationFailed on read failure
+     */
+    void read(std::string const& index_path);
+
+    /**
+     * Clears the index
+     */
+    void clear() { m_segment_summaries.clear(); }
+
+    /**
+     * @param segment_id
+     * @param placeholder The variable's type
+     * @param var The encoded variable
+     * @return Whether the given segment may contain the given non-dictionary variable. Segments
+     * that aren't indexed may contain any variable.
+     */
+    bool segment_may_contain_var(
+            segment_id_t segment_id,
+            ir::VariablePlaceholder placeholder,
+            encoded_variable_t var
+    ) const;
+
+private:
+    // Types
+    struct VarSummary {
+        encoded_variable_t min_var;
+        encoded_variable_t max_var;
+        std::optional<BloomFilter> bloom_filter;
+    };
+
+    struct SegmentSummary {
+        // Unset if the segment contains no variables of the type
+        std::optional<VarSummary> int_vars;
+        std::optional<VarSummary> float_vars;
+    };
+
+    // Methods
+    /**
+     * Reads the summary of a segment's variables of a single type
+     * @param reader
+     * @return The summary, or std::nullopt if the segment contains no variables of the type
+     * @throw NonDictVarSegmentIndexReader::OperationFailed if the summary is corrupt
+     */
+    static std::optional<VarSummary> read_var_summary(ReaderInterface& reader);
+
+    // Variables
+    std::unordered_map<segment_id_t, SegmentSummary> m_segment_summaries;
+};
+}  // namespace clp
+
+#endif  // CLP_NONDICTVARSEGMENTINDEXREADER_HPP
@@ -0,0 +1,183 @@
+#include "NonDictVarSegmentIndexWriter.hpp"
+
+#include <algorithm>
+
+#include "BloomFilter.hpp"
+#include "ir/types.hpp"
+
+using clp::ir::VariablePlaceholder;
+
+namespace clp {
+namespace {
+// Maximum number of distinct values of each type to index per segment, bounding the memory used
+// while a segment is open and the size of its Bloom filters
+constexpr size_t cMaxNumDistinctVarsPerSegment = 256 * 1024;
+constexpr double cBloomFilterFalsePositiveRate = 0.01;
+}  // namespace
+
+void NonDictVarSegmentIndexWriter::VarSet::insert(encoded_variable_t var) {
+    if (m_is_empty) {
+        m_min_var = var;
+        m_max_var = var;
+        m_is_empty = false;
+    } else {
+        m_min_var = std::min(m_min_var, var);
+        m_max_var = std::max(m_max_var, var);
+    }
+
+    if (m_has_too_many_distinct_vars) {
+        return;
+    }
+    m_distinct_vars.insert(var);
+    if (m_distinct_vars.size() > cMaxNumDistinctVarsPerSegment) {
+        m_distinct_vars.clear();
+        m_has_too_many_distinct_vars = true;
+    }
+}
+
+void NonDictVarSegmentIndexWriter::VarSet::insert_all(VarSet const& other) {
+    if (other.m_is_empty) {
+        return;
+    }
+    insert(other.m_min_var);
+    insert(other.m_max_var);
+
+    if (other.m_has_too_many_distinct_vars) {
+        m_distinct_vars.clear();
+        m_has_too_many_distinct_vars = true;
+        return;
+    }
+    for (auto const var : other.m_distinct_vars) {
+        if (m_has_too_many_distinct_vars) {
+            break;
+        }
+        insert(var);
+    }
+}
+
+void NonDictVarSegmentIndexWriter::VarSet::clear() {
+    m_is_empty = true;
+    m_min_var = 0;
+    m_max_var = 0;
+    m_distinct_vars.clear();
+    m_has_too_many_distinct_vars = false;
+}
+
+void NonDictVarSegmentIndexWriter::SegmentVars::insert_msg_vars(
+        LogTypeDictionaryEntry const& logtype_entry,
+        std::vector<encoded_variable_t> const& encoded_vars
+) {
+    VariablePlaceholder placeholder;
+    auto const num_placeholders = logtype_entry.get_num_placeholders();
+    for (size_t placeholder_ix = 0, var_ix = 0;
+         placeholder_ix < num_placeholders && var_ix < encoded_vars.size();
+         ++placeholder_ix)
+    {
+        logtype_entry.get_placeholder_info(placeholder_ix, placeholder);
+        switch (placeholder) {
+            case VariablePlaceholder::Integer:
+                int_vars.insert(encoded_vars[var_ix++]);
+                break;
+            case VariablePlaceholder::Float:
+                float_vars.insert(encoded_vars[var_ix++]);
+                break;
+            case VariablePlaceholder::Dictionary:
+                ++var_ix;
+                break;
+            default:
+                // Escaped placeholders don't correspond to variables
+                break;
+        }
+    }
+}
+
+void NonDictVarSegmentIndexWriter::SegmentVars::insert_all(SegmentVars const& other) {
+    int_vars.insert_all(other.int_vars);
+    float_vars.insert_all(other.float_vars);
+}
+
+void NonDictVarSegmentIndexWriter::SegmentVars::clear() {
+    int_vars.clear();
+    float_vars.clear();
+}
+
+void NonDictVarSegmentIndexWriter::open(std::string const& index_path) {
+    if (m_is_open) {
+        throw OperationFailed(ErrorCode_NotReady, __FILENAME__, __LINE__);
+    }
+
+    m_file_writer.open(index_path, FileWriter::OpenMode::CREATE_FOR_WRITING);
+    // Write header
+    m_file_writer.write_numeric_value<uint64_t>(0);
+    // Open compressor
+    m_compressor.open(m_file_writer);
+    m_num_segments_in_index = 0;
+
+    m_is_open = true;
+}
+
+void NonDictVarSegmentIndexWriter::close() {
+    if (false == m_is_open) {
+        throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
+    }
+
+    write_header_and_flush_to_disk();
+    m_compressor.close();
+    m_file_writer.close();
+
+    m_is_open = false;
+}
+
+void NonDictVarSegmentIndexWriter::write_header_and_flush_to_disk() {
+    if (false == m_is_open) {
+        throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
+    }
+
+    m_compressor.flush();
+
+    // Update header
+    auto file_writer_pos = m_file_writer.get_pos();
+    m_file_writer.seek_from_begin(0);
+    m_file_writer.write_numeric_value<uint64_t>(m_num_segments_in_index);
+    m_file_writer.seek_from_begin(file_writer_pos);
+
+    m_file_writer.flush();
+}
+
+void NonDictVarSegmentIndexWriter::index_segment(
+        segment_id_t segment_id,
+        SegmentVars const& segment_vars
+) {
+    m_compressor.write_numeric_value(segment_id);
+    write_var_set(segment_vars.int_vars);
+    write_var_set(segment_vars.float_vars);
+
+    ++m_num_segments_in_index;
+}
+
+void NonDictVarSegmentIndexWriter::write_var_set(VarSet const& vars) {
+    if (vars.empty()) {
+        m_compressor.write_numeric_value<uint8_t>(false);
+        return;
+    }
+    m_compressor.write_numeric_value<uint8_t>(true);
+    m_compressor.write_numeric_value(vars.m_min_var);
+    m_compressor.write_numeric_value(vars.m_max_var);
+
+    if (vars.m_has_too_many_distinct_vars) {
+        m_compressor.write_numeric_value<uint32_t>(0);
+        return;
+    }
+    BloomFilter bloom_filter(vars.m_distinct_vars.size(), cBloomFilterFalsePositiveRate);
+    for (auto const var : vars.m_distinct_vars) {
+        bloom_filter.add(static_cast<uint64_t>(var));
+    }
+    auto const& bit_array = bloom_filter.get_bit_array();
+    m_compressor.write_numeric_value(bloom_filter.get_num_hash_functions());
+    m_compressor.write_numeric_value<uint64_t>(bit_array.size());
+    m_compressor.write(
+            reinterpret_cast<char const*>(bit_array.data()),
+            bit_array.size() * sizeof(uint64_t)
+    );
+}
+}  // namespace clp
@@ -0,0 +1,154 @@
+#ifndef CLP_NONDICTVARSEGMENTINDEXWRITER_HPP
+#define CLP_NONDICTVARSEGMENTINDEXWRITER_HPP
+
+#include <cstddef>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "Defs.h"
+#include "FileWriter.hpp"
+#include "LogTypeDictionaryEntry.hpp"
+#include "streaming_compression/passthrough/Compressor.hpp"
+#include "streaming_compression/zstd/Compressor.hpp"
+#include "TraceableException.hpp"
+
+namespace clp {
+/**
+ * Class for writing an index of the non-dictionary (integer and float) variables in each segment.
+ * For each type of variable in a segment, the index stores the minimum and maximum encoded value
+ * and a Bloom filter of the encoded values, so that searches for specific values can skip segments
+ * that don't contain them.
+ *
+ * The index is stored as the number of segments in the index (uint64_t) followed by a compressed
+ * stream containing, for each segment:
+ * - the segment's ID
+ * - for integer variables and then float variables:
+ *   - whether the segment contains any variables of the type (uint8_t); if so:
+ *     - the minimum and maximum encoded values
+ *     - the number of hash functions in the Bloom filter (uint32_t), or 0 if the segment has too
+ *       many distinct values to index
+ *     - if there's a Bloom filter, the number of words in its bit array (uint64_t) followed by the
+ *       words (uint64_t each)
+ */
+class NonDictVarSegmentIndexWriter {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        // Methods
+        char const* what() const noexcept override {
+            return "NonDictVarSegmentIndexWriter operation failed";
+        }
+    };
+
+    /**
+     * Set of the non-dictionary variables of a single type
+     */
+    class VarSet {
+    public:
+        // Methods
+        void insert(encoded_variable_t var);
+        void insert_all(VarSet const& other);
+        void clear();
+
+        bool empty() const { return m_is_empty; }
+
+    private:
+        friend class NonDictVarSegmentIndexWriter;
+
+        // Variables
+        bool m_is_empty{true};
+        encoded_variable_t m_min_var{0};
+        encoded_variable_t m_max_var{0};
+        // Distinct variables, unless there are too many to index
+        std::unordered_set<encoded_variable_t> m_distinct_vars;
+        bool m_has_too_many_distinct_vars{false};
+    };
+
+    /**
+     * Sets of the non-dictionary variables in a segment
+     */
+    struct SegmentVars {
+        // Methods
+        /**
+         * Inserts the non-dictionary variables of a message
+         * @param logtype_entry The message's logtype
+         * @param encoded_vars The message's encoded variables
+         */
+        void insert_msg_vars(
+                LogTypeDictionaryEntry const& logtype_entry,
+                std::vector<encoded_variable_t> const& encoded_vars
+        );
+        void insert_all(SegmentVars const& other);
+        void clear();
+
+        // Variables
+        VarSet int_vars;
+        VarSet float_vars;
+    };
+
+    // Constructors
+    NonDictVarSegmentIndexWriter() : m_is_open(false) {}
+
+    // Methods
+    /**
+     * Opens the index for writing
+     * @param index_path
+     * @throw NonDictVarSegmentIndexWriter::OperationFailed if the index is already open
+     * @throw FileWriter::OperationFailed on open or write failure
+     */
+    void open(std::string const& index_path);
+    /**
+     * Closes the index
+     * @throw NonDictVarSegmentIndexWriter::OperationFailed if the index isn't open
+     * @throw FileWriter::OperationFailed on write or close failure
+     */
+    void close();
+
+    /**
+     * Writes the index's header and flushes the index to disk
+     * @throw NonDictVarSegmentIndexWriter::OperationFailed if the index isn't open
+     */
+    void write_header_and_flush_to_disk();
+
+    /**
+     * Adds the given segment's variables to the index
+     * @param segment_id
+     * @param segment_vars
+     */
+    void index_segment(segment_id_t segment_id, SegmentVars const& segment_vars);
+
+    /**
+     * @return The on-disk size of the index
+     */
+    size_t get_on_disk_size() const { return m_file_writer.get_pos(); }
+
+private:
+    // Methods
+    /**
+     * Writes the summary of the given variables to the index
+     * @param vars
+     */
+    void write_var_set(VarSet const& vars);
+
+    // Variables
+    bool m_is_open;
+    uint64_t m_num_segments_in_index{0};
+
+    FileWriter m_file_writer;
+#if USE_PASSTHROUGH_COMPRESSION
+    streaming_compression::passthrough::Compressor m_compressor;
+#elif USE_ZSTD_COMPRESSION
+    streaming_compression::zstd::Compressor m_compressor;
+#else
+    static_assert(false, "Unsupported compression mode.");
+#endif
+};
+}  // namespace clp
+
+#endif  // CLP_NONDICTVARSEGMENTINDEXWRITER_HPP
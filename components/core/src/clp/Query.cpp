@@ -26,8 +26,9 @@ static void inplace_set_intersection(SetType const& a, SetType& b) {
 }
 
 namespace clp {
-QueryVar::QueryVar(encoded_variable_t precise_non_dict_var) {
+QueryVar::QueryVar(encoded_variable_t precise_non_dict_var, ir::VariablePlaceholder placeholder) {
     m_precise_var = precise_non_dict_var;
+    m_non_dict_var_placeholder = placeholder;
     m_is_precise_var = true;
     m_is_dict_var = false;
     m_var_dict_entry = nullptr;
@@ -88,8 +89,31 @@ void QueryVar::remove_segments_that_dont_contain_dict_var(set<segment_id_t>& seg
     }
 }
 
-void SubQuery::add_non_dict_var(encoded_variable_t precise_non_dict_var) {
-    m_vars.emplace_back(precise_non_dict_var);
+void QueryVar::remove_segments_that_dont_contain_non_dict_var(
+        NonDictVarSegmentIndexReader const& non_dict_var_segment_index,
+        set<segment_id_t>& segment_ids
+) const {
+    if (m_is_dict_var) {
+        // Not a non-dictionary variable, so do nothing
+        return;
+    }
+
+    for (auto it = segment_ids.cbegin(); it != segment_ids.cend();) {
+        if (non_dict_var_segment_index
+                    .segment_may_contain_var(*it, m_non_dict_var_placeholder, m_precise_var))
+        {
+            ++it;
+        } else {
+            it = segment_ids.erase(it);
+        }
+    }
+}
+
+void SubQuery::add_non_dict_var(
+        encoded_variable_t precise_non_dict_var,
+        ir::VariablePlaceholder placeholder
+) {
+    m_vars.emplace_back(precise_non_dict_var, placeholder);
 }
 
 void SubQuery::add_dict_var(
@@ -120,7 +144,9 @@ void SubQuery::mark_wildcard_match_required() {
     m_wildcard_match_required = true;
 }
 
-void SubQuery::calculate_ids_of_matching_segments() {
+void SubQuery::calculate_ids_of_matching_segments(
+        NonDictVarSegmentIndexReader const& non_dict_var_segment_index
+) {
     // Get IDs of segments containing logtypes
     m_ids_of_matching_segments.clear();
     for (auto entry : m_possible_logtype_entries) {
@@ -134,6 +160,10 @@ void SubQuery::calculate_ids_of_matching_segments() {
     // Intersect with IDs of segments containing variables
     for (auto& query_var : m_vars) {
         query_var.remove_segments_that_dont_contain_dict_var(m_ids_of_matching_segments);
+        query_var.remove_segments_that_dont_contain_non_dict_var(
+                non_dict_var_segment_index,
+                m_ids_of_matching_segments
+        );
     }
 }
 
@@ -183,6 +213,7 @@ Query::Query(
           m_search_end_timestamp{search_end_timestamp},
           m_ignore_case{ignore_case},
           m_search_string{std::move(search_string)},
+          m_search_string_matcher{m_search_string, false == ignore_case},
           m_sub_queries{std::move(sub_queries)} {
     m_search_string_matches_all = (m_search_string.empty() || "*" == m_search_string);
 }
@@ -3,11 +3,16 @@
 
 #include <set>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 
+#include <string_utils/WildcardMatcher.hpp>
+
 #include "Defs.h"
+#include "ir/types.hpp"
 #include "LogTypeDictionaryEntry.hpp"
+#include "NonDictVarSegmentIndexReader.hpp"
 #include "VariableDictionaryEntry.hpp"
 
 namespace clp {
@@ -18,7 +23,7 @@ namespace clp {
 class QueryVar {
 public:
     // Constructors
-    explicit QueryVar(encoded_variable_t precise_non_dict_var);
+    QueryVar(encoded_variable_t precise_non_dict_var, ir::VariablePlaceholder placeholder);
     QueryVar(encoded_variable_t precise_dict_var, VariableDictionaryEntry const* var_dict_entry);
     QueryVar(
             std::unordered_set<encoded_variable_t> const& possible_dict_vars,
@@ -38,6 +43,16 @@ public:
      * @param segment_ids
      */
     void remove_segments_that_dont_contain_dict_var(std::set<segment_id_t>& segment_ids) const;
+    /**
+     * Removes segments from the given set that the given index shows don't contain the given
+     * non-dictionary variable
+     * @param non_dict_var_segment_index
+     * @param segment_ids
+     */
+    void remove_segments_that_dont_contain_non_dict_var(
+            NonDictVarSegmentIndexReader const& non_dict_var_segment_index,
+            std::set<segment_id_t>& segment_ids
+    ) const;
 
     bool is_precise_var() const { return m_is_precise_var; }
 
@@ -56,6 +71,8 @@ private:
     bool m_is_dict_var;
 
     encoded_variable_t m_precise_var;
+    // Only used if the variable is a non-dictionary variable
+    ir::VariablePlaceholder m_non_dict_var_placeholder;
     // Only used if the precise variable is a dictionary variable
     VariableDictionaryEntry const* m_var_dict_entry;
 
@@ -75,8 +92,10 @@ public:
     /**
      * Adds a precise non-dictionary variable to the subquery
      * @param precise_non_dict_var
+     * @param placeholder The variable's type
      */
-    void add_non_dict_var(encoded_variable_t precise_non_dict_var);
+    void
+    add_non_dict_var(encoded_variable_t precise_non_dict_var, ir::VariablePlaceholder placeholder);
     /**
      * Adds a precise dictionary variable to the subquery
      * @param precise_dict_var
@@ -108,8 +127,11 @@ public:
     /**
      * Calculates the segment IDs that should contain a match for the subquery's current logtypes
      * and QueryVars
+     * @param non_dict_var_segment_index
      */
-    void calculate_ids_of_matching_segments();
+    void calculate_ids_of_matching_segments(
+            NonDictVarSegmentIndexReader const& non_dict_var_segment_index
+    );
 
     void clear();
 
@@ -196,6 +218,15 @@ public:
      */
     bool search_string_matches_all() const { return m_search_string_matches_all; }
 
+    /**
+     * @param msg
+     * @return Whether the given message matches the search string (considering the query's case
+     * sensitivity)
+     */
+    bool search_string_matches(std::string_view msg) const {
+        return m_search_string_matcher.matches(msg);
+    }
+
     std::vector<SubQuery> const& get_sub_queries() const { return m_sub_queries; }
 
     bool contains_sub_queries() const { return m_sub_queries.empty() == false; }
@@ -213,6 +244,7 @@ private:
     bool m_ignore_case{false};
     std::string m_search_string;
     bool m_search_string_matches_all{true};
+    string_utils::WildcardMatcher m_search_string_matcher;
     std::vector<SubQuery> m_sub_queries;
     std::vector<SubQuery const*> m_relevant_sub_queries;
     segment_id_t m_prev_segment_id{cInvalidSegmentId};
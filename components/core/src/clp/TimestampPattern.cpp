@@ -71,6 +71,23 @@ static bool convert_string_to_number(
         int& value
 );
 
+/**
+ * Matches one of the given names at the given position in a string
+ * @param str
+ * @param names
+ * @param num_names
+ * @param ix Position to match at. Advanced past the name if a name matches.
+ * @param name_ix Returns the index of the first name that matches
+ * @return true if a name matches, false otherwise
+ */
+static bool match_name(
+        string const& str,
+        char const* const* names,
+        int num_names,
+        size_t& ix,
+        int& name_ix
+);
+
 static void append_padded_value(
         int const value,
         char const padding_character,
@@ -111,6 +128,24 @@ static bool convert_string_to_number(
     return true;
 }
 
+static bool match_name(
+        string const& str,
+        char const* const* names,
+        int const num_names,
+        size_t& ix,
+        int& name_ix
+) {
+    for (int i = 0; i < num_names; ++i) {
+        size_t const length = strlen(names[i]);
+        if (0 == str.compare(ix, length, names[i])) {
+            name_ix = i;
+            ix += length;
+            return true;
+        }
+    }
+    return false;
+}
+
 namespace clp {
 /*
  * To initialize m_known_ts_patterns, we first create a vector of patterns then copy it to a dynamic
@@ -218,6 +253,37 @@ TimestampPattern const* TimestampPattern::search_known_ts_patterns(
     return nullptr;
 }
 
+TimestampPattern const* TimestampPattern::search_known_ts_patterns(
+        string const& line,
+        TimestampPattern const* predicted_pattern,
+        epochtime_t& timestamp,
+        size_t& timestamp_begin_pos,
+        size_t& timestamp_end_pos
+) {
+    if (nullptr == predicted_pattern) {
+        return search_known_ts_patterns(line, timestamp, timestamp_begin_pos, timestamp_end_pos);
+    }
+    if (predicted_pattern->parse_timestamp(line, timestamp, timestamp_begin_pos, timestamp_end_pos))
+    {
+        return predicted_pattern;
+    }
+
+    for (size_t i = 0; i < m_known_ts_patterns_len; ++i) {
+        auto const* pattern = &m_known_ts_patterns[i];
+        if (pattern == predicted_pattern) {
+            // Already tried
+            continue;
+        }
+        if (pattern->parse_timestamp(line, timestamp, timestamp_begin_pos, timestamp_end_pos)) {
+            return pattern;
+        }
+    }
+
+    timestamp_begin_pos = string::npos;
+    timestamp_end_pos = string::npos;
+    return nullptr;
+}
+
 string const& TimestampPattern::get_format() const {
     return m_format;
 }
@@ -233,6 +299,7 @@ bool TimestampPattern::is_empty() const {
 void TimestampPattern::clear() {
     m_num_spaces_before_ts = 0;
     m_format.clear();
+    m_compiled_format.clear();
 }
 
 bool TimestampPattern::parse_timestamp(
@@ -270,442 +337,152 @@ bool TimestampPattern::parse_timestamp(
     long nanosecond = 0;
     bool is_pm = false;
 
-    size_t const format_length = m_format.length();
-    size_t format_ix = 0;
-    ParserState state = ParserState::Literal;
-    for (; format_ix < format_length && line_ix < line_length; ++format_ix) {
-        switch (state) {
-            case (ParserState::Literal):
-                if ('%' == m_format[format_ix]) {
-                    state = ParserState::FormatSpecifier;
-                } else {
-                    if (m_format[format_ix] != line[line_ix]) {
-                        // Doesn't match
-                        return false;
-                    }
-                    ++line_ix;
+    for (auto const& field : m_compiled_format) {
+        if (line_ix >= line_length) {
+            // Complete format string not present in line
+            return false;
+        }
+
+        int value{0};
+        switch (field.type) {
+            case FormatFieldType::Literal:
+                if (0 != line.compare(line_ix, field.literal.length(), field.literal)) {
+                    // Doesn't match
+                    return false;
                 }
+                line_ix += field.literal.length();
                 break;
-            case (ParserState::FormatSpecifier): {
-                // NOTE: We set the next state here so that we don't have to set it before breaking
-                // out of every case below. Any cases which don't transition to this next state
-                // should set their next state before breaking.
-                state = ParserState::Literal;
-                // Parse fields
-                switch (m_format[format_ix]) {
-                    case '%':
-                        if ('%' != line[line_ix]) {
-                            return false;
-                        }
-                        ++line_ix;
-                        break;
-                    case 'y': {  // Zero-padded year in century
-                        constexpr int cFieldLength = 2;
-                        if (line_ix + cFieldLength > line_length) {
-                            // Too short
-                            return false;
-                        }
-                        int value;
-                        if (false
-                                    == convert_string_to_number(
-                                            line,
-                                            line_ix,
-                                            line_ix + cFieldLength,
-                                            '0',
-                                            value
-                                    )
-                            || value < 0 || value > 99)
-                        {
-                            return false;
-                        }
-                        year = value;
-                        // Year >= 69 treated as 1900s, year below 69 treated as 2000s
-                        if (year >= 69) {
-                            year += 1900;
-                        } else {
-                            year += 2000;
-                        }
-                        line_ix += cFieldLength;
-                        break;
-                    }
-                    case 'Y': {  // Zero-padded year with century
-                        constexpr int cFieldLength = 4;
-                        if (line_ix + cFieldLength > line_length) {
-                            // Too short
-                            return false;
-                        }
-                        int value;
-                        if (false
-                                    == convert_string_to_number(
-                                            line,
-                                            line_ix,
-                                            line_ix + cFieldLength,
-                                            '0',
-                                            value
-                                    )
-                            || value < 0 || value > 9999)
-                        {
-                            return false;
-                        }
-                        year = value;
-                        line_ix += cFieldLength;
-                        break;
-                    }
-                    case 'B': {  // Month name
-                        bool match_found = false;
-                        for (int month_ix = 0; !match_found && month_ix < cNumMonths; ++month_ix) {
-                            size_t const length = strlen(cMonthNames[month_ix]);
-                            if (0 == line.compare(line_ix, length, cMonthNames[month_ix])) {
-                                month = month_ix + 1;
-                                match_found = true;
-                                line_ix += length;
-                            }
-                        }
-                        if (!match_found) {
-                            return false;
-                        }
-                        break;
-                    }
-                    case 'b': {  // Abbreviated month name
-                        bool match_found = false;
-                        for (int month_ix = 0; !match_found && month_ix < cNumMonths; ++month_ix) {
-                            size_t const length = strlen(cAbbrevMonthNames[month_ix]);
-                            if (0 == line.compare(line_ix, length, cAbbrevMonthNames[month_ix])) {
-                                month = month_ix + 1;
-                                match_found = true;
-                                line_ix += length;
-                            }
-                        }
-                        if (!match_found) {
-                            return false;
-                        }
-                        break;
-                    }
-                    case 'm': {  // Zero-padded month
-                        constexpr int cFieldLength = 2;
-                        if (line_ix + cFieldLength > line_length) {
-                            // Too short
-                            return false;
-                        }
-                        int value;
-                        if (false
-                                    == convert_string_to_number(
-                                            line,
-                                            line_ix,
-                                            line_ix + cFieldLength,
-                                            '0',
-                                            value
-                                    )
-                            || value < 1 || value > 12)
-                        {
-                            return false;
-                        }
-                        month = value;
-                        line_ix += cFieldLength;
-                        break;
-                    }
-                    case 'd': {  // Zero-padded day in month
-                        constexpr int cFieldLength = 2;
-                        if (line_ix + cFieldLength > line_length) {
-                            // Too short
-                            return false;
-                        }
-                        int value;
-                        if (false
-                                    == convert_string_to_number(
-                                            line,
-                                            line_ix,
-                                            line_ix + cFieldLength,
-                                            '0',
-                                            value
-                                    )
-                            || value < 1 || value > 31)
-                        {
-                            return false;
-                        }
-                        date = value;
-                        line_ix += cFieldLength;
-                        break;
-                    }
-                    case 'e': {  // Space-padded day in month
-                        constexpr int cFieldLength = 2;
-                        if (line_ix + cFieldLength > line_length) {
-                            // Too short
-                            return false;
-                        }
-                        int value;
-                        if (false
-                                    == convert_string_to_number(
-                                            line,
-                                            line_ix,
-                                            line_ix + cFieldLength,
-                                            ' ',
-                                            value
-                                    )
-                            || value < 1 || value > 31)
-                        {
-                            return false;
-                        }
-                        date = value;
-                        line_ix += cFieldLength;
-                        break;
-                    }
-                    case 'a': {  // Abbreviated day of week
-                        bool match_found = false;
-                        for (int day_ix = 0; !match_found && day_ix < cNumDaysInWeek; ++day_ix) {
-                            size_t const abbrev_length = strlen(cAbbrevDaysOfWeek[day_ix]);
-                            if (0
-                                == line.compare(line_ix, abbrev_length, cAbbrevDaysOfWeek[day_ix]))
-                            {
-                                match_found = true;
-                                line_ix += abbrev_length;
-                            }
-                        }
-                        if (!match_found) {
-                            return false;
-                        }
-                        // Weekday is not useful in determining absolute timestamp, so we don't do
-                        // anything with it
-                        break;
-                    }
-                    case 'p':  // Part of day
-                        if (0 == line.compare(line_ix, 2, "AM")) {
-                            is_pm = false;
-                        } else if (0 == line.compare(line_ix, 2, "PM")) {
-                            is_pm = true;
-                        } else {
-                            return false;
-                        }
-                        line_ix += 2;
-                        break;
-                    case 'H': {  // Zero-padded hour on 24-hour clock
-                        constexpr int cFieldLength = 2;
-                        if (line_ix + cFieldLength > line_length) {
-                            // Too short
-                            return false;
-                        }
-                        int value;
-                        if (false
-                                    == convert_string_to_number(
-                                            line,
-                                            line_ix,
-                                            line_ix + cFieldLength,
-                                            '0',
-                                            value
-                                    )
-                            || value < 0 || value > 23)
-                        {
-                            return false;
-                        }
-                        hour = value;
-                        line_ix += cFieldLength;
-                        break;
-                    }
-                    case 'k': {  // Space-padded hour on 24-hour clock
-                        constexpr int cFieldLength = 2;
-                        if (line_ix + cFieldLength > line_length) {
-                            // Too short
-                            return false;
-                        }
-                        int value;
-                        if (false
-                                    == convert_string_to_number(
-                                            line,
-                                            line_ix,
-                                            line_ix + cFieldLength,
-                                            ' ',
-                                            value
-                                    )
-                            || value < 0 || value > 23)
-                        {
-                            return false;
-                        }
-                        hour = value;
-                        line_ix += cFieldLength;
-                        break;
-                    }
-                    case 'I': {  // Zero-padded hour on 12-hour clock
-                        constexpr int cFieldLength = 2;
-                        if (line_ix + cFieldLength > line_length) {
-                            // Too short
-                            return false;
-                        }
-                        int value;
-                        if (false
-                                    == convert_string_to_number(
-                                            line,
-                                            line_ix,
-                                            line_ix + cFieldLength,
-                                            '0',
-                                            value
-                                    )
-                            || value < 1 || value > 12)
-                        {
-                            return false;
-                        }
-                        hour = value;
-                        uses_12_hour_clock = true;
-                        line_ix += cFieldLength;
-                        break;
-                    }
-                    case 'l': {  // Space-padded hour on 12-hour clock
-                        constexpr int cFieldLength = 2;
-                        if (line_ix + cFieldLength > line_length) {
-                            // Too short
-                            return false;
-                        }
-                        int value;
-                        if (false
-                                    == convert_string_to_number(
-                                            line,
-                                            line_ix,
-                                            line_ix + cFieldLength,
-                                            ' ',
-                                            value
-                                    )
-                            || value < 1 || value > 12)
-                        {
-                            return false;
-                        }
-                        hour = value;
-                        uses_12_hour_clock = true;
-                        line_ix += cFieldLength;
-                        break;
-                    }
-                    case 'M': {  // Zero-padded minute
-                        constexpr int cFieldLength = 2;
-                        if (line_ix + cFieldLength > line_length) {
-                            // Too short
-                            return false;
-                        }
-                        int value;
-                        if (false
-                                    == convert_string_to_number(
-                                            line,
-                                            line_ix,
-                                            line_ix + cFieldLength,
-                                            '0',
-                                            value
-                                    )
-                            || value < 0 || value > 59)
-                        {
-                            return false;
-                        }
-                        minute = value;
-                        line_ix += cFieldLength;
-                        break;
-                    }
-                    case 'S': {  // Zero-padded second
-                        constexpr int cFieldLength = 2;
-                        if (line_ix + cFieldLength > line_length) {
-                            // Too short
-                            return false;
-                        }
-                        int value;
-                        if (false
-                                    == convert_string_to_number(
-                                            line,
-                                            line_ix,
-                                            line_ix + cFieldLength,
-                                            '0',
-                                            value
-                                    )
-                            || value < 0 || value > 60)
-                        {
-                            return false;
-                        }
-                        second = value;
-                        line_ix += cFieldLength;
-                        break;
-                    }
-                    case '3': {  // Zero-padded millisecond
-                        constexpr int cFieldLength = 3;
-                        if (line_ix + cFieldLength > line_length) {
-                            // Too short
-                            return false;
-                        }
-                        int value;
-                        if (false
-                                    == convert_string_to_number(
-                                            line,
-                                            line_ix,
-                                            line_ix + cFieldLength,
-                                            '0',
-                                            value
-                                    )
-                            || value < 0 || value > 999)
-                        {
-                            return false;
-                        }
-                        millisecond = value;
-                        line_ix += cFieldLength;
-                        break;
-                    }
-                    case '#':
-                        state = ParserState::RelativeTimestampUnit;
-                        break;
-                    default:
-                        return false;
+            case FormatFieldType::Number: {
+                size_t const field_end_ix = line_ix + field.length;
+                if (field_end_ix > line_length) {
+                    // Too short
+                    return false;
                 }
+                if (false
+                            == convert_string_to_number(
+                                    line,
+                                    line_ix,
+                                    field_end_ix,
+                                    field.padding_character,
+                                    value
+                            )
+                    || value < field.min_value || value > field.max_value)
+                {
+                    return false;
+                }
+                line_ix = field_end_ix;
+                break;
+            }
+            case FormatFieldType::MonthName: {
+                int month_ix;
+                if (false == match_name(line, cMonthNames, cNumMonths, line_ix, month_ix)) {
+                    return false;
+                }
+                month = month_ix + 1;
                 break;
             }
-            case (ParserState::RelativeTimestampUnit): {
-                int field_length = 0;
+            case FormatFieldType::AbbrevMonthName: {
+                int month_ix;
+                if (false == match_name(line, cAbbrevMonthNames, cNumMonths, line_ix, month_ix)) {
+                    return false;
+                }
+                month = month_ix + 1;
+                break;
+            }
+            case FormatFieldType::AbbrevDayOfWeek: {
+                // Weekday is not useful in determining absolute timestamp, so we don't do anything
+                // with it
+                int day_ix;
+                if (false
+                    == match_name(line, cAbbrevDaysOfWeek, cNumDaysInWeek, line_ix, day_ix))
+                {
+                    return false;
+                }
+                break;
+            }
+            case FormatFieldType::PartOfDay:
+                if (0 == line.compare(line_ix, 2, "AM")) {
+                    is_pm = false;
+                } else if (0 == line.compare(line_ix, 2, "PM")) {
+                    is_pm = true;
+                } else {
+                    return false;
+                }
+                line_ix += 2;
+                break;
+            case FormatFieldType::RelativeTimestamp: {
                 // Leading zeroes are not currently supported for relative timestamps
                 if (line[line_ix] == '0') {
                     return false;
                 }
-                for (int i = line_ix; i < line_length; ++i) {
-                    int c = line[i];
+                size_t field_end_ix = line_ix;
+                for (; field_end_ix < line_length; ++field_end_ix) {
+                    int c = line[field_end_ix];
                     if (c < '0' || '9' < c) {
                         break;
                     }
-                    ++field_length;
                 }
-                if (field_length == 0) {
+                if (field_end_ix == line_ix) {
                     return false;
                 }
-                int value;
                 if (false
-                            == convert_string_to_number(
-                                    line,
-                                    line_ix,
-                                    line_ix + field_length,
-                                    '0',
-                                    value
-                            )
+                            == convert_string_to_number(line, line_ix, field_end_ix, '0', value)
                     || 0 > value)
                 {
                     return false;
                 }
-                switch (m_format[format_ix]) {
-                    case '3': {  // Relative timestamp in milliseconds
-                        millisecond = value;
-                        break;
-                    }
-                    case '6': {  // Relative timestamp in microseconds
-                        microsecond = value;
-                        break;
-                    }
-                    case '9': {  // Relative timestamp in nanoseconds
-                        nanosecond = value;
-                        break;
-                    }
-                    default: {
-                        return false;
-                    }
-                }
-                line_ix += field_length;
-                state = ParserState::Literal;
+                line_ix = field_end_ix;
                 break;
             }
+            case FormatFieldType::Empty:
+                break;
+            case FormatFieldType::Unsupported:
+                return false;
+            default:
+                throw OperationFailed(ErrorCode_Unsupported, __FILENAME__, __LINE__);
+        }
+
+        switch (field.component) {
+            case TimestampComponent::None:
+                break;
+            case TimestampComponent::YearInCentury:
+                // Year >= 69 treated as 1900s, year below 69 treated as 2000s
+                year = value + (value >= 69 ? 1900 : 2000);
+                break;
+            case TimestampComponent::Year:
+                year = value;
+                break;
+            case TimestampComponent::Month:
+                month = value;
+                break;
+            case TimestampComponent::Date:
+                date = value;
+                break;
+            case TimestampComponent::HourOn12HourClock:
+                uses_12_hour_clock = true;
+                hour = value;
+                break;
+            case TimestampComponent::Hour:
+                hour = value;
+                break;
+            case TimestampComponent::Minute:
+                minute = value;
+                break;
+            case TimestampComponent::Second:
+                second = value;
+                break;
+            case TimestampComponent::Millisecond:
+                millisecond = value;
+                break;
+            case TimestampComponent::Microsecond:
+                microsecond = value;
+                break;
+            case TimestampComponent::Nanosecond:
+                nanosecond = value;
+                break;
             default:
                 throw OperationFailed(ErrorCode_Unsupported, __FILENAME__, __LINE__);
         }
-    }
-    if (format_ix < format_length) {
-        // Complete format string not present in line
-        return false;
     }
 
     // Process parsed fields
@@ -748,6 +525,138 @@ bool TimestampPattern::parse_timestamp(
     return true;
 }
 
+void TimestampPattern::compile_format() {
+    m_compiled_format.clear();
+
+    auto add_field = [&](FormatFieldType type, TimestampComponent component) -> FormatField& {
+        auto& field = m_compiled_format.emplace_back();
+        field.type = type;
+        field.component = component;
+        return field;
+    };
+    auto add_literal = [&](char c) {
+        if (m_compiled_format.empty() || FormatFieldType::Literal != m_compiled_format.back().type)
+        {
+            add_field(FormatFieldType::Literal, TimestampComponent::None);
+        }
+        m_compiled_format.back().literal += c;
+    };
+    auto add_number_field = [&](TimestampComponent component,
+                                uint8_t length,
+                                char padding_character,
+                                int min_value,
+                                int max_value) {
+        auto& field = add_field(FormatFieldType::Number, component);
+        field.length = length;
+        field.padding_character = padding_character;
+        field.min_value = min_value;
+        field.max_value = max_value;
+    };
+
+    size_t const format_length = m_format.length();
+    size_t format_ix = 0;
+    for (; format_ix < format_length; ++format_ix) {
+        auto c = m_format[format_ix];
+        if ('%' != c) {
+            add_literal(c);
+            continue;
+        }
+
+        ++format_ix;
+        if (format_ix == format_length) {
+            add_field(FormatFieldType::Empty, TimestampComponent::None);
+            break;
+        }
+        switch (m_format[format_ix]) {
+            case '%':
+                add_literal('%');
+                break;
+            case 'y':
+                add_number_field(TimestampComponent::YearInCentury, 2, '0', 0, 99);
+                break;
+            case 'Y':
+                add_number_field(TimestampComponent::Year, 4, '0', 0, 9999);
+                break;
+            case 'B':
+                add_field(FormatFieldType::MonthName, TimestampComponent::None);
+                break;
+            case 'b':
+                add_field(FormatFieldType::AbbrevMonthName, TimestampComponent::None);
+                break;
+            case 'm':
+                add_number_field(TimestampComponent::Month, 2, '0', 1, 12);
+                break;
+            case 'd':
+                add_number_field(TimestampComponent::Date, 2, '0', 1, 31);
+                break;
+            case 'e':
+                add_number_field(TimestampComponent::Date, 2, ' ', 1, 31);
+                break;
+            case 'a':
+                add_field(FormatFieldType::AbbrevDayOfWeek, TimestampComponent::None);
+                break;
+            case 'p':
+                add_field(FormatFieldType::PartOfDay, TimestampComponent::None);
+                break;
+            case 'H':
+                add_number_field(TimestampComponent::Hour, 2, '0', 0, 23);
+                break;
+            case 'k':
+                add_number_field(TimestampComponent::Hour, 2, ' ', 0, 23);
+                break;
+            case 'I':
+                add_number_field(TimestampComponent::HourOn12HourClock, 2, '0', 1, 12);
+                break;
+            case 'l':
+                add_number_field(TimestampComponent::HourOn12HourClock, 2, ' ', 1, 12);
+                break;
+            case 'M':
+                add_number_field(TimestampComponent::Minute, 2, '0', 0, 59);
+                break;
+            case 'S':
+                add_number_field(TimestampComponent::Second, 2, '0', 0, 60);
+                break;
+            case '3':
+                add_number_field(TimestampComponent::Millisecond, 3, '0', 0, 999);
+                break;
+            case '#': {
+                ++format_ix;
+                if (format_ix == format_length) {
+                    add_field(FormatFieldType::Empty, TimestampComponent::None);
+                    break;
+                }
+                switch (m_format[format_ix]) {
+                    case '3':
+                        add_field(
+                                FormatFieldType::RelativeTimestamp,
+                                TimestampComponent::Millisecond
+                        );
+                        break;
+                    case '6':
+                        add_field(
+                                FormatFieldType::RelativeTimestamp,
+                                TimestampComponent::Microsecond
+                        );
+                        break;
+                    case '9':
+                        add_field(
+                                FormatFieldType::RelativeTimestamp,
+                                TimestampComponent::Nanosecond
+                        );
+                        break;
+                    default:
+                        add_field(FormatFieldType::Unsupported, TimestampComponent::None);
+                        break;
+                }
+                break;
+            }
+            default:
+                add_field(FormatFieldType::Unsupported, TimestampComponent::None);
+                break;
+        }
+    }
+}
+
 void TimestampPattern::insert_formatted_timestamp(epochtime_t const timestamp, string& msg) const {
     size_t msg_length = msg.length();
 
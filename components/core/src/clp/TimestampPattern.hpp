@@ -4,6 +4,8 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "Defs.h"
 #include "FileWriter.hpp"
@@ -64,7 +66,9 @@ public:
 
     TimestampPattern(uint8_t num_spaces_before_ts, std::string const& format)
             : m_num_spaces_before_ts(num_spaces_before_ts),
-              m_format(format) {}
+              m_format(format) {
+        compile_format();
+    }
 
     // Methods
     /**
@@ -87,6 +91,24 @@ public:
             size_t& timestamp_begin_pos,
             size_t& timestamp_end_pos
     );
+    /**
+     * Same as the above except that the given pattern is tried first. Callers parsing a stream of
+     * lines (e.g., from a single file) should pass the pattern that parsed the previous timestamp,
+     * since consecutive lines almost always share a pattern.
+     * @param line
+     * @param predicted_pattern The pattern to try first, or nullptr if there's none
+     * @param timestamp Parsed timestamp
+     * @param timestamp_begin_pos
+     * @param timestamp_end_pos
+     * @return pointer to the timestamp pattern if found, nullptr otherwise
+     */
+    static TimestampPattern const* search_known_ts_patterns(
+            std::string const& line,
+            TimestampPattern const* predicted_pattern,
+            epochtime_t& timestamp,
+            size_t& timestamp_begin_pos,
+            size_t& timestamp_end_pos
+    );
 
     /**
      * Gets the timestamp pattern's format string
@@ -148,6 +170,59 @@ public:
     friend bool operator!=(TimestampPattern const& lhs, TimestampPattern const& rhs);
 
 private:
+    // Types
+    enum class FormatFieldType : uint8_t {
+        Literal = 0,
+        Number,
+        MonthName,
+        AbbrevMonthName,
+        AbbrevDayOfWeek,
+        PartOfDay,
+        RelativeTimestamp,
+        // A specifier which doesn't parse anything (e.g., a trailing '%')
+        Empty,
+        // An unsupported specifier, which never parses
+        Unsupported
+    };
+
+    enum class TimestampComponent : uint8_t {
+        None = 0,
+        YearInCentury,
+        Year,
+        Month,
+        Date,
+        Hour,
+        HourOn12HourClock,
+        Minute,
+        Second,
+        Millisecond,
+        Microsecond,
+        Nanosecond
+    };
+
+    /**
+     * A field of a compiled format string, i.e., a run of literal characters or a directive
+     */
+    struct FormatField {
+        FormatFieldType type{FormatFieldType::Literal};
+        // The literal characters of a Literal field
+        std::string literal;
+        // The component set by a Number or RelativeTimestamp field
+        TimestampComponent component{TimestampComponent::None};
+        // Properties of a Number field
+        uint8_t length{0};
+        char padding_character{'0'};
+        int min_value{0};
+        int max_value{0};
+    };
+
+    // Methods
+    /**
+     * Compiles the format string into the sequence of fields used to parse timestamps, so that
+     * parsing doesn't need to interpret the format string for every line
+     */
+    void compile_format();
+
     // Variables
     static std::unique_ptr<TimestampPattern[]> m_known_ts_patterns;
     static size_t m_known_ts_patterns_len;
@@ -157,6 +232,7 @@ private:
     //                   ^ ^ ^
     uint8_t m_num_spaces_before_ts;
     std::string m_format;
+    std::vector<FormatField> m_compiled_format;
 };
 }  // namespace clp
 
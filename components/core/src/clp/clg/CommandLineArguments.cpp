@@ -55,6 +55,11 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                     po::value<string>(&global_metadata_db_config_file_path)->value_name("FILE")
                             ->default_value(global_metadata_db_config_file_path),
                     "Global metadata DB YAML config"
+            )(
+                    "num-threads",
+                    po::value<size_t>(&m_num_threads)->value_name("NUM")
+                            ->default_value(m_num_threads),
+                    "Search archives in parallel using NUM threads"
             );
 
     // Define input options
@@ -276,6 +281,10 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
             default:
                 throw invalid_argument("Unknown --output-method specified.");
         }
+
+        if (0 == m_num_threads) {
+            throw invalid_argument("Number of threads must be greater than 0.");
+        }
     } catch (exception& e) {
         SPDLOG_ERROR("{}", e.what());
         print_basic_usage();
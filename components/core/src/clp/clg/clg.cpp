@@ -1,7 +1,14 @@
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
 
 #include <log_surgeon/Lexer.hpp>
 #include <spdlog/sinks/stdout_sinks.h>
@@ -41,6 +48,119 @@ using std::string;
 using std::to_string;
 using std::vector;
 
+/**
+ * Lexers generated from archives' schema files, cached by the contents of the schema files
+ */
+struct LexerCache {
+    std::map<std::string, log_surgeon::lexers::ByteLexer> forward_lexer_map;
+    std::map<std::string, log_surgeon::lexers::ByteLexer> reverse_lexer_map;
+    log_surgeon::lexers::ByteLexer one_time_use_forward_lexer;
+    log_surgeon::lexers::ByteLexer one_time_use_reverse_lexer;
+};
+
+/**
+ * Writes the results of archives searched in parallel to stdout in archive order. Each archive's
+ * results are handed over in chunks as they're found, and the thread searching an archive waits
+ * while too many of its results are waiting to be written, so that memory usage stays bounded
+ * regardless of how many results an archive has.
+ */
+class ParallelSearchOutput {
+public:
+    // Constants
+    static constexpr size_t cMaxQueuedBytesPerArchive{8UL * 1024 * 1024};
+
+    // Constructors
+    explicit ParallelSearchOutput(size_t num_archives) : m_archive_results(num_archives) {}
+
+    // Methods
+    /**
+     * Queues a chunk of the given archive's results to be written, waiting while the archive
+     * already has too many results queued. The chunk is dropped if writing has stopped.
+     * @param archive_ix
+     * @param chunk
+     */
+    void append(size_t archive_ix, string&& chunk);
+
+    /**
+     * Marks the given archive's search as done
+     * @param archive_ix
+     * @param succeeded
+     */
+    void finish(size_t archive_ix, bool succeeded);
+
+    /**
+     * @return Whether the search of any archive failed
+     */
+    [[nodiscard]] bool has_search_failed() const { return m_search_failed; }
+
+    /**
+     * Writes each archive's results as they're queued, in archive order, until every archive's
+     * results are written or an archive's search fails
+     * @return Whether every archive's search succeeded
+     */
+    bool write_in_order();
+
+private:
+    // Types
+    struct ArchiveResults {
+        std::deque<string> chunks;
+        size_t num_queued_bytes{0};
+        bool is_done{false};
+        bool succeeded{false};
+    };
+
+    // Variables
+    vector<ArchiveResults> m_archive_results;
+    std::atomic_bool m_search_failed{false};
+    bool m_is_writing_stopped{false};
+    std::mutex m_mutex;
+    std::condition_variable m_results_changed_cv;
+};
+
+/**
+ * Buffers the results of searching an archive, handing them to a ParallelSearchOutput once enough
+ * have been buffered
+ */
+class ArchiveOutputBuffer {
+public:
+    // Constants
+    static constexpr size_t cChunkSize{64UL * 1024};
+
+    // Constructors
+    ArchiveOutputBuffer(ParallelSearchOutput& output, size_t archive_ix)
+            : m_output{output},
+              m_archive_ix{archive_ix} {}
+
+    // Methods
+    [[nodiscard]] string& get_buffer() { return m_buffer; }
+
+    /**
+     * Hands the buffered results to the output if there are at least a chunk's worth
+     */
+    void flush_if_full() {
+        if (m_buffer.size() >= cChunkSize) {
+            flush();
+        }
+    }
+
+    /**
+     * Hands any buffered results to the output
+     */
+    void flush() {
+        if (m_buffer.empty()) {
+            return;
+        }
+        m_output.append(m_archive_ix, std::move(m_buffer));
+        m_buffer.clear();
+    }
+
+private:
+    // Variables
+    ParallelSearchOutput& m_output;
+    size_t m_archive_ix;
+    string m_buffer;
+};
+
 /**
  * Opens the archive and reads the dictionaries
  * @param archive_path
@@ -48,18 +168,56 @@ using std::vector;
  * @return true on success, false otherwise
  */
 static bool open_archive(string const& archive_path, Archive& archive_reader);
+/**
+ * Gets the lexers for the given archive, generating them from the archive's schema file if they
+ * aren't already cached
+ * @param archive_path
+ * @param lexer_cache
+ * @param forward_lexer_ptr Returns the forward lexer
+ * @param reverse_lexer_ptr Returns the reverse lexer
+ * @return Whether the archive should be searched using heuristics, i.e., it has no schema file
+ */
+static bool load_lexers(
+        std::filesystem::path const& archive_path,
+        LexerCache& lexer_cache,
+        log_surgeon::lexers::ByteLexer*& forward_lexer_ptr,
+        log_surgeon::lexers::ByteLexer*& reverse_lexer_ptr
+);
 /**
  * Searches the archive with the given parameters
  * @param search_strings
  * @param command_line_args
  * @param archive
+ * @param forward_lexer
+ * @param reverse_lexer
+ * @param use_heuristic
+ * @param output_buffer Buffer to append results to, or nullptr to write results to stdout
  * @return true on success, false otherwise
  */
 static bool search(
         vector<string> const& search_strings,
         CommandLineArguments& command_line_args,
         Archive& archive,
-        bool use_heuristic
+        log_surgeon::lexers::ByteLexer& forward_lexer,
+        log_surgeon::lexers::ByteLexer& reverse_lexer,
+        bool use_heuristic,
+        ArchiveOutputBuffer* output_buffer
+);
+/**
+ * Searches the given archives using a pool of threads, each with its own archive reader. Results
+ * are written to stdout in archive order as they're found, exactly as if the archives were searched
+ * sequentially.
+ * @param search_strings
+ * @param command_line_args
+ * @param archive_paths
+ * @param num_threads
+ * @return true on success, false otherwise
+ */
+static bool search_archives_in_parallel(
+        vector<string> const& search_strings,
+        CommandLineArguments& command_line_args,
+        vector<std::filesystem::path> const& archive_paths,
+        size_t num_threads
 );
 /**
  * Opens a compressed file or logs any errors if it couldn't be opened
@@ -79,20 +237,23 @@ static bool open_compressed_file(
  * @param output_method
  * @param archive
  * @param file_metadata_ix
+ * @param output_buffer Buffer to append results to, or nullptr to write results to stdout
  * @return The total number of matches found across all files
  */
 static size_t search_files(
         vector<Query>& queries,
         CommandLineArguments::OutputMethod output_method,
         Archive& archive,
-        MetadataDB::FileIterator& file_metadata_ix
+        MetadataDB::FileIterator& file_metadata_ix,
+        ArchiveOutputBuffer* output_buffer
 );
 /**
  * Prints search result to stdout in text format
  * @param orig_file_path
  * @param compressed_msg
  * @param decompressed_msg
- * @param custom_arg Unused
+ * @param custom_arg Buffer (ArchiveOutputBuffer*) to append the result to instead of stdout, or
+ * nullptr
  */
 static void print_result_text(
         string const& orig_file_path,
@@ -105,7 +266,8 @@ static void print_result_text(
  * @param orig_file_path
  * @param compressed_msg
  * @param decompressed_msg
- * @param custom_arg Unused
+ * @param custom_arg Buffer (ArchiveOutputBuffer*) to append the result to instead of stdout, or
+ * nullptr
  */
 static void print_result_binary(
         string const& orig_file_path,
@@ -201,13 +363,72 @@ static bool open_archive(string const& archive_path, Archive& archive_reader) {
     return true;
 }
 
+static bool load_lexers(
+        std::filesystem::path const& archive_path,
+        LexerCache& lexer_cache,
+        log_surgeon::lexers::ByteLexer*& forward_lexer_ptr,
+        log_surgeon::lexers::ByteLexer*& reverse_lexer_ptr
+) {
+    // TODO: if performance is too slow, can make this more efficient by only diffing files with the
+    // same checksum
+    uint32_t const max_map_schema_length = 100'000;
+
+    // The lexers are unused when searching with heuristics
+    forward_lexer_ptr = &lexer_cache.one_time_use_forward_lexer;
+    reverse_lexer_ptr = &lexer_cache.one_time_use_reverse_lexer;
+
+    // Generate lexer if schema file exists
+    auto schema_file_path = archive_path / clp::streaming_archive::cSchemaFileName;
+    if (false == std::filesystem::exists(schema_file_path)) {
+        return true;
+    }
+
+    char buf[max_map_schema_length];
+    FileReader file_reader{schema_file_path};
+
+    size_t num_bytes_read;
+    file_reader.read(buf, max_map_schema_length, num_bytes_read);
+    if (num_bytes_read < max_map_schema_length) {
+        auto& forward_lexer_map = lexer_cache.forward_lexer_map;
+        auto& reverse_lexer_map = lexer_cache.reverse_lexer_map;
+        auto forward_lexer_map_it = forward_lexer_map.find(buf);
+        auto reverse_lexer_map_it = reverse_lexer_map.find(buf);
+        // if there is a chance there might be a difference make a new lexer as it's pretty fast to
+        // create
+        if (forward_lexer_map_it == forward_lexer_map.end()) {
+            // Create forward lexer
+            auto insert_result = forward_lexer_map.emplace(buf, log_surgeon::lexers::ByteLexer());
+            forward_lexer_ptr = &insert_result.first->second;
+            load_lexer_from_file(schema_file_path, false, *forward_lexer_ptr);
+
+            // Create reverse lexer
+            insert_result = reverse_lexer_map.emplace(buf, log_surgeon::lexers::ByteLexer());
+            reverse_lexer_ptr = &insert_result.first->second;
+            load_lexer_from_file(schema_file_path, true, *reverse_lexer_ptr);
+        } else {
+            // load the lexers if they already exist
+            forward_lexer_ptr = &forward_lexer_map_it->second;
+            reverse_lexer_ptr = &reverse_lexer_map_it->second;
+        }
+    } else {
+        // Create forward lexer
+        load_lexer_from_file(schema_file_path, false, lexer_cache.one_time_use_forward_lexer);
+
+        // Create reverse lexer
+        load_lexer_from_file(schema_file_path, false, lexer_cache.one_time_use_reverse_lexer);
+    }
+
+    return false;
+}
+
 static bool search(
         vector<string> const& search_strings,
         CommandLineArguments& command_line_args,
         Archive& archive,
         log_surgeon::lexers::ByteLexer& forward_lexer,
         log_surgeon::lexers::ByteLexer& reverse_lexer,
-        bool use_heuristic
+        bool use_heuristic,
+        ArchiveOutputBuffer* output_buffer
 ) {
     ErrorCode error_code;
     auto search_begin_ts = command_line_args.get_search_begin_ts();
@@ -270,7 +491,8 @@ static bool search(
                         queries,
                         command_line_args.get_output_method(),
                         archive,
-                        *file_metadata_ix
+                        *file_metadata_ix,
+                        output_buffer
                 );
             } else {
                 auto file_metadata_ix_ptr = archive.get_file_iterator(
@@ -285,7 +507,8 @@ static bool search(
                         queries,
                         command_line_args.get_output_method(),
                         archive,
-                        file_metadata_ix
+                        file_metadata_ix,
+                        output_buffer
                 );
                 for (auto segment_id : ids_of_segments_to_search) {
                     file_metadata_ix.set_segment_id(segment_id);
@@ -293,7 +516,8 @@ static bool search(
                             queries,
                             command_line_args.get_output_method(),
                             archive,
-                            file_metadata_ix
+                            file_metadata_ix,
+                            output_buffer
                     );
                 }
             }
@@ -325,6 +549,134 @@ static bool search(
     return true;
 }
 
+static bool search_archives_in_parallel(
+        vector<string> const& search_strings,
+        CommandLineArguments& command_line_args,
+        vector<std::filesystem::path> const& archive_paths,
+        size_t num_threads
+) {
+    ParallelSearchOutput output{archive_paths.size()};
+    std::atomic_size_t next_archive_ix{0};
+
+    auto search_next_archives = [&]() {
+        LexerCache lexer_cache;
+        Archive archive_reader;
+        log_surgeon::lexers::ByteLexer* forward_lexer_ptr{nullptr};
+        log_surgeon::lexers::ByteLexer* reverse_lexer_ptr{nullptr};
+        for (auto archive_ix = next_archive_ix++; archive_ix < archive_paths.size();
+             archive_ix = next_archive_ix++)
+        {
+            auto const& archive_path = archive_paths[archive_ix];
+            ArchiveOutputBuffer output_buffer{output, archive_ix};
+            bool succeeded{false};
+            // Once a search fails, the remaining archives are skipped
+            if (false == output.has_search_failed()
+                && open_archive(archive_path.string(), archive_reader))
+            {
+                bool const use_heuristic = load_lexers(
+                        archive_path,
+                        lexer_cache,
+                        forward_lexer_ptr,
+                        reverse_lexer_ptr
+                );
+                succeeded = search(
+                        search_strings,
+                        command_line_args,
+                        archive_reader,
+                        *forward_lexer_ptr,
+                        *reverse_lexer_ptr,
+                        use_heuristic,
+                        &output_buffer
+                );
+                archive_reader.close();
+            }
+            output_buffer.flush();
+            output.finish(archive_ix, succeeded);
+        }
+    };
+
+    vector<std::thread> threads;
+    num_threads = std::min(num_threads, archive_paths.size());
+    threads.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back(search_next_archives);
+    }
+
+    bool const succeeded = output.write_in_order();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return succeeded;
+}
+
+void ParallelSearchOutput::append(size_t archive_ix, string&& chunk) {
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto& results = m_archive_results[archive_ix];
+        m_results_changed_cv.wait(lock, [&] {
+            return m_is_writing_stopped || results.num_queued_bytes < cMaxQueuedBytesPerArchive;
+        });
+        if (m_is_writing_stopped) {
+            return;
+        }
+        results.num_queued_bytes += chunk.size();
+        results.chunks.emplace_back(std::move(chunk));
+    }
+    m_results_changed_cv.notify_all();
+}
+
+void ParallelSearchOutput::finish(size_t archive_ix, bool succeeded) {
+    {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        auto& results = m_archive_results[archive_ix];
+        results.succeeded = succeeded;
+        results.is_done = true;
+    }
+    if (false == succeeded) {
+        m_search_failed = true;
+    }
+    m_results_changed_cv.notify_all();
+}
+
+bool ParallelSearchOutput::write_in_order() {
+    bool succeeded{true};
+    for (auto& results : m_archive_results) {
+        while (true) {
+            string chunk;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_results_changed_cv.wait(lock, [&results] {
+                    return false == results.chunks.empty() || results.is_done;
+                });
+                if (results.chunks.empty()) {
+                    succeeded = results.succeeded;
+                    break;
+                }
+                chunk = std::move(results.chunks.front());
+                results.chunks.pop_front();
+                results.num_queued_bytes -= chunk.size();
+            }
+            m_results_changed_cv.notify_all();
+
+            if (fwrite(chunk.data(), sizeof(char), chunk.size(), stdout) < chunk.size()) {
+                SPDLOG_ERROR("Failed to write results, errno={}", errno);
+            }
+        }
+        if (false == succeeded) {
+            break;
+        }
+    }
+
+    // Release any threads waiting to queue results that will never be written
+    {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        m_is_writing_stopped = true;
+    }
+    m_results_changed_cv.notify_all();
+    return succeeded;
+}
+
 static bool open_compressed_file(
         MetadataDB::FileIterator& file_metadata_ix,
         Archive& archive,
@@ -350,7 +702,8 @@ static size_t search_files(
         vector<Query>& queries,
         CommandLineArguments::OutputMethod const output_method,
         Archive& archive,
-        MetadataDB::FileIterator& file_metadata_ix
+        MetadataDB::FileIterator& file_metadata_ix,
+        ArchiveOutputBuffer* output_buffer
 ) {
     size_t num_matches = 0;
 
@@ -361,11 +714,11 @@ static size_t search_files(
     switch (output_method) {
         case CommandLineArguments::OutputMethod::StdoutText:
             output_func = print_result_text;
-            output_func_arg = nullptr;
+            output_func_arg = output_buffer;
             break;
         case CommandLineArguments::OutputMethod::StdoutBinary:
             output_func = print_result_binary;
-            output_func_arg = nullptr;
+            output_func_arg = output_buffer;
             break;
         default:
             SPDLOG_ERROR("Unknown output method - {}", (char)output_method);
@@ -374,6 +727,13 @@ static size_t search_files(
 
     // Run all queries on each file
     for (; file_metadata_ix.has_next(); file_metadata_ix.next()) {
+        if (std::none_of(queries.begin(), queries.end(), [&](Query& query) {
+                return archive.file_may_match_query(file_metadata_ix, query);
+            }))
+        {
+            continue;
+        }
+
         if (open_compressed_file(file_metadata_ix, archive, compressed_file)) {
             Grep::calculate_sub_queries_relevant_to_file(compressed_file, queries);
 
@@ -401,6 +761,15 @@ static void print_result_text(
         string const& decompressed_msg,
         void* custom_arg
 ) {
+    if (nullptr != custom_arg) {
+        auto& archive_output_buffer = *static_cast<ArchiveOutputBuffer*>(custom_arg);
+        auto& output_buffer = archive_output_buffer.get_buffer();
+        output_buffer += orig_file_path;
+        output_buffer += ':';
+        output_buffer += decompressed_msg;
+        archive_output_buffer.flush_if_full();
+        return;
+    }
     printf("%s:%s", orig_file_path.c_str(), decompressed_msg.c_str());
 }
 
@@ -410,54 +779,36 @@ static void print_result_binary(
         string const& decompressed_msg,
         void* custom_arg
 ) {
-    bool write_successful = true;
-    do {
-        size_t length;
-        size_t num_elems_written;
-
-        // Write file path
-        length = orig_file_path.length();
-        num_elems_written = fwrite(&length, sizeof(length), 1, stdout);
-        if (num_elems_written < 1) {
-            write_successful = false;
-            break;
-        }
-        num_elems_written = fwrite(orig_file_path.c_str(), sizeof(char), length, stdout);
-        if (num_elems_written < length) {
-            write_successful = false;
-            break;
-        }
-
-        // Write timestamp
-        epochtime_t timestamp = compressed_msg.get_ts_in_milli();
-        num_elems_written = fwrite(&timestamp, sizeof(timestamp), 1, stdout);
-        if (num_elems_written < 1) {
-            write_successful = false;
-            break;
-        }
-
-        // Write logtype ID
-        auto logtype_id = compressed_msg.get_logtype_id();
-        num_elems_written = fwrite(&logtype_id, sizeof(logtype_id), 1, stdout);
-        if (num_elems_written < 1) {
-            write_successful = false;
-            break;
-        }
-
-        // Write message
-        length = decompressed_msg.length();
-        num_elems_written = fwrite(&length, sizeof(length), 1, stdout);
-        if (num_elems_written < 1) {
-            write_successful = false;
-            break;
-        }
-        num_elems_written = fwrite(decompressed_msg.c_str(), sizeof(char), length, stdout);
-        if (num_elems_written < length) {
-            write_successful = false;
-            break;
-        }
-    } while (false);
-    if (!write_successful) {
+    string local_buffer;
+    auto* archive_output_buffer = static_cast<ArchiveOutputBuffer*>(custom_arg);
+    auto& output_buffer = (nullptr == archive_output_buffer) ? local_buffer
+                                                              : archive_output_buffer->get_buffer();
+    auto append_numeric_value = [&output_buffer](auto value) {
+        output_buffer.append(reinterpret_cast<char const*>(&value), sizeof(value));
+    };
+
+    // Write file path
+    append_numeric_value(orig_file_path.length());
+    output_buffer += orig_file_path;
+
+    // Write timestamp
+    epochtime_t timestamp = compressed_msg.get_ts_in_milli();
+    append_numeric_value(timestamp);
+
+    // Write logtype ID
+    append_numeric_value(compressed_msg.get_logtype_id());
+
+    // Write message
+    append_numeric_value(decompressed_msg.length());
+    output_buffer += decompressed_msg;
+
+    if (nullptr != archive_output_buffer) {
+        archive_output_buffer->flush_if_full();
+        return;
+    }
+    size_t num_elems_written
+            = fwrite(local_buffer.data(), sizeof(char), local_buffer.size(), stdout);
+    if (num_elems_written < local_buffer.size()) {
         SPDLOG_ERROR("Failed to write result in binary form, errno={}", errno);
     }
 }
@@ -465,7 +816,7 @@ static void print_result_binary(
 int main(int argc, char const* argv[]) {
     // Program-wide initialization
     try {
-        auto stderr_logger = spdlog::stderr_logger_st("stderr");
+        auto stderr_logger = spdlog::stderr_logger_mt("stderr");
         spdlog::set_default_logger(stderr_logger);
         spdlog::set_pattern("%Y-%m-%d %H:%M:%S,%e [%l] %v");
     } catch (std::exception& e) {
@@ -542,16 +893,12 @@ int main(int argc, char const* argv[]) {
     }
     global_metadata_db->open();
 
-    // TODO: if performance is too slow, can make this more efficient by only diffing files with the
-    // same checksum
-    uint32_t const max_map_schema_length = 100'000;
-    std::map<std::string, log_surgeon::lexers::ByteLexer> forward_lexer_map;
-    std::map<std::string, log_surgeon::lexers::ByteLexer> reverse_lexer_map;
-    log_surgeon::lexers::ByteLexer one_time_use_forward_lexer;
-    log_surgeon::lexers::ByteLexer one_time_use_reverse_lexer;
+    LexerCache lexer_cache;
     log_surgeon::lexers::ByteLexer* forward_lexer_ptr;
     log_surgeon::lexers::ByteLexer* reverse_lexer_ptr;
 
+    auto const num_threads = command_line_args.get_num_threads();
+    vector<std::filesystem::path> archive_paths_to_search_in_parallel;
     string archive_id;
     Archive archive_reader;
     for (auto archive_ix = std::unique_ptr<GlobalMetadataDB::ArchiveIterator>(get_archive_iterator(
@@ -575,54 +922,19 @@ int main(int argc, char const* argv[]) {
             continue;
         }
 
+        if (num_threads > 1) {
+            // Search the archives once they've all been listed
+            archive_paths_to_search_in_parallel.emplace_back(std::move(archive_path));
+            continue;
+        }
+
         // Open archive
         if (!open_archive(archive_path.string(), archive_reader)) {
             return -1;
         }
 
-        // Generate lexer if schema file exists
-        auto schema_file_path = archive_path / clp::streaming_archive::cSchemaFileName;
-        bool use_heuristic = true;
-        if (std::filesystem::exists(schema_file_path)) {
-            use_heuristic = false;
-
-            char buf[max_map_schema_length];
-            FileReader file_reader{schema_file_path};
-
-            size_t num_bytes_read;
-            file_reader.read(buf, max_map_schema_length, num_bytes_read);
-            if (num_bytes_read < max_map_schema_length) {
-                auto forward_lexer_map_it = forward_lexer_map.find(buf);
-                auto reverse_lexer_map_it = reverse_lexer_map.find(buf);
-                // if there is a chance there might be a difference make a new lexer as it's pretty
-                // fast to create
-                if (forward_lexer_map_it == forward_lexer_map.end()) {
-                    // Create forward lexer
-                    auto insert_result
-                            = forward_lexer_map.emplace(buf, log_surgeon::lexers::ByteLexer());
-                    forward_lexer_ptr = &insert_result.first->second;
-                    load_lexer_from_file(schema_file_path, false, *forward_lexer_ptr);
-
-                    // Create reverse lexer
-                    insert_result
-                            = reverse_lexer_map.emplace(buf, log_surgeon::lexers::ByteLexer());
-                    reverse_lexer_ptr = &insert_result.first->second;
-                    load_lexer_from_file(schema_file_path, true, *reverse_lexer_ptr);
-                } else {
-                    // load the lexers if they already exist
-                    forward_lexer_ptr = &forward_lexer_map_it->second;
-                    reverse_lexer_ptr = &reverse_lexer_map_it->second;
-                }
-            } else {
-                // Create forward lexer
-                forward_lexer_ptr = &one_time_use_forward_lexer;
-                load_lexer_from_file(schema_file_path, false, one_time_use_forward_lexer);
-
-                // Create reverse lexer
-                reverse_lexer_ptr = &one_time_use_reverse_lexer;
-                load_lexer_from_file(schema_file_path, false, one_time_use_reverse_lexer);
-            }
-        }
+        bool const use_heuristic
+                = load_lexers(archive_path, lexer_cache, forward_lexer_ptr, reverse_lexer_ptr);
 
         // Perform search
         if (!search(search_strings,
@@ -630,13 +942,26 @@ int main(int argc, char const* argv[]) {
                     archive_reader,
                     *forward_lexer_ptr,
                     *reverse_lexer_ptr,
-                    use_heuristic))
+                    use_heuristic,
+                    nullptr))
         {
             return -1;
         }
         archive_reader.close();
     }
 
+    if (false == archive_paths_to_search_in_parallel.empty()
+        && false
+                   == search_archives_in_parallel(
+                           search_strings,
+                           command_line_args,
+                           archive_paths_to_search_in_parallel,
+                           num_threads
+                   ))
+    {
+        return -1;
+    }
+
     global_metadata_db->close();
 
     Profiler::stop_continuous_measurement<Profiler::ContinuousMeasurementIndex::Search>();
@@ -181,13 +181,25 @@ auto CommandLineArguments::parse_ir_extraction_arguments(
     // clang-format off
     options_ir_extraction
             .add_options()(
-                    "temp-output-dir",
-                    po::value<string>(&m_ir_temp_output_dir)->value_name("DIR"),
-                    "Temporary output directory for IR chunks while they're being written"
-            )(
                     "target-size",
                     po::value<size_t>(&m_ir_target_size)->value_name("SIZE"),
                     "Target size (B) for each IR chunk before a new chunk is created"
+            )(
+                    "seek-index-interval",
+                    po::value<size_t>(&m_ir_seek_index_checkpoint_interval)
+                            ->value_name("NUM_EVENTS"),
+                    "Write a seek index next to each IR chunk with a checkpoint every NUM_EVENTS"
+                    " log events (0 disables the index)"
+            )(
+                    "target-msg-ix",
+                    po::value<size_t>()->value_name("MSG_IX"),
+                    "Only extract the IR chunk containing the message with index MSG_IX, reusing"
+                    " it if it's already in OUTPUT_DIR"
+            )(
+                    "cache-size",
+                    po::value<size_t>(&m_ir_cache_size)->value_name("SIZE"),
+                    "Evict the least recently used IR chunks from OUTPUT_DIR until their total"
+                    " size (B) is at most SIZE (0 disables eviction)"
             );
     // clang-format on
 
@@ -260,6 +272,17 @@ auto CommandLineArguments::parse_ir_extraction_arguments(
              << endl;
         cerr << endl;
 
+        cerr << R"(  # Extract only the IR chunk containing message 1000 of the same file (split),)"
+             << endl;
+        cerr << R"(  # reusing it if it's cached in OUTPUT_DIR, and keep OUTPUT_DIR under 1 GiB)"
+             << endl;
+        cerr << "  " << get_program_name()
+             << " i --target-msg-ix 1000 --cache-size 1073741824 ARCHIVE_PATH "
+                "8cf8d8f2-bf3f-42a2-90b2-6bc4ed0a36b4 OUTPUT_DIR "
+                "mongodb://127.0.0.1:27017/test result"
+             << endl;
+        cerr << endl;
+
         cerr << "Options can be specified on the command line or through a configuration "
                 "file."
              << endl;
@@ -288,8 +311,8 @@ auto CommandLineArguments::parse_ir_extraction_arguments(
         throw invalid_argument("COLLECTION not specified or empty.");
     }
 
-    if (m_ir_temp_output_dir.empty()) {
-        m_ir_temp_output_dir = m_ir_output_dir;
+    if (0 != parsed_command_line_options.count("target-msg-ix")) {
+        m_ir_target_msg_ix = parsed_command_line_options["target-msg-ix"].as<size_t>();
     }
     return ParsingResult::Success;
 }
@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -52,12 +53,18 @@ public:
 
     [[nodiscard]] size_t get_ir_target_size() const { return m_ir_target_size; }
 
+    [[nodiscard]] auto get_ir_seek_index_checkpoint_interval() const -> size_t {
+        return m_ir_seek_index_checkpoint_interval;
+    }
+
     [[nodiscard]] auto get_ir_output_dir() const -> std::string const& { return m_ir_output_dir; }
 
-    [[nodiscard]] auto get_ir_temp_output_dir() const -> std::string const& {
-        return m_ir_temp_output_dir;
+    [[nodiscard]] auto get_ir_target_msg_ix() const -> std::optional<size_t> const& {
+        return m_ir_target_msg_ix;
     }
 
+    [[nodiscard]] auto get_ir_cache_size() const -> size_t { return m_ir_cache_size; }
+
     [[nodiscard]] auto get_ir_mongodb_uri() const -> std::string const& { return m_ir_mongodb_uri; }
 
     [[nodiscard]] auto get_ir_mongodb_collection() const -> std::string const& {
@@ -186,8 +193,10 @@ private:
     // Variables for IR extraction
     std::string m_file_split_id;
     size_t m_ir_target_size{128ULL * 1024 * 1024};
+    size_t m_ir_seek_index_checkpoint_interval{0};
     std::string m_ir_output_dir;
-    std::string m_ir_temp_output_dir;
+    std::optional<size_t> m_ir_target_msg_ix;
+    size_t m_ir_cache_size{0};
     std::string m_ir_mongodb_uri;
     std::string m_ir_mongodb_collection;
 
@@ -0,0 +1,376 @@
+#include "IrChunkCache.hpp"
+
+#include <sys/file.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "../ErrorCode.hpp"
+#include "../FileDescriptor.hpp"
+#include "../FileWriter.hpp"
+#include "../ir/constants.hpp"
+#include "../ir/SeekIndex.hpp"
+
+using clp::ir::cIrFileExtension;
+using clp::ir::cSeekIndexFileExtension;
+using std::string;
+using std::string_view;
+
+namespace clp::clo {
+namespace {
+// The name of the file locked by processes accessing the cache. It isn't named like a chunk.
+constexpr string_view cLockFileName{".ir_chunk_cache.lock"};
+// The suffix of the temporary files that chunks and seek indexes are written to. It isn't that of a
+// chunk.
+constexpr string_view cTempFileExtension{".tmp"};
+
+// Distinguishes the temporary files written by the threads of a process
+std::atomic<size_t> num_temp_files_created{0};
+
+/**
+ * Parses the given string as a message index
+ * @param str
+ * @param message_ix Returns the message index
+ * @return Whether the entire string is a message index
+ */
+auto parse_message_ix(string_view str, size_t& message_ix) -> bool;
+
+auto parse_message_ix(string_view str, size_t& message_ix) -> bool {
+    auto const* str_end = str.data() + str.length();
+    auto const [ptr, error_code] = std::from_chars(str.data(), str_end, message_ix);
+    return std::errc{} == error_code && str_end == ptr;
+}
+}  // namespace
+
+IrChunkCache::DirectoryLock::DirectoryLock(FileDescriptor const& lock_file)
+        : m_fd{lock_file.get_raw_fd()} {
+    if (0 != flock(m_fd, LOCK_EX)) {
+        throw OperationFailed(ErrorCode_errno, __FILENAME__, __LINE__);
+    }
+}
+
+IrChunkCache::DirectoryLock::~DirectoryLock() {
+    flock(m_fd, LOCK_UN);
+}
+
+IrChunkCache::IrChunkCache(std::filesystem::path dir)
+        : m_dir{std::move(dir)},
+          m_lock_file{(m_dir / cLockFileName).string(), FileDescriptor::OpenMode::CreateForWrite} {
+    DirectoryLock const lock{m_lock_file};
+    load_chunks();
+}
+
+auto IrChunkCache::get_chunk_file_name(
+        string_view orig_file_id,
+        size_t begin_message_ix,
+        size_t end_message_ix
+) -> string {
+    string file_name{orig_file_id};
+    file_name += "_" + std::to_string(begin_message_ix);
+    file_name += "_" + std::to_string(end_message_ix);
+    file_name += cIrFileExtension;
+    return file_name;
+}
+
+auto IrChunkCache::parse_chunk_file_name(
+        string_view file_name,
+        string& orig_file_id,
+        size_t& begin_message_ix,
+        size_t& end_message_ix
+) -> bool {
+    if (false == file_name.ends_with(cIrFileExtension)) {
+        return false;
+    }
+    auto const stem = file_name.substr(0, file_name.length() - cIrFileExtension.length());
+
+    auto const end_message_ix_pos = stem.rfind('_');
+    if (string_view::npos == end_message_ix_pos || 0 == end_message_ix_pos) {
+        return false;
+    }
+    auto const begin_message_ix_pos = stem.rfind('_', end_message_ix_pos - 1);
+    if (string_view::npos == begin_message_ix_pos || 0 == begin_message_ix_pos) {
+        return false;
+    }
+
+    if (false
+                == parse_message_ix(
+                        stem.substr(
+                                begin_message_ix_pos + 1,
+                                end_message_ix_pos - begin_message_ix_pos - 1
+                        ),
+                        begin_message_ix
+                )
+        || false == parse_message_ix(stem.substr(end_message_ix_pos + 1), end_message_ix)
+        || begin_message_ix >= end_message_ix)
+    {
+        return false;
+    }
+    orig_file_id = stem.substr(0, begin_message_ix_pos);
+    return true;
+}
+
+auto IrChunkCache::find(string const& orig_file_id, size_t message_ix) -> std::optional<Chunk> {
+    DirectoryLock const lock{m_lock_file};
+
+    // Chunks are ordered by their original file ID and then by their message range
+    for (auto it = m_chunks.lower_bound(ChunkKey{orig_file_id, 0, 0});
+         m_chunks.end() != it && std::get<0>(it->first) == orig_file_id
+         && it->second.begin_message_ix <= message_ix;
+         ++it)
+    {
+        auto& chunk = it->second;
+        if (message_ix >= chunk.end_message_ix) {
+            continue;
+        }
+
+        // Another process may have evicted the chunk since it was loaded, in which case it's a miss
+        if (false == pin_chunk(chunk.file_name)) {
+            m_size -= chunk.size;
+            m_chunks.erase(it);
+            return std::nullopt;
+        }
+        chunk.last_used_time = std::filesystem::file_time_type::clock::now();
+        std::error_code error_code;
+        std::filesystem::last_write_time(m_dir / chunk.file_name, chunk.last_used_time, error_code);
+        return chunk;
+    }
+    return std::nullopt;
+}
+
+auto IrChunkCache::add(
+        string const& orig_file_id,
+        size_t begin_message_ix,
+        size_t end_message_ix,
+        std::span<char const> ir_chunk,
+        std::optional<ir::SeekIndex> const& seek_index
+) -> string {
+    auto file_name = get_chunk_file_name(orig_file_id, begin_message_ix, end_message_ix);
+    auto const path = m_dir / file_name;
+
+    auto seek_index_path = path.string();
+    seek_index_path += cSeekIndexFileExtension;
+
+    // Write the chunk and its seek index next to their final paths so that they can be renamed
+    // into place atomically
+    auto const temp_path = get_temp_path(file_name);
+    std::optional<string> temp_seek_index_path;
+    auto const remove_temp_files = [&]() {
+        std::error_code error_code;
+        std::filesystem::remove(temp_path, error_code);
+        if (temp_seek_index_path.has_value()) {
+            std::filesystem::remove(temp_seek_index_path.value(), error_code);
+        }
+    };
+    try {
+        FileWriter file_writer;
+        file_writer.open(temp_path, FileWriter::OpenMode::CREATE_FOR_WRITING);
+        file_writer.write(ir_chunk.data(), ir_chunk.size());
+        file_writer.close();
+
+        if (seek_index.has_value()) {
+            temp_seek_index_path = get_temp_path(file_name + string{cSeekIndexFileExtension});
+            seek_index->write_to_file(temp_seek_index_path.value());
+        }
+    } catch (FileWriter::OperationFailed const&) {
+        remove_temp_files();
+        throw;
+    }
+
+    DirectoryLock const lock{m_lock_file};
+    // Release this instance's pin (if any) so that it can be replaced by a pin on the new file
+    m_pinned_chunks.erase(file_name);
+
+    // Replace the seek index before the chunk so that the new chunk is never paired with a stale
+    // seek index from a previous extraction of the chunk
+    std::error_code error_code;
+    if (temp_seek_index_path.has_value()) {
+        std::filesystem::rename(temp_seek_index_path.value(), seek_index_path, error_code);
+    } else {
+        std::filesystem::remove(seek_index_path, error_code);
+    }
+    if (false == static_cast<bool>(error_code)) {
+        std::filesystem::rename(temp_path, path, error_code);
+    }
+    if (error_code) {
+        remove_temp_files();
+        throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
+    }
+
+    auto const size = get_chunk_size(file_name);
+    Chunk chunk{
+            file_name,
+            begin_message_ix,
+            end_message_ix,
+            size,
+            std::filesystem::file_time_type::clock::now()
+    };
+    auto const [it, inserted] = m_chunks.try_emplace(
+            ChunkKey{orig_file_id, begin_message_ix, end_message_ix},
+            chunk
+    );
+    if (false == inserted) {
+        m_size -= it->second.size;
+        it->second = std::move(chunk);
+    }
+    m_size += size;
+    if (false == pin_chunk(file_name)) {
+        throw OperationFailed(ErrorCode_FileNotFound, __FILENAME__, __LINE__);
+    }
+    return file_name;
+}
+
+auto IrChunkCache::evict(size_t max_size) -> std::vector<string> {
+    std::vector<string> evicted_chunk_file_names;
+
+    DirectoryLock const lock{m_lock_file};
+    // Other processes may have added, used, or evicted chunks since they were loaded
+    load_chunks();
+    if (m_size <= max_size) {
+        return evicted_chunk_file_names;
+    }
+
+    std::vector<std::map<ChunkKey, Chunk>::iterator> evictable_chunks;
+    for (auto it = m_chunks.begin(); m_chunks.end() != it; ++it) {
+        if (0 == m_pinned_chunks.count(it->second.file_name)) {
+            evictable_chunks.push_back(it);
+        }
+    }
+    std::sort(
+            evictable_chunks.begin(),
+            evictable_chunks.end(),
+            [](auto const& lhs, auto const& rhs) {
+                return lhs->second.last_used_time < rhs->second.last_used_time;
+            }
+    );
+
+    for (auto const& it : evictable_chunks) {
+        if (m_size <= max_size) {
+            break;
+        }
+        auto const path = m_dir / it->second.file_name;
+        try {
+            // Another process has the chunk pinned if it holds a shared lock on the chunk's file
+            FileDescriptor const chunk_file{path.string(), FileDescriptor::OpenMode::ReadOnly};
+            if (0 != flock(chunk_file.get_raw_fd(), LOCK_EX | LOCK_NB)) {
+                continue;
+            }
+        } catch (FileDescriptor::OperationFailed const&) {
+            // The chunk no longer exists
+            m_size -= it->second.size;
+            m_chunks.erase(it);
+            continue;
+        }
+
+        std::error_code error_code;
+        std::filesystem::remove(path, error_code);
+        if (error_code) {
+            continue;
+        }
+        auto seek_index_path = path.string();
+        seek_index_path += cSeekIndexFileExtension;
+        std::filesystem::remove(seek_index_path, error_code);
+
+        m_size -= it->second.size;
+        evicted_chunk_file_names.emplace_back(std::move(it->second.file_name));
+        m_chunks.erase(it);
+    }
+    return evicted_chunk_file_names;
+}
+
+void IrChunkCache::load_chunks() {
+    m_chunks.clear();
+    m_size = 0;
+
+    std::error_code error_code;
+    std::filesystem::directory_iterator dir_it{m_dir, error_code};
+    if (error_code) {
+        throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
+    }
+
+    string orig_file_id;
+    size_t begin_message_ix{};
+    size_t end_message_ix{};
+    for (auto const& entry : dir_it) {
+        if (false == entry.is_regular_file(error_code)) {
+            continue;
+        }
+        auto file_name = entry.path().filename().string();
+        if (false
+            == parse_chunk_file_name(file_name, orig_file_id, begin_message_ix, end_message_ix))
+        {
+            continue;
+        }
+        // Skip chunks that are removed while the directory is being read
+        auto const last_write_time = entry.last_write_time(error_code);
+        if (error_code) {
+            continue;
+        }
+
+        auto const size = get_chunk_size(file_name);
+        m_size += size;
+        m_chunks.emplace(
+                ChunkKey{orig_file_id, begin_message_ix, end_message_ix},
+                Chunk{std::move(file_name), begin_message_ix, end_message_ix, size, last_write_time}
+        );
+    }
+}
+
+auto IrChunkCache::pin_chunk(string const& file_name) -> bool {
+    if (m_pinned_chunks.contains(file_name)) {
+        return true;
+    }
+
+    std::unique_ptr<FileDescriptor> chunk_file;
+    try {
+        chunk_file = std::make_unique<FileDescriptor>(
+                (m_dir / file_name).string(),
+                FileDescriptor::OpenMode::ReadOnly
+        );
+    } catch (FileDescriptor::OperationFailed const&) {
+        return false;
+    }
+    if (0 != flock(chunk_file->get_raw_fd(), LOCK_SH)) {
+        throw OperationFailed(ErrorCode_errno, __FILENAME__, __LINE__);
+    }
+    m_pinned_chunks.emplace(file_name, std::move(chunk_file));
+    return true;
+}
+
+auto IrChunkCache::get_temp_path(string_view file_name) const -> string {
+    string temp_file_name{"."};
+    temp_file_name += file_name;
+    temp_file_name += "." + std::to_string(getpid());
+    temp_file_name += "." + std::to_string(num_temp_files_created++);
+    temp_file_name += cTempFileExtension;
+    return (m_dir / temp_file_name).string();
+}
+
+auto IrChunkCache::get_chunk_size(string const& file_name) const -> size_t {
+    auto const path = m_dir / file_name;
+    std::error_code error_code;
+    auto size = std::filesystem::file_size(path, error_code);
+    if (error_code) {
+        return 0;
+    }
+
+    auto seek_index_path = path.string();
+    seek_index_path += cSeekIndexFileExtension;
+    auto const seek_index_size = std::filesystem::file_size(seek_index_path, error_code);
+    if (false == static_cast<bool>(error_code)) {
+        size += seek_index_size;
+    }
+    return size;
+}
+}  // namespace clp::clo
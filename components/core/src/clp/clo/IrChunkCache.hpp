@@ -0,0 +1,213 @@
+#ifndef CLP_CLO_IRCHUNKCACHE_HPP
+#define CLP_CLO_IRCHUNKCACHE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "../ErrorCode.hpp"
+#include "../FileDescriptor.hpp"
+#include "../ir/SeekIndex.hpp"
+#include "../TraceableException.hpp"
+
+namespace clp::clo {
+/**
+ * A least-recently-used cache of the IR chunks extracted into a directory. Each chunk is stored as
+ * `<orig_file_id>_<begin_message_ix>_<end_message_ix>` + `ir::cIrFileExtension` (with an optional
+ * seek index next to it), and a chunk file's last write time records when the chunk was last used.
+ * Since the cache's state is entirely in the directory, it persists across processes.
+ *
+ * Concurrent processes can share a cache directory: every operation holds an exclusive lock on a
+ * lock file in the directory, and each chunk that an instance finds or adds is pinned with a shared
+ * lock on the chunk's file until the instance is destroyed, so that no process evicts it.
+ */
+class IrChunkCache {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        // Methods
+        [[nodiscard]] auto what() const noexcept -> char const* override {
+            return "clo::IrChunkCache operation failed";
+        }
+    };
+
+    struct Chunk {
+        std::string file_name;
+        size_t begin_message_ix;
+        size_t end_message_ix;
+        // Bytes, including the chunk's seek index
+        size_t size;
+        std::filesystem::file_time_type last_used_time;
+    };
+
+    // Constructors
+    /**
+     * Loads the cache's chunks from the given directory. Files that aren't named like IR chunks are
+     * ignored.
+     * @param dir
+     * @throw IrChunkCache::OperationFailed if the directory can't be read or locked
+     * @throw FileDescriptor::OperationFailed if the directory's lock file can't be opened
+     */
+    explicit IrChunkCache(std::filesystem::path dir);
+
+    // Methods
+    /**
+     * @param orig_file_id
+     * @param begin_message_ix
+     * @param end_message_ix
+     * @return The name of the file that stores the given chunk
+     */
+    [[nodiscard]] static auto get_chunk_file_name(
+            std::string_view orig_file_id,
+            size_t begin_message_ix,
+            size_t end_message_ix
+    ) -> std::string;
+
+    /**
+     * Parses a chunk's original file ID and message range from the name of its file
+     * @param file_name
+     * @param orig_file_id Returns the original file ID
+     * @param begin_message_ix Returns the index of the chunk's first message
+     * @param end_message_ix Returns the index after the chunk's last message
+     * @return Whether the file name is that of a chunk
+     */
+    [[nodiscard]] static auto parse_chunk_file_name(
+            std::string_view file_name,
+            std::string& orig_file_id,
+            size_t& begin_message_ix,
+            size_t& end_message_ix
+    ) -> bool;
+
+    /**
+     * @return The total size of the cached chunks, in bytes
+     */
+    [[nodiscard]] auto get_size() const -> size_t { return m_size; }
+
+    /**
+     * Finds a chunk of the given original file that contains the given message, marks it as used,
+     * and pins it
+     * @param orig_file_id
+     * @param message_ix
+     * @return The chunk, or std::nullopt if no cached chunk contains the message (including if the
+     * chunk was evicted by another process)
+     * @throw IrChunkCache::OperationFailed if the directory can't be locked
+     */
+    [[nodiscard]] auto find(std::string const& orig_file_id, size_t message_ix)
+            -> std::optional<Chunk>;
+
+    /**
+     * Writes the given chunk, and its seek index if any, into the cache directory. They're written to
+     * temporary files which are then renamed into place, so other processes never see a partially
+     * written chunk.
+     * @param orig_file_id
+     * @param begin_message_ix
+     * @param end_message_ix
+     * @param ir_chunk
+     * @param seek_index
+     * @return The name of the chunk's file
+     * @throw IrChunkCache::OperationFailed if the directory can't be locked, the chunk or its seek
+     * index can't be renamed into place, or the chunk can't be pinned
+     * @throw FileWriter::OperationFailed if the chunk or its seek index couldn't be written
+     */
+    auto add(
+            std::string const& orig_file_id,
+            size_t begin_message_ix,
+            size_t end_message_ix,
+            std::span<char const> ir_chunk,
+            std::optional<ir::SeekIndex> const& seek_index
+    ) -> std::string;
+
+    /**
+     * Deletes the least recently used chunks until the cache's total size is at most `max_size`.
+     * The cache's chunks are reloaded first so that chunks added or used by other processes are
+     * accounted for. Chunks that are pinned by any process are never evicted, so the cache may
+     * remain larger than `max_size`.
+     * @param max_size
+     * @return The file names of the evicted chunks
+     * @throw IrChunkCache::OperationFailed if the directory can't be read or locked
+     */
+    auto evict(size_t max_size) -> std::vector<std::string>;
+
+private:
+    // Types
+    // (orig_file_id, begin_message_ix, end_message_ix)
+    using ChunkKey = std::tuple<std::string, size_t, size_t>;
+
+    /**
+     * Holds the exclusive lock on the cache directory's lock file while in scope.
+     */
+    class DirectoryLock {
+    public:
+        // Constructors
+        /**
+         * @param lock_file
+         * @throw IrChunkCache::OperationFailed if the lock can't be acquired
+         */
+        explicit DirectoryLock(FileDescriptor const& lock_file);
+
+        // Disable copy/move constructors/assignment operators
+        DirectoryLock(DirectoryLock const&) = delete;
+        DirectoryLock(DirectoryLock&&) = delete;
+        auto operator=(DirectoryLock const&) -> DirectoryLock& = delete;
+        auto operator=(DirectoryLock&&) -> DirectoryLock& = delete;
+
+        // Destructor
+        ~DirectoryLock();
+
+    private:
+        int m_fd;
+    };
+
+    // Methods
+    /**
+     * Loads the cache's chunks from its directory, replacing any previously loaded chunks.
+     * NOTE: The caller must hold the directory lock.
+     * @throw IrChunkCache::OperationFailed if the directory can't be read
+     */
+    void load_chunks();
+
+    /**
+     * Pins the given chunk by taking a shared lock on its file.
+     * NOTE: The caller must hold the directory lock.
+     * @param file_name
+     * @return Whether the chunk was pinned, or false if the chunk's file no longer exists
+     */
+    auto pin_chunk(std::string const& file_name) -> bool;
+
+    /**
+     * @param file_name
+     * @return A path in the cache directory, unique to this write, at which to write the given file
+     * before renaming it into place. The path's file name isn't that of a chunk.
+     */
+    [[nodiscard]] auto get_temp_path(std::string_view file_name) const -> std::string;
+
+    /**
+     * @param file_name
+     * @return The size of the given chunk file and its seek index (if any), in bytes
+     */
+    [[nodiscard]] auto get_chunk_size(std::string const& file_name) const -> size_t;
+
+    // Variables
+    std::filesystem::path m_dir;
+    FileDescriptor m_lock_file;
+    std::map<ChunkKey, Chunk> m_chunks;
+    // Open descriptors of the chunks pinned by this instance, each holding a shared lock
+    std::unordered_map<std::string, std::unique_ptr<FileDescriptor>> m_pinned_chunks;
+    size_t m_size{0};
+};
+}  // namespace clp::clo
+
+#endif  // CLP_CLO_IRCHUNKCACHE_HPP
@@ -1,26 +1,31 @@
 #include <filesystem>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 
 #include <mongocxx/instance.hpp>
+#include <mongocxx/options/replace.hpp>
 #include <spdlog/sinks/stdout_sinks.h>
 
 #include "../../reducer/network_utils.hpp"
 #include "../clp/FileDecompressor.hpp"
 #include "../Defs.h"
 #include "../Grep.hpp"
-#include "../ir/constants.hpp"
+#include "../ir/SeekIndex.hpp"
 #include "../Profiler.hpp"
 #include "../spdlog_with_specializations.hpp"
 #include "../Utils.hpp"
 #include "CommandLineArguments.hpp"
 #include "constants.hpp"
+#include "IrChunkCache.hpp"
 #include "OutputHandler.hpp"
 
 using clp::clo::CommandLineArguments;
 using clp::clo::CountByTimeOutputHandler;
 using clp::clo::CountOutputHandler;
+using clp::clo::IrChunkCache;
 using clp::clo::NetworkOutputHandler;
 using clp::clo::OutputHandler;
 using clp::clo::ResultsCacheOutputHandler;
@@ -34,7 +39,6 @@ using clp::ErrorCode_errno;
 using clp::ErrorCode_FileExists;
 using clp::ErrorCode_Success;
 using clp::Grep;
-using clp::ir::cIrFileExtension;
 using clp::load_lexer_from_file;
 using clp::Query;
 using clp::streaming_archive::MetadataDB;
@@ -109,6 +113,24 @@ namespace {
  */
 bool extract_ir(CommandLineArguments const& command_line_args);
 
+/**
+ * @param ir_file_name
+ * @param orig_file_id
+ * @param file_split_id
+ * @param begin_message_ix
+ * @param end_message_ix
+ * @param is_last_ir_chunk
+ * @return The results cache document describing the given IR chunk.
+ */
+auto make_ir_chunk_metadata(
+        string const& ir_file_name,
+        string const& orig_file_id,
+        string const& file_split_id,
+        size_t begin_message_ix,
+        size_t end_message_ix,
+        bool is_last_ir_chunk
+) -> bsoncxx::document::value;
+
 /**
  * Performs a searches acccording to the given arguments.
  * @param command_line_args
@@ -122,6 +144,36 @@ bool search(CommandLineArguments const& command_line_args);
  */
 bool validate_archive_path(std::filesystem::path const& archive_path);
 
+auto make_ir_chunk_metadata(
+        string const& ir_file_name,
+        string const& orig_file_id,
+        string const& file_split_id,
+        size_t begin_message_ix,
+        size_t end_message_ix,
+        bool is_last_ir_chunk
+) -> bsoncxx::document::value {
+    return bsoncxx::builder::basic::make_document(
+            bsoncxx::builder::basic::kvp(clp::clo::cResultsCacheKeys::IrOutput::Path, ir_file_name),
+            bsoncxx::builder::basic::kvp(clp::clo::cResultsCacheKeys::OrigFileId, orig_file_id),
+            bsoncxx::builder::basic::kvp(
+                    clp::clo::cResultsCacheKeys::IrOutput::FileSplitId,
+                    file_split_id
+            ),
+            bsoncxx::builder::basic::kvp(
+                    clp::clo::cResultsCacheKeys::IrOutput::BeginMsgIx,
+                    static_cast<int64_t>(begin_message_ix)
+            ),
+            bsoncxx::builder::basic::kvp(
+                    clp::clo::cResultsCacheKeys::IrOutput::EndMsgIx,
+                    static_cast<int64_t>(end_message_ix)
+            ),
+            bsoncxx::builder::basic::kvp(
+                    clp::clo::cResultsCacheKeys::IrOutput::IsLastIrChunk,
+                    is_last_ir_chunk
+            )
+    );
+}
+
 bool extract_ir(CommandLineArguments const& command_line_args) {
     std::filesystem::path const archive_path{command_line_args.get_archive_path()};
     if (false == validate_archive_path(archive_path)) {
@@ -166,67 +218,102 @@ bool extract_ir(CommandLineArguments const& command_line_args) {
             return false;
         }
 
+        IrChunkCache ir_chunk_cache{output_dir};
+        auto const& target_message_ix = command_line_args.get_ir_target_msg_ix();
         std::vector<bsoncxx::document::value> results;
-        auto ir_output_handler = [&](std::filesystem::path const& src_ir_path,
+        std::optional<IrChunkCache::Chunk> cached_chunk;
+        if (target_message_ix.has_value()) {
+            auto const split_begin_message_ix = file_metadata_ix_ptr->get_begin_message_ix();
+            auto const split_end_message_ix
+                    = split_begin_message_ix + file_metadata_ix_ptr->get_num_messages();
+            if (target_message_ix.value() < split_begin_message_ix
+                || target_message_ix.value() >= split_end_message_ix)
+            {
+                SPDLOG_ERROR(
+                        "Message {} isn't in file split '{}'",
+                        target_message_ix.value(),
+                        file_split_id
+                );
+                return false;
+            }
+
+            string orig_file_id;
+            file_metadata_ix_ptr->get_orig_file_id(orig_file_id);
+            cached_chunk = ir_chunk_cache.find(orig_file_id, target_message_ix.value());
+            if (cached_chunk.has_value()) {
+                // The chunk may have been extracted by another job, so make sure its metadata is
+                // in this job's results cache collection
+                auto const chunk_metadata = make_ir_chunk_metadata(
+                        cached_chunk->file_name,
+                        orig_file_id,
+                        file_split_id,
+                        cached_chunk->begin_message_ix,
+                        cached_chunk->end_message_ix,
+                        split_end_message_ix == cached_chunk->end_message_ix
+                );
+                try {
+                    collection.replace_one(
+                            bsoncxx::builder::basic::make_document(bsoncxx::builder::basic::kvp(
+                                    clp::clo::cResultsCacheKeys::IrOutput::Path,
+                                    cached_chunk->file_name
+                            )),
+                            chunk_metadata.view(),
+                            mongocxx::options::replace{}.upsert(true)
+                    );
+                } catch (mongocxx::exception const& e) {
+                    SPDLOG_ERROR("Failed to insert results into results cache - {}", e.what());
+                    return false;
+                }
+            }
+        }
+
+        auto ir_output_handler = [&](std::span<char const> ir_chunk,
+                                     std::optional<clp::ir::SeekIndex> const& seek_index,
                                      string const& orig_file_id,
                                      size_t begin_message_ix,
                                      size_t end_message_ix,
                                      bool is_last_ir_chunk) {
-            auto dest_ir_file_name = orig_file_id;
-            dest_ir_file_name += "_" + std::to_string(begin_message_ix);
-            dest_ir_file_name += "_" + std::to_string(end_message_ix);
-            dest_ir_file_name += cIrFileExtension;
-
-            auto const dest_ir_path = output_dir / dest_ir_file_name;
+            string ir_file_name;
             try {
-                std::filesystem::rename(src_ir_path, dest_ir_path);
-            } catch (std::filesystem::filesystem_error const& e) {
+                ir_file_name = ir_chunk_cache.add(
+                        orig_file_id,
+                        begin_message_ix,
+                        end_message_ix,
+                        ir_chunk,
+                        seek_index
+                );
+            } catch (TraceableException const& e) {
                 SPDLOG_ERROR(
-                        "Failed to rename '{}' to '{}' - {}",
-                        src_ir_path.string(),
-                        dest_ir_path.string(),
+                        "Failed to write IR chunk {}-{} of '{}' - {}",
+                        begin_message_ix,
+                        end_message_ix,
+                        orig_file_id,
                         e.what()
                 );
                 return false;
             }
-            results.emplace_back(std::move(bsoncxx::builder::basic::make_document(
-                    bsoncxx::builder::basic::kvp(
-                            clp::clo::cResultsCacheKeys::IrOutput::Path,
-                            dest_ir_file_name
-                    ),
-                    bsoncxx::builder::basic::kvp(
-                            clp::clo::cResultsCacheKeys::OrigFileId,
-                            orig_file_id
-                    ),
-                    bsoncxx::builder::basic::kvp(
-                            clp::clo::cResultsCacheKeys::IrOutput::FileSplitId,
-                            file_split_id
-                    ),
-                    bsoncxx::builder::basic::kvp(
-                            clp::clo::cResultsCacheKeys::IrOutput::BeginMsgIx,
-                            static_cast<int64_t>(begin_message_ix)
-                    ),
-                    bsoncxx::builder::basic::kvp(
-                            clp::clo::cResultsCacheKeys::IrOutput::EndMsgIx,
-                            static_cast<int64_t>(end_message_ix)
-                    ),
-                    bsoncxx::builder::basic::kvp(
-                            clp::clo::cResultsCacheKeys::IrOutput::IsLastIrChunk,
-                            is_last_ir_chunk
-                    )
-            )));
+            results.emplace_back(make_ir_chunk_metadata(
+                    ir_file_name,
+                    orig_file_id,
+                    file_split_id,
+                    begin_message_ix,
+                    end_message_ix,
+                    is_last_ir_chunk
+            ));
             return true;
         };
 
         FileDecompressor file_decompressor;
-        if (false
-            == file_decompressor.decompress_to_ir(
-                    archive_reader,
-                    *file_metadata_ix_ptr,
-                    command_line_args.get_ir_target_size(),
-                    command_line_args.get_ir_temp_output_dir(),
-                    ir_output_handler
-            ))
+        if (false == cached_chunk.has_value()
+            && false
+                       == file_decompressor.decompress_to_ir(
+                               archive_reader,
+                               *file_metadata_ix_ptr,
+                               command_line_args.get_ir_target_size(),
+                               command_line_args.get_ir_seek_index_checkpoint_interval(),
+                               target_message_ix,
+                               ir_output_handler
+                       ))
         {
             return false;
         }
@@ -242,6 +329,25 @@ bool extract_ir(CommandLineArguments const& command_line_args) {
             results.clear();
         }
 
+        if (auto const cache_size = command_line_args.get_ir_cache_size(); 0 != cache_size) {
+            for (auto const& evicted_file_name : ir_chunk_cache.evict(cache_size)) {
+                try {
+                    collection.delete_many(
+                            bsoncxx::builder::basic::make_document(bsoncxx::builder::basic::kvp(
+                                    clp::clo::cResultsCacheKeys::IrOutput::Path,
+                                    evicted_file_name
+                            ))
+                    );
+                } catch (mongocxx::exception const& e) {
+                    SPDLOG_WARN(
+                            "Failed to delete evicted IR chunk '{}' from results cache - {}",
+                            evicted_file_name,
+                            e.what()
+                    );
+                }
+            }
+        }
+
         file_metadata_ix_ptr.reset(nullptr);
 
         archive_reader.close();
@@ -431,6 +537,10 @@ void search_files(
                 continue;
             }
 
+            if (false == archive.file_may_match_query(file_metadata_ix, query)) {
+                continue;
+            }
+
             auto result = search_file(query, archive, file_metadata_ix, output_handler);
             if (SearchFilesResult::OpenFailure == result) {
                 continue;
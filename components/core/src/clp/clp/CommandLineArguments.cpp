@@ -20,6 +20,11 @@ using std::string;
 using std::vector;
 
 namespace clp::clp {
+namespace {
+// Output directory that indicates files should be extracted to stdout
+constexpr char cStdoutOutputDir[] = "-";
+}  // namespace
+
 CommandLineArgumentsBase::ParsingResult
 CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
     // Print out basic usage if user doesn't specify any options
@@ -186,8 +191,18 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
             extraction_positional_options_description.add("output-dir", 1);
             extraction_positional_options_description.add("paths", -1);
 
+            po::options_description options_extraction("Extraction Options");
+            options_extraction.add_options()(
+                    "num-threads",
+                    po::value<size_t>(&m_num_extraction_threads)
+                            ->value_name("NUM")
+                            ->default_value(m_num_extraction_threads),
+                    "Extract each archive's files in parallel using NUM threads"
+            );
+
             po::options_description all_extraction_options;
             all_extraction_options.add(extraction_positional_options);
+            all_extraction_options.add(options_extraction);
 
             // Parse extraction options
             vector<string> unrecognized_options
@@ -215,9 +230,18 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                 cerr << "  " << get_program_name() << " x archives-dir output-dir file1.txt"
                      << endl;
                 cerr << endl;
+                cerr << "  # Extract all files from archives-dir into output-dir using 8 threads"
+                     << endl;
+                cerr << "  " << get_program_name() << " x --num-threads 8 archives-dir output-dir"
+                     << endl;
+                cerr << endl;
+                cerr << "  # Extract file1.txt to stdout" << endl;
+                cerr << "  " << get_program_name() << " x archives-dir - file1.txt" << endl;
+                cerr << endl;
 
                 po::options_description visible_options;
                 visible_options.add(options_general);
+                visible_options.add(options_extraction);
                 cerr << visible_options << endl;
                 return ParsingResult::InfoCommand;
             }
@@ -226,6 +250,15 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
             if (m_archives_dir.empty()) {
                 throw invalid_argument("ARCHIVES_DIR cannot be empty.");
             }
+
+            if (0 == m_num_extraction_threads) {
+                throw invalid_argument("Number of threads must be greater than 0.");
+            }
+
+            m_extract_to_stdout = (cStdoutOutputDir == m_output_dir);
+            if (m_extract_to_stdout && m_num_extraction_threads > 1) {
+                throw invalid_argument("Files can only be extracted to stdout using one thread.");
+            }
         } else if (Command::ExtractIr == m_command) {
             // Define IR extraction hidden positional options
             po::options_description ir_positional_options;
@@ -256,11 +289,12 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                     "Target size (B) for each IR chunk before a new chunk is created"
             );
             options_ir.add_options()(
-                    "temp-output-dir",
-                    po::value<string>(&m_ir_temp_output_dir)
-                            ->value_name("DIR")
-                            ->default_value(m_ir_temp_output_dir),
-                    "Temporary output directory for IR chunks while they're being written"
+                    "seek-index-interval",
+                    po::value<size_t>(&m_ir_seek_index_checkpoint_interval)
+                            ->value_name("NUM_EVENTS")
+                            ->default_value(m_ir_seek_index_checkpoint_interval),
+                    "Write a seek index next to each IR chunk with a checkpoint every NUM_EVENTS"
+                    " log events (0 disables the index)"
             );
 
             po::options_description all_ir_options;
@@ -311,10 +345,6 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
             if (m_orig_file_id.empty()) {
                 throw invalid_argument("ORIG_FILE_ID cannot be empty.");
             }
-
-            if (m_ir_temp_output_dir.empty()) {
-                m_ir_temp_output_dir = m_output_dir;
-            }
         } else if (Command::Compress == m_command) {
             // Define compression hidden positional options
             po::options_description compression_positional_options;
@@ -369,6 +399,12 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                             ->value_name("LEVEL")
                             ->default_value(m_compression_level),
                     "1 (fast/low compression) to 9 (slow/high compression)"
+            )(
+                    "num-threads",
+                    po::value<size_t>(&m_num_compression_threads)
+                            ->value_name("NUM")
+                            ->default_value(m_num_compression_threads),
+                    "Compress files in parallel using NUM threads, each writing its own archives"
             )(
                     "print-archive-stats-progress",
                     po::bool_switch(&m_print_archive_stats_progress),
@@ -384,6 +420,23 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                             ->default_value(m_schema_file_path),
                     "Path to a schema file. If not specified, heuristics are used to determine "
                     "dictionary variables. See README-Schema.md for details."
+            )(
+                    "zstd-dictionary",
+                    po::value<string>(&m_zstd_dictionary_path)
+                            ->value_name("FILE")
+                            ->default_value(m_zstd_dictionary_path),
+                    "Compress each archive's dictionaries and segments using the zstd dictionary "
+                    "in FILE (e.g., one created by `zstd --train`)"
+            )(
+                    "train-zstd-dictionary",
+                    po::bool_switch(&m_train_zstd_dictionary),
+                    "Train a zstd dictionary on samples of the input files and compress each "
+                    "archive's dictionaries and segments using it"
+            )(
+                    "index-segment-logtypes",
+                    po::bool_switch(&m_index_segment_logtypes),
+                    "Write an index of each segment's messages by logtype, letting searches skip "
+                    "files and messages without matching logtypes"
             );
 
             po::options_description all_compression_options;
@@ -452,6 +505,24 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
             }
             m_sort_input_files = "true" == sort_input_files_str;
 
+            if (0 == m_num_compression_threads) {
+                throw invalid_argument("Number of threads must be greater than 0.");
+            }
+
+            if (false == m_zstd_dictionary_path.empty()) {
+                if (m_train_zstd_dictionary) {
+                    throw invalid_argument(
+                            "zstd-dictionary and train-zstd-dictionary cannot both be specified."
+                    );
+                }
+                if (false == boost::filesystem::is_regular_file(m_zstd_dictionary_path)) {
+                    throw invalid_argument(
+                            "Specified zstd dictionary '" + m_zstd_dictionary_path
+                            + "' is not a regular file."
+                    );
+                }
+            }
+
             if (false == m_schema_file_path.empty()) {
                 if (false == boost::filesystem::exists(m_schema_file_path)) {
                     throw invalid_argument("Specified schema file does not exist.");
@@ -476,7 +547,7 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
         return ParsingResult::Failure;
     }
 
-    if (m_output_dir.back() != '/') {
+    if (false == m_extract_to_stdout && m_output_dir.back() != '/') {
         m_output_dir += '/';
     }
 
@@ -494,6 +565,7 @@ void CommandLineArguments::print_compression_basic_usage() const {
 void CommandLineArguments::print_extraction_basic_usage() const {
     cerr << "Usage: " << get_program_name() << " [OPTIONS] x ARCHIVES_DIR OUTPUT_DIR [FILE ...]"
          << endl;
+    cerr << "  Use '" << cStdoutOutputDir << "' as OUTPUT_DIR to write the files to stdout" << endl;
 }
 
 void CommandLineArguments::print_ir_basic_usage() const {
@@ -37,14 +37,18 @@ public:
 
     std::string const& get_path_prefix_to_remove() const { return m_path_prefix_to_remove; }
 
-    std::string const& get_ir_temp_output_dir() const { return m_ir_temp_output_dir; }
-
     std::string const& get_output_dir() const { return m_output_dir; }
 
     std::string const& get_schema_file_path() const { return m_schema_file_path; }
 
     bool get_use_heuristic() const { return (m_schema_file_path.empty()); }
 
+    std::string const& get_zstd_dictionary_path() const { return m_zstd_dictionary_path; }
+
+    bool train_zstd_dictionary() const { return m_train_zstd_dictionary; }
+
+    bool index_segment_logtypes() const { return m_index_segment_logtypes; }
+
     bool show_progress() const { return m_show_progress; }
 
     bool sort_input_files() const { return m_sort_input_files; }
@@ -63,6 +67,12 @@ public:
 
     int get_compression_level() const { return m_compression_level; }
 
+    size_t get_num_compression_threads() const { return m_num_compression_threads; }
+
+    size_t get_num_extraction_threads() const { return m_num_extraction_threads; }
+
+    bool extract_to_stdout() const { return m_extract_to_stdout; }
+
     Command get_command() const { return m_command; }
 
     std::string const& get_archives_dir() const { return m_archives_dir; }
@@ -75,6 +85,10 @@ public:
 
     size_t get_ir_target_size() const { return m_ir_target_size; }
 
+    size_t get_ir_seek_index_checkpoint_interval() const {
+        return m_ir_seek_index_checkpoint_interval;
+    }
+
     GlobalMetadataDBConfig const& get_metadata_db_config() const { return m_metadata_db_config; }
 
 private:
@@ -90,16 +104,22 @@ private:
     std::string m_orig_file_id;
     size_t m_ir_msg_ix{0};
     size_t m_ir_target_size{128ULL * 1024 * 1024};
+    size_t m_ir_seek_index_checkpoint_interval{0};
     bool m_sort_input_files;
-    std::string m_ir_temp_output_dir;
     std::string m_output_dir;
     std::string m_schema_file_path;
+    std::string m_zstd_dictionary_path;
+    bool m_train_zstd_dictionary{false};
+    bool m_index_segment_logtypes{false};
     bool m_show_progress;
     bool m_print_archive_stats_progress;
     size_t m_target_encoded_file_size;
     size_t m_target_segment_uncompressed_size;
     size_t m_target_data_size_of_dictionaries;
     int m_compression_level;
+    size_t m_num_compression_threads{1};
+    size_t m_num_extraction_threads{1};
+    bool m_extract_to_stdout{false};
     Command m_command;
     std::string m_archives_dir;
     std::vector<std::string> m_input_paths;
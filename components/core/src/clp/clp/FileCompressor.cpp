@@ -11,6 +11,7 @@
 #include <log_surgeon/ReaderParser.hpp>
 
 #include "../ffi/ir_stream/decoding_methods.hpp"
+#include "../ir/LogEventPrefetcher.hpp"
 #include "../ir/types.hpp"
 #include "../ir/utils.hpp"
 #include "../LogSurgeonReader.hpp"
@@ -23,6 +24,7 @@ using clp::ir::eight_byte_encoded_variable_t;
 using clp::ir::four_byte_encoded_variable_t;
 using clp::ir::has_ir_stream_magic_number;
 using clp::ir::LogEventDeserializer;
+using clp::ir::LogEventPrefetcher;
 using clp::ParsedMessage;
 using clp::streaming_archive::writer::split_archive;
 using clp::streaming_archive::writer::split_file;
@@ -525,9 +527,16 @@ std::error_code FileCompressor::compress_ir_stream_by_encoding(
     auto timestamp_pattern = log_event_deserializer.get_timestamp_pattern();
     archive.change_ts_pattern(&timestamp_pattern);
 
+    // Deserialize the stream on a separate thread so that reading and decoding the next batch of
+    // log events overlaps with encoding the current batch into the archive
+    LogEventPrefetcher<encoded_variable_t> log_event_prefetcher{
+            log_event_deserializer,
+            cIrLogEventBatchSize,
+            cMaxNumBufferedIrLogEventBatches
+    };
     std::error_code error_code{};
     while (true) {
-        auto result = log_event_deserializer.deserialize_log_event();
+        auto result = log_event_prefetcher.take_batch();
         if (result.has_error()) {
             auto error = result.error();
             if (std::errc::no_message_available != error) {
@@ -536,20 +545,24 @@ std::error_code FileCompressor::compress_ir_stream_by_encoding(
             break;
         }
 
-        // Split archive/encoded file if necessary before writing the new event
-        if (archive.get_data_size_of_dictionaries() >= target_data_size_of_dicts) {
-            split_file_and_archive(
-                    archive_user_config,
-                    path,
-                    group_id,
-                    &timestamp_pattern,
-                    archive
-            );
-        } else if (archive.get_file().get_encoded_size_in_bytes() >= target_encoded_file_size) {
-            split_file(path, group_id, &timestamp_pattern, archive);
-        }
+        for (auto const& log_event : result.value()) {
+            // Split archive/encoded file if necessary before writing the new event
+            if (archive.get_data_size_of_dictionaries() >= target_data_size_of_dicts) {
+                split_file_and_archive(
+                        archive_user_config,
+                        path,
+                        group_id,
+                        &timestamp_pattern,
+                        archive
+                );
+            } else if (archive.get_file().get_encoded_size_in_bytes()
+                       >= target_encoded_file_size)
+            {
+                split_file(path, group_id, &timestamp_pattern, archive);
+            }
 
-        archive.write_log_event_ir(result.value());
+            archive.write_log_event_ir(log_event);
+        }
     }
 
     close_file_and_append_to_segment(archive);
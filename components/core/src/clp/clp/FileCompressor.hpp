@@ -52,6 +52,8 @@ public:
 private:
     // Constants
     static constexpr size_t cUtfMaxValidationLen = 4096;
+    static constexpr size_t cIrLogEventBatchSize = 4096;
+    static constexpr size_t cMaxNumBufferedIrLogEventBatches = 4;
 
     // Methods
     /**
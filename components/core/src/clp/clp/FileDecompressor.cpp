@@ -1,8 +1,12 @@
 #include "FileDecompressor.hpp"
 
+#include <cstdio>
+
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
 
+#include "../ffi/ir_stream/encoding_methods.hpp"
+
 using std::string;
 
 namespace clp::clp {
@@ -10,7 +14,8 @@ bool FileDecompressor::decompress_file(
         streaming_archive::MetadataDB::FileIterator const& file_metadata_ix,
         string const& output_dir,
         streaming_archive::reader::Archive& archive_reader,
-        std::unordered_map<string, string>& temp_path_to_final_path
+        std::unordered_map<string, string>& temp_path_to_final_path,
+        std::mutex& output_paths_mutex
 ) {
     // Open compressed file
     auto error_code = archive_reader.open_file(m_encoded_file, file_metadata_ix);
@@ -26,35 +31,42 @@ bool FileDecompressor::decompress_file(
     boost::filesystem::path final_output_path = output_dir;
     final_output_path /= m_encoded_file.get_orig_path();
 
-    boost::filesystem::path temp_output_path = output_dir;
-    FileWriter::OpenMode open_mode;
-    boost::system::error_code boost_error_code;
-    if (m_encoded_file.is_split() || boost::filesystem::exists(final_output_path, boost_error_code))
     {
-        temp_output_path /= m_encoded_file.get_orig_file_id_as_string();
-        open_mode = FileWriter::OpenMode::CREATE_IF_NONEXISTENT_FOR_APPENDING;
-        auto temp_output_path_string = temp_output_path.string();
-        if (0 == temp_path_to_final_path.count(temp_output_path_string)) {
-            temp_path_to_final_path[temp_output_path_string] = final_output_path.string();
+        // NOTE: The output file is created while holding the lock so that other threads see it
+        // when checking whether their output path already exists
+        std::lock_guard<std::mutex> const output_paths_lock(output_paths_mutex);
+
+        boost::filesystem::path temp_output_path = output_dir;
+        FileWriter::OpenMode open_mode;
+        boost::system::error_code boost_error_code;
+        if (m_encoded_file.is_split()
+            || boost::filesystem::exists(final_output_path, boost_error_code))
+        {
+            temp_output_path /= m_encoded_file.get_orig_file_id_as_string();
+            open_mode = FileWriter::OpenMode::CREATE_IF_NONEXISTENT_FOR_APPENDING;
+            auto temp_output_path_string = temp_output_path.string();
+            if (0 == temp_path_to_final_path.count(temp_output_path_string)) {
+                temp_path_to_final_path[temp_output_path_string] = final_output_path.string();
+            }
+        } else {
+            temp_output_path = final_output_path;
+            open_mode = FileWriter::OpenMode::CREATE_FOR_WRITING;
         }
-    } else {
-        temp_output_path = final_output_path;
-        open_mode = FileWriter::OpenMode::CREATE_FOR_WRITING;
-    }
 
-    // Generate output directory
-    error_code = create_directory_structure(final_output_path.parent_path().string(), 0700);
-    if (ErrorCode_Success != error_code) {
-        SPDLOG_ERROR(
-                "Failed to create directory structure {}, errno={}",
-                final_output_path.parent_path().c_str(),
-                errno
-        );
-        return false;
-    }
+        // Generate output directory
+        error_code = create_directory_structure(final_output_path.parent_path().string(), 0700);
+        if (ErrorCode_Success != error_code) {
+            SPDLOG_ERROR(
+                    "Failed to create directory structure {}, errno={}",
+                    final_output_path.parent_path().c_str(),
+                    errno
+            );
+            return false;
+        }
 
-    // Open output file
-    m_decompressed_file_writer.open(temp_output_path.string(), open_mode);
+        // Open output file
+        m_decompressed_file_writer.open(temp_output_path.string(), open_mode);
+    }
 
     // Decompress
     archive_reader.reset_file_indices(m_encoded_file);
@@ -74,4 +86,103 @@ bool FileDecompressor::decompress_file(
 
     return true;
 }
+
+bool FileDecompressor::decompress_file_to_stdout(
+        streaming_archive::MetadataDB::FileIterator const& file_metadata_ix,
+        streaming_archive::reader::Archive& archive_reader
+) {
+    // Open compressed file
+    auto error_code = archive_reader.open_file(m_encoded_file, file_metadata_ix);
+    if (ErrorCode_Success != error_code) {
+        if (ErrorCode_errno == error_code) {
+            SPDLOG_ERROR("Failed to open encoded file, errno={}", errno);
+        } else {
+            SPDLOG_ERROR("Failed to open encoded file, error_code={}", error_code);
+        }
+        return false;
+    }
+
+    // Decompress
+    bool success = true;
+    archive_reader.reset_file_indices(m_encoded_file);
+    while (archive_reader.get_next_message(m_encoded_file, m_encoded_message)) {
+        if (!archive_reader
+                     .decompress_message(m_encoded_file, m_encoded_message, m_decompressed_message))
+        {
+            // Can't decompress any more of file
+            break;
+        }
+        auto const num_bytes_written = std::fwrite(
+                m_decompressed_message.data(),
+                sizeof(char),
+                m_decompressed_message.length(),
+                stdout
+        );
+        if (num_bytes_written != m_decompressed_message.length()) {
+            SPDLOG_ERROR("Failed to write to stdout, errno={}", errno);
+            success = false;
+            break;
+        }
+    }
+
+    archive_reader.close_file(m_encoded_file);
+
+    return success;
+}
+
+bool FileDecompressor::read_ir_chunk_containing_target(
+        streaming_archive::reader::Archive& archive_reader,
+        size_t ir_target_size,
+        size_t target_message_ix,
+        size_t& begin_message_ix
+) {
+    // Mirror the sizes that ir::LogEventSerializer counts, without compressing the serialized IR
+    std::vector<int8_t> ir_buf;
+    string logtype;
+    size_t serialized_size{0};
+    ir::epoch_time_ms_t prev_timestamp{0};
+    while (begin_message_ix + m_ir_chunk_log_events.size() <= target_message_ix
+           && archive_reader.get_next_message(m_encoded_file, m_encoded_message))
+    {
+        if (false
+            == archive_reader
+                       .decompress_message_without_ts(m_encoded_message, m_decompressed_message))
+        {
+            SPDLOG_ERROR("Failed to decompress message");
+            return false;
+        }
+
+        if (serialized_size >= ir_target_size) {
+            begin_message_ix += m_ir_chunk_log_events.size();
+            m_ir_chunk_messages.clear();
+            m_ir_chunk_log_events.clear();
+            serialized_size = 0;
+            prev_timestamp = 0;
+        }
+
+        auto const timestamp = m_encoded_message.get_ts_in_milli();
+        ir_buf.clear();
+        if (false
+            == ffi::ir_stream::four_byte_encoding::serialize_log_event(
+                    timestamp - prev_timestamp,
+                    m_decompressed_message,
+                    logtype,
+                    ir_buf
+            ))
+        {
+            SPDLOG_ERROR(
+                    "Failed to serialize log event: {} with ts {}",
+                    m_decompressed_message.c_str(),
+                    timestamp
+            );
+            return false;
+        }
+        prev_timestamp = timestamp;
+        serialized_size += ir_buf.size();
+
+        m_ir_chunk_messages += m_decompressed_message;
+        m_ir_chunk_log_events.emplace_back(timestamp, m_ir_chunk_messages.size());
+    }
+    return true;
+}
 }  // namespace clp::clp
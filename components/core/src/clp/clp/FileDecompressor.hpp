@@ -4,11 +4,20 @@
 #include <cerrno>
 #include <cstddef>
 #include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "../BufferWriter.hpp"
 #include "../FileWriter.hpp"
 #include "../ir/constants.hpp"
 #include "../ir/LogEventSerializer.hpp"
+#include "../ir/SeekIndex.hpp"
 #include "../spdlog_with_specializations.hpp"
 #include "../streaming_archive/MetadataDB.hpp"
 #include "../streaming_archive/reader/Archive.hpp"
@@ -26,25 +35,56 @@ namespace clp::clp {
 class FileDecompressor {
 public:
     // Methods
+    /**
+     * Decompresses the given file into the given directory. Splits of a file, and files whose
+     * output path already exists, are appended to a temporary file named after the original file's
+     * ID; the caller should rename these to their final paths once all files are decompressed.
+     * @param file_metadata_ix
+     * @param output_dir
+     * @param archive_reader
+     * @param temp_path_to_final_path Map from temporary output paths to their final paths
+     * @param output_paths_mutex Mutex to hold while choosing and creating the output file, so that
+     * files with the same path can be decompressed concurrently without clobbering each other
+     * @return Whether decompression was successful
+     */
     bool decompress_file(
             streaming_archive::MetadataDB::FileIterator const& file_metadata_ix,
             std::string const& output_dir,
             streaming_archive::reader::Archive& archive_reader,
-            std::unordered_map<std::string, std::string>& temp_path_to_final_path
+            std::unordered_map<std::string, std::string>& temp_path_to_final_path,
+            std::mutex& output_paths_mutex
+    );
+
+    /**
+     * Decompresses the given file to stdout
+     * @param file_metadata_ix
+     * @param archive_reader
+     * @return Whether decompression was successful
+     */
+    bool decompress_file_to_stdout(
+            streaming_archive::MetadataDB::FileIterator const& file_metadata_ix,
+            streaming_archive::reader::Archive& archive_reader
     );
 
     /**
-     * Decompresses the given file split into one or more IR files (chunks). The function creates a
+     * Decompresses the given file split into one or more IR chunks in memory. The function starts a
      * new IR chunk when the current IR chunk exceeds ir_target_size.
      *
      * @tparam IrOutputHandler Function to handle the resulting IR chunks.
-     * Signature: (std::filesystem::path const& ir_file_path, string const& orig_file_id,
-     * size_t begin_message_ix, size_t end_message_ix, bool is_last_ir_chunk) -> bool;
-     * The function returns whether it succeeded.
+     * Signature: (std::span<char const> ir_chunk, std::optional<ir::SeekIndex> const& seek_index,
+     * string const& orig_file_id, size_t begin_message_ix, size_t end_message_ix,
+     * bool is_last_ir_chunk) -> bool;
+     * The function returns whether it succeeded. `ir_chunk` and `seek_index` are only valid until
+     * the function returns.
      * @param archive_reader
      * @param file_metadata_ix
      * @param ir_target_size Target size of each IR chunk. NOTE: This is not a hard limit.
-     * @param output_dir Directory to write IR chunks to
+     * @param seek_index_checkpoint_interval Number of log events between the checkpoints of each IR
+     * chunk's seek index, or 0 to not build seek indexes
+     * @param target_message_ix If set, only the IR chunk containing the message with this index is
+     * passed to ir_output_handler, and decompression stops after that chunk. The chunk's boundaries
+     * are the same as if every chunk were decompressed, but the chunks before it are only sized
+     * rather than being serialized and compressed.
      * @param ir_output_handler
      * @return Whether decompression was successful.
      */
@@ -53,16 +93,41 @@ public:
             streaming_archive::reader::Archive& archive_reader,
             streaming_archive::MetadataDB::FileIterator const& file_metadata_ix,
             size_t ir_target_size,
-            std::string const& output_dir,
+            size_t seek_index_checkpoint_interval,
+            std::optional<size_t> target_message_ix,
             IrOutputHandler ir_output_handler
     ) -> bool;
 
 private:
+    // Methods
+    /**
+     * Reads the open file's messages up to and including the target message, keeping only the
+     * messages of the IR chunk containing the target in m_ir_chunk_messages and
+     * m_ir_chunk_log_events. Since a chunk's boundaries only depend on the uncompressed size of its
+     * serialized log events, the preceding chunks are only sized rather than being compressed.
+     * @param archive_reader
+     * @param ir_target_size
+     * @param target_message_ix
+     * @param begin_message_ix The index of the first message to read. Returns the index of the
+     * first message of the IR chunk containing the target.
+     * @return Whether the messages were read successfully
+     */
+    bool read_ir_chunk_containing_target(
+            streaming_archive::reader::Archive& archive_reader,
+            size_t ir_target_size,
+            size_t target_message_ix,
+            size_t& begin_message_ix
+    );
+
     // Variables
     FileWriter m_decompressed_file_writer;
     streaming_archive::reader::File m_encoded_file;
     streaming_archive::reader::Message m_encoded_message;
     std::string m_decompressed_message;
+    BufferWriter m_ir_chunk_writer;
+    // The concatenated messages of an IR chunk, and each message's timestamp and end offset
+    std::string m_ir_chunk_messages;
+    std::vector<std::pair<ir::epoch_time_ms_t, size_t>> m_ir_chunk_log_events;
 };
 
 // Templated methods
@@ -71,7 +136,8 @@ auto FileDecompressor::decompress_to_ir(
         streaming_archive::reader::Archive& archive_reader,
         streaming_archive::MetadataDB::FileIterator const& file_metadata_ix,
         size_t ir_target_size,
-        std::string const& output_dir,
+        size_t seek_index_checkpoint_interval,
+        std::optional<size_t> target_message_ix,
         IrOutputHandler ir_output_handler
 ) -> bool {
     // Open encoded file
@@ -86,33 +152,49 @@ auto FileDecompressor::decompress_to_ir(
         return false;
     }
 
-    // Generate output directory
-    if (auto const error_code = create_directory_structure(output_dir, 0700);
-        ErrorCode_Success != error_code)
+    auto const& file_orig_id = m_encoded_file.get_orig_file_id_as_string();
+    auto begin_message_ix = m_encoded_file.get_begin_message_ix();
+    auto const chunk_contains_target = [&](size_t end_message_ix) {
+        return false == target_message_ix.has_value()
+               || (begin_message_ix <= target_message_ix.value()
+                   && target_message_ix.value() < end_message_ix);
+    };
+
+    m_ir_chunk_messages.clear();
+    m_ir_chunk_log_events.clear();
+    if (target_message_ix.has_value()
+        && false
+                   == read_ir_chunk_containing_target(
+                           archive_reader,
+                           ir_target_size,
+                           target_message_ix.value(),
+                           begin_message_ix
+                   ))
     {
-        SPDLOG_ERROR(
-                "Failed to create directory structure {}, errno={}",
-                output_dir.c_str(),
-                errno
-        );
         return false;
     }
 
-    std::filesystem::path ir_output_path{output_dir};
-    auto ir_file_name = m_encoded_file.get_id_as_string();
-    ir_file_name += ir::cIrFileExtension;
-    ir_output_path /= ir_file_name;
-
-    auto const& file_orig_id = m_encoded_file.get_orig_file_id_as_string();
-    auto begin_message_ix = m_encoded_file.get_begin_message_ix();
-
     ir::LogEventSerializer<ir::four_byte_encoded_variable_t> ir_serializer;
-    // Open output IR file
-    if (false == ir_serializer.open(ir_output_path.string())) {
+    m_ir_chunk_writer.clear();
+    if (false == ir_serializer.open(m_ir_chunk_writer, seek_index_checkpoint_interval)) {
         SPDLOG_ERROR("Failed to serialize preamble");
         return false;
     }
 
+    // Serialize the messages of the target's chunk that were read while searching for it
+    size_t message_begin_pos{0};
+    for (auto const& [timestamp, message_end_pos] : m_ir_chunk_log_events) {
+        std::string_view const message{
+                m_ir_chunk_messages.data() + message_begin_pos,
+                message_end_pos - message_begin_pos
+        };
+        if (false == ir_serializer.serialize_log_event(timestamp, message)) {
+            SPDLOG_ERROR("Failed to serialize log event: {} with ts {}", message, timestamp);
+            return false;
+        }
+        message_begin_pos = message_end_pos;
+    }
+
     while (archive_reader.get_next_message(m_encoded_file, m_encoded_message)) {
         if (false
             == archive_reader
@@ -126,20 +208,28 @@ auto FileDecompressor::decompress_to_ir(
             ir_serializer.close();
 
             auto const end_message_ix = begin_message_ix + ir_serializer.get_num_log_events();
-            if (false
-                == ir_output_handler(
-                        ir_output_path,
-                        file_orig_id,
-                        begin_message_ix,
-                        end_message_ix,
-                        false
-                ))
-            {
-                return false;
+            if (chunk_contains_target(end_message_ix)) {
+                if (false
+                    == ir_output_handler(
+                            m_ir_chunk_writer.get_buffer(),
+                            ir_serializer.get_seek_index(),
+                            file_orig_id,
+                            begin_message_ix,
+                            end_message_ix,
+                            false
+                    ))
+                {
+                    return false;
+                }
+                if (target_message_ix.has_value()) {
+                    archive_reader.close_file(m_encoded_file);
+                    return true;
+                }
             }
             begin_message_ix = end_message_ix;
 
-            if (false == ir_serializer.open(ir_output_path.string())) {
+            m_ir_chunk_writer.clear();
+            if (false == ir_serializer.open(m_ir_chunk_writer, seek_index_checkpoint_interval)) {
                 SPDLOG_ERROR("Failed to serialize preamble");
                 return false;
             }
@@ -162,8 +252,23 @@ auto FileDecompressor::decompress_to_ir(
     auto const end_message_ix = begin_message_ix + ir_serializer.get_num_log_events();
     ir_serializer.close();
 
+    if (false == chunk_contains_target(end_message_ix)) {
+        SPDLOG_ERROR(
+                "Message {} isn't in file split {}",
+                target_message_ix.value(),
+                m_encoded_file.get_id_as_string()
+        );
+        return false;
+    }
     if (false
-        == ir_output_handler(ir_output_path, file_orig_id, begin_message_ix, end_message_ix, true))
+        == ir_output_handler(
+                m_ir_chunk_writer.get_buffer(),
+                ir_serializer.get_seek_index(),
+                file_orig_id,
+                begin_message_ix,
+                end_message_ix,
+                true
+        ))
     {
         return false;
     }
@@ -1,21 +1,32 @@
 #include "compression.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <future>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <string_view>
 
 #include <archive_entry.h>
 #include <boost/filesystem/operations.hpp>
 #include <boost/uuid/random_generator.hpp>
 
+#include "../FileReader.hpp"
 #include "../GlobalMySQLMetadataDB.hpp"
 #include "../GlobalSQLiteMetadataDB.hpp"
 #include "../spdlog_with_specializations.hpp"
 #include "../streaming_archive/writer/Archive.hpp"
 #include "../streaming_archive/writer/utils.hpp"
+#include "../streaming_compression/zstd/Dictionary.hpp"
+#include "../utf8_utils.hpp"
 #include "../Utils.hpp"
 #include "FileCompressor.hpp"
 #include "utils.hpp"
 
+using clp::streaming_archive::writer::Archive;
 using clp::streaming_archive::writer::split_archive;
 using std::cerr;
 using std::cout;
@@ -27,6 +38,109 @@ using std::unique_ptr;
 using std::vector;
 
 namespace clp::clp {
+namespace {
+/**
+ * Wrapper that lets archive writers in multiple threads share a global metadata database. Each
+ * access is made while holding a lock, and the database is kept open while any writer has it open,
+ * so a writer that fails between open() and close() can't block the others.
+ */
+class SynchronizedGlobalMetadataDB : public GlobalMetadataDB {
+public:
+    // Constructors
+    explicit SynchronizedGlobalMetadataDB(GlobalMetadataDB& global_metadata_db)
+            : m_global_metadata_db(global_metadata_db) {}
+
+    // Methods implementing GlobalMetadataDB
+    void open() override {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        if (0 == m_num_openers) {
+            m_global_metadata_db.open();
+        }
+        ++m_num_openers;
+    }
+
+    void close() override {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        if (0 == m_num_openers) {
+            return;
+        }
+        --m_num_openers;
+        if (0 == m_num_openers) {
+            m_global_metadata_db.close();
+        }
+    }
+
+    void add_archive(std::string const& id, streaming_archive::ArchiveMetadata const& metadata)
+            override {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        m_global_metadata_db.add_archive(id, metadata);
+    }
+
+    void update_archive_metadata(
+            std::string const& archive_id,
+            streaming_archive::ArchiveMetadata const& metadata
+    ) override {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        m_global_metadata_db.update_archive_metadata(archive_id, metadata);
+    }
+
+    void update_metadata_for_files(
+            std::string const& archive_id,
+            std::vector<streaming_archive::writer::File*> const& files
+    ) override {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        m_global_metadata_db.update_metadata_for_files(archive_id, files);
+    }
+
+    ArchiveIterator* get_archive_iterator() override {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        return m_global_metadata_db.get_archive_iterator();
+    }
+
+    ArchiveIterator*
+    get_archive_iterator_for_time_window(epochtime_t begin_ts, epochtime_t end_ts) override {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        return m_global_metadata_db.get_archive_iterator_for_time_window(begin_ts, end_ts);
+    }
+
+    ArchiveIterator* get_archive_iterator_for_file_path(std::string const& path) override {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        return m_global_metadata_db.get_archive_iterator_for_file_path(path);
+    }
+
+    bool get_file_split(
+            std::string const& orig_file_id,
+            size_t message_ix,
+            std::string& archive_id,
+            std::string& file_split_id
+    ) override {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        return m_global_metadata_db.get_file_split(
+                orig_file_id,
+                message_ix,
+                archive_id,
+                file_split_id
+        );
+    }
+
+private:
+    GlobalMetadataDB& m_global_metadata_db;
+    std::mutex m_mutex;
+    // Number of writers that have opened the database without closing it
+    size_t m_num_openers{0};
+};
+
+/**
+ * Progress of a compression job, shared by all compression threads
+ */
+struct CompressionProgress {
+    bool show_progress{false};
+    size_t num_files_to_compress{0};
+    std::atomic_size_t num_files_compressed{0};
+    std::mutex output_mutex;
+};
+}  // namespace
+
 // Local prototypes
 /**
  * Comparator to sort files based on their group ID
@@ -43,6 +157,45 @@ static bool file_group_id_comparator(FileToCompress const& lhs, FileToCompress c
  */
 static bool
 file_gt_last_write_time_comparator(FileToCompress const& lhs, FileToCompress const& rhs);
+/**
+ * Reports that a file was compressed, printing the overall progress if enabled
+ * @param progress
+ */
+static void report_file_compressed(CompressionProgress& progress);
+/**
+ * Trains a zstd dictionary on lines sampled from the beginning of the given files. Files that
+ * don't start with UTF-8 text (e.g., compressed files) aren't sampled.
+ * @param files
+ * @param compression_level
+ * @return The dictionary, or nullptr if it couldn't be trained (e.g., there weren't enough samples)
+ */
+static std::shared_ptr<streaming_compression::zstd::Dictionary const>
+train_zstd_dictionary(vector<FileToCompress> const& files, int compression_level);
+/**
+ * Compresses the given files into one or more archives, starting a new archive whenever the
+ * dictionaries of the current one reach their target size
+ * @param command_line_args
+ * @param archive_user_config
+ * @param files_to_compress
+ * @param empty_directory_paths
+ * @param grouped_files_to_compress Grouped files, sorted by group ID
+ * @param target_encoded_file_size
+ * @param reader_parser
+ * @param use_heuristic
+ * @param progress
+ * @return true if all files were compressed successfully, false otherwise
+ */
+static bool compress_files(
+        CommandLineArguments const& command_line_args,
+        Archive::UserConfig archive_user_config,
+        vector<FileToCompress> const& files_to_compress,
+        vector<string> const& empty_directory_paths,
+        vector<FileToCompress> const& grouped_files_to_compress,
+        size_t target_encoded_file_size,
+        std::unique_ptr<log_surgeon::ReaderParser> reader_parser,
+        bool use_heuristic,
+        CompressionProgress& progress
+);
 
 static bool file_group_id_comparator(FileToCompress const& lhs, FileToCompress const& rhs) {
     return lhs.get_group_id() < rhs.get_group_id();
@@ -54,6 +207,178 @@ file_gt_last_write_time_comparator(FileToCompress const& lhs, FileToCompress con
            > boost::filesystem::last_write_time(rhs.get_path());
 }
 
+vector<vector<FileToCompress>>
+partition_files_by_size(vector<FileToCompress> const& files, size_t num_partitions) {
+    vector<size_t> file_sizes(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        boost::system::error_code error_code;
+        auto const file_size = boost::filesystem::file_size(files[i].get_path(), error_code);
+        file_sizes[i] = error_code ? 0 : file_size;
+    }
+
+    vector<size_t> file_ixs_by_size(files.size());
+    std::iota(file_ixs_by_size.begin(), file_ixs_by_size.end(), 0);
+    std::stable_sort(
+            file_ixs_by_size.begin(),
+            file_ixs_by_size.end(),
+            [&file_sizes](size_t lhs, size_t rhs) { return file_sizes[lhs] > file_sizes[rhs]; }
+    );
+
+    // Min-heap of (number of bytes assigned, partition index)
+    using partition_size_t = std::pair<size_t, size_t>;
+    std::priority_queue<
+            partition_size_t,
+            vector<partition_size_t>,
+            std::greater<partition_size_t>>
+            partition_sizes;
+    for (size_t i = 0; i < num_partitions; ++i) {
+        partition_sizes.emplace(0, i);
+    }
+    vector<vector<size_t>> partition_file_ixs(num_partitions);
+    for (auto const file_ix : file_ixs_by_size) {
+        auto [num_bytes, partition_ix] = partition_sizes.top();
+        partition_sizes.pop();
+        partition_file_ixs[partition_ix].push_back(file_ix);
+        partition_sizes.emplace(num_bytes + file_sizes[file_ix], partition_ix);
+    }
+
+    vector<vector<FileToCompress>> partitions(num_partitions);
+    for (size_t i = 0; i < num_partitions; ++i) {
+        auto& file_ixs = partition_file_ixs[i];
+        std::sort(file_ixs.begin(), file_ixs.end());
+        partitions[i].reserve(file_ixs.size());
+        for (auto const file_ix : file_ixs) {
+            partitions[i].push_back(files[file_ix]);
+        }
+    }
+    return partitions;
+}
+
+static void report_file_compressed(CompressionProgress& progress) {
+    auto const num_files_compressed = ++progress.num_files_compressed;
+    if (false == progress.show_progress) {
+        return;
+    }
+    std::lock_guard<std::mutex> const lock(progress.output_mutex);
+    cerr << "Compressed " << num_files_compressed << '/' << progress.num_files_to_compress
+         << " files" << '\r';
+}
+
+static std::shared_ptr<streaming_compression::zstd::Dictionary const>
+train_zstd_dictionary(vector<FileToCompress> const& files, int compression_level) {
+    // zstd recommends training on about 100 times as much data as the dictionary's size
+    constexpr size_t cMaxDictionarySize = 112 * 1024;
+    constexpr size_t cMaxTotalSamplesSize = 100 * cMaxDictionarySize;
+    constexpr size_t cMaxSamplesSizePerFile = 1024 * 1024;
+
+    vector<string> samples;
+    size_t total_samples_size{0};
+    auto buffer = std::make_unique<char[]>(cMaxSamplesSizePerFile);
+    for (auto const& file : files) {
+        if (total_samples_size >= cMaxTotalSamplesSize) {
+            break;
+        }
+
+        size_t num_bytes_read{0};
+        try {
+            FileReader file_reader{file.get_path()};
+            auto const error_code = file_reader.try_read(
+                    buffer.get(),
+                    std::min(cMaxSamplesSizePerFile, cMaxTotalSamplesSize - total_samples_size),
+                    num_bytes_read
+            );
+            if (ErrorCode_Success != error_code && ErrorCode_EndOfFile != error_code) {
+                continue;
+            }
+        } catch (FileReader::OperationFailed const&) {
+            // Files that can't be read are reported when they're compressed
+            continue;
+        }
+
+        // Only sample complete lines
+        std::string_view const content{buffer.get(), num_bytes_read};
+        auto const content_end_pos = content.rfind('\n');
+        if (std::string_view::npos == content_end_pos
+            || false == is_utf8_encoded(content.substr(0, content_end_pos + 1)))
+        {
+            continue;
+        }
+        size_t line_begin_pos{0};
+        while (line_begin_pos <= content_end_pos) {
+            auto const line_end_pos = content.find('\n', line_begin_pos) + 1;
+            samples.emplace_back(content.substr(line_begin_pos, line_end_pos - line_begin_pos));
+            line_begin_pos = line_end_pos;
+        }
+        total_samples_size += content_end_pos + 1;
+    }
+
+    try {
+        return std::make_shared<streaming_compression::zstd::Dictionary const>(
+                streaming_compression::zstd::Dictionary::train(samples, cMaxDictionarySize),
+                compression_level
+        );
+    } catch (streaming_compression::zstd::Dictionary::OperationFailed const&) {
+        return nullptr;
+    }
+}
+
+static bool compress_files(
+        CommandLineArguments const& command_line_args,
+        Archive::UserConfig archive_user_config,
+        vector<FileToCompress> const& files_to_compress,
+        vector<string> const& empty_directory_paths,
+        vector<FileToCompress> const& grouped_files_to_compress,
+        size_t target_encoded_file_size,
+        std::unique_ptr<log_surgeon::ReaderParser> reader_parser,
+        bool use_heuristic,
+        CompressionProgress& progress
+) {
+    auto uuid_generator = boost::uuids::random_generator();
+
+    // Open Archive
+    Archive archive_writer;
+    // Set schema file if specified by user
+    if (false == command_line_args.get_use_heuristic()) {
+        archive_writer.m_schema_file_path = command_line_args.get_schema_file_path();
+    }
+    // Open archive
+    archive_writer.open(archive_user_config);
+
+    archive_writer.add_empty_directories(empty_directory_paths);
+
+    bool all_files_compressed_successfully = true;
+    FileCompressor file_compressor(uuid_generator, std::move(reader_parser));
+    auto target_data_size_of_dictionaries
+            = command_line_args.get_target_data_size_of_dictionaries();
+
+    // Compress all files, followed by all grouped files
+    for (auto const* files : {&files_to_compress, &grouped_files_to_compress}) {
+        for (auto const& file_to_compress : *files) {
+            if (archive_writer.get_data_size_of_dictionaries() >= target_data_size_of_dictionaries)
+            {
+                split_archive(archive_user_config, archive_writer);
+            }
+            if (false
+                == file_compressor.compress_file(
+                        target_data_size_of_dictionaries,
+                        archive_user_config,
+                        target_encoded_file_size,
+                        file_to_compress,
+                        archive_writer,
+                        use_heuristic
+                ))
+            {
+                all_files_compressed_successfully = false;
+            }
+            report_file_compressed(progress);
+        }
+    }
+
+    archive_writer.close();
+
+    return all_files_compressed_successfully;
+}
+
 bool compress(
         CommandLineArguments& command_line_args,
         vector<FileToCompress>& files_to_compress,
@@ -96,7 +421,7 @@ bool compress(
     auto uuid_generator = boost::uuids::random_generator();
 
     // Setup config
-    streaming_archive::writer::Archive::UserConfig archive_user_config;
+    Archive::UserConfig archive_user_config;
     archive_user_config.id = uuid_generator();
     archive_user_config.creator_id = uuid_generator();
     archive_user_config.creation_num = 0;
@@ -107,86 +432,103 @@ bool compress(
     archive_user_config.global_metadata_db = global_metadata_db.get();
     archive_user_config.print_archive_stats_progress
             = command_line_args.print_archive_stats_progress();
-
-    // Open Archive
-    streaming_archive::writer::Archive archive_writer;
-    // Set schema file if specified by user
-    if (false == command_line_args.get_use_heuristic()) {
-        archive_writer.m_schema_file_path = command_line_args.get_schema_file_path();
+    archive_user_config.index_segment_logtypes = command_line_args.index_segment_logtypes();
+    if (false == command_line_args.get_zstd_dictionary_path().empty()) {
+        archive_user_config.zstd_dictionary
+                = std::make_shared<streaming_compression::zstd::Dictionary const>(
+                        streaming_compression::zstd::Dictionary::read_content_from_file(
+                                command_line_args.get_zstd_dictionary_path()
+                        ),
+                        command_line_args.get_compression_level()
+                );
+    } else if (command_line_args.train_zstd_dictionary()) {
+        auto all_files = files_to_compress;
+        all_files.insert(
+                all_files.end(),
+                grouped_files_to_compress.cbegin(),
+                grouped_files_to_compress.cend()
+        );
+        archive_user_config.zstd_dictionary
+                = train_zstd_dictionary(all_files, command_line_args.get_compression_level());
+        if (nullptr == archive_user_config.zstd_dictionary) {
+            SPDLOG_WARN("Failed to train a zstd dictionary, so compressing without one.");
+        }
     }
-    // Open archive
-    archive_writer.open(archive_user_config);
-
-    archive_writer.add_empty_directories(empty_directory_paths);
 
-    bool all_files_compressed_successfully = true;
-    FileCompressor file_compressor(uuid_generator, std::move(reader_parser));
-    auto target_data_size_of_dictionaries
-            = command_line_args.get_target_data_size_of_dictionaries();
+    CompressionProgress progress;
+    progress.show_progress = command_line_args.show_progress();
+    progress.num_files_to_compress = files_to_compress.size() + grouped_files_to_compress.size();
 
-    // Compress all files
-    size_t num_files_compressed = 0;
-    size_t num_files_to_compress = 0;
-    if (command_line_args.show_progress()) {
-        num_files_to_compress = files_to_compress.size() + grouped_files_to_compress.size();
-    }
     if (command_line_args.sort_input_files()) {
         sort(files_to_compress.begin(), files_to_compress.end(), file_gt_last_write_time_comparator
         );
     }
-    for (auto it = files_to_compress.cbegin(); it != files_to_compress.cend(); ++it) {
-        if (archive_writer.get_data_size_of_dictionaries() >= target_data_size_of_dictionaries) {
-            split_archive(archive_user_config, archive_writer);
-        }
-        if (false
-            == file_compressor.compress_file(
-                    target_data_size_of_dictionaries,
-                    archive_user_config,
-                    target_encoded_file_size,
-                    *it,
-                    archive_writer,
-                    use_heuristic
-            ))
-        {
-            all_files_compressed_successfully = false;
-        }
-        if (command_line_args.show_progress()) {
-            ++num_files_compressed;
-            cerr << "Compressed " << num_files_compressed << '/' << num_files_to_compress
-                 << " files" << '\r';
-        }
-    }
-
     // Sort files by group ID to avoid spreading groups over multiple segments
     sort(grouped_files_to_compress.begin(),
          grouped_files_to_compress.end(),
          file_group_id_comparator);
-    // Compress grouped files
-    for (auto const& file_to_compress : grouped_files_to_compress) {
-        if (archive_writer.get_data_size_of_dictionaries() >= target_data_size_of_dictionaries) {
-            split_archive(archive_user_config, archive_writer);
+
+    auto const num_threads = command_line_args.get_num_compression_threads();
+    if (num_threads <= 1 || files_to_compress.size() <= 1) {
+        return compress_files(
+                command_line_args,
+                archive_user_config,
+                files_to_compress,
+                empty_directory_paths,
+                grouped_files_to_compress,
+                target_encoded_file_size,
+                std::move(reader_parser),
+                use_heuristic,
+                progress
+        );
+    }
+
+    // Each thread compresses its share of the files into its own archives. Grouped files and empty
+    // directories are all added by the first thread so that groups aren't split across archives.
+    SynchronizedGlobalMetadataDB synchronized_global_metadata_db(*global_metadata_db);
+    archive_user_config.global_metadata_db = &synchronized_global_metadata_db;
+    auto const file_partitions = partition_files_by_size(
+            files_to_compress,
+            std::min(num_threads, files_to_compress.size())
+    );
+    vector<string> const no_paths;
+    vector<FileToCompress> const no_files;
+    vector<std::future<bool>> compression_results;
+    compression_results.reserve(file_partitions.size());
+    for (size_t i = 0; i < file_partitions.size(); ++i) {
+        bool const is_first_thread = (0 == i);
+        if (false == is_first_thread) {
+            archive_user_config.id = uuid_generator();
+            archive_user_config.creator_id = uuid_generator();
+            // Each thread needs its own parser since parsing is stateful
+            if (false == use_heuristic) {
+                reader_parser = std::make_unique<log_surgeon::ReaderParser>(
+                        command_line_args.get_schema_file_path()
+                );
+            }
         }
-        if (false
-            == file_compressor.compress_file(
-                    target_data_size_of_dictionaries,
-                    archive_user_config,
-                    target_encoded_file_size,
-                    file_to_compress,
-                    archive_writer,
-                    use_heuristic
-            ))
-        {
+        compression_results.emplace_back(std::async(
+                std::launch::async,
+                compress_files,
+                std::cref(command_line_args),
+                archive_user_config,
+                std::cref(file_partitions[i]),
+                std::cref(is_first_thread ? empty_directory_paths : no_paths),
+                std::cref(is_first_thread ? grouped_files_to_compress : no_files),
+                target_encoded_file_size,
+                std::move(reader_parser),
+                use_heuristic,
+                std::ref(progress)
+        ));
+    }
+
+    bool all_files_compressed_successfully = true;
+    for (auto& compression_result : compression_results) {
+        // NOTE: This rethrows any exception thrown while compressing
+        if (false == compression_result.get()) {
             all_files_compressed_successfully = false;
         }
-        if (command_line_args.show_progress()) {
-            ++num_files_compressed;
-            cerr << "Compressed " << num_files_compressed << '/' << num_files_to_compress
-                 << " files" << '\r';
-        }
     }
-
-    archive_writer.close();
-
     return all_files_compressed_successfully;
 }
 
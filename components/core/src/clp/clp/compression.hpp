@@ -45,6 +45,17 @@ bool read_and_validate_grouped_file_list(
         std::string const& list_path,
         std::vector<FileToCompress>& grouped_files
 );
+
+/**
+ * Partitions files among workers so that each worker compresses a similar number of bytes. Files
+ * are assigned largest first to the worker with the fewest bytes so far, and each partition
+ * preserves the files' relative order. Files whose size can't be read are treated as empty.
+ * @param files
+ * @param num_partitions
+ * @return The partitions
+ */
+std::vector<std::vector<FileToCompress>>
+partition_files_by_size(std::vector<FileToCompress> const& files, size_t num_partitions);
 }  // namespace clp::clp
 
 #endif  // CLP_CLP_COMPRESSION_HPP
@@ -1,12 +1,22 @@
 #include "decompression.hpp"
 
+#include <algorithm>
+#include <cstdio>
 #include <filesystem>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
 
 #include "../ErrorCode.hpp"
 #include "../FileWriter.hpp"
 #include "../GlobalMySQLMetadataDB.hpp"
 #include "../GlobalSQLiteMetadataDB.hpp"
+#include "../ir/SeekIndex.hpp"
 #include "../spdlog_with_specializations.hpp"
 #include "../streaming_archive/reader/Archive.hpp"
 #include "../TraceableException.hpp"
@@ -20,162 +30,240 @@ using std::make_unique;
 using std::string;
 using std::unique_ptr;
 using std::unordered_set;
+using std::vector;
 
 namespace clp::clp {
+namespace {
+/**
+ * Determines whether the given file should be decompressed by the given thread. Files are assigned
+ * to threads by segment so that each thread only decompresses the segments containing its files.
+ * All splits of a file are assigned to the same thread (by the original file's ID) so that they're
+ * appended to their output file in order.
+ * @param file_metadata_ix
+ * @param num_threads
+ * @param thread_ix
+ * @return Whether the file is assigned to the thread
+ */
+bool is_file_assigned_to_thread(
+        streaming_archive::MetadataDB::FileIterator const& file_metadata_ix,
+        size_t num_threads,
+        size_t thread_ix
+);
+
+/**
+ * Decompresses the files in the given archive that are assigned to the given thread. Each thread
+ * opens its own reader for the archive, so memory usage grows with the number of threads rather
+ * than the number of files.
+ * @param command_line_args
+ * @param archive_path
+ * @param files_to_decompress Paths of the files to decompress, or empty to decompress all files
+ * @param num_threads
+ * @param thread_ix
+ * @param temp_path_to_final_path
+ * @param output_paths_mutex Mutex guarding the output paths (including
+ * `temp_path_to_final_path`)
+ * @param decompressed_files Returns the paths of the files that were decompressed
+ * @return Whether decompression was successful
+ */
+bool decompress_archive_files(
+        CommandLineArguments const& command_line_args,
+        std::filesystem::path const& archive_path,
+        unordered_set<string> const& files_to_decompress,
+        size_t num_threads,
+        size_t thread_ix,
+        std::unordered_map<string, string>& temp_path_to_final_path,
+        std::mutex& output_paths_mutex,
+        unordered_set<string>& decompressed_files
+);
+
+bool is_file_assigned_to_thread(
+        streaming_archive::MetadataDB::FileIterator const& file_metadata_ix,
+        size_t num_threads,
+        size_t thread_ix
+) {
+    if (1 == num_threads) {
+        return true;
+    }
+
+    size_t hash{0};
+    if (file_metadata_ix.is_split()) {
+        string orig_file_id;
+        file_metadata_ix.get_orig_file_id(orig_file_id);
+        hash = std::hash<string>{}(orig_file_id);
+    } else {
+        hash = file_metadata_ix.get_segment_id();
+    }
+    return hash % num_threads == thread_ix;
+}
+
+bool decompress_archive_files(
+        CommandLineArguments const& command_line_args,
+        std::filesystem::path const& archive_path,
+        unordered_set<string> const& files_to_decompress,
+        size_t num_threads,
+        size_t thread_ix,
+        std::unordered_map<string, string>& temp_path_to_final_path,
+        std::mutex& output_paths_mutex,
+        unordered_set<string>& decompressed_files
+) {
+    streaming_archive::reader::Archive archive_reader;
+    archive_reader.open(archive_path.string());
+    archive_reader.refresh_dictionaries();
+
+    auto const extract_to_stdout = command_line_args.extract_to_stdout();
+    if (0 == thread_ix && files_to_decompress.empty() && false == extract_to_stdout) {
+        archive_reader.decompress_empty_directories(command_line_args.get_output_dir());
+    }
+
+    // Decompress files
+    FileDecompressor file_decompressor;
+    string orig_path;
+    auto file_metadata_ix_ptr = (1 == files_to_decompress.size())
+                                        ? archive_reader.get_file_iterator_by_path(
+                                                *files_to_decompress.begin()
+                                        )
+                                        : archive_reader.get_file_iterator();
+    for (auto& file_metadata_ix = *file_metadata_ix_ptr; file_metadata_ix.has_next();
+         file_metadata_ix.next())
+    {
+        file_metadata_ix.get_path(orig_path);
+        if (false == files_to_decompress.empty() && 0 == files_to_decompress.count(orig_path)) {
+            // Skip files that aren't in the list of files to decompress
+            continue;
+        }
+        if (false == is_file_assigned_to_thread(file_metadata_ix, num_threads, thread_ix)) {
+            continue;
+        }
+
+        // Decompress file
+        bool decompressed_file{false};
+        if (extract_to_stdout) {
+            decompressed_file
+                    = file_decompressor.decompress_file_to_stdout(file_metadata_ix, archive_reader);
+        } else {
+            decompressed_file = file_decompressor.decompress_file(
+                    file_metadata_ix,
+                    command_line_args.get_output_dir(),
+                    archive_reader,
+                    temp_path_to_final_path,
+                    output_paths_mutex
+            );
+        }
+        if (false == decompressed_file) {
+            return false;
+        }
+        decompressed_files.insert(orig_path);
+    }
+    file_metadata_ix_ptr.reset(nullptr);
+
+    archive_reader.close();
+    return true;
+}
+}  // namespace
+
 bool decompress(
         CommandLineArguments& command_line_args,
         unordered_set<string> const& files_to_decompress
 ) {
     ErrorCode error_code;
 
-    // Create output directory in case it doesn't exist
-    auto output_dir = std::filesystem::path(command_line_args.get_output_dir());
-    error_code = create_directory(output_dir.parent_path().string(), 0700, true);
-    if (ErrorCode_Success != error_code) {
-        SPDLOG_ERROR("Failed to create {} - {}", output_dir.parent_path().c_str(), strerror(errno));
-        return false;
+    auto const extract_to_stdout = command_line_args.extract_to_stdout();
+    if (false == extract_to_stdout) {
+        // Create output directory in case it doesn't exist
+        auto output_dir = std::filesystem::path(command_line_args.get_output_dir());
+        error_code = create_directory(output_dir.parent_path().string(), 0700, true);
+        if (ErrorCode_Success != error_code) {
+            SPDLOG_ERROR(
+                    "Failed to create {} - {}",
+                    output_dir.parent_path().c_str(),
+                    strerror(errno)
+            );
+            return false;
+        }
     }
 
-    unordered_set<string> decompressed_files;
+    auto const num_threads = command_line_args.get_num_extraction_threads();
+    vector<unordered_set<string>> decompressed_files_per_thread(num_threads);
 
     try {
         auto archives_dir = std::filesystem::path(command_line_args.get_archives_dir());
         auto const& global_metadata_db_config = command_line_args.get_metadata_db_config();
         auto global_metadata_db = get_global_metadata_db(global_metadata_db_config, archives_dir);
 
-        streaming_archive::reader::Archive archive_reader;
-
-        std::filesystem::path empty_directory_path;
-
-        FileDecompressor file_decompressor;
-
         string archive_id;
-        string orig_path;
         std::unordered_map<string, string> temp_path_to_final_path;
+        std::mutex output_paths_mutex;
         global_metadata_db->open();
-        if (files_to_decompress.empty()) {
-            for (auto archive_ix = std::unique_ptr<GlobalMetadataDB::ArchiveIterator>(
-                         global_metadata_db->get_archive_iterator()
-                 );
-                 archive_ix->contains_element();
-                 archive_ix->get_next())
-            {
-                archive_ix->get_id(archive_id);
-                auto archive_path = archives_dir / archive_id;
-
-                if (false == std::filesystem::exists(archive_path)) {
-                    SPDLOG_WARN(
-                            "Archive {} does not exist in '{}'.",
-                            archive_id,
-                            command_line_args.get_archives_dir()
-                    );
-                    continue;
-                }
-
-                archive_reader.open(archive_path.string());
-                archive_reader.refresh_dictionaries();
-
-                archive_reader.decompress_empty_directories(command_line_args.get_output_dir());
+        auto archive_ix = (1 == files_to_decompress.size())
+                                  ? unique_ptr<GlobalMetadataDB::ArchiveIterator>(
+                                            global_metadata_db->get_archive_iterator_for_file_path(
+                                                    *files_to_decompress.begin()
+                                            )
+                                    )
+                                  : unique_ptr<GlobalMetadataDB::ArchiveIterator>(
+                                            global_metadata_db->get_archive_iterator()
+                                    );
+        // Archives are decompressed one after another so that splits of a file spanning multiple
+        // archives are appended to their output file in order
+        for (; archive_ix->contains_element(); archive_ix->get_next()) {
+            archive_ix->get_id(archive_id);
+            auto archive_path = archives_dir / archive_id;
+
+            if (false == std::filesystem::exists(archive_path)) {
+                SPDLOG_WARN(
+                        "Archive {} does not exist in '{}'.",
+                        archive_id,
+                        command_line_args.get_archives_dir()
+                );
+                continue;
+            }
 
-                // Decompress files
-                auto file_metadata_ix_ptr = archive_reader.get_file_iterator();
-                for (auto& file_metadata_ix = *file_metadata_ix_ptr; file_metadata_ix.has_next();
-                     file_metadata_ix.next())
+            if (1 == num_threads) {
+                if (false
+                    == decompress_archive_files(
+                            command_line_args,
+                            archive_path,
+                            files_to_decompress,
+                            num_threads,
+                            0,
+                            temp_path_to_final_path,
+                            output_paths_mutex,
+                            decompressed_files_per_thread[0]
+                    ))
                 {
-                    // Decompress file
-                    if (false
-                        == file_decompressor.decompress_file(
-                                file_metadata_ix,
-                                command_line_args.get_output_dir(),
-                                archive_reader,
-                                temp_path_to_final_path
-                        ))
-                    {
-                        return false;
-                    }
-                    file_metadata_ix.get_path(orig_path);
-                    decompressed_files.insert(orig_path);
+                    return false;
                 }
-                file_metadata_ix_ptr.reset(nullptr);
-
-                archive_reader.close();
+                continue;
             }
-        } else if (files_to_decompress.size() == 1) {
-            auto const& file_path = *files_to_decompress.begin();
-            for (auto archive_ix = std::unique_ptr<GlobalMetadataDB::ArchiveIterator>(
-                         global_metadata_db->get_archive_iterator_for_file_path(file_path)
-                 );
-                 archive_ix->contains_element();
-                 archive_ix->get_next())
-            {
-                archive_ix->get_id(archive_id);
-                auto archive_path = archives_dir / archive_id;
-                archive_reader.open(archive_path.string());
-                archive_reader.refresh_dictionaries();
-
-                // Decompress all splits with the given path
-                auto file_metadata_ix_ptr = archive_reader.get_file_iterator_by_path(file_path);
-                for (auto& file_metadata_ix = *file_metadata_ix_ptr; file_metadata_ix.has_next();
-                     file_metadata_ix.next())
-                {
-                    // Decompress file
-                    if (false
-                        == file_decompressor.decompress_file(
-                                file_metadata_ix,
-                                command_line_args.get_output_dir(),
-                                archive_reader,
-                                temp_path_to_final_path
-                        ))
-                    {
-                        return false;
-                    }
-                    decompressed_files.insert(file_path);
-                }
-                file_metadata_ix_ptr.reset(nullptr);
 
-                archive_reader.close();
+            vector<std::future<bool>> decompression_results;
+            decompression_results.reserve(num_threads);
+            for (size_t i = 0; i < num_threads; ++i) {
+                decompression_results.emplace_back(std::async(
+                        std::launch::async,
+                        decompress_archive_files,
+                        std::cref(command_line_args),
+                        std::cref(archive_path),
+                        std::cref(files_to_decompress),
+                        num_threads,
+                        i,
+                        std::ref(temp_path_to_final_path),
+                        std::ref(output_paths_mutex),
+                        std::ref(decompressed_files_per_thread[i])
+                ));
             }
-        } else {  // files_to_decompress.size() > 1
-            for (auto archive_ix = std::unique_ptr<GlobalMetadataDB::ArchiveIterator>(
-                         global_metadata_db->get_archive_iterator()
-                 );
-                 archive_ix->contains_element();
-                 archive_ix->get_next())
-            {
-                archive_ix->get_id(archive_id);
-                auto archive_path = archives_dir / archive_id;
-                archive_reader.open(archive_path.string());
-                archive_reader.refresh_dictionaries();
-
-                // Decompress files
-                auto file_metadata_ix_ptr = archive_reader.get_file_iterator();
-                for (auto& file_metadata_ix = *file_metadata_ix_ptr; file_metadata_ix.has_next();
-                     file_metadata_ix.next())
-                {
-                    file_metadata_ix.get_path(orig_path);
-                    if (files_to_decompress.count(orig_path) == 0) {
-                        // Skip files that aren't in the list of files to decompress
-                        continue;
-                    }
-
-                    // Decompress file
-                    if (false
-                        == file_decompressor.decompress_file(
-                                file_metadata_ix,
-                                command_line_args.get_output_dir(),
-                                archive_reader,
-                                temp_path_to_final_path
-                        ))
-                    {
-                        return false;
-                    }
-                    decompressed_files.insert(orig_path);
+            bool all_files_decompressed_successfully = true;
+            for (auto& decompression_result : decompression_results) {
+                // NOTE: This rethrows any exception thrown while decompressing
+                if (false == decompression_result.get()) {
+                    all_files_decompressed_successfully = false;
                 }
-                file_metadata_ix_ptr.reset(nullptr);
-
-                archive_reader.close();
+            }
+            if (false == all_files_decompressed_successfully) {
+                return false;
             }
         }
+        archive_ix.reset(nullptr);
         global_metadata_db->close();
 
         string final_path;
@@ -219,11 +307,21 @@ bool decompress(
             return false;
         }
     }
+    if (extract_to_stdout) {
+        std::fflush(stdout);
+    }
 
     if (files_to_decompress.empty() == false) {
         // Check if any requested files were not found in the archive
         for (auto const& file : files_to_decompress) {
-            if (decompressed_files.count(file) == 0) {
+            auto const is_decompressed = std::any_of(
+                    decompressed_files_per_thread.cbegin(),
+                    decompressed_files_per_thread.cend(),
+                    [&](auto const& decompressed_files) {
+                        return 0 != decompressed_files.count(file);
+                    }
+            );
+            if (false == is_decompressed) {
                 SPDLOG_ERROR("'{}' not found in any archive", file.c_str());
             }
         }
@@ -237,9 +335,9 @@ bool decompress_to_ir(CommandLineArguments& command_line_args) {
 
     // Create output directory in case it doesn't exist
     std::filesystem::path output_dir{command_line_args.get_output_dir()};
-    error_code = create_directory(output_dir.parent_path().string(), 0700, true);
+    error_code = create_directory_structure(output_dir.string(), 0700);
     if (ErrorCode_Success != error_code) {
-        SPDLOG_ERROR("Failed to create {} - {}", output_dir.parent_path().c_str(), strerror(errno));
+        SPDLOG_ERROR("Failed to create {} - {}", output_dir.c_str(), strerror(errno));
         return false;
     }
 
@@ -278,7 +376,8 @@ bool decompress_to_ir(CommandLineArguments& command_line_args) {
             return false;
         }
 
-        auto ir_output_handler = [&](std::filesystem::path const& src_ir_path,
+        auto ir_output_handler = [&](std::span<char const> ir_chunk,
+                                     std::optional<ir::SeekIndex> const& seek_index,
                                      string const& orig_file_id,
                                      size_t begin_message_ix,
                                      size_t end_message_ix,
@@ -289,16 +388,15 @@ bool decompress_to_ir(CommandLineArguments& command_line_args) {
             dest_ir_file_name += ir::cIrFileExtension;
 
             auto const dest_ir_path = output_dir / dest_ir_file_name;
-            try {
-                std::filesystem::rename(src_ir_path, dest_ir_path);
-            } catch (std::filesystem::filesystem_error const& e) {
-                SPDLOG_ERROR(
-                        "Failed to rename from {} to {}. Error: {}",
-                        src_ir_path.c_str(),
-                        dest_ir_path.c_str(),
-                        e.what()
-                );
-                return false;
+            FileWriter ir_file_writer;
+            ir_file_writer.open(dest_ir_path.string(), FileWriter::OpenMode::CREATE_FOR_WRITING);
+            ir_file_writer.write(ir_chunk.data(), ir_chunk.size());
+            ir_file_writer.close();
+
+            if (seek_index.has_value()) {
+                auto dest_seek_index_path = dest_ir_path.string();
+                dest_seek_index_path += ir::cSeekIndexFileExtension;
+                seek_index->write_to_file(dest_seek_index_path);
             }
             return true;
         };
@@ -310,7 +408,8 @@ bool decompress_to_ir(CommandLineArguments& command_line_args) {
                     archive_reader,
                     *file_metadata_ix_ptr,
                     command_line_args.get_ir_target_size(),
-                    command_line_args.get_ir_temp_output_dir(),
+                    command_line_args.get_ir_seek_index_checkpoint_interval(),
+                    std::nullopt,
                     ir_output_handler
             ))
         {
@@ -8,7 +8,8 @@
 
 namespace clp::clp {
 /**
- * Decompresses an archive into the given directory
+ * Decompresses an archive into the given directory, or to stdout. Each archive's files are
+ * decompressed in parallel if multiple extraction threads were requested.
  * @param command_line_args
  * @param files_to_decompress
  * @return true if decompression was successful, false otherwise
@@ -682,6 +682,9 @@ auto Deserializer::deserialize_to_next_log_event(clp::ReaderInterface& reader
     if (auto const err{deserialize_tag(reader, tag)}; IRErrorCode::IRErrorCode_Success != err) {
         return ir_error_code_to_errc(err);
     }
+    if (cProtocol::Eof == tag) {
+        return ir_error_code_to_errc(IRErrorCode::IRErrorCode_Eof);
+    }
 
     if (auto const err{deserialize_utc_offset_changes(reader, tag, m_utc_offset)};
         IRErrorCode::IRErrorCode_Success != err)
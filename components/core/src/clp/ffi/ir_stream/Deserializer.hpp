@@ -50,6 +50,7 @@ public:
      * @param reader
      * @return A result containing the deserialized log event or an error code indicating the
      * failure:
+     * - std::errc::no_message_available if the end of the IR stream has been reached
      * - std::errc::result_out_of_range if the IR stream is truncated
      * - std::errc::protocol_error if the IR stream is corrupted
      * - std::errc::protocol_not_supported if the IR stream contains an unsupported metadata format
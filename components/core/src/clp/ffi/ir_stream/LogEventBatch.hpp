@@ -0,0 +1,101 @@
+#ifndef CLP_FFI_IR_STREAM_LOGEVENTBATCH_HPP
+#define CLP_FFI_IR_STREAM_LOGEVENTBATCH_HPP
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "../../ir/types.hpp"
+#include "../../time_types.hpp"
+
+namespace clp::ffi::ir_stream {
+template <typename encoded_variable_t>
+class LogEventBatchDeserializer;
+
+/**
+ * A batch of log events from an IR stream, stored column-wise. Each log event's logtype and
+ * dictionary variables are views into the buffer the batch was deserialized from, so the buffer
+ * must outlive the batch. The batch's storage is reused when it's cleared, so deserializing many
+ * batches into the same object doesn't allocate once its columns are large enough.
+ * @tparam encoded_variable_t The type of encoded variables in the stream
+ */
+template <typename encoded_variable_t>
+class LogEventBatch {
+public:
+    // Methods
+    [[nodiscard]] auto size() const -> size_t { return m_timestamps.size(); }
+
+    [[nodiscard]] auto empty() const -> bool { return m_timestamps.empty(); }
+
+    /**
+     * Removes all log events from the batch while retaining its storage
+     */
+    auto clear() -> void {
+        m_timestamps.clear();
+        m_utc_offsets.clear();
+        m_logtypes.clear();
+        m_encoded_vars.clear();
+        m_encoded_vars_end_ixs.clear();
+        m_dict_vars.clear();
+        m_dict_vars_end_ixs.clear();
+    }
+
+    // Columns
+    [[nodiscard]] auto get_timestamps() const -> std::vector<ir::epoch_time_ms_t> const& {
+        return m_timestamps;
+    }
+
+    [[nodiscard]] auto get_utc_offsets() const -> std::vector<UtcOffset> const& {
+        return m_utc_offsets;
+    }
+
+    [[nodiscard]] auto get_logtypes() const -> std::vector<std::string_view> const& {
+        return m_logtypes;
+    }
+
+    // Per-log-event accessors
+    /**
+     * @param log_event_ix
+     * @return The encoded variables of the given log event
+     */
+    [[nodiscard]] auto get_encoded_vars(size_t log_event_ix
+    ) const -> std::span<encoded_variable_t const> {
+        auto const begin_ix = 0 == log_event_ix ? 0 : m_encoded_vars_end_ixs[log_event_ix - 1];
+        return std::span<encoded_variable_t const>{m_encoded_vars}.subspan(
+                begin_ix,
+                m_encoded_vars_end_ixs[log_event_ix] - begin_ix
+        );
+    }
+
+    /**
+     * @param log_event_ix
+     * @return The dictionary variables of the given log event
+     */
+    [[nodiscard]] auto get_dict_vars(size_t log_event_ix
+    ) const -> std::span<std::string_view const> {
+        auto const begin_ix = 0 == log_event_ix ? 0 : m_dict_vars_end_ixs[log_event_ix - 1];
+        return std::span<std::string_view const>{m_dict_vars}.subspan(
+                begin_ix,
+                m_dict_vars_end_ixs[log_event_ix] - begin_ix
+        );
+    }
+
+private:
+    friend class LogEventBatchDeserializer<encoded_variable_t>;
+
+    // Variables
+    std::vector<ir::epoch_time_ms_t> m_timestamps;
+    std::vector<UtcOffset> m_utc_offsets;
+    std::vector<std::string_view> m_logtypes;
+
+    // The encoded and dictionary variables of every log event, back-to-back. Each log event's
+    // variables end at the corresponding index in `m_*_end_ixs`.
+    std::vector<encoded_variable_t> m_encoded_vars;
+    std::vector<size_t> m_encoded_vars_end_ixs;
+    std::vector<std::string_view> m_dict_vars;
+    std::vector<size_t> m_dict_vars_end_ixs;
+};
+}  // namespace clp::ffi::ir_stream
+
+#endif  // CLP_FFI_IR_STREAM_LOGEVENTBATCH_HPP
@@ -0,0 +1,348 @@
+#include "LogEventBatchDeserializer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include <json/single_include/nlohmann/json.hpp>
+#include <outcome/single-header/outcome.hpp>
+#include <string_utils/string_utils.hpp>
+
+#include "../../BufferReader.hpp"
+#include "../../ErrorCode.hpp"
+#include "../../ir/types.hpp"
+#include "../../time_types.hpp"
+#include "byteswap.hpp"
+#include "decoding_methods.hpp"
+#include "LogEventBatch.hpp"
+#include "protocol_constants.hpp"
+
+using clp::ir::eight_byte_encoded_variable_t;
+using clp::ir::epoch_time_ms_t;
+using clp::ir::four_byte_encoded_variable_t;
+using std::is_same_v;
+using std::span;
+using std::string_view;
+
+namespace clp::ffi::ir_stream {
+namespace {
+/**
+ * Reads a big-endian integer from the given buffer
+ * @tparam integer_t
+ * @param buf
+ * @param pos The position to read from, returns the position after the integer
+ * @param value Returns the integer
+ * @return Whether the buffer contained enough data
+ */
+template <typename integer_t>
+auto read_int(span<char const> buf, size_t& pos, integer_t& value) -> bool;
+
+/**
+ * Reads a length-prefixed string from the given buffer, where the length's size depends on the
+ * given tag
+ * @tparam LengthUByteTag
+ * @tparam LengthUShortTag
+ * @tparam LengthIntTag
+ * @param buf
+ * @param pos The position to read from, returns the position after the string
+ * @param tag
+ * @param str Returns a view of the string in the buffer
+ * @return IRErrorCode_Success on success
+ * @return IRErrorCode_Corrupted_IR if the tag isn't one of the given length tags
+ * @return IRErrorCode_Incomplete_IR if the buffer doesn't contain the entire string
+ */
+template <encoded_tag_t LengthUByteTag, encoded_tag_t LengthUShortTag, encoded_tag_t LengthIntTag>
+auto read_string(span<char const> buf, size_t& pos, encoded_tag_t tag, string_view& str)
+        -> IRErrorCode;
+
+template <typename integer_t>
+auto read_int(span<char const> buf, size_t& pos, integer_t& value) -> bool {
+    constexpr auto cReadSize = sizeof(integer_t);
+    if (buf.size() - pos < cReadSize) {
+        return false;
+    }
+
+    integer_t value_little_endian{};
+    std::memcpy(&value_little_endian, buf.data() + pos, cReadSize);
+    pos += cReadSize;
+
+    static_assert(cReadSize == 1 || cReadSize == 2 || cReadSize == 4 || cReadSize == 8);
+    if constexpr (cReadSize == 1) {
+        value = value_little_endian;
+    } else if constexpr (cReadSize == 2) {
+        value = bswap_16(value_little_endian);
+    } else if constexpr (cReadSize == 4) {
+        value = bswap_32(value_little_endian);
+    } else if constexpr (cReadSize == 8) {
+        value = bswap_64(value_little_endian);
+    }
+    return true;
+}
+
+template <encoded_tag_t LengthUByteTag, encoded_tag_t LengthUShortTag, encoded_tag_t LengthIntTag>
+auto read_string(span<char const> buf, size_t& pos, encoded_tag_t tag, string_view& str)
+        -> IRErrorCode {
+    size_t length{};
+    if (LengthUByteTag == tag) {
+        uint8_t ubyte_length{};
+        if (false == read_int(buf, pos, ubyte_length)) {
+            return IRErrorCode_Incomplete_IR;
+        }
+        length = ubyte_length;
+    } else if (LengthUShortTag == tag) {
+        uint16_t ushort_length{};
+        if (false == read_int(buf, pos, ushort_length)) {
+            return IRErrorCode_Incomplete_IR;
+        }
+        length = ushort_length;
+    } else if (LengthIntTag == tag) {
+        int32_t int_length{};
+        if (false == read_int(buf, pos, int_length)) {
+            return IRErrorCode_Incomplete_IR;
+        }
+        if (int_length < 0) {
+            return IRErrorCode_Corrupted_IR;
+        }
+        length = static_cast<size_t>(int_length);
+    } else {
+        return IRErrorCode_Corrupted_IR;
+    }
+
+    if (buf.size() - pos < length) {
+        return IRErrorCode_Incomplete_IR;
+    }
+    str = string_view{buf.data() + pos, length};
+    pos += length;
+    return IRErrorCode_Success;
+}
+}  // namespace
+
+template <typename encoded_variable_t>
+auto LogEventBatchDeserializer<encoded_variable_t>::create(span<char const> buf)
+        -> OUTCOME_V2_NAMESPACE::std_result<LogEventBatchDeserializer<encoded_variable_t>> {
+    constexpr bool cUsesFourByteEncoding{
+            is_same_v<encoded_variable_t, four_byte_encoded_variable_t>
+    };
+
+    BufferReader reader{buf.data(), buf.size()};
+    bool is_four_byte_encoded{false};
+    if (auto const error_code = get_encoding_type(reader, is_four_byte_encoded);
+        IRErrorCode_Success != error_code)
+    {
+        return IRErrorCode_Incomplete_IR == error_code ? std::errc::result_out_of_range
+                                                       : std::errc::protocol_error;
+    }
+    if (cUsesFourByteEncoding != is_four_byte_encoded) {
+        return std::errc::protocol_not_supported;
+    }
+
+    encoded_tag_t metadata_type{0};
+    std::vector<int8_t> metadata;
+    if (auto const error_code = deserialize_preamble(reader, metadata_type, metadata);
+        IRErrorCode_Success != error_code)
+    {
+        return IRErrorCode_Incomplete_IR == error_code ? std::errc::result_out_of_range
+                                                       : std::errc::protocol_error;
+    }
+    if (cProtocol::Metadata::EncodingJson != metadata_type) {
+        return std::errc::protocol_not_supported;
+    }
+
+    // Parse metadata and validate version
+    auto const metadata_json = nlohmann::json::parse(metadata, nullptr, false);
+    if (metadata_json.is_discarded()) {
+        return std::errc::protocol_error;
+    }
+    auto const version_iter = metadata_json.find(cProtocol::Metadata::VersionKey);
+    if (metadata_json.end() == version_iter || false == version_iter->is_string()) {
+        return std::errc::protocol_error;
+    }
+    if (IRProtocolErrorCode_Supported
+        != validate_protocol_version(version_iter->get_ref<nlohmann::json::string_t const&>()))
+    {
+        return std::errc::protocol_not_supported;
+    }
+
+    epoch_time_ms_t ref_timestamp{0};
+    if constexpr (cUsesFourByteEncoding) {
+        auto const ref_timestamp_iter
+                = metadata_json.find(cProtocol::Metadata::ReferenceTimestampKey);
+        if (metadata_json.end() == ref_timestamp_iter || false == ref_timestamp_iter->is_string()) {
+            return std::errc::protocol_error;
+        }
+        if (false
+            == string_utils::convert_string_to_int(
+                    ref_timestamp_iter->get_ref<nlohmann::json::string_t const&>(),
+                    ref_timestamp
+            ))
+        {
+            return std::errc::protocol_error;
+        }
+    }
+
+    size_t log_events_pos{0};
+    if (ErrorCode_Success != reader.try_get_pos(log_events_pos)) {
+        return std::errc::protocol_error;
+    }
+    LogEventBatchDeserializer<encoded_variable_t> deserializer{buf, ref_timestamp};
+    deserializer.m_pos = log_events_pos;
+    return deserializer;
+}
+
+template <typename encoded_variable_t>
+auto LogEventBatchDeserializer<encoded_variable_t>::deserialize_log_events(
+        size_t max_num_log_events,
+        LogEventBatch<encoded_variable_t>& batch
+) -> IRErrorCode {
+    batch.clear();
+    while (batch.size() < max_num_log_events) {
+        auto pos = m_pos;
+        encoded_tag_t tag{};
+        if (false == read_int(m_buf, pos, tag)) {
+            return IRErrorCode_Incomplete_IR;
+        }
+
+        if (cProtocol::Eof == tag) {
+            m_pos = pos;
+            return IRErrorCode_Eof;
+        }
+
+        if (cProtocol::Payload::UtcOffsetChange == tag) {
+            int64_t serialized_utc_offset{};
+            if (false == read_int(m_buf, pos, serialized_utc_offset)) {
+                return IRErrorCode_Incomplete_IR;
+            }
+            m_utc_offset = UtcOffset{serialized_utc_offset};
+            m_pos = pos;
+            continue;
+        }
+
+        m_pos = pos;
+        if (auto const error_code = deserialize_log_event(tag, batch);
+            IRErrorCode_Success != error_code)
+        {
+            // Rewind to the log event's tag so that it can be retried with more data
+            m_pos -= sizeof(tag);
+            return error_code;
+        }
+    }
+    return IRErrorCode_Success;
+}
+
+template <typename encoded_variable_t>
+auto LogEventBatchDeserializer<encoded_variable_t>::deserialize_log_event(
+        encoded_tag_t tag,
+        LogEventBatch<encoded_variable_t>& batch
+) -> IRErrorCode {
+    constexpr encoded_tag_t cEncodedVarTag{
+            is_same_v<encoded_variable_t, four_byte_encoded_variable_t>
+                    ? cProtocol::Payload::VarFourByteEncoding
+                    : cProtocol::Payload::VarEightByteEncoding
+    };
+
+    auto pos = m_pos;
+    auto const num_encoded_vars_before = batch.m_encoded_vars.size();
+    auto const num_dict_vars_before = batch.m_dict_vars.size();
+    auto const rollback = [&](IRErrorCode error_code) {
+        batch.m_encoded_vars.resize(num_encoded_vars_before);
+        batch.m_dict_vars.resize(num_dict_vars_before);
+        return error_code;
+    };
+
+    // Variables
+    while (true) {
+        if (cEncodedVarTag == tag) {
+            encoded_variable_t encoded_var{};
+            if (false == read_int(m_buf, pos, encoded_var)) {
+                return rollback(IRErrorCode_Incomplete_IR);
+            }
+            batch.m_encoded_vars.push_back(encoded_var);
+        } else if (cProtocol::Payload::VarStrLenUByte == tag
+                   || cProtocol::Payload::VarStrLenUShort == tag
+                   || cProtocol::Payload::VarStrLenInt == tag)
+        {
+            string_view dict_var;
+            if (auto const error_code = read_string<
+                        cProtocol::Payload::VarStrLenUByte,
+                        cProtocol::Payload::VarStrLenUShort,
+                        cProtocol::Payload::VarStrLenInt>(m_buf, pos, tag, dict_var);
+                IRErrorCode_Success != error_code)
+            {
+                return rollback(error_code);
+            }
+            batch.m_dict_vars.push_back(dict_var);
+        } else {
+            break;
+        }
+        if (false == read_int(m_buf, pos, tag)) {
+            return rollback(IRErrorCode_Incomplete_IR);
+        }
+    }
+
+    // Logtype
+    string_view logtype;
+    if (auto const error_code = read_string<
+                cProtocol::Payload::LogtypeStrLenUByte,
+                cProtocol::Payload::LogtypeStrLenUShort,
+                cProtocol::Payload::LogtypeStrLenInt>(m_buf, pos, tag, logtype);
+        IRErrorCode_Success != error_code)
+    {
+        return rollback(error_code);
+    }
+
+    // Timestamp
+    if (false == read_int(m_buf, pos, tag)) {
+        return rollback(IRErrorCode_Incomplete_IR);
+    }
+    epoch_time_ms_t timestamp{};
+    bool is_complete{false};
+    if constexpr (is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>) {
+        if (cProtocol::Payload::TimestampVal != tag) {
+            return rollback(IRErrorCode_Corrupted_IR);
+        }
+        is_complete = read_int(m_buf, pos, timestamp);
+    } else {
+        epoch_time_ms_t timestamp_delta{};
+        if (cProtocol::Payload::TimestampDeltaByte == tag) {
+            int8_t delta{};
+            is_complete = read_int(m_buf, pos, delta);
+            timestamp_delta = delta;
+        } else if (cProtocol::Payload::TimestampDeltaShort == tag) {
+            int16_t delta{};
+            is_complete = read_int(m_buf, pos, delta);
+            timestamp_delta = delta;
+        } else if (cProtocol::Payload::TimestampDeltaInt == tag) {
+            int32_t delta{};
+            is_complete = read_int(m_buf, pos, delta);
+            timestamp_delta = delta;
+        } else if (cProtocol::Payload::TimestampDeltaLong == tag) {
+            is_complete = read_int(m_buf, pos, timestamp_delta);
+        } else {
+            return rollback(IRErrorCode_Corrupted_IR);
+        }
+        timestamp = m_prev_timestamp + timestamp_delta;
+    }
+    if (false == is_complete) {
+        return rollback(IRErrorCode_Incomplete_IR);
+    }
+
+    m_prev_timestamp = timestamp;
+    m_pos = pos;
+    batch.m_timestamps.push_back(timestamp);
+    batch.m_utc_offsets.push_back(m_utc_offset);
+    batch.m_logtypes.push_back(logtype);
+    batch.m_encoded_vars_end_ixs.push_back(batch.m_encoded_vars.size());
+    batch.m_dict_vars_end_ixs.push_back(batch.m_dict_vars.size());
+    return IRErrorCode_Success;
+}
+
+// Explicitly declare specializations to avoid having to validate that the template parameters are
+// supported
+template class LogEventBatchDeserializer<eight_byte_encoded_variable_t>;
+template class LogEventBatchDeserializer<four_byte_encoded_variable_t>;
+}  // namespace clp::ffi::ir_stream
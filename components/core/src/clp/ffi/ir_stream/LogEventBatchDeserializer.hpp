@@ -0,0 +1,117 @@
+#ifndef CLP_FFI_IR_STREAM_LOGEVENTBATCHDESERIALIZER_HPP
+#define CLP_FFI_IR_STREAM_LOGEVENTBATCHDESERIALIZER_HPP
+
+#include <cstddef>
+#include <span>
+
+#include <outcome/single-header/outcome.hpp>
+
+#include "../../ir/types.hpp"
+#include "../../time_types.hpp"
+#include "decoding_methods.hpp"
+#include "LogEventBatch.hpp"
+
+namespace clp::ffi::ir_stream {
+/**
+ * Class for deserializing log events in batches from an IR stream that's entirely in memory (e.g.,
+ * in a decompressed buffer or a memory-mapped file).
+ * <br/>
+ * Unlike `ir::LogEventDeserializer`, this reads the buffer directly rather than through a
+ * `ReaderInterface`, and doesn't copy logtypes or dictionary variables; instead, they're returned
+ * as views into the buffer (see `LogEventBatch`).
+ * @tparam encoded_variable_t The type of encoded variables in the stream
+ */
+template <typename encoded_variable_t>
+class LogEventBatchDeserializer {
+public:
+    // Constructors
+    /**
+     * @param buf The IR stream's log events, i.e., the stream's content after its preamble. The
+     * buffer must outlive the deserializer and any batches it fills.
+     * @param prev_timestamp For four-byte-encoded streams, the timestamp that the first log
+     * event's timestamp delta is relative to, i.e., the stream's reference timestamp (or a seek
+     * index checkpoint's previous timestamp). Unused for eight-byte-encoded streams.
+     * @param utc_offset The UTC offset in effect at the beginning of `buf`
+     */
+    explicit LogEventBatchDeserializer(
+            std::span<char const> buf,
+            ir::epoch_time_ms_t prev_timestamp = 0,
+            UtcOffset utc_offset = UtcOffset{0}
+    )
+            : m_buf{buf},
+              m_prev_timestamp{prev_timestamp},
+              m_utc_offset{utc_offset} {}
+
+    // Factory functions
+    /**
+     * Creates a deserializer for an entire IR stream, i.e., a buffer starting with the stream's
+     * encoding type and preamble. The reference timestamp of a four-byte-encoded stream is read
+     * from the preamble's metadata.
+     * @param buf The IR stream. The buffer must outlive the deserializer and any batches it fills.
+     * @return A result containing the deserializer, positioned at the stream's first log event, or
+     * an error code indicating the failure:
+     * - std::errc::result_out_of_range if the buffer doesn't contain the entire preamble
+     * - std::errc::protocol_error if the preamble is invalid
+     * - std::errc::protocol_not_supported if the stream's encoding type, metadata type, or version
+     *   isn't supported
+     */
+    [[nodiscard]] static auto create(std::span<char const> buf)
+            -> OUTCOME_V2_NAMESPACE::std_result<LogEventBatchDeserializer<encoded_variable_t>>;
+
+    // Methods
+    /**
+     * Deserializes up to `max_num_log_events` log events into the given batch, replacing its
+     * previous contents.
+     * @param max_num_log_events
+     * @param batch
+     * @return IRErrorCode_Success if `max_num_log_events` log events were deserialized
+     * @return IRErrorCode_Eof if the end of the stream was reached first
+     * @return IRErrorCode_Incomplete_IR if the buffer ended in the middle of a log event. The
+     * deserializer's position is left at the start of the incomplete log event.
+     * @return IRErrorCode_Corrupted_IR if the buffer contains invalid IR
+     * In every case, the batch contains all log events deserialized before the return.
+     */
+    [[nodiscard]] auto deserialize_log_events(
+            size_t max_num_log_events,
+            LogEventBatch<encoded_variable_t>& batch
+    ) -> IRErrorCode;
+
+    /**
+     * Replaces the buffer with one containing more of the same stream (e.g., after reading more of
+     * the stream into a larger buffer), so that an incomplete log event can be retried. The
+     * position in the buffer is unchanged.
+     * @param buf A buffer that starts with the current buffer's content. The buffer must outlive
+     * the deserializer and any batches it fills.
+     */
+    auto extend_buf(std::span<char const> buf) -> void { m_buf = buf; }
+
+    /**
+     * @return The position in the buffer after the last deserialized packet
+     */
+    [[nodiscard]] auto get_pos() const -> size_t { return m_pos; }
+
+    [[nodiscard]] auto get_current_utc_offset() const -> UtcOffset { return m_utc_offset; }
+
+private:
+    // Methods
+    /**
+     * Deserializes the next log event (preceded by the given tag) into the given batch
+     * @param tag
+     * @param batch
+     * @return IRErrorCode_Success on success
+     * @return IRErrorCode_Incomplete_IR if the buffer doesn't contain the entire log event
+     * @return IRErrorCode_Corrupted_IR if the buffer contains invalid IR
+     */
+    [[nodiscard]] auto
+    deserialize_log_event(encoded_tag_t tag, LogEventBatch<encoded_variable_t>& batch)
+            -> IRErrorCode;
+
+    // Variables
+    std::span<char const> m_buf;
+    size_t m_pos{0};
+    ir::epoch_time_ms_t m_prev_timestamp;
+    UtcOffset m_utc_offset;
+};
+}  // namespace clp::ffi::ir_stream
+
+#endif  // CLP_FFI_IR_STREAM_LOGEVENTBATCHDESERIALIZER_HPP
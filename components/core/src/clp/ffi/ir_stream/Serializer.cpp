@@ -13,6 +13,7 @@
 #include <json/single_include/nlohmann/json.hpp>
 #include <msgpack.hpp>
 #include <outcome/single-header/outcome.hpp>
+#include <simdjson.h>
 
 #include "../../ir/types.hpp"
 #include "../../time_types.hpp"
@@ -76,6 +77,65 @@ private:
     span<Child>::iterator m_curr_child_it;
 };
 
+/**
+ * Class for iterating the fields of a JSON object.
+ *
+ * NOTE: Since JSON objects are parsed on demand, a field's value must be consumed (including any
+ * nested objects) before advancing to the next field. So the iterator only advances past the
+ * current field when the next field is requested.
+ */
+class JsonObjectIterator {
+public:
+    // Types
+    using Child = simdjson::ondemand::field;
+
+    // Constructors
+    JsonObjectIterator(
+            SchemaTreeNode::id_t schema_tree_node_id,
+            simdjson::ondemand::object_iterator begin,
+            simdjson::ondemand::object_iterator end
+    )
+            : m_schema_tree_node_id{schema_tree_node_id},
+              m_curr_child_it{begin},
+              m_end_it{end} {}
+
+    // Methods
+    /**
+     * @return This object's ID in the schema tree.
+     */
+    [[nodiscard]] auto get_schema_tree_node_id() const -> SchemaTreeNode::id_t {
+        return m_schema_tree_node_id;
+    }
+
+    /**
+     * Advances past the previously returned child, if any.
+     * @return Whether there are more children to traverse.
+     */
+    [[nodiscard]] auto has_next_child() -> bool {
+        if (m_curr_child_returned) {
+            ++m_curr_child_it;
+            m_curr_child_returned = false;
+        }
+        return m_curr_child_it != m_end_it;
+    }
+
+    /**
+     * Gets the next child.
+     * @param child Returns the next child to traverse.
+     * @return Whether the child was parsed successfully.
+     */
+    [[nodiscard]] auto get_next_child(Child& child) -> bool {
+        m_curr_child_returned = true;
+        return simdjson::SUCCESS == (*m_curr_child_it).get(child);
+    }
+
+private:
+    SchemaTreeNode::id_t m_schema_tree_node_id;
+    simdjson::ondemand::object_iterator m_curr_child_it;
+    simdjson::ondemand::object_iterator m_end_it;
+    bool m_curr_child_returned{false};
+};
+
 /**
  * Gets the schema-tree node type that corresponds with a given MessagePack value.
  * @param val
@@ -85,6 +145,18 @@ private:
 [[nodiscard]] auto get_schema_tree_node_type_from_msgpack_val(msgpack::object const& val
 ) -> optional<SchemaTreeNode::Type>;
 
+/**
+ * Gets the schema-tree node type that corresponds with a given JSON value.
+ * @param val
+ * @param json_type The JSON type of `val`.
+ * @return The corresponding schema-tree node type.
+ * @return std::nullopt if the value doesn't match any of the supported schema-tree node types.
+ */
+[[nodiscard]] auto get_schema_tree_node_type_from_json_val(
+        simdjson::ondemand::value& val,
+        simdjson::ondemand::json_type json_type
+) -> optional<SchemaTreeNode::Type>;
+
 /**
  * Serializes an empty object.
  * @param output_buf
@@ -177,6 +249,49 @@ auto get_schema_tree_node_type_from_msgpack_val(msgpack::object const& val
     return ret_val;
 }
 
+auto get_schema_tree_node_type_from_json_val(
+        simdjson::ondemand::value& val,
+        simdjson::ondemand::json_type json_type
+) -> optional<SchemaTreeNode::Type> {
+    optional<SchemaTreeNode::Type> ret_val;
+    switch (json_type) {
+        case simdjson::ondemand::json_type::number: {
+            simdjson::ondemand::number_type number_type{};
+            if (simdjson::SUCCESS != val.get_number_type().get(number_type)) {
+                return std::nullopt;
+            }
+            switch (number_type) {
+                case simdjson::ondemand::number_type::signed_integer:
+                case simdjson::ondemand::number_type::unsigned_integer:
+                    ret_val.emplace(SchemaTreeNode::Type::Int);
+                    break;
+                case simdjson::ondemand::number_type::floating_point_number:
+                    ret_val.emplace(SchemaTreeNode::Type::Float);
+                    break;
+                default:
+                    return std::nullopt;
+            }
+            break;
+        }
+        case simdjson::ondemand::json_type::string:
+            ret_val.emplace(SchemaTreeNode::Type::Str);
+            break;
+        case simdjson::ondemand::json_type::boolean:
+            ret_val.emplace(SchemaTreeNode::Type::Bool);
+            break;
+        case simdjson::ondemand::json_type::null:
+        case simdjson::ondemand::json_type::object:
+            ret_val.emplace(SchemaTreeNode::Type::Obj);
+            break;
+        case simdjson::ondemand::json_type::array:
+            ret_val.emplace(SchemaTreeNode::Type::UnstructuredArray);
+            break;
+        default:
+            return std::nullopt;
+    }
+    return ret_val;
+}
+
 auto serialize_value_empty_object(vector<int8_t>& output_buf) -> void {
     output_buf.push_back(cProtocol::Payload::ValueEmpty);
 }
@@ -376,6 +491,130 @@ auto Serializer<encoded_variable_t>::serialize_msgpack_map(msgpack::object_map c
     return true;
 }
 
+template <typename encoded_variable_t>
+auto Serializer<encoded_variable_t>::serialize_json_object(simdjson::ondemand::object& json_object
+) -> bool {
+    simdjson::ondemand::object_iterator begin_it;
+    simdjson::ondemand::object_iterator end_it;
+    if (simdjson::SUCCESS != json_object.begin().get(begin_it)
+        || simdjson::SUCCESS != json_object.end().get(end_it))
+    {
+        return false;
+    }
+    if (begin_it == end_it) {
+        serialize_value_empty_object(m_ir_buf);
+        return true;
+    }
+
+    m_schema_tree.take_snapshot();
+    m_schema_tree_node_buf.clear();
+    m_key_group_buf.clear();
+    m_value_group_buf.clear();
+
+    // Traverse the object using DFS iteratively
+    bool failure{false};
+    vector<JsonObjectIterator> dfs_stack;
+    dfs_stack.emplace_back(SchemaTree::cRootId, begin_it, end_it);
+    while (false == dfs_stack.empty()) {
+        auto& curr{dfs_stack.back()};
+        if (false == curr.has_next_child()) {
+            // Visited all children, so pop node
+            dfs_stack.pop_back();
+            continue;
+        }
+
+        JsonObjectIterator::Child field;
+        string_view key;
+        if (false == curr.get_next_child(field)
+            || simdjson::SUCCESS != field.unescaped_key().get(key))
+        {
+            failure = true;
+            break;
+        }
+        auto& val{field.value()};
+
+        // Convert the current value's type to its corresponding schema-tree node type
+        simdjson::ondemand::json_type json_type{};
+        if (simdjson::SUCCESS != val.type().get(json_type)) {
+            failure = true;
+            break;
+        }
+        auto const opt_schema_tree_node_type{get_schema_tree_node_type_from_json_val(val, json_type)
+        };
+        if (false == opt_schema_tree_node_type.has_value()) {
+            failure = true;
+            break;
+        }
+        auto const schema_tree_node_type{opt_schema_tree_node_type.value()};
+
+        SchemaTree::NodeLocator const locator{
+                curr.get_schema_tree_node_id(),
+                key,
+                schema_tree_node_type
+        };
+
+        // Get the schema-tree node that corresponds with the current kv-pair, or add it if it
+        // doesn't exist.
+        auto opt_schema_tree_node_id{m_schema_tree.try_get_node_id(locator)};
+        if (false == opt_schema_tree_node_id.has_value()) {
+            opt_schema_tree_node_id.emplace(m_schema_tree.insert_node(locator));
+            if (false == serialize_schema_tree_node(locator)) {
+                failure = true;
+                break;
+            }
+        }
+        auto const schema_tree_node_id{opt_schema_tree_node_id.value()};
+
+        if (simdjson::ondemand::json_type::object == json_type) {
+            // Serialize object
+            simdjson::ondemand::object inner_object;
+            simdjson::ondemand::object_iterator inner_begin_it;
+            simdjson::ondemand::object_iterator inner_end_it;
+            if (simdjson::SUCCESS != val.get_object().get(inner_object)
+                || simdjson::SUCCESS != inner_object.begin().get(inner_begin_it)
+                || simdjson::SUCCESS != inner_object.end().get(inner_end_it))
+            {
+                failure = true;
+                break;
+            }
+            if (inner_begin_it == inner_end_it) {
+                // Value is an empty object, so we can serialize it immediately
+                if (false == serialize_key(schema_tree_node_id)) {
+                    failure = true;
+                    break;
+                }
+                serialize_value_empty_object(m_value_group_buf);
+            } else {
+                // Add object for DFS iteration
+                dfs_stack.emplace_back(schema_tree_node_id, inner_begin_it, inner_end_it);
+            }
+        } else {
+            // Serialize primitive
+            if (false
+                == (serialize_key(schema_tree_node_id)
+                    && serialize_json_val(val, schema_tree_node_type)))
+            {
+                failure = true;
+                break;
+            }
+        }
+    }
+
+    if (failure) {
+        m_schema_tree.revert();
+        return false;
+    }
+
+    m_ir_buf.insert(
+            m_ir_buf.cend(),
+            m_schema_tree_node_buf.cbegin(),
+            m_schema_tree_node_buf.cend()
+    );
+    m_ir_buf.insert(m_ir_buf.cend(), m_key_group_buf.cbegin(), m_key_group_buf.cend());
+    m_ir_buf.insert(m_ir_buf.cend(), m_value_group_buf.cbegin(), m_value_group_buf.cend());
+    return true;
+}
+
 template <typename encoded_variable_t>
 auto Serializer<encoded_variable_t>::serialize_schema_tree_node(
         SchemaTree::NodeLocator const& locator
@@ -490,6 +729,96 @@ auto Serializer<encoded_variable_t>::serialize_val(
     return true;
 }
 
+template <typename encoded_variable_t>
+auto Serializer<encoded_variable_t>::serialize_json_val(
+        simdjson::ondemand::value& val,
+        SchemaTreeNode::Type schema_tree_node_type
+) -> bool {
+    switch (schema_tree_node_type) {
+        case SchemaTreeNode::Type::Int: {
+            simdjson::ondemand::number_type number_type{};
+            if (simdjson::SUCCESS != val.get_number_type().get(number_type)) {
+                return false;
+            }
+            if (simdjson::ondemand::number_type::unsigned_integer == number_type) {
+                // simdjson only uses this type for integers that don't fit in an `int64_t`
+                return false;
+            }
+            int64_t int_val{};
+            if (simdjson::SUCCESS != val.get_int64().get(int_val)) {
+                return false;
+            }
+            serialize_value_int(int_val, m_value_group_buf);
+            break;
+        }
+
+        case SchemaTreeNode::Type::Float: {
+            double float_val{};
+            if (simdjson::SUCCESS != val.get_double().get(float_val)) {
+                return false;
+            }
+            serialize_value_float(float_val, m_value_group_buf);
+            break;
+        }
+
+        case SchemaTreeNode::Type::Bool: {
+            bool bool_val{};
+            if (simdjson::SUCCESS != val.get_bool().get(bool_val)) {
+                return false;
+            }
+            serialize_value_bool(bool_val, m_value_group_buf);
+            break;
+        }
+
+        case SchemaTreeNode::Type::Str: {
+            string_view str_val;
+            if (simdjson::SUCCESS != val.get_string().get(str_val)
+                || false
+                           == serialize_value_string<encoded_variable_t>(
+                                   str_val,
+                                   m_logtype_buf,
+                                   m_value_group_buf
+                           ))
+            {
+                return false;
+            }
+            break;
+        }
+
+        case SchemaTreeNode::Type::Obj: {
+            bool is_null{false};
+            if (simdjson::SUCCESS != val.is_null().get(is_null) || false == is_null) {
+                return false;
+            }
+            serialize_value_null(m_value_group_buf);
+            break;
+        }
+
+        case SchemaTreeNode::Type::UnstructuredArray: {
+            string_view array_json;
+            if (simdjson::SUCCESS != simdjson::to_json_string(val).get(array_json)) {
+                return false;
+            }
+            m_logtype_buf.clear();
+            if (false
+                == serialize_clp_string<encoded_variable_t>(
+                        array_json,
+                        m_logtype_buf,
+                        m_value_group_buf
+                ))
+            {
+                return false;
+            }
+            break;
+        }
+
+        default:
+            // Unknown schema tree node type
+            return false;
+    }
+    return true;
+}
+
 // Explicitly declare template specializations so that we can define the template methods in this
 // file
 template auto Serializer<eight_byte_encoded_variable_t>::create(
@@ -509,6 +838,13 @@ template auto Serializer<four_byte_encoded_variable_t>::serialize_msgpack_map(
         msgpack::object_map const& msgpack_map
 ) -> bool;
 
+template auto Serializer<eight_byte_encoded_variable_t>::serialize_json_object(
+        simdjson::ondemand::object& json_object
+) -> bool;
+template auto Serializer<four_byte_encoded_variable_t>::serialize_json_object(
+        simdjson::ondemand::object& json_object
+) -> bool;
+
 template auto Serializer<eight_byte_encoded_variable_t>::serialize_schema_tree_node(
         SchemaTree::NodeLocator const& locator
 ) -> bool;
@@ -529,4 +865,13 @@ template auto Serializer<four_byte_encoded_variable_t>::serialize_val(
         msgpack::object const& val,
         SchemaTreeNode::Type schema_tree_node_type
 ) -> bool;
+
+template auto Serializer<eight_byte_encoded_variable_t>::serialize_json_val(
+        simdjson::ondemand::value& val,
+        SchemaTreeNode::Type schema_tree_node_type
+) -> bool;
+template auto Serializer<four_byte_encoded_variable_t>::serialize_json_val(
+        simdjson::ondemand::value& val,
+        SchemaTreeNode::Type schema_tree_node_type
+) -> bool;
 }  // namespace clp::ffi::ir_stream
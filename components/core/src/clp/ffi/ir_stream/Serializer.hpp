@@ -8,6 +8,7 @@
 
 #include <msgpack.hpp>
 #include <outcome/single-header/outcome.hpp>
+#include <simdjson.h>
 
 #include "../../time_types.hpp"
 #include "../SchemaTree.hpp"
@@ -89,6 +90,16 @@ public:
      */
     [[nodiscard]] auto serialize_msgpack_map(msgpack::object_map const& msgpack_map) -> bool;
 
+    /**
+     * Serializes the given JSON object as a key-value pair log event. The object is traversed in a
+     * single pass, so callers can serialize JSON without first converting it into another format.
+     * Schema-tree nodes and values are serialized the same way as in `serialize_msgpack_map`,
+     * except that arrays are serialized using their JSON text as it appears in the input.
+     * @param json_object The object, which will be consumed by this method.
+     * @return Whether serialization succeeded.
+     */
+    [[nodiscard]] auto serialize_json_object(simdjson::ondemand::object& json_object) -> bool;
+
 private:
     // Constructors
     Serializer() = default;
@@ -118,6 +129,17 @@ private:
     [[nodiscard]] auto
     serialize_val(msgpack::object const& val, SchemaTreeNode::Type schema_tree_node_type) -> bool;
 
+    /**
+     * Serializes the given JSON value into `m_value_group_buf`.
+     * @param val
+     * @param schema_tree_node_type The type of the schema tree node that corresponds to `val`.
+     * @return Whether serialization succeeded.
+     */
+    [[nodiscard]] auto serialize_json_val(
+            simdjson::ondemand::value& val,
+            SchemaTreeNode::Type schema_tree_node_type
+    ) -> bool;
+
     UtcOffset m_curr_utc_offset{0};
     Buffer m_ir_buf;
     SchemaTree m_schema_tree;
@@ -0,0 +1,231 @@
+#include "EncodedTextAstMatcher.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <string_utils/WildcardMatcher.hpp>
+
+#include "../../ir/EncodedTextAst.hpp"
+#include "../../ir/parsing.hpp"
+#include "../../ir/types.hpp"
+#include "../../type_utils.hpp"
+#include "../encoding_methods.hpp"
+#include "ExactVariableToken.hpp"
+#include "query_methods.hpp"
+#include "QueryToken.hpp"
+#include "Subquery.hpp"
+#include "WildcardToken.hpp"
+
+using clp::ir::eight_byte_encoded_variable_t;
+using clp::ir::four_byte_encoded_variable_t;
+using clp::ir::VariablePlaceholder;
+using clp::string_utils::WildcardMatcher;
+using std::string;
+using std::string_view;
+using std::vector;
+
+namespace clp::ffi::search {
+namespace {
+/**
+ * Converts a logtype query without wildcards into the encoded logtype it matches exactly. In the
+ * query, escaped wildcards and escape characters are escaped as they are in a wildcard query, while
+ * variable placeholders are escaped as they are in an encoded logtype.
+ * @param logtype_query
+ * @return The encoded logtype
+ */
+auto unescape_logtype_query(string_view logtype_query) -> string;
+
+auto unescape_logtype_query(string_view logtype_query) -> string {
+    auto const escape_char{enum_to_underlying_type(VariablePlaceholder::Escape)};
+    string logtype;
+    logtype.reserve(logtype_query.length());
+    auto const logtype_query_length = logtype_query.length();
+    for (size_t i = 0; i < logtype_query_length; ++i) {
+        auto c = logtype_query[i];
+        if (escape_char == c && i + 1 < logtype_query_length) {
+            c = logtype_query[++i];
+            if (ir::is_variable_placeholder(c)) {
+                logtype += escape_char;
+            }
+        }
+        logtype += c;
+    }
+    return logtype;
+}
+}  // namespace
+
+template <typename encoded_variable_t>
+EncodedTextAstMatcher<encoded_variable_t>::EncodedTextAstMatcher(string_view wildcard_query)
+        : m_query_matcher{wildcard_query} {
+    vector<Subquery<encoded_variable_t>> subqueries;
+    generate_subqueries(wildcard_query, subqueries);
+
+    m_subqueries.reserve(subqueries.size());
+    for (auto const& subquery : subqueries) {
+        auto& compiled_subquery = m_subqueries.emplace_back();
+        compiled_subquery.logtype_query_contains_wildcards
+                = subquery.logtype_query_contains_wildcards();
+        if (compiled_subquery.logtype_query_contains_wildcards) {
+            compiled_subquery.logtype_matcher = WildcardMatcher{subquery.get_logtype_query()};
+            compiled_subquery.requires_verification = true;
+        } else {
+            // Without wildcards, the message's logtype is compared directly with the logtype query,
+            // so it must be in the same (encoded) form
+            compiled_subquery.logtype_query = unescape_logtype_query(subquery.get_logtype_query());
+        }
+
+        for (auto const& query_var : subquery.get_query_vars()) {
+            auto& var = compiled_subquery.vars.emplace_back();
+            std::visit(
+                    overloaded{
+                            [&](ExactVariableToken<encoded_variable_t> const& token) {
+                                var.placeholder = token.get_placeholder();
+                                if (VariablePlaceholder::Dictionary == var.placeholder) {
+                                    // The token has no unescaped wildcards, so this is an exact
+                                    // comparison that also handles escaped characters
+                                    var.matcher = WildcardMatcher{token.get_value()};
+                                } else {
+                                    var.is_encoded = true;
+                                    var.encoded_value = token.get_encoded_value();
+                                }
+                            },
+                            [&](WildcardToken<encoded_variable_t> const& token) {
+                                switch (token.get_current_interpretation()) {
+                                    case TokenType::IntegerVariable:
+                                        var.placeholder = VariablePlaceholder::Integer;
+                                        break;
+                                    case TokenType::FloatVariable:
+                                        var.placeholder = VariablePlaceholder::Float;
+                                        break;
+                                    case TokenType::DictionaryVariable:
+                                    default:
+                                        var.placeholder = VariablePlaceholder::Dictionary;
+                                        break;
+                                }
+                                var.matcher = WildcardMatcher{token.get_value()};
+                                compiled_subquery.requires_verification = true;
+                            }
+                    },
+                    query_var
+            );
+        }
+    }
+}
+
+template <typename encoded_variable_t>
+auto EncodedTextAstMatcher<encoded_variable_t>::matches(
+        ir::EncodedTextAst<encoded_variable_t> const& encoded_text_ast
+) const -> bool {
+    bool requires_verification{false};
+    for (auto const& subquery : m_subqueries) {
+        if (false == matches_subquery(subquery, encoded_text_ast)) {
+            continue;
+        }
+        if (false == subquery.requires_verification) {
+            return true;
+        }
+        requires_verification = true;
+    }
+    if (false == requires_verification) {
+        return false;
+    }
+
+    auto const decoded_message = encoded_text_ast.decode_and_unparse();
+    return decoded_message.has_value() && m_query_matcher.matches(decoded_message.value());
+}
+
+template <typename encoded_variable_t>
+auto EncodedTextAstMatcher<encoded_variable_t>::matches_subquery(
+        CompiledSubquery const& subquery,
+        ir::EncodedTextAst<encoded_variable_t> const& encoded_text_ast
+) -> bool {
+    auto const& logtype = encoded_text_ast.get_logtype();
+    auto const escape_char{enum_to_underlying_type(VariablePlaceholder::Escape)};
+    if (subquery.logtype_query_contains_wildcards) {
+        // A '?' matches one character in the message, but an escaped character takes two in the
+        // logtype, so logtypes with escaped characters can't be filtered with the logtype query.
+        // They're rare enough that such messages are left to be verified after decoding.
+        if (false == subquery.logtype_matcher.matches(logtype)
+            && std::string::npos == logtype.find(escape_char))
+        {
+            return false;
+        }
+    } else if (logtype != subquery.logtype_query) {
+        return false;
+    }
+
+    auto const& vars = subquery.vars;
+    if (vars.empty()) {
+        return true;
+    }
+
+    // Find the query's variables in the message's variables, in order. If the logtype query has no
+    // wildcards, the logtypes are equal, so the message has exactly one variable per query variable
+    // and every variable must match.
+    auto const& encoded_vars = encoded_text_ast.get_encoded_vars();
+    auto const& dict_vars = encoded_text_ast.get_dict_vars();
+    size_t encoded_var_ix{0};
+    size_t dict_var_ix{0};
+    size_t query_var_ix{0};
+    auto const logtype_length = logtype.length();
+    for (size_t i = 0; i < logtype_length; ++i) {
+        auto const c = logtype[i];
+        if (escape_char == c) {
+            ++i;
+            continue;
+        }
+
+        bool is_match{false};
+        auto const& query_var = vars[query_var_ix];
+        if (enum_to_underlying_type(VariablePlaceholder::Integer) == c
+            || enum_to_underlying_type(VariablePlaceholder::Float) == c)
+        {
+            if (encoded_var_ix >= encoded_vars.size()) {
+                return false;
+            }
+            auto const encoded_var = encoded_vars[encoded_var_ix++];
+            if (enum_to_underlying_type(query_var.placeholder) != c) {
+                continue;
+            }
+            if (query_var.is_encoded) {
+                is_match = query_var.encoded_value == encoded_var;
+            } else if (VariablePlaceholder::Integer == query_var.placeholder) {
+                is_match = query_var.matcher.matches(decode_integer_var(encoded_var));
+            } else {
+                is_match = query_var.matcher.matches(decode_float_var(encoded_var));
+            }
+        } else if (enum_to_underlying_type(VariablePlaceholder::Dictionary) == c) {
+            if (dict_var_ix >= dict_vars.size()) {
+                return false;
+            }
+            auto const& dict_var = dict_vars[dict_var_ix++];
+            if (VariablePlaceholder::Dictionary != query_var.placeholder) {
+                continue;
+            }
+            is_match = query_var.matcher.matches(dict_var);
+        } else {
+            continue;
+        }
+
+        if (false == is_match) {
+            if (false == subquery.logtype_query_contains_wildcards) {
+                return false;
+            }
+            continue;
+        }
+        ++query_var_ix;
+        if (vars.size() == query_var_ix) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Explicitly declare specializations to avoid having to validate that the template parameters are
+// supported
+template class EncodedTextAstMatcher<eight_byte_encoded_variable_t>;
+template class EncodedTextAstMatcher<four_byte_encoded_variable_t>;
+}  // namespace clp::ffi::search
@@ -0,0 +1,85 @@
+#ifndef CLP_FFI_SEARCH_ENCODEDTEXTASTMATCHER_HPP
+#define CLP_FFI_SEARCH_ENCODEDTEXTASTMATCHER_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <string_utils/WildcardMatcher.hpp>
+
+#include "../../ir/EncodedTextAst.hpp"
+#include "../../ir/types.hpp"
+
+namespace clp::ffi::search {
+/**
+ * Matches encoded log messages (e.g., from an IR stream) against a wildcard query without decoding
+ * them, except when a match can only be confirmed by comparing the decoded message with the query.
+ * <br/>
+ * The query is translated into subqueries (see `generate_subqueries`) when the matcher is
+ * constructed. A message can only match the query if it matches one of the subqueries, i.e.:
+ * - its logtype matches the subquery's logtype query; and
+ * - the subquery's variables match the message's variables of the same type, in order. Exact
+ *   integer and float variables are compared in their encoded form.
+ * <br/>
+ * If a matching subquery has no wildcards in its logtype query and no variables with wildcards,
+ * the message matches the query exactly. Otherwise, the message is decoded and compared with the
+ * query to verify the match.
+ * @tparam encoded_variable_t The type of encoded variables
+ */
+template <typename encoded_variable_t>
+class EncodedTextAstMatcher {
+public:
+    // Constructors
+    /**
+     * @param wildcard_query A case-sensitive wildcard query which must match an entire message
+     * @throw ffi::search::QueryMethodFailed if the query is empty
+     */
+    explicit EncodedTextAstMatcher(std::string_view wildcard_query);
+
+    // Methods
+    /**
+     * @param encoded_text_ast
+     * @return Whether the given encoded message matches the query
+     */
+    [[nodiscard]] auto matches(ir::EncodedTextAst<encoded_variable_t> const& encoded_text_ast
+    ) const -> bool;
+
+private:
+    // Types
+    struct QueryVariable {
+        ir::VariablePlaceholder placeholder;
+        // Whether `encoded_value` can be compared directly with the message's encoded variable
+        bool is_encoded{false};
+        encoded_variable_t encoded_value{0};
+        // Matcher for the variable's decoded value, used when `is_encoded` is false
+        string_utils::WildcardMatcher matcher;
+    };
+
+    struct CompiledSubquery {
+        // The encoded logtype to compare with, used when `logtype_query_contains_wildcards` is
+        // false
+        std::string logtype_query;
+        bool logtype_query_contains_wildcards{false};
+        string_utils::WildcardMatcher logtype_matcher;
+        std::vector<QueryVariable> vars;
+        bool requires_verification{false};
+    };
+
+    // Methods
+    /**
+     * @param subquery
+     * @param encoded_text_ast
+     * @return Whether the given encoded message matches the subquery
+     */
+    [[nodiscard]] static auto matches_subquery(
+            CompiledSubquery const& subquery,
+            ir::EncodedTextAst<encoded_variable_t> const& encoded_text_ast
+    ) -> bool;
+
+    // Variables
+    std::vector<CompiledSubquery> m_subqueries;
+    string_utils::WildcardMatcher m_query_matcher;
+};
+}  // namespace clp::ffi::search
+
+#endif  // CLP_FFI_SEARCH_ENCODEDTEXTASTMATCHER_HPP
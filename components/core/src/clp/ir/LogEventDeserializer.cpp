@@ -68,6 +68,30 @@ auto LogEventDeserializer<encoded_variable_t>::create(ReaderInterface& reader
     }
 }
 
+template <typename encoded_variable_t>
+auto LogEventDeserializer<encoded_variable_t>::create_from_checkpoint(
+        ReaderInterface& reader,
+        SeekIndex const& seek_index,
+        SeekIndex::Checkpoint const& checkpoint
+) -> OUTCOME_V2_NAMESPACE::std_result<LogEventDeserializer<encoded_variable_t>> {
+    constexpr bool cUsesFourByteEncoding{
+            std::is_same_v<encoded_variable_t, four_byte_encoded_variable_t>
+    };
+    if (cUsesFourByteEncoding != seek_index.uses_four_byte_encoding()) {
+        return std::errc::protocol_not_supported;
+    }
+
+    if constexpr (cUsesFourByteEncoding) {
+        LogEventDeserializer<encoded_variable_t> deserializer{reader, checkpoint.prev_timestamp};
+        deserializer.m_utc_offset = checkpoint.utc_offset;
+        return deserializer;
+    } else {
+        LogEventDeserializer<encoded_variable_t> deserializer{reader};
+        deserializer.m_utc_offset = checkpoint.utc_offset;
+        return deserializer;
+    }
+}
+
 template <typename encoded_variable_t>
 auto LogEventDeserializer<encoded_variable_t>::deserialize_log_event(
 ) -> OUTCOME_V2_NAMESPACE::std_result<LogEvent<encoded_variable_t>> {
@@ -138,6 +162,16 @@ template auto LogEventDeserializer<eight_byte_encoded_variable_t>::create(Reader
 ) -> OUTCOME_V2_NAMESPACE::std_result<LogEventDeserializer<eight_byte_encoded_variable_t>>;
 template auto LogEventDeserializer<four_byte_encoded_variable_t>::create(ReaderInterface& reader
 ) -> OUTCOME_V2_NAMESPACE::std_result<LogEventDeserializer<four_byte_encoded_variable_t>>;
+template auto LogEventDeserializer<eight_byte_encoded_variable_t>::create_from_checkpoint(
+        ReaderInterface& reader,
+        SeekIndex const& seek_index,
+        SeekIndex::Checkpoint const& checkpoint
+) -> OUTCOME_V2_NAMESPACE::std_result<LogEventDeserializer<eight_byte_encoded_variable_t>>;
+template auto LogEventDeserializer<four_byte_encoded_variable_t>::create_from_checkpoint(
+        ReaderInterface& reader,
+        SeekIndex const& seek_index,
+        SeekIndex::Checkpoint const& checkpoint
+) -> OUTCOME_V2_NAMESPACE::std_result<LogEventDeserializer<four_byte_encoded_variable_t>>;
 template auto LogEventDeserializer<eight_byte_encoded_variable_t>::deserialize_log_event(
 ) -> OUTCOME_V2_NAMESPACE::std_result<LogEvent<eight_byte_encoded_variable_t>>;
 template auto LogEventDeserializer<four_byte_encoded_variable_t>::deserialize_log_event(
@@ -11,6 +11,7 @@
 #include "../TraceableException.hpp"
 #include "../type_utils.hpp"
 #include "LogEvent.hpp"
+#include "SeekIndex.hpp"
 #include "types.hpp"
 
 namespace clp::ir {
@@ -37,6 +38,25 @@ public:
     static auto create(ReaderInterface& reader
     ) -> OUTCOME_V2_NAMESPACE::std_result<LogEventDeserializer<encoded_variable_t>>;
 
+    /**
+     * Creates a log event deserializer that resumes deserializing a stream from a checkpoint in its
+     * seek index. The stream's preamble isn't read, so the caller is responsible for ensuring the
+     * stream is valid.
+     * @param reader A reader for the IR stream, positioned at the checkpoint. For a
+     * Zstandard-compressed stream, this can be a decompressor opened on a file reader positioned at
+     * the checkpoint's `compressed_pos`.
+     * @param seek_index The stream's seek index
+     * @param checkpoint A checkpoint from `seek_index`
+     * @return A result containing the deserializer or an error code indicating the failure:
+     * - std::errc::protocol_not_supported if the seek index's encoding doesn't match
+     *   `encoded_variable_t`
+     */
+    static auto create_from_checkpoint(
+            ReaderInterface& reader,
+            SeekIndex const& seek_index,
+            SeekIndex::Checkpoint const& checkpoint
+    ) -> OUTCOME_V2_NAMESPACE::std_result<LogEventDeserializer<encoded_variable_t>>;
+
     // Delete copy constructor and assignment
     LogEventDeserializer(LogEventDeserializer const&) = delete;
     auto operator=(LogEventDeserializer const&) -> LogEventDeserializer& = delete;
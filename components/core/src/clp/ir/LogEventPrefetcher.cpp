@@ -0,0 +1,118 @@
+#include "LogEventPrefetcher.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <outcome/single-header/outcome.hpp>
+
+#include "../ErrorCode.hpp"
+#include "LogEventDeserializer.hpp"
+#include "types.hpp"
+
+namespace clp::ir {
+template <typename encoded_variable_t>
+LogEventPrefetcher<encoded_variable_t>::LogEventPrefetcher(
+        LogEventDeserializer<encoded_variable_t>& deserializer,
+        size_t batch_size,
+        size_t max_num_buffered_batches
+)
+        : m_deserializer{deserializer},
+          m_batch_size{batch_size},
+          m_max_num_buffered_batches{max_num_buffered_batches} {
+    if (0 == m_batch_size || 0 == m_max_num_buffered_batches) {
+        throw OperationFailed(ErrorCode_BadParam, __FILENAME__, __LINE__);
+    }
+    m_thread = std::thread(&LogEventPrefetcher::prefetch, this);
+}
+
+template <typename encoded_variable_t>
+LogEventPrefetcher<encoded_variable_t>::~LogEventPrefetcher() {
+    {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        m_should_stop = true;
+    }
+    m_prefetcher_cv.notify_one();
+    m_thread.join();
+}
+
+template <typename encoded_variable_t>
+auto LogEventPrefetcher<encoded_variable_t>::take_batch(
+) -> OUTCOME_V2_NAMESPACE::std_result<Batch> {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_reader_cv.wait(lock, [this] {
+        return false == m_buffered_batches.empty() || m_is_prefetching_done;
+    });
+    if (m_buffered_batches.empty()) {
+        if (nullptr != m_exception) {
+            std::rethrow_exception(m_exception);
+        }
+        return m_error_code;
+    }
+
+    auto batch = std::move(m_buffered_batches.front());
+    m_buffered_batches.pop_front();
+    lock.unlock();
+    m_prefetcher_cv.notify_one();
+    return batch;
+}
+
+template <typename encoded_variable_t>
+auto LogEventPrefetcher<encoded_variable_t>::prefetch() -> void {
+    std::error_code error_code{};
+    std::exception_ptr exception;
+    try {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_prefetcher_cv.wait(lock, [this] {
+                    return m_should_stop || m_buffered_batches.size() < m_max_num_buffered_batches;
+                });
+                if (m_should_stop) {
+                    break;
+                }
+            }
+
+            Batch batch;
+            batch.reserve(m_batch_size);
+            while (batch.size() < m_batch_size) {
+                auto result = m_deserializer.deserialize_log_event();
+                if (result.has_error()) {
+                    error_code = result.error();
+                    break;
+                }
+                batch.emplace_back(std::move(result.value()));
+            }
+
+            if (false == batch.empty()) {
+                {
+                    std::lock_guard<std::mutex> const lock(m_mutex);
+                    m_buffered_batches.emplace_back(std::move(batch));
+                }
+                m_reader_cv.notify_one();
+            }
+            if (error_code) {
+                break;
+            }
+        }
+    } catch (...) {
+        exception = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        m_error_code = error_code;
+        m_exception = std::move(exception);
+        m_is_prefetching_done = true;
+    }
+    m_reader_cv.notify_one();
+}
+
+// Explicitly declare template specializations so that we can define the template methods in this
+// file
+template class LogEventPrefetcher<eight_byte_encoded_variable_t>;
+template class LogEventPrefetcher<four_byte_encoded_variable_t>;
+}  // namespace clp::ir
@@ -0,0 +1,109 @@
+#ifndef CLP_IR_LOGEVENTPREFETCHER_HPP
+#define CLP_IR_LOGEVENTPREFETCHER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <outcome/single-header/outcome.hpp>
+
+#include "../TraceableException.hpp"
+#include "LogEvent.hpp"
+#include "LogEventDeserializer.hpp"
+
+namespace clp::ir {
+/**
+ * Deserializes log events from an IR stream on a background thread, in batches, so that the caller
+ * can process one batch (e.g., encode it into an archive) while the next is being read and
+ * deserialized. At most a fixed number of batches are buffered at once, bounding the memory used by
+ * prefetching.
+ *
+ * NOTE: The deserializer (and its reader) must only be used by the prefetcher for its lifetime.
+ * @tparam encoded_variable_t Type of encoded variables in the stream
+ */
+template <typename encoded_variable_t>
+class LogEventPrefetcher {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        // Methods
+        [[nodiscard]] auto what() const noexcept -> char const* override {
+            return "clp::ir::LogEventPrefetcher operation failed";
+        }
+    };
+
+    using Batch = std::vector<LogEvent<encoded_variable_t>>;
+
+    // Constructors
+    /**
+     * Starts prefetching log events from the given deserializer
+     * @param deserializer
+     * @param batch_size The maximum number of log events in each batch
+     * @param max_num_buffered_batches
+     * @throw OperationFailed if batch_size or max_num_buffered_batches is 0
+     */
+    LogEventPrefetcher(
+            LogEventDeserializer<encoded_variable_t>& deserializer,
+            size_t batch_size,
+            size_t max_num_buffered_batches
+    );
+
+    // Destructor
+    ~LogEventPrefetcher();
+
+    // Explicitly disable copy and move constructor/assignment
+    LogEventPrefetcher(LogEventPrefetcher const&) = delete;
+    auto operator=(LogEventPrefetcher const&) -> LogEventPrefetcher& = delete;
+    LogEventPrefetcher(LogEventPrefetcher&&) = delete;
+    auto operator=(LogEventPrefetcher&&) -> LogEventPrefetcher& = delete;
+
+    // Methods
+    /**
+     * Waits for and takes the next batch of log events. Batches are returned in stream order and
+     * are never empty. Once every batch has been taken, the error that ended prefetching is
+     * returned.
+     * @return A result containing the batch or an error code indicating the failure:
+     * - std::errc::no_message_available on reaching the end of the IR stream
+     * - Same as `LogEventDeserializer::deserialize_log_event` if deserialization failed
+     * @throw Any exception thrown by the deserializer while prefetching
+     */
+    [[nodiscard]] auto take_batch() -> OUTCOME_V2_NAMESPACE::std_result<Batch>;
+
+private:
+    // Methods
+    /**
+     * Deserializes batches of log events until the end of the stream or an error, blocking
+     * whenever the buffer is full
+     */
+    auto prefetch() -> void;
+
+    // Variables
+    LogEventDeserializer<encoded_variable_t>& m_deserializer;
+    size_t m_batch_size;
+    size_t m_max_num_buffered_batches;
+
+    std::mutex m_mutex;
+    std::condition_variable m_prefetcher_cv;
+    std::condition_variable m_reader_cv;
+    std::deque<Batch> m_buffered_batches;
+    bool m_is_prefetching_done{false};
+    bool m_should_stop{false};
+    // Why prefetching ended; only valid once m_is_prefetching_done is true
+    std::error_code m_error_code;
+    std::exception_ptr m_exception;
+
+    std::thread m_thread;
+};
+}  // namespace clp::ir
+
+#endif  // CLP_IR_LOGEVENTPREFETCHER_HPP
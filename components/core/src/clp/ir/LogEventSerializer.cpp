@@ -11,6 +11,9 @@
 #include "../ffi/ir_stream/protocol_constants.hpp"
 #include "../ir/types.hpp"
 #include "../type_utils.hpp"
+#include "../WriterInterface.hpp"
+#include "constants.hpp"
+#include "SeekIndex.hpp"
 
 using std::string;
 using std::string_view;
@@ -25,48 +28,37 @@ LogEventSerializer<encoded_variable_t>::~LogEventSerializer() {
 }
 
 template <typename encoded_variable_t>
-auto LogEventSerializer<encoded_variable_t>::open(string const& file_path) -> bool {
+auto LogEventSerializer<encoded_variable_t>::open(
+        string const& file_path,
+        size_t seek_index_checkpoint_interval
+) -> bool {
     if (m_is_open) {
         throw OperationFailed(ErrorCode_NotReady, __FILENAME__, __LINE__);
     }
 
-    m_serialized_size = 0;
-    m_num_log_events = 0;
-    m_ir_buf.clear();
-
-    m_writer.open(file_path, FileWriter::OpenMode::CREATE_FOR_WRITING);
-    m_zstd_compressor.open(m_writer);
-
-    bool res{};
-    if constexpr (std::is_same_v<encoded_variable_t, four_byte_encoded_variable_t>) {
-        m_prev_event_timestamp = 0;
-        res = ffi::ir_stream::four_byte_encoding::serialize_preamble(
-                cTimestampPattern,
-                cTimestampPatternSyntax,
-                cTimezoneID,
-                m_prev_event_timestamp,
-                m_ir_buf
-        );
-    } else {
-        res = clp::ffi::ir_stream::eight_byte_encoding::serialize_preamble(
-                cTimestampPattern,
-                cTimestampPatternSyntax,
-                cTimezoneID,
-                m_ir_buf
-        );
-    }
-
-    if (false == res) {
-        close_writer();
+    m_file_writer.open(file_path, FileWriter::OpenMode::CREATE_FOR_WRITING);
+    m_writer = &m_file_writer;
+    if (false == open_stream(seek_index_checkpoint_interval)) {
         return false;
     }
+    if (m_seek_index.has_value()) {
+        m_seek_index_path = file_path;
+        m_seek_index_path += cSeekIndexFileExtension;
+    }
+    return true;
+}
 
-    m_is_open = true;
-
-    // Flush the preamble
-    flush();
+template <typename encoded_variable_t>
+auto LogEventSerializer<encoded_variable_t>::open(
+        WriterInterface& writer,
+        size_t seek_index_checkpoint_interval
+) -> bool {
+    if (m_is_open) {
+        throw OperationFailed(ErrorCode_NotReady, __FILENAME__, __LINE__);
+    }
 
-    return true;
+    m_writer = &writer;
+    return open_stream(seek_index_checkpoint_interval);
 }
 
 template <typename encoded_variable_t>
@@ -90,6 +82,12 @@ auto LogEventSerializer<encoded_variable_t>::close() -> void {
     flush();
     close_writer();
     m_is_open = false;
+
+    // Seek indexes for streams on other writers are kept for `get_seek_index`
+    if (m_seek_index.has_value() && false == m_seek_index_path.empty()) {
+        m_seek_index->write_to_file(m_seek_index_path);
+        m_seek_index.reset();
+    }
 }
 
 template <typename encoded_variable_t>
@@ -101,6 +99,15 @@ auto LogEventSerializer<encoded_variable_t>::serialize_log_event(
         throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
     }
 
+    // NOTE: We compare against the number of checkpoints rather than checking the remainder so that
+    // retrying a log event that failed to serialize doesn't add a duplicate checkpoint.
+    if (m_seek_index.has_value()
+        && m_seek_index->get_checkpoints().size() * m_seek_index->get_checkpoint_interval()
+                   == m_num_log_events)
+    {
+        add_seek_index_checkpoint(timestamp);
+    }
+
     string logtype;
     bool res{};
     auto const buf_size_before_serialization = m_ir_buf.size();
@@ -129,19 +136,102 @@ auto LogEventSerializer<encoded_variable_t>::serialize_log_event(
     return true;
 }
 
+template <typename encoded_variable_t>
+auto LogEventSerializer<encoded_variable_t>::open_stream(size_t seek_index_checkpoint_interval
+) -> bool {
+    m_serialized_size = 0;
+    m_num_log_events = 0;
+    m_ir_buf.clear();
+
+    m_seek_index.reset();
+    m_seek_index_path.clear();
+    if (0 != seek_index_checkpoint_interval) {
+        m_seek_index.emplace(
+                std::is_same_v<encoded_variable_t, four_byte_encoded_variable_t>,
+                seek_index_checkpoint_interval
+        );
+    }
+
+    m_zstd_compressor.open(*m_writer);
+
+    bool res{};
+    if constexpr (std::is_same_v<encoded_variable_t, four_byte_encoded_variable_t>) {
+        m_prev_event_timestamp = 0;
+        res = ffi::ir_stream::four_byte_encoding::serialize_preamble(
+                cTimestampPattern,
+                cTimestampPatternSyntax,
+                cTimezoneID,
+                m_prev_event_timestamp,
+                m_ir_buf
+        );
+    } else {
+        res = clp::ffi::ir_stream::eight_byte_encoding::serialize_preamble(
+                cTimestampPattern,
+                cTimestampPatternSyntax,
+                cTimezoneID,
+                m_ir_buf
+        );
+    }
+
+    if (false == res) {
+        close_writer();
+        return false;
+    }
+
+    m_is_open = true;
+
+    // Flush the preamble
+    flush();
+
+    return true;
+}
+
 template <typename encoded_variable_t>
 auto LogEventSerializer<encoded_variable_t>::close_writer() -> void {
     m_zstd_compressor.close();
-    m_writer.close();
+    if (&m_file_writer == m_writer) {
+        m_file_writer.close();
+    }
+    m_writer = nullptr;
+}
+
+template <typename encoded_variable_t>
+auto LogEventSerializer<encoded_variable_t>::add_seek_index_checkpoint(epoch_time_ms_t timestamp
+) -> void {
+    flush();
+    m_zstd_compressor.flush();
+
+    SeekIndex::Checkpoint checkpoint;
+    checkpoint.log_event_ix = m_num_log_events;
+    checkpoint.compressed_pos = m_writer->get_pos();
+    checkpoint.uncompressed_pos = m_zstd_compressor.get_pos();
+    checkpoint.timestamp = timestamp;
+    if constexpr (std::is_same_v<encoded_variable_t, four_byte_encoded_variable_t>) {
+        checkpoint.prev_timestamp = m_prev_event_timestamp;
+    }
+    // The serializer never changes the UTC offset, so it's always the default
+    m_seek_index->add_checkpoint(checkpoint);
 }
 
 // Explicitly declare template specializations so that we can define the template methods in this
 // file
 template LogEventSerializer<eight_byte_encoded_variable_t>::~LogEventSerializer();
 template LogEventSerializer<four_byte_encoded_variable_t>::~LogEventSerializer();
-template auto LogEventSerializer<eight_byte_encoded_variable_t>::open(string const& file_path
+template auto LogEventSerializer<eight_byte_encoded_variable_t>::open(
+        string const& file_path,
+        size_t seek_index_checkpoint_interval
+) -> bool;
+template auto LogEventSerializer<four_byte_encoded_variable_t>::open(
+        string const& file_path,
+        size_t seek_index_checkpoint_interval
+) -> bool;
+template auto LogEventSerializer<eight_byte_encoded_variable_t>::open(
+        WriterInterface& writer,
+        size_t seek_index_checkpoint_interval
 ) -> bool;
-template auto LogEventSerializer<four_byte_encoded_variable_t>::open(string const& file_path
+template auto LogEventSerializer<four_byte_encoded_variable_t>::open(
+        WriterInterface& writer,
+        size_t seek_index_checkpoint_interval
 ) -> bool;
 template auto LogEventSerializer<eight_byte_encoded_variable_t>::flush() -> void;
 template auto LogEventSerializer<four_byte_encoded_variable_t>::flush() -> void;
@@ -157,4 +247,10 @@ template auto LogEventSerializer<four_byte_encoded_variable_t>::serialize_log_ev
 ) -> bool;
 template auto LogEventSerializer<eight_byte_encoded_variable_t>::close_writer() -> void;
 template auto LogEventSerializer<four_byte_encoded_variable_t>::close_writer() -> void;
+template auto LogEventSerializer<eight_byte_encoded_variable_t>::add_seek_index_checkpoint(
+        epoch_time_ms_t timestamp
+) -> void;
+template auto LogEventSerializer<four_byte_encoded_variable_t>::add_seek_index_checkpoint(
+        epoch_time_ms_t timestamp
+) -> void;
 }  // namespace clp::ir
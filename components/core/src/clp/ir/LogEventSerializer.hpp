@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -13,6 +14,8 @@
 #include "../streaming_compression/zstd/Compressor.hpp"
 #include "../TraceableException.hpp"
 #include "../type_utils.hpp"
+#include "../WriterInterface.hpp"
+#include "SeekIndex.hpp"
 #include "types.hpp"
 
 namespace clp::ir {
@@ -20,6 +23,12 @@ namespace clp::ir {
  * Class for serializing log events into a Zstandard-compressed IR stream. The serializer first
  * buffers the serialized data into an internal buffer, and only flushes the buffered IR to disk
  * when `flush` or `close` is called.
+ * <br/>
+ * The serializer can optionally write a seek index (see `ir::SeekIndex`) next to the IR file,
+ * ending a Zstandard frame at each of the index's checkpoints.
+ * <br/>
+ * Instead of a file, the serializer can also write the IR stream to any `WriterInterface` (e.g., an
+ * in-memory buffer).
  */
 template <typename encoded_variable_t>
 class LogEventSerializer {
@@ -53,13 +62,31 @@ public:
     /**
      * Creates a Zstandard-compressed IR file on disk, and writes the IR file's preamble.
      * @param file_path
+     * @param seek_index_checkpoint_interval Number of log events between the checkpoints of the
+     * seek index written to `file_path + ir::cSeekIndexFileExtension` when the file is closed, or 0
+     * to not write a seek index
      * @return true on success, false if serializing the preamble fails
      * @throw FileWriter::OperationFailed if the FileWriter fails to open the file specified by
      * file_path
      * @throw streaming_compression::zstd::Compressor if the Zstandard compressor couldn't be opened
      * @throw ir::LogEventSerializer::OperationFailed if an IR file is already open
      */
-    [[nodiscard]] auto open(std::string const& file_path) -> bool;
+    [[nodiscard]] auto
+    open(std::string const& file_path, size_t seek_index_checkpoint_interval = 0) -> bool;
+
+    /**
+     * Starts a Zstandard-compressed IR stream on the given writer (e.g., an in-memory buffer), and
+     * writes the stream's preamble.
+     * @param writer A writer that must remain valid until the stream is closed
+     * @param seek_index_checkpoint_interval Number of log events between the checkpoints of the
+     * seek index built for the stream, or 0 to not build a seek index. Rather than being written to
+     * a file, the seek index is available through `get_seek_index` once the stream is closed.
+     * @return true on success, false if serializing the preamble fails
+     * @throw streaming_compression::zstd::Compressor if the Zstandard compressor couldn't be opened
+     * @throw ir::LogEventSerializer::OperationFailed if an IR stream is already open
+     */
+    [[nodiscard]] auto open(WriterInterface& writer, size_t seek_index_checkpoint_interval = 0)
+            -> bool;
 
     /**
      * Flushes any buffered data.
@@ -68,7 +95,9 @@ public:
     auto flush() -> void;
 
     /**
-     * Serializes the EoF tag, flushes the buffer, and closes the current IR stream.
+     * Serializes the EoF tag, flushes the buffer, and closes the current IR stream. If a seek index
+     * was requested for an IR file, it's written as well.
+     * @throw FileWriter::OperationFailed if the seek index couldn't be written
      * @throw ir::LogEventSerializer::OperationFailed if no IR file is open
      */
     auto close() -> void;
@@ -83,6 +112,14 @@ public:
      */
     [[nodiscard]] auto get_num_log_events() const -> size_t { return m_num_log_events; }
 
+    /**
+     * @return The seek index of the last stream opened on a writer, once the stream is closed, or
+     * std::nullopt if no seek index was requested
+     */
+    [[nodiscard]] auto get_seek_index() const -> std::optional<SeekIndex> const& {
+        return m_seek_index;
+    }
+
     /**
      * Serializes the given log event.
      * @return Whether the log event was successfully serialized.
@@ -104,11 +141,25 @@ private:
     static constexpr std::string_view cTimezoneID{"UTC"};
 
     // Methods
+    /**
+     * Resets the serializer's state, opens the compressor on m_writer, and writes the preamble.
+     * @param seek_index_checkpoint_interval
+     * @return Whether the preamble was serialized successfully
+     */
+    [[nodiscard]] auto open_stream(size_t seek_index_checkpoint_interval) -> bool;
+
     /**
      * Closes the member compressor and file writer in the proper order.
      */
     auto close_writer() -> void;
 
+    /**
+     * Adds a seek index checkpoint before the next log event, ending the current Zstandard frame so
+     * that decompression can start at the checkpoint.
+     * @param timestamp Timestamp of the next log event
+     */
+    auto add_seek_index_checkpoint(epoch_time_ms_t timestamp) -> void;
+
     // Variables
     size_t m_num_log_events{0};
     size_t m_serialized_size{0};  // Bytes
@@ -119,9 +170,14 @@ private:
             EmptyType> m_prev_event_timestamp{};
 
     std::vector<int8_t> m_ir_buf;
-    FileWriter m_writer;
+    FileWriter m_file_writer;
+    // Either m_file_writer or a writer given to `open`
+    WriterInterface* m_writer{nullptr};
     streaming_compression::zstd::Compressor m_zstd_compressor;
 
+    std::optional<SeekIndex> m_seek_index;
+    std::string m_seek_index_path;
+
     bool m_is_open{false};
 };
 }  // namespace clp::ir
@@ -0,0 +1,129 @@
+#include "SeekIndex.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "../Defs.h"
+#include "../ErrorCode.hpp"
+#include "../FileReader.hpp"
+#include "../FileWriter.hpp"
+#include "../time_types.hpp"
+#include "types.hpp"
+
+namespace clp::ir {
+namespace {
+constexpr std::array<char, 8> cMagicNumber{'C', 'L', 'P', 'I', 'R', 'I', 'D', 'X'};
+constexpr uint8_t cFormatVersion{1};
+}  // namespace
+
+SeekIndex::SeekIndex(bool uses_four_byte_encoding, size_t checkpoint_interval)
+        : m_uses_four_byte_encoding{uses_four_byte_encoding},
+          m_checkpoint_interval{checkpoint_interval} {
+    if (0 == m_checkpoint_interval) {
+        throw OperationFailed(ErrorCode_BadParam, __FILENAME__, __LINE__);
+    }
+}
+
+auto SeekIndex::read_from_file(std::string const& path) -> SeekIndex {
+    FileReader file_reader{path};
+
+    std::array<char, cMagicNumber.size()> magic_number{};
+    file_reader.read_exact_length(magic_number.data(), magic_number.size(), false);
+    if (magic_number != cMagicNumber) {
+        throw OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
+    }
+    uint8_t format_version{};
+    file_reader.read_numeric_value(format_version, false);
+    if (cFormatVersion != format_version) {
+        throw OperationFailed(ErrorCode_Unsupported, __FILENAME__, __LINE__);
+    }
+
+    uint8_t uses_four_byte_encoding{};
+    file_reader.read_numeric_value(uses_four_byte_encoding, false);
+    uint64_t checkpoint_interval{};
+    file_reader.read_numeric_value(checkpoint_interval, false);
+    uint64_t num_checkpoints{};
+    file_reader.read_numeric_value(num_checkpoints, false);
+    if (0 == checkpoint_interval) {
+        throw OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
+    }
+
+    SeekIndex seek_index{0 != uses_four_byte_encoding, checkpoint_interval};
+    seek_index.m_checkpoints.reserve(num_checkpoints);
+    for (uint64_t i = 0; i < num_checkpoints; ++i) {
+        Checkpoint checkpoint;
+        file_reader.read_numeric_value(checkpoint.log_event_ix, false);
+        file_reader.read_numeric_value(checkpoint.compressed_pos, false);
+        file_reader.read_numeric_value(checkpoint.uncompressed_pos, false);
+        file_reader.read_numeric_value(checkpoint.timestamp, false);
+        file_reader.read_numeric_value(checkpoint.prev_timestamp, false);
+        int64_t utc_offset{};
+        file_reader.read_numeric_value(utc_offset, false);
+        checkpoint.utc_offset = UtcOffset{utc_offset};
+        seek_index.add_checkpoint(checkpoint);
+    }
+    return seek_index;
+}
+
+auto SeekIndex::write_to_file(std::string const& path) const -> void {
+    FileWriter file_writer;
+    file_writer.open(path, FileWriter::OpenMode::CREATE_FOR_WRITING);
+
+    file_writer.write(cMagicNumber.data(), cMagicNumber.size());
+    file_writer.write_numeric_value(cFormatVersion);
+    file_writer.write_numeric_value(static_cast<uint8_t>(m_uses_four_byte_encoding));
+    file_writer.write_numeric_value(static_cast<uint64_t>(m_checkpoint_interval));
+    file_writer.write_numeric_value(static_cast<uint64_t>(m_checkpoints.size()));
+    for (auto const& checkpoint : m_checkpoints) {
+        file_writer.write_numeric_value(checkpoint.log_event_ix);
+        file_writer.write_numeric_value(checkpoint.compressed_pos);
+        file_writer.write_numeric_value(checkpoint.uncompressed_pos);
+        file_writer.write_numeric_value(checkpoint.timestamp);
+        file_writer.write_numeric_value(checkpoint.prev_timestamp);
+        file_writer.write_numeric_value(static_cast<int64_t>(checkpoint.utc_offset.count()));
+    }
+
+    file_writer.close();
+}
+
+auto SeekIndex::add_checkpoint(Checkpoint const& checkpoint) -> void {
+    // Checkpoints must be evenly spaced so that a log event's checkpoint can be computed directly
+    if (m_checkpoints.size() * m_checkpoint_interval != checkpoint.log_event_ix) {
+        throw OperationFailed(ErrorCode_BadParam, __FILENAME__, __LINE__);
+    }
+    m_checkpoints.push_back(checkpoint);
+}
+
+auto SeekIndex::get_checkpoint_for_log_event_ix(size_t log_event_ix
+) const -> std::optional<Checkpoint> {
+    if (m_checkpoints.empty()) {
+        return std::nullopt;
+    }
+    auto const checkpoint_ix
+            = std::min(log_event_ix / m_checkpoint_interval, m_checkpoints.size() - 1);
+    return m_checkpoints[checkpoint_ix];
+}
+
+auto SeekIndex::get_checkpoint_for_timestamp(epoch_time_ms_t timestamp
+) const -> std::optional<Checkpoint> {
+    if (m_checkpoints.empty()) {
+        return std::nullopt;
+    }
+    auto const it = std::upper_bound(
+            m_checkpoints.cbegin(),
+            m_checkpoints.cend(),
+            timestamp,
+            [](epoch_time_ms_t ts, Checkpoint const& checkpoint) {
+                return ts < checkpoint.timestamp;
+            }
+    );
+    if (m_checkpoints.cbegin() == it) {
+        return m_checkpoints.front();
+    }
+    return *(it - 1);
+}
+}  // namespace clp::ir
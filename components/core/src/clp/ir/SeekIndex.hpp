@@ -0,0 +1,130 @@
+#ifndef CLP_IR_SEEKINDEX_HPP
+#define CLP_IR_SEEKINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../ErrorCode.hpp"
+#include "../time_types.hpp"
+#include "../TraceableException.hpp"
+#include "types.hpp"
+
+namespace clp::ir {
+/**
+ * An index of checkpoints in a Zstandard-compressed IR stream, stored in a sidecar file next to the
+ * stream. A checkpoint is taken every `checkpoint_interval` log events and records where the log
+ * event starts in both the compressed and decompressed stream, along with the deserializer state
+ * needed to resume decoding from it.
+ * <br/>
+ * The IR stream's writer ends a Zstandard frame at each checkpoint, so a reader can seek the
+ * compressed file directly to a checkpoint and start a new decompressor there, without
+ * decompressing anything that precedes it.
+ * <br/>
+ * The sidecar's layout is a fixed-size header followed by fixed-size checkpoints, all in the
+ * machine's native byte order.
+ */
+class SeekIndex {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        // Methods
+        [[nodiscard]] auto what() const noexcept -> char const* override {
+            return "clp::ir::SeekIndex operation failed";
+        }
+    };
+
+    struct Checkpoint {
+        // Index of the first log event after the checkpoint
+        uint64_t log_event_ix{0};
+        // Position of the checkpoint in the compressed stream (i.e., the start of a Zstandard
+        // frame)
+        uint64_t compressed_pos{0};
+        // Position of the checkpoint in the decompressed IR stream
+        uint64_t uncompressed_pos{0};
+        // Timestamp of the first log event after the checkpoint
+        epoch_time_ms_t timestamp{0};
+        // Timestamp of the last log event before the checkpoint (or the stream's reference
+        // timestamp if there's no such event), which four-byte-encoded streams encode timestamps
+        // relative to
+        epoch_time_ms_t prev_timestamp{0};
+        // UTC offset in effect at the checkpoint
+        UtcOffset utc_offset{0};
+    };
+
+    // Constructors
+    /**
+     * @param uses_four_byte_encoding Whether the indexed IR stream uses the four-byte encoding
+     * @param checkpoint_interval Number of log events between consecutive checkpoints
+     * @throw ir::SeekIndex::OperationFailed if checkpoint_interval is 0
+     */
+    SeekIndex(bool uses_four_byte_encoding, size_t checkpoint_interval);
+
+    // Methods
+    /**
+     * Reads a seek index from the given sidecar file
+     * @param path
+     * @return The seek index
+     * @throw FileReader::OperationFailed on open or read failure
+     * @throw ir::SeekIndex::OperationFailed if the file isn't a valid seek index
+     */
+    [[nodiscard]] static auto read_from_file(std::string const& path) -> SeekIndex;
+
+    /**
+     * Writes the seek index to the given sidecar file, replacing any existing file
+     * @param path
+     * @throw FileWriter::OperationFailed on open or write failure
+     */
+    auto write_to_file(std::string const& path) const -> void;
+
+    /**
+     * Adds a checkpoint to the end of the index
+     * @param checkpoint
+     * @throw ir::SeekIndex::OperationFailed if the checkpoint isn't at the next multiple of the
+     * checkpoint interval
+     */
+    auto add_checkpoint(Checkpoint const& checkpoint) -> void;
+
+    [[nodiscard]] auto uses_four_byte_encoding() const -> bool { return m_uses_four_byte_encoding; }
+
+    [[nodiscard]] auto get_checkpoint_interval() const -> size_t { return m_checkpoint_interval; }
+
+    [[nodiscard]] auto get_checkpoints() const -> std::vector<Checkpoint> const& {
+        return m_checkpoints;
+    }
+
+    /**
+     * @param log_event_ix
+     * @return The last checkpoint at or before the given log event, or std::nullopt if the index
+     * is empty
+     */
+    [[nodiscard]] auto get_checkpoint_for_log_event_ix(size_t log_event_ix
+    ) const -> std::optional<Checkpoint>;
+
+    /**
+     * Gets the last checkpoint whose first log event's timestamp is at or before the given
+     * timestamp. NOTE: This assumes the stream's log events are ordered by timestamp; otherwise,
+     * the checkpoint returned is only a hint.
+     * @param timestamp
+     * @return The checkpoint, or the first checkpoint if every checkpoint is after the given
+     * timestamp, or std::nullopt if the index is empty
+     */
+    [[nodiscard]] auto get_checkpoint_for_timestamp(epoch_time_ms_t timestamp
+    ) const -> std::optional<Checkpoint>;
+
+private:
+    // Variables
+    bool m_uses_four_byte_encoding;
+    size_t m_checkpoint_interval;
+    std::vector<Checkpoint> m_checkpoints;
+};
+}  // namespace clp::ir
+
+#endif  // CLP_IR_SEEKINDEX_HPP
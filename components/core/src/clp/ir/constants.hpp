@@ -5,6 +5,8 @@
 
 namespace clp::ir {
 constexpr std::string_view cIrFileExtension{".clp.zst"};
+// Appended to an IR file's path to get the path of its seek index
+constexpr std::string_view cSeekIndexFileExtension{".idx"};
 }  // namespace clp::ir
 
 #endif  // CLP_IR_CONSTANTS_HPP
@@ -1,5 +1,15 @@
 #include "parsing.hpp"
 
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
 #include <string_utils/string_utils.hpp>
 
 #include "../type_utils.hpp"
@@ -9,6 +19,191 @@ using std::string;
 using std::string_view;
 
 namespace clp::ir {
+namespace {
+#if defined(__AVX2__) || defined(__SSE2__)
+/**
+ * Bitmasks classifying each character in a block of a string, where bit i corresponds to the i-th
+ * character in the block
+ */
+struct BlockMasks {
+    uint32_t non_delim;
+    uint32_t decimal_digit;
+    uint32_t alphabet;
+};
+
+    #if defined(__AVX2__)
+constexpr size_t cBlockSize = 32;
+using Block = __m256i;
+
+inline Block load_block(char const* block) {
+    return _mm256_loadu_si256(reinterpret_cast<Block const*>(block));
+}
+
+inline Block broadcast(char c) {
+    return _mm256_set1_epi8(c);
+}
+
+inline Block is_equal(Block chars, char c) {
+    return _mm256_cmpeq_epi8(chars, broadcast(c));
+}
+
+inline Block is_greater(Block lhs, Block rhs) {
+    return _mm256_cmpgt_epi8(lhs, rhs);
+}
+
+inline Block bitwise_or(Block lhs, Block rhs) {
+    return _mm256_or_si256(lhs, rhs);
+}
+
+inline Block bitwise_and(Block lhs, Block rhs) {
+    return _mm256_and_si256(lhs, rhs);
+}
+
+inline uint32_t to_bitmask(Block block) {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(block));
+}
+    #else
+constexpr size_t cBlockSize = 16;
+using Block = __m128i;
+
+inline Block load_block(char const* block) {
+    return _mm_loadu_si128(reinterpret_cast<Block const*>(block));
+}
+
+inline Block broadcast(char c) {
+    return _mm_set1_epi8(c);
+}
+
+inline Block is_equal(Block chars, char c) {
+    return _mm_cmpeq_epi8(chars, broadcast(c));
+}
+
+inline Block is_greater(Block lhs, Block rhs) {
+    return _mm_cmpgt_epi8(lhs, rhs);
+}
+
+inline Block bitwise_or(Block lhs, Block rhs) {
+    return _mm_or_si128(lhs, rhs);
+}
+
+inline Block bitwise_and(Block lhs, Block rhs) {
+    return _mm_and_si128(lhs, rhs);
+}
+
+inline uint32_t to_bitmask(Block block) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(block));
+}
+    #endif
+
+/**
+ * NOTE: The comparisons are signed, so characters outside the ASCII range are never within the
+ * given range, matching `is_delim`'s treatment of them as delimiters.
+ * @param chars
+ * @param lower_bound
+ * @param upper_bound
+ * @return A mask of the characters in the inclusive range [lower_bound, upper_bound]
+ */
+inline Block is_in_range(Block chars, char lower_bound, char upper_bound) {
+    return bitwise_and(
+            is_greater(chars, broadcast(static_cast<char>(lower_bound - 1))),
+            is_greater(broadcast(static_cast<char>(upper_bound + 1)), chars)
+    );
+}
+
+/**
+ * Classifies every character in the given block using the same character classes as `is_delim`,
+ * `string_utils::is_decimal_digit`, and `string_utils::is_alphabet`
+ * @param block Pointer to `cBlockSize` characters
+ * @return The block's masks
+ */
+inline BlockMasks classify_block(char const* block) {
+    auto const chars = load_block(block);
+
+    auto const decimal_digit = is_in_range(chars, '0', '9');
+    auto const alphabet = bitwise_or(is_in_range(chars, 'A', 'Z'), is_in_range(chars, 'a', 'z'));
+    auto const other_non_delim = bitwise_or(
+            bitwise_or(is_equal(chars, '+'), is_in_range(chars, '-', '.')),
+            bitwise_or(is_equal(chars, '\\'), is_equal(chars, '_'))
+    );
+
+    return {to_bitmask(bitwise_or(bitwise_or(decimal_digit, alphabet), other_non_delim)),
+            to_bitmask(decimal_digit),
+            to_bitmask(alphabet)};
+}
+
+constexpr uint32_t cBlockBitmask = static_cast<uint32_t>((uint64_t{1} << cBlockSize) - 1);
+#endif
+
+/**
+ * @param str
+ * @param pos
+ * @return The position of the first non-delimiter in `str` at or after `pos`, or the length of
+ * `str` if there's none
+ */
+size_t find_next_non_delim(string_view const str, size_t pos) {
+    auto const str_length = str.length();
+#if defined(__AVX2__) || defined(__SSE2__)
+    for (; pos + cBlockSize <= str_length; pos += cBlockSize) {
+        auto const masks = classify_block(str.data() + pos);
+        if (0 != masks.non_delim) {
+            return pos + std::countr_zero(masks.non_delim);
+        }
+    }
+#endif
+    for (; pos < str_length; ++pos) {
+        if (false == is_delim(str[pos])) {
+            break;
+        }
+    }
+    return pos;
+}
+
+/**
+ * @param str
+ * @param pos
+ * @param contains_decimal_digit Set to true if the characters between `pos` and the returned
+ * position contain a decimal digit
+ * @param contains_alphabet Set to true if the characters between `pos` and the returned position
+ * contain an alphabet
+ * @return The position of the first delimiter in `str` at or after `pos`, or the length of `str`
+ * if there's none
+ */
+size_t find_next_delim(
+        string_view const str,
+        size_t pos,
+        bool& contains_decimal_digit,
+        bool& contains_alphabet
+) {
+    auto const str_length = str.length();
+#if defined(__AVX2__) || defined(__SSE2__)
+    for (; pos + cBlockSize <= str_length; pos += cBlockSize) {
+        auto const masks = classify_block(str.data() + pos);
+        auto const delims = ~masks.non_delim & cBlockBitmask;
+        if (0 != delims) {
+            auto const token_length = std::countr_zero(delims);
+            auto const token_bitmask = (uint32_t{1} << token_length) - 1;
+            contains_decimal_digit |= (0 != (masks.decimal_digit & token_bitmask));
+            contains_alphabet |= (0 != (masks.alphabet & token_bitmask));
+            return pos + token_length;
+        }
+        contains_decimal_digit |= (0 != masks.decimal_digit);
+        contains_alphabet |= (0 != masks.alphabet);
+    }
+#endif
+    for (; pos < str_length; ++pos) {
+        auto const c = str[pos];
+        if (string_utils::is_decimal_digit(c)) {
+            contains_decimal_digit = true;
+        } else if (string_utils::is_alphabet(c)) {
+            contains_alphabet = true;
+        } else if (is_delim(c)) {
+            break;
+        }
+    }
+    return pos;
+}
+}  // namespace
+
 /*
  * For performance, we rely on the ASCII ordering of characters to compare ranges of characters at a
  * time instead of comparing individual characters
@@ -43,15 +238,7 @@ bool get_bounds_of_next_var(string_view const str, size_t& begin_pos, size_t& en
     }
 
     while (true) {
-        begin_pos = end_pos;
-
-        // Find next non-delimiter
-        for (; begin_pos < msg_length; ++begin_pos) {
-            auto c = str[begin_pos];
-            if (false == is_delim(c)) {
-                break;
-            }
-        }
+        begin_pos = find_next_non_delim(str, end_pos);
         if (msg_length == begin_pos) {
             // Early exit for performance
             return false;
@@ -59,19 +246,7 @@ bool get_bounds_of_next_var(string_view const str, size_t& begin_pos, size_t& en
 
         bool contains_decimal_digit = false;
         bool contains_alphabet = false;
-
-        // Find next delimiter
-        end_pos = begin_pos;
-        for (; end_pos < msg_length; ++end_pos) {
-            auto c = str[end_pos];
-            if (string_utils::is_decimal_digit(c)) {
-                contains_decimal_digit = true;
-            } else if (string_utils::is_alphabet(c)) {
-                contains_alphabet = true;
-            } else if (is_delim(c)) {
-                break;
-            }
-        }
+        end_pos = find_next_delim(str, begin_pos, contains_decimal_digit, contains_alphabet);
 
         auto variable = str.substr(begin_pos, end_pos - begin_pos);
         // Treat token as variable if:
@@ -1,3 +1,4 @@
+#include <memory>
 #include <set>
 #include <string>
 
@@ -10,6 +11,7 @@
 #include "../LogTypeDictionaryReader.hpp"
 #include "../spdlog_with_specializations.hpp"
 #include "../streaming_archive/Constants.hpp"
+#include "../streaming_compression/zstd/Dictionary.hpp"
 #include "../type_utils.hpp"
 #include "../VariableDictionaryReader.hpp"
 #include "CommandLineArguments.hpp"
@@ -48,13 +50,29 @@ int main(int argc, char const* argv[]) {
     FileWriter file_writer;
     FileWriter index_writer;
 
+    // Load the zstd dictionary that the archive was compressed with, if any
+    std::unique_ptr<clp::streaming_compression::zstd::Dictionary> zstd_dictionary;
+    auto zstd_dictionary_path = boost::filesystem::path(command_line_args.get_archive_path())
+                                / clp::streaming_archive::cZstdDictionaryFileName;
+    if (boost::filesystem::exists(zstd_dictionary_path)) {
+        zstd_dictionary = std::make_unique<clp::streaming_compression::zstd::Dictionary>(
+                clp::streaming_compression::zstd::Dictionary::read_content_from_file(
+                        zstd_dictionary_path.string()
+                )
+        );
+    }
+
     // Open log-type dictionary
     auto logtype_dict_path = boost::filesystem::path(command_line_args.get_archive_path())
                              / clp::streaming_archive::cLogTypeDictFilename;
     auto logtype_segment_index_path = boost::filesystem::path(command_line_args.get_archive_path())
                                       / clp::streaming_archive::cLogTypeSegmentIndexFilename;
     clp::LogTypeDictionaryReader logtype_dict;
-    logtype_dict.open(logtype_dict_path.string(), logtype_segment_index_path.string());
+    logtype_dict.open(
+            logtype_dict_path.string(),
+            logtype_segment_index_path.string(),
+            zstd_dictionary.get()
+    );
     logtype_dict.read_new_entries();
 
     // Write readable dictionary
@@ -138,7 +156,7 @@ int main(int argc, char const* argv[]) {
     auto var_segment_index_path = boost::filesystem::path(command_line_args.get_archive_path())
                                   / clp::streaming_archive::cVarSegmentIndexFilename;
     clp::VariableDictionaryReader var_dict;
-    var_dict.open(var_dict_path.string(), var_segment_index_path.string());
+    var_dict.open(var_dict_path.string(), var_segment_index_path.string(), zstd_dictionary.get());
     var_dict.read_new_entries();
 
     // Write readable dictionary
@@ -19,7 +19,8 @@ ArchiveMetadata::ArchiveMetadata(
     m_compressed_size += sizeof(m_archive_format_version) + sizeof(m_creator_id_len)
                          + m_creator_id.length() + sizeof(m_creation_idx)
                          + sizeof(m_uncompressed_size) + sizeof(m_begin_timestamp)
-                         + sizeof(m_end_timestamp) + sizeof(m_compressed_size);
+                         + sizeof(m_end_timestamp) + sizeof(m_compressed_size)
+                         + sizeof(m_zstd_dictionary_id);
 }
 
 ArchiveMetadata::ArchiveMetadata(FileReader& file_reader) {
@@ -31,6 +32,11 @@ ArchiveMetadata::ArchiveMetadata(FileReader& file_reader) {
     file_reader.read_numeric_value(m_compressed_size, false);
     file_reader.read_numeric_value(m_begin_timestamp, false);
     file_reader.read_numeric_value(m_end_timestamp, false);
+    // Archives of older formats don't store a zstd dictionary ID. They're left for the caller to
+    // reject after checking the format version, rather than failing here with a truncated read.
+    if (cArchiveFormatVersion == m_archive_format_version) {
+        file_reader.read_numeric_value(m_zstd_dictionary_id, false);
+    }
 }
 
 void ArchiveMetadata::expand_time_range(epochtime_t begin_timestamp, epochtime_t end_timestamp) {
@@ -51,5 +57,6 @@ void ArchiveMetadata::write_to_file(FileWriter& file_writer) const {
     file_writer.write_numeric_value(m_compressed_size + m_dynamic_uncompressed_size);
     file_writer.write_numeric_value(m_begin_timestamp);
     file_writer.write_numeric_value(m_end_timestamp);
+    file_writer.write_numeric_value(m_zstd_dictionary_id);
 }
 }  // namespace clp::streaming_archive
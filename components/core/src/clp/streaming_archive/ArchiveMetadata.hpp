@@ -41,7 +41,9 @@ public:
     );
 
     /**
-     * Constructs a metadata object and initializes it from the given file reader
+     * Constructs a metadata object and initializes it from the given file reader. Fields that the
+     * archive's format version doesn't have are left at their defaults, so callers must check the
+     * version before using them.
      * @param file_reader
      */
     explicit ArchiveMetadata(FileReader& file_reader);
@@ -75,6 +77,16 @@ public:
         m_dynamic_compressed_size = size_bytes;
     }
 
+    /**
+     * @return The ID of the zstd dictionary that the archive was compressed with, or 0 if it was
+     * compressed without one
+     */
+    [[nodiscard]] auto get_zstd_dictionary_id() const { return m_zstd_dictionary_id; }
+
+    void set_zstd_dictionary_id(uint32_t zstd_dictionary_id) {
+        m_zstd_dictionary_id = zstd_dictionary_id;
+    }
+
     [[nodiscard]] auto get_begin_timestamp() const { return m_begin_timestamp; }
 
     [[nodiscard]] auto get_end_timestamp() const { return m_end_timestamp; }
@@ -102,6 +114,7 @@ private:
     // The size of the archive
     uint64_t m_compressed_size{0};
     uint64_t m_dynamic_compressed_size{0};
+    uint32_t m_zstd_dictionary_id{0};
 };
 }  // namespace clp::streaming_archive
 
@@ -4,16 +4,25 @@
 #include "../Defs.h"
 
 namespace clp::streaming_archive {
-constexpr archive_format_version_t cArchiveFormatVersion = cArchiveFormatDevVersionFlag | 9;
+constexpr archive_format_version_t cArchiveFormatVersion = cArchiveFormatDevVersionFlag | 10;
 constexpr char cSegmentsDirname[] = "s";
 constexpr char cSegmentListFilename[] = "segment_list.txt";
+// Segments are compressed as a sequence of independently decompressible frames, each containing
+// roughly this many uncompressed bytes, followed by a seek table locating each frame
+constexpr uint64_t cSegmentFrameTargetUncompressedSize = 4 * 1024 * 1024;  // 4 MiB
+constexpr uint32_t cSegmentSeekTableMagicNumber = 0x4b455353;  // "SSEK"
+// Each segment's logtype index is stored next to the segment, named using the segment's ID
+constexpr char cSegmentLogtypeIndexFileExtension[] = ".ltindex";
 constexpr char cLogTypeDictFilename[] = "logtype.dict";
 constexpr char cVarDictFilename[] = "var.dict";
 constexpr char cLogTypeSegmentIndexFilename[] = "logtype.segindex";
 constexpr char cVarSegmentIndexFilename[] = "var.segindex";
+constexpr char cNonDictVarSegmentIndexFilename[] = "nondictvar.segindex";
 constexpr char cMetadataFileName[] = "metadata";
 constexpr char cMetadataDBFileName[] = "metadata.db";
 constexpr char cSchemaFileName[] = "schema.txt";
+// The zstd dictionary that the archive's dictionaries and segments were compressed with, if any
+constexpr char cZstdDictionaryFileName[] = "zstd.dict";
 
 namespace cMetadataDB {
 constexpr char ArchivesTableName[] = "archives";
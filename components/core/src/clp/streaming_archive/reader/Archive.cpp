@@ -36,10 +36,12 @@ void Archive::open(string const& path) {
     // Read the metadata file
     string metadata_file_path = path + '/' + cMetadataFileName;
     archive_format_version_t format_version{};
+    uint32_t zstd_dictionary_id{0};
     try {
         FileReader file_reader{metadata_file_path};
         ArchiveMetadata const metadata{file_reader};
         format_version = metadata.get_archive_format_version();
+        zstd_dictionary_id = metadata.get_zstd_dictionary_id();
     } catch (TraceableException& traceable_exception) {
         auto error_code = traceable_exception.get_error_code();
         if (ErrorCode_errno == error_code) {
@@ -80,6 +82,24 @@ void Archive::open(string const& path) {
     }
     m_metadata_db.open(metadata_db_path.string());
 
+    // Load the zstd dictionary that the archive was compressed with, if any
+    if (0 != zstd_dictionary_id) {
+        m_zstd_dictionary = std::make_unique<streaming_compression::zstd::Dictionary>(
+                streaming_compression::zstd::Dictionary::read_content_from_file(
+                        m_path + '/' + cZstdDictionaryFileName
+                )
+        );
+        if (m_zstd_dictionary->get_id() != zstd_dictionary_id) {
+            SPDLOG_ERROR(
+                    "streaming_archive::reader::Archive: zstd dictionary ID {} doesn't match the "
+                    "archive's {}",
+                    m_zstd_dictionary->get_id(),
+                    zstd_dictionary_id
+            );
+            throw OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
+        }
+    }
+
     // Open log-type dictionary
     string logtype_dict_path = m_path;
     logtype_dict_path += '/';
@@ -87,7 +107,8 @@ void Archive::open(string const& path) {
     string logtype_segment_index_path = m_path;
     logtype_segment_index_path += '/';
     logtype_segment_index_path += cLogTypeSegmentIndexFilename;
-    m_logtype_dictionary.open(logtype_dict_path, logtype_segment_index_path);
+    m_logtype_dictionary
+            .open(logtype_dict_path, logtype_segment_index_path, m_zstd_dictionary.get());
 
     // Open variables dictionary
     string var_dict_path = m_path;
@@ -96,14 +117,14 @@ void Archive::open(string const& path) {
     string var_segment_index_path = m_path;
     var_segment_index_path += '/';
     var_segment_index_path += cVarSegmentIndexFilename;
-    m_var_dictionary.open(var_dict_path, var_segment_index_path);
+    m_var_dictionary.open(var_dict_path, var_segment_index_path, m_zstd_dictionary.get());
 
     // Open segment manager
     m_segments_dir_path = m_path;
     m_segments_dir_path += '/';
     m_segments_dir_path += cSegmentsDirname;
     m_segments_dir_path += '/';
-    m_segment_manager.open(m_segments_dir_path);
+    m_segment_manager.open(m_segments_dir_path, m_zstd_dictionary.get());
 
     // Open segment list
     string segment_list_path = m_segments_dir_path;
@@ -113,19 +134,54 @@ void Archive::open(string const& path) {
 void Archive::close() {
     m_logtype_dictionary.close();
     m_var_dictionary.close();
+    m_non_dict_var_segment_index.clear();
     m_segment_manager.close();
+    m_segment_logtype_index = SegmentLogtypeIndex{};
     m_segments_dir_path.clear();
     m_metadata_db.close();
+    m_zstd_dictionary.reset();
     m_path.clear();
 }
 
 void Archive::refresh_dictionaries() {
     m_logtype_dictionary.read_new_entries();
     m_var_dictionary.read_new_entries();
+
+    string non_dict_var_segment_index_path = m_path;
+    non_dict_var_segment_index_path += '/';
+    non_dict_var_segment_index_path += cNonDictVarSegmentIndexFilename;
+    m_non_dict_var_segment_index.read(non_dict_var_segment_index_path);
 }
 
 ErrorCode Archive::open_file(File& file, MetadataDB::FileIterator const& file_metadata_ix) {
-    return file.open_me(m_logtype_dictionary, file_metadata_ix, m_segment_manager);
+    auto const* logtype_index = get_file_logtype_index(
+            file_metadata_ix.get_segment_id(),
+            file_metadata_ix.get_segment_logtypes_pos()
+    );
+    return file.open_me(m_logtype_dictionary, file_metadata_ix, m_segment_manager, logtype_index);
+}
+
+bool Archive::file_may_match_query(MetadataDB::FileIterator const& file_metadata_ix, Query& query) {
+    if (false == query.contains_sub_queries()) {
+        return true;
+    }
+
+    auto const segment_id = file_metadata_ix.get_segment_id();
+    auto const* logtype_index
+            = get_file_logtype_index(segment_id, file_metadata_ix.get_segment_logtypes_pos());
+    if (nullptr == logtype_index) {
+        return true;
+    }
+
+    query.make_sub_queries_relevant_to_segment(segment_id);
+    for (auto const* sub_query : query.get_relevant_sub_queries()) {
+        for (auto const& [logtype_id, msg_ixs] : *logtype_index) {
+            if (sub_query->matches_logtype(logtype_id)) {
+                return true;
+            }
+        }
+    }
+    return false;
 }
 
 void Archive::close_file(File& file) {
@@ -157,6 +213,18 @@ SubQuery const* Archive::find_message_matching_query(File& file, Query const& qu
     return file.find_message_matching_query(query, msg);
 }
 
+SegmentLogtypeIndex::FileIndex const*
+Archive::get_file_logtype_index(segment_id_t segment_id, uint64_t segment_logtypes_pos) {
+    if (cInvalidSegmentId == segment_id) {
+        return nullptr;
+    }
+    if (m_segment_logtype_index.get_segment_id() != segment_id) {
+        // Segments without a logtype index are searched without one
+        m_segment_logtype_index.try_load(m_segments_dir_path, segment_id);
+    }
+    return m_segment_logtype_index.get_file_index(segment_logtypes_pos);
+}
+
 bool Archive::get_next_message(File& file, Message& msg) {
     return file.get_next_message(msg);
 }
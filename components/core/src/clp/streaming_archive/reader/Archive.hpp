@@ -10,12 +10,15 @@
 
 #include "../../ErrorCode.hpp"
 #include "../../LogTypeDictionaryReader.hpp"
+#include "../../NonDictVarSegmentIndexReader.hpp"
 #include "../../Query.hpp"
 #include "../../SQLiteDB.hpp"
+#include "../../streaming_compression/zstd/Dictionary.hpp"
 #include "../../VariableDictionaryReader.hpp"
 #include "../MetadataDB.hpp"
 #include "File.hpp"
 #include "Message.hpp"
+#include "SegmentLogtypeIndex.hpp"
 
 namespace clp::streaming_archive::reader {
 class Archive {
@@ -45,13 +48,18 @@ public:
     void close();
 
     /**
-     * Reads any new entries added to the dictionaries
+     * Reads any new entries added to the dictionaries and the segment indexes
      * @throw Same as LogTypeDictionary::read_from_file and VariableDictionary::read_from_file
+     * @throw Same as NonDictVarSegmentIndexReader::read
      */
     void refresh_dictionaries();
     LogTypeDictionaryReader const& get_logtype_dictionary() const;
     VariableDictionaryReader const& get_var_dictionary() const;
 
+    NonDictVarSegmentIndexReader const& get_non_dict_var_segment_index() const {
+        return m_non_dict_var_segment_index;
+    }
+
     /**
      * Opens file with given path
      * @param file
@@ -59,6 +67,16 @@ public:
      * @return Same as streaming_archive::reader::File::open_me
      */
     ErrorCode open_file(File& file, MetadataDB::FileIterator const& file_metadata_ix);
+    /**
+     * Uses the logtype index of the given file's segment, if it has one, to check whether the file
+     * may contain messages matching the given query, without opening the file
+     * @param file_metadata_ix
+     * @param query
+     * @return false if none of the file's logtypes match any of the query's sub-queries relevant
+     * to the file's segment, true otherwise
+     * @throw Same as streaming_archive::reader::SegmentLogtypeIndex::try_load
+     */
+    bool file_may_match_query(MetadataDB::FileIterator const& file_metadata_ix, Query& query);
     /**
      * Wrapper for streaming_archive::reader::File::close_me
      * @param file
@@ -186,14 +204,30 @@ public:
     }
 
 private:
+    // Methods
+    /**
+     * Gets the logtype index of a file, loading its segment's logtype index if necessary
+     * @param segment_id
+     * @param segment_logtypes_pos
+     * @return The file's logtype index, or nullptr if the file isn't indexed
+     * @throw Same as streaming_archive::reader::SegmentLogtypeIndex::try_load
+     */
+    SegmentLogtypeIndex::FileIndex const*
+    get_file_logtype_index(segment_id_t segment_id, uint64_t segment_logtypes_pos);
+
     // Variables
     std::string m_id;
     std::string m_path;
     std::string m_segments_dir_path;
+    // The zstd dictionary that the archive's dictionaries and segments were compressed with
+    std::unique_ptr<streaming_compression::zstd::Dictionary> m_zstd_dictionary;
     LogTypeDictionaryReader m_logtype_dictionary;
     VariableDictionaryReader m_var_dictionary;
+    NonDictVarSegmentIndexReader m_non_dict_var_segment_index;
 
     SegmentManager m_segment_manager;
+    // Logtype index of the segment that was last searched
+    SegmentLogtypeIndex m_segment_logtype_index;
 
     MetadataDB m_metadata_db;
 };
@@ -3,6 +3,8 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
+
 #include "../../EncodedVariableInterpreter.hpp"
 #include "../../spdlog_with_specializations.hpp"
 #include "../Constants.hpp"
@@ -22,9 +24,12 @@ epochtime_t File::get_end_ts() const {
 ErrorCode File::open_me(
         LogTypeDictionaryReader const& archive_logtype_dict,
         MetadataDB::FileIterator const& file_metadata_ix,
-        SegmentManager& segment_manager
+        SegmentManager& segment_manager,
+        SegmentLogtypeIndex::FileIndex const* logtype_index
 ) {
     m_archive_logtype_dict = &archive_logtype_dict;
+    m_logtype_index = logtype_index;
+    m_candidate_msgs_query = nullptr;
 
     // Populate metadata from database document
     file_metadata_ix.get_id(m_id_as_string);
@@ -173,11 +178,16 @@ void File::close_me() {
     m_orig_path.clear();
 
     m_archive_logtype_dict = nullptr;
+
+    m_logtype_index = nullptr;
+    m_candidate_msgs_query = nullptr;
+    m_candidate_msg_ixs.clear();
 }
 
 void File::reset_indices() {
     m_msgs_ix = 0;
     m_variables_ix = 0;
+    m_candidate_msgs_query = nullptr;
 }
 
 string const& File::get_orig_path() const {
@@ -250,20 +260,81 @@ bool File::find_message_in_time_range(
 }
 
 SubQuery const* File::find_message_matching_query(Query const& query, Message& msg) {
+    if (nullptr != m_logtype_index) {
+        return find_indexed_message_matching_query(query, msg);
+    }
+
     SubQuery const* matching_sub_query = nullptr;
     while (m_msgs_ix < m_num_messages && nullptr == matching_sub_query) {
-        auto logtype_id = m_logtypes[m_msgs_ix];
+        matching_sub_query = match_current_message(query, msg);
+    }
 
-        // Get number of variables in logtype
-        auto const& logtype_dictionary_entry = m_archive_logtype_dict->get_entry(logtype_id);
-        auto const num_vars = logtype_dictionary_entry.get_num_variables();
+    return matching_sub_query;
+}
+
+SubQuery const* File::find_indexed_message_matching_query(Query const& query, Message& msg) {
+    if (&query != m_candidate_msgs_query) {
+        // Gather the messages whose logtypes match any relevant sub-query
+        auto const& relevant_sub_queries = query.get_relevant_sub_queries();
+        m_candidate_msg_ixs.clear();
+        for (auto const& [logtype_id, msg_ixs] : *m_logtype_index) {
+            if (std::any_of(
+                        relevant_sub_queries.cbegin(),
+                        relevant_sub_queries.cend(),
+                        [logtype_id](SubQuery const* sub_query) {
+                            return sub_query->matches_logtype(logtype_id);
+                        }
+                ))
+            {
+                m_candidate_msg_ixs.insert(
+                        m_candidate_msg_ixs.end(),
+                        msg_ixs.cbegin(),
+                        msg_ixs.cend()
+                );
+            }
+        }
+        std::sort(m_candidate_msg_ixs.begin(), m_candidate_msg_ixs.end());
+        m_next_candidate_msg_ix = 0;
+        m_candidate_msgs_query = &query;
+    }
 
-        auto const vars_end_ix{m_variables_ix + num_vars};
-        auto const timestamp{m_timestamps[m_msgs_ix]};
-        if (false == query.timestamp_is_in_search_time_range(timestamp)) {
+    while (m_next_candidate_msg_ix < m_candidate_msg_ixs.size()) {
+        auto const candidate_msg_ix = m_candidate_msg_ixs[m_next_candidate_msg_ix++];
+        if (candidate_msg_ix >= m_num_messages) {
+            throw OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
+        }
+        if (candidate_msg_ix < m_msgs_ix) {
             continue;
         }
 
+        // Skip to the candidate message
+        for (; m_msgs_ix < candidate_msg_ix; ++m_msgs_ix) {
+            auto const& logtype_dictionary_entry
+                    = m_archive_logtype_dict->get_entry(m_logtypes[m_msgs_ix]);
+            m_variables_ix += logtype_dictionary_entry.get_num_variables();
+        }
+
+        auto const* matching_sub_query = match_current_message(query, msg);
+        if (nullptr != matching_sub_query) {
+            return matching_sub_query;
+        }
+    }
+
+    return nullptr;
+}
+
+SubQuery const* File::match_current_message(Query const& query, Message& msg) {
+    auto logtype_id = m_logtypes[m_msgs_ix];
+
+    // Get number of variables in logtype
+    auto const& logtype_dictionary_entry = m_archive_logtype_dict->get_entry(logtype_id);
+    auto const num_vars = logtype_dictionary_entry.get_num_variables();
+
+    auto const vars_end_ix{m_variables_ix + num_vars};
+    auto const timestamp{m_timestamps[m_msgs_ix]};
+
+    SubQuery const* matching_sub_query = nullptr;
+    if (query.timestamp_is_in_search_time_range(timestamp)) {
         for (auto const* sub_query : query.get_relevant_sub_queries()) {
             if (false == sub_query->matches_logtype(logtype_id)) {
                 continue;
@@ -283,12 +354,12 @@ SubQuery const* File::find_message_matching_query(Query const& query, Message& m
             matching_sub_query = sub_query;
             break;
         }
-
-        // Advance indices
-        ++m_msgs_ix;
-        m_variables_ix += num_vars;
     }
 
+    // Advance indices
+    ++m_msgs_ix;
+    m_variables_ix = vars_end_ix;
+
     return matching_sub_query;
 }
 
@@ -12,6 +12,7 @@
 #include "../../TimestampPattern.hpp"
 #include "../MetadataDB.hpp"
 #include "Message.hpp"
+#include "SegmentLogtypeIndex.hpp"
 #include "SegmentManager.hpp"
 
 namespace clp::streaming_archive::reader {
@@ -77,13 +78,15 @@ private:
      * @param archive_logtype_dict
      * @param file_metadata_ix
      * @param segment_manager
+     * @param logtype_index The file's logtype index, or nullptr if the file isn't indexed
      * @return Same as SegmentManager::try_read
      * @return ErrorCode_Success on success
      */
     ErrorCode open_me(
             LogTypeDictionaryReader const& archive_logtype_dict,
             MetadataDB::FileIterator const& file_metadata_ix,
-            SegmentManager& segment_manager
+            SegmentManager& segment_manager,
+            SegmentLogtypeIndex::FileIndex const* logtype_index
     );
     /**
      * Closes the file
@@ -120,6 +123,22 @@ private:
      * @return pointer to matching subquery otherwise
      */
     SubQuery const* find_message_matching_query(Query const& query, Message& msg);
+    /**
+     * Finds message matching the given query using the file's logtype index, only visiting
+     * messages whose logtypes match one of the query's relevant sub-queries
+     * @param query
+     * @param msg
+     * @return Same as find_message_matching_query
+     */
+    SubQuery const* find_indexed_message_matching_query(Query const& query, Message& msg);
+    /**
+     * Finds the first sub-query matching the current message, then advances to the next message
+     * @param query
+     * @param msg
+     * @return nullptr if no sub-query matched
+     * @return pointer to matching subquery otherwise
+     */
+    SubQuery const* match_current_message(Query const& query, Message& msg);
     /**
      * Get next message in file
      * @param msg
@@ -162,6 +181,12 @@ private:
 
     size_t m_split_ix;
     bool m_is_split;
+
+    SegmentLogtypeIndex::FileIndex const* m_logtype_index{nullptr};
+    // Indices of the messages that may match m_candidate_msgs_query, in ascending order
+    Query const* m_candidate_msgs_query{nullptr};
+    std::vector<uint64_t> m_candidate_msg_ixs;
+    size_t m_next_candidate_msg_ix{0};
 };
 }  // namespace clp::streaming_archive::reader
 
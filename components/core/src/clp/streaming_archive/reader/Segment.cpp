@@ -3,9 +3,13 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <climits>
+#include <cstring>
+#include <limits>
 
 #include <boost/filesystem.hpp>
+#include <zstd.h>
 
 #include "../../FileReader.hpp"
 #include "../../spdlog_with_specializations.hpp"
@@ -22,7 +26,11 @@ Segment::~Segment() {
     close();
 }
 
-ErrorCode Segment::try_open(string const& segment_dir_path, segment_id_t segment_id) {
+ErrorCode Segment::try_open(
+        string const& segment_dir_path,
+        segment_id_t segment_id,
+        [[maybe_unused]] streaming_compression::zstd::Dictionary const* zstd_dictionary
+) {
     // Construct segment path
     string segment_path = segment_dir_path;
     segment_path += std::to_string(segment_id);
@@ -73,9 +81,17 @@ ErrorCode Segment::try_open(string const& segment_dir_path, segment_id_t segment
         return ErrorCode_Failure;
     }
 
-    m_decompressor.open(m_memory_mapped_segment_file.data(), segment_file_size);
-
     m_segment_path = segment_path;
+
+#if USE_ZSTD_COMPRESSION
+    m_frames_compressed_size = load_seek_table(segment_file_size);
+    m_stream_begin_pos = 0;
+    m_next_read_pos = 0;
+    m_decompressor.set_dictionary(zstd_dictionary);
+    m_decompressor.open(m_memory_mapped_segment_file.data(), m_frames_compressed_size);
+#else
+    m_decompressor.open(m_memory_mapped_segment_file.data(), segment_file_size);
+#endif
     return ErrorCode_Success;
 }
 
@@ -84,6 +100,9 @@ void Segment::close() {
         m_decompressor.close();
         m_memory_mapped_segment_file.close();
         m_segment_path.clear();
+#if USE_ZSTD_COMPRESSION
+        m_frames.clear();
+#endif
     }
 }
 
@@ -96,10 +115,121 @@ Segment::try_read(uint64_t decompressed_stream_pos, char* extraction_buf, uint64
                      "during decompression");
         return ErrorCode_BadParam;
     }
+
+#if USE_ZSTD_COMPRESSION
+    if (false == m_frames.empty()) {
+        // Keep decompressing the current stream if the content is ahead of it in the same frame;
+        // otherwise, restart the stream from the beginning of the content's frame
+        auto const frame_ix = get_frame_ix(decompressed_stream_pos);
+        if (decompressed_stream_pos < m_next_read_pos || get_frame_ix(m_next_read_pos) != frame_ix)
+        {
+            auto const& frame = m_frames[frame_ix];
+            m_decompressor.close();
+            m_decompressor.open(
+                    m_memory_mapped_segment_file.data() + frame.compressed_offset,
+                    m_frames_compressed_size - frame.compressed_offset
+            );
+            m_stream_begin_pos = frame.uncompressed_offset;
+        }
+
+        auto const error_code = m_decompressor.get_decompressed_stream_region(
+                decompressed_stream_pos - m_stream_begin_pos,
+                extraction_buf,
+                extraction_len
+        );
+        if (ErrorCode_Success == error_code) {
+            m_next_read_pos = decompressed_stream_pos + extraction_len;
+        } else {
+            // Force the stream to be restarted on the next read
+            m_next_read_pos = std::numeric_limits<uint64_t>::max();
+        }
+        return error_code;
+    }
+#endif
+
     return m_decompressor.get_decompressed_stream_region(
             decompressed_stream_pos,
             extraction_buf,
             extraction_len
     );
 }
+
+#if USE_ZSTD_COMPRESSION
+size_t Segment::load_seek_table(size_t segment_file_size) {
+    m_frames.clear();
+
+    constexpr size_t cSkippableFrameHeaderSize = 2 * sizeof(uint32_t);
+    constexpr size_t cFooterSize = sizeof(uint64_t) + sizeof(uint32_t);
+    if (segment_file_size < cSkippableFrameHeaderSize + cFooterSize) {
+        return segment_file_size;
+    }
+
+    auto const* segment_data = m_memory_mapped_segment_file.data();
+    auto const* footer = segment_data + segment_file_size - cFooterSize;
+    uint32_t magic_number{};
+    memcpy(&magic_number, footer + sizeof(uint64_t), sizeof(magic_number));
+    if (cSegmentSeekTableMagicNumber != magic_number) {
+        // Segment was written without a seek table
+        return segment_file_size;
+    }
+
+    uint64_t num_frames{};
+    memcpy(&num_frames, footer, sizeof(num_frames));
+    constexpr size_t cFrameEntrySize = 2 * sizeof(uint64_t);
+    if (num_frames
+        > (segment_file_size - cSkippableFrameHeaderSize - cFooterSize) / cFrameEntrySize)
+    {
+        SPDLOG_WARN(
+                "streaming_archive::reader::Segment: Ignoring corrupt seek table in {}",
+                m_segment_path.c_str()
+        );
+        return segment_file_size;
+    }
+    auto const seek_table_size = num_frames * cFrameEntrySize + cFooterSize;
+    auto const frames_compressed_size
+            = segment_file_size - seek_table_size - cSkippableFrameHeaderSize;
+
+    m_frames.reserve(num_frames);
+    auto const* frame_entry = segment_data + frames_compressed_size + cSkippableFrameHeaderSize;
+    size_t compressed_offset{0};
+    uint64_t uncompressed_offset{0};
+    for (uint64_t i = 0; i < num_frames; ++i) {
+        m_frames.push_back({compressed_offset, uncompressed_offset});
+
+        uint64_t compressed_size{};
+        uint64_t uncompressed_size{};
+        memcpy(&compressed_size, frame_entry, sizeof(compressed_size));
+        memcpy(
+                &uncompressed_size,
+                frame_entry + sizeof(compressed_size),
+                sizeof(uncompressed_size)
+        );
+        frame_entry += cFrameEntrySize;
+
+        compressed_offset += compressed_size;
+        uncompressed_offset += uncompressed_size;
+    }
+    if (compressed_offset != frames_compressed_size) {
+        SPDLOG_WARN(
+                "streaming_archive::reader::Segment: Ignoring corrupt seek table in {}",
+                m_segment_path.c_str()
+        );
+        m_frames.clear();
+        return segment_file_size;
+    }
+
+    return frames_compressed_size;
+}
+
+size_t Segment::get_frame_ix(uint64_t decompressed_stream_pos) const {
+    // The first frame begins at position 0, so upper_bound never returns the first frame
+    auto const it = std::upper_bound(
+            m_frames.cbegin(),
+            m_frames.cend(),
+            decompressed_stream_pos,
+            [](uint64_t pos, Frame const& frame) { return pos < frame.uncompressed_offset; }
+    );
+    return (it - m_frames.cbegin()) - 1;
+}
+#endif
 }  // namespace clp::streaming_archive::reader
@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <boost/iostreams/device/mapped_file.hpp>
 
@@ -16,6 +17,10 @@ namespace clp::streaming_archive::reader {
 /**
  * Class for reading segments. A segment is a container for multiple compressed buffers that
  * itself may be further compressed and stored on disk.
+ *
+ * If the segment was written with a seek table (see streaming_archive::writer::Segment), reads
+ * start decompressing from the frame containing the requested content rather than from the
+ * beginning of the segment.
  */
 class Segment {
 public:
@@ -29,10 +34,15 @@ public:
      * Opens a segment with the given ID from the given directory
      * @param segment_dir_path
      * @param segment_id
+     * @param zstd_dictionary zstd dictionary the segment was compressed with, or nullptr if none
      * @return ErrorCode_Failure if unable to memory map the segment file
      * @return ErrorCode_Success on success
      */
-    ErrorCode try_open(std::string const& segment_dir_path, segment_id_t segment_id);
+    ErrorCode try_open(
+            std::string const& segment_dir_path,
+            segment_id_t segment_id,
+            streaming_compression::zstd::Dictionary const* zstd_dictionary = nullptr
+    );
 
     /**
      * Closes the segment
@@ -52,6 +62,28 @@ public:
     try_read(uint64_t decompressed_stream_pos, char* extraction_buf, uint64_t extraction_len);
 
 private:
+#if USE_ZSTD_COMPRESSION
+    // Types
+    struct Frame {
+        size_t compressed_offset;
+        uint64_t uncompressed_offset;
+    };
+
+    // Methods
+    /**
+     * Loads the seek table from the end of the memory-mapped segment, if the segment has one
+     * @param segment_file_size
+     * @return The size of the segment excluding the seek table
+     */
+    size_t load_seek_table(size_t segment_file_size);
+
+    /**
+     * @param decompressed_stream_pos
+     * @return The index of the frame containing the given position in the segment
+     */
+    size_t get_frame_ix(uint64_t decompressed_stream_pos) const;
+#endif
+
     std::string m_segment_path;
     boost::iostreams::mapped_file_source m_memory_mapped_segment_file;
 
@@ -59,6 +91,14 @@ private:
     streaming_compression::passthrough::Decompressor m_decompressor;
 #elif USE_ZSTD_COMPRESSION
     streaming_compression::zstd::Decompressor m_decompressor;
+
+    // Empty if the segment has no seek table
+    std::vector<Frame> m_frames;
+    size_t m_frames_compressed_size{0};
+    // Position in the segment where the decompressor's stream begins
+    uint64_t m_stream_begin_pos{0};
+    // Position in the segment of the decompressor's next byte
+    uint64_t m_next_read_pos{0};
 #else
     static_assert(false, "Unsupported compression mode.");
 #endif
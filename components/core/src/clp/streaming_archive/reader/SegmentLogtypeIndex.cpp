@@ -0,0 +1,138 @@
+#include "SegmentLogtypeIndex.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "../../FileReader.hpp"
+#include "../../streaming_compression/passthrough/Decompressor.hpp"
+#include "../../streaming_compression/zstd/Decompressor.hpp"
+#include "../Constants.hpp"
+
+namespace clp::streaming_archive::reader {
+namespace {
+/**
+ * Reads a LEB128 varint from the given buffer
+ * @param buf_pos The position in the buffer to read from. Returns the position after the varint.
+ * @param buf_end
+ * @return The value
+ * @throw streaming_archive::reader::SegmentLogtypeIndex::OperationFailed if the varint is
+ * truncated or too long
+ */
+uint64_t read_varint(char const*& buf_pos, char const* buf_end) {
+    constexpr uint8_t cPayloadMask{0x7F};
+    constexpr uint8_t cContinuationBit{0x80};
+    constexpr int cMaxShift{63};
+    uint64_t value{0};
+    for (int shift = 0; shift <= cMaxShift; shift += 7) {
+        if (buf_end == buf_pos) {
+            throw SegmentLogtypeIndex::OperationFailed(ErrorCode_Truncated, __FILENAME__, __LINE__);
+        }
+        auto const byte = static_cast<uint8_t>(*buf_pos++);
+        value |= static_cast<uint64_t>(byte & cPayloadMask) << shift;
+        if (0 == (byte & cContinuationBit)) {
+            return value;
+        }
+    }
+    throw SegmentLogtypeIndex::OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
+}
+}  // namespace
+
+ErrorCode
+SegmentLogtypeIndex::try_load(std::string const& segments_dir_path, segment_id_t segment_id) {
+    m_segment_id = segment_id;
+    m_segment_logtypes_pos_to_file_index.clear();
+
+    auto index_path = segments_dir_path;
+    index_path += std::to_string(segment_id);
+    index_path += cSegmentLogtypeIndexFileExtension;
+    if (false == std::filesystem::exists(index_path)) {
+        return ErrorCode_FileNotFound;
+    }
+
+    constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KB
+
+    FileReader file_reader{index_path};
+    uint64_t num_files{0};
+    file_reader.read_numeric_value(num_files, false);
+#if USE_PASSTHROUGH_COMPRESSION
+    streaming_compression::passthrough::Decompressor decompressor;
+#elif USE_ZSTD_COMPRESSION
+    streaming_compression::zstd::Decompressor decompressor;
+#else
+    static_assert(false, "Unsupported compression mode.");
+#endif
+    decompressor.open(file_reader, cDecompressorFileReadBufferCapacity);
+
+    // Decompress the whole index so that its varints can be decoded from memory
+    std::vector<char> index_buf;
+    while (true) {
+        auto const index_size = index_buf.size();
+        index_buf.resize(index_size + cDecompressorFileReadBufferCapacity);
+        size_t num_bytes_read{0};
+        auto const error_code = decompressor.try_read(
+                index_buf.data() + index_size,
+                cDecompressorFileReadBufferCapacity,
+                num_bytes_read
+        );
+        index_buf.resize(index_size + num_bytes_read);
+        if (ErrorCode_EndOfFile == error_code) {
+            break;
+        }
+        if (ErrorCode_Success != error_code) {
+            decompressor.close();
+            throw OperationFailed(error_code, __FILENAME__, __LINE__);
+        }
+    }
+    decompressor.close();
+
+    char const* buf_pos = index_buf.data();
+    char const* buf_end = buf_pos + index_buf.size();
+    try {
+        for (uint64_t file_ix = 0; file_ix < num_files; ++file_ix) {
+            auto const segment_logtypes_pos = read_varint(buf_pos, buf_end);
+            auto const num_logtypes = read_varint(buf_pos, buf_end);
+            // Each logtype takes at least two bytes, so this bounds allocations for corrupt indexes
+            if (num_logtypes > static_cast<uint64_t>(buf_end - buf_pos)) {
+                throw OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
+            }
+
+            FileIndex file_index(num_logtypes);
+            for (auto& [logtype_id, msg_ixs] : file_index) {
+                logtype_id = read_varint(buf_pos, buf_end);
+                auto const num_msgs = read_varint(buf_pos, buf_end);
+                if (num_msgs > static_cast<uint64_t>(buf_end - buf_pos)) {
+                    throw OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
+                }
+                msg_ixs.resize(num_msgs);
+                uint64_t msg_ix{0};
+                for (auto& msg_ix_out : msg_ixs) {
+                    msg_ix += read_varint(buf_pos, buf_end);
+                    msg_ix_out = msg_ix;
+                }
+            }
+            auto const [it, inserted] = m_segment_logtypes_pos_to_file_index.emplace(
+                    segment_logtypes_pos,
+                    std::move(file_index)
+            );
+            if (false == inserted) {
+                throw OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
+            }
+        }
+    } catch (OperationFailed const&) {
+        m_segment_logtypes_pos_to_file_index.clear();
+        throw;
+    }
+
+    return ErrorCode_Success;
+}
+
+SegmentLogtypeIndex::FileIndex const*
+SegmentLogtypeIndex::get_file_index(uint64_t segment_logtypes_pos) const {
+    auto const it = m_segment_logtypes_pos_to_file_index.find(segment_logtypes_pos);
+    if (m_segment_logtypes_pos_to_file_index.cend() == it) {
+        return nullptr;
+    }
+    return &it->second;
+}
+}  // namespace clp::streaming_archive::reader
@@ -0,0 +1,69 @@
+#ifndef CLP_STREAMING_ARCHIVE_READER_SEGMENTLOGTYPEINDEX_HPP
+#define CLP_STREAMING_ARCHIVE_READER_SEGMENTLOGTYPEINDEX_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../../Defs.h"
+#include "../../ErrorCode.hpp"
+#include "../../TraceableException.hpp"
+
+namespace clp::streaming_archive::reader {
+/**
+ * Class for reading a segment's logtype index (see streaming_archive::writer::SegmentLogtypeIndex).
+ * Segments written before the index existed don't have one.
+ */
+class SegmentLogtypeIndex {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        // Methods
+        char const* what() const noexcept override {
+            return "streaming_archive::reader::SegmentLogtypeIndex operation failed";
+        }
+    };
+
+    // Each of a file's logtypes and the ascending indices of the file's messages with the logtype
+    using FileIndex = std::vector<std::pair<logtype_dictionary_id_t, std::vector<uint64_t>>>;
+
+    // Methods
+    /**
+     * Loads the logtype index of the given segment from the given directory, replacing any
+     * previously loaded index
+     * @param segments_dir_path
+     * @param segment_id
+     * @return ErrorCode_FileNotFound if the segment has no logtype index
+     * @return ErrorCode_Success on success
+     * @throw streaming_archive::reader::SegmentLogtypeIndex::OperationFailed if the index is
+     * corrupt
+     * @throw FileReader::OperationFailed on open or read failure
+     */
+    ErrorCode try_load(std::string const& segments_dir_path, segment_id_t segment_id);
+
+    /**
+     * @return The ID of the segment whose index was last loaded (whether or not it existed)
+     */
+    segment_id_t get_segment_id() const { return m_segment_id; }
+
+    /**
+     * @param segment_logtypes_pos Position of the file's logtypes in the segment
+     * @return The index of the given file, or nullptr if the file isn't indexed
+     */
+    FileIndex const* get_file_index(uint64_t segment_logtypes_pos) const;
+
+private:
+    // Variables
+    segment_id_t m_segment_id{cInvalidSegmentId};
+    std::unordered_map<uint64_t, FileIndex> m_segment_logtypes_pos_to_file_index;
+};
+}  // namespace clp::streaming_archive::reader
+
+#endif  // CLP_STREAMING_ARCHIVE_READER_SEGMENTLOGTYPEINDEX_HPP
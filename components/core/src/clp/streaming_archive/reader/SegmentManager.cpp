@@ -3,10 +3,14 @@
 using std::string;
 
 namespace clp::streaming_archive::reader {
-void SegmentManager::open(string const& segment_dir_path) {
+void SegmentManager::open(
+        string const& segment_dir_path,
+        streaming_compression::zstd::Dictionary const* zstd_dictionary
+) {
     // Cleanup in case caller forgot to call close before calling this function
     close();
     m_segment_dir_path = segment_dir_path;
+    m_zstd_dictionary = zstd_dictionary;
 }
 
 void SegmentManager::close() {
@@ -28,8 +32,11 @@ ErrorCode SegmentManager::try_read(
     // Check that segment exists or insert it if not
     if (m_id_to_open_segment.count(segment_id) == 0) {
         // Insert and open segment
-        ErrorCode error_code
-                = m_id_to_open_segment[segment_id].try_open(m_segment_dir_path, segment_id);
+        ErrorCode error_code = m_id_to_open_segment[segment_id].try_open(
+                m_segment_dir_path,
+                segment_id,
+                m_zstd_dictionary
+        );
         if (ErrorCode_Success != error_code) {
             m_id_to_open_segment.erase(segment_id);
             return error_code;
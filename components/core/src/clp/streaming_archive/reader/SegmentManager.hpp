@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 #include "../../Defs.h"
+#include "../../streaming_compression/zstd/Dictionary.hpp"
 #include "Segment.hpp"
 
 namespace clp::streaming_archive::reader {
@@ -20,8 +21,12 @@ public:
     /**
      * Opens the segment manager
      * @param segment_dir_path
+     * @param zstd_dictionary zstd dictionary the segments were compressed with, or nullptr if none
      */
-    void open(std::string const& segment_dir_path);
+    void open(
+            std::string const& segment_dir_path,
+            streaming_compression::zstd::Dictionary const* zstd_dictionary = nullptr
+    );
 
     /**
      * Closes the segment manager
@@ -48,6 +53,7 @@ public:
 
 private:
     std::string m_segment_dir_path;
+    streaming_compression::zstd::Dictionary const* m_zstd_dictionary{nullptr};
 
     std::unordered_map<segment_id_t, Segment> m_id_to_open_segment;
     // List of open segment IDs in LRU order (LRU segment ID at front)
@@ -5,6 +5,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 
 #include <boost/asio.hpp>
 #include <boost/uuid/uuid.hpp>
@@ -31,6 +32,11 @@ using std::unordered_set;
 using std::vector;
 
 namespace clp::streaming_archive::writer {
+namespace {
+// Serializes the archive stats printed by the archives being written concurrently
+std::mutex archive_stats_output_mutex;
+}  // namespace
+
 Archive::~Archive() {
     if (m_path.empty() == false || m_file != nullptr
         || m_files_with_timestamps_in_segment.empty() == false
@@ -138,6 +144,27 @@ void Archive::open(UserConfig const& user_config) {
         }
     }
 
+    m_index_segment_logtypes = user_config.index_segment_logtypes;
+#if USE_ZSTD_COMPRESSION
+    m_zstd_dictionary = user_config.zstd_dictionary;
+#endif
+    if (nullptr != m_zstd_dictionary) {
+        // Store the zstd dictionary in the archive so that the archive can be read on its own
+        auto const zstd_dictionary_path = archive_path / cZstdDictionaryFileName;
+        FileWriter zstd_dictionary_file_writer;
+        zstd_dictionary_file_writer.open(
+                zstd_dictionary_path.string(),
+                FileWriter::OpenMode::CREATE_FOR_WRITING
+        );
+        zstd_dictionary_file_writer.write_string(m_zstd_dictionary->get_content());
+        zstd_dictionary_file_writer.close();
+
+        m_local_metadata->set_zstd_dictionary_id(m_zstd_dictionary->get_id());
+        m_local_metadata->increment_static_compressed_size(
+                m_zstd_dictionary->get_content().size()
+        );
+    }
+
     // Save metadata to disk
     auto metadata_file_path = archive_path / cMetadataFileName;
     try {
@@ -167,13 +194,27 @@ void Archive::open(UserConfig const& user_config) {
     string logtype_dict_path = archive_path_string + '/' + cLogTypeDictFilename;
     string logtype_dict_segment_index_path
             = archive_path_string + '/' + cLogTypeSegmentIndexFilename;
-    m_logtype_dict
-            .open(logtype_dict_path, logtype_dict_segment_index_path, cLogtypeDictionaryIdMax);
+    m_logtype_dict.open(
+            logtype_dict_path,
+            logtype_dict_segment_index_path,
+            cLogtypeDictionaryIdMax,
+            m_zstd_dictionary.get()
+    );
 
     // Open variable dictionary
     string var_dict_path = archive_path_string + '/' + cVarDictFilename;
     string var_dict_segment_index_path = archive_path_string + '/' + cVarSegmentIndexFilename;
-    m_var_dict.open(var_dict_path, var_dict_segment_index_path, cVariableDictionaryIdMax);
+    m_var_dict.open(
+            var_dict_path,
+            var_dict_segment_index_path,
+            cVariableDictionaryIdMax,
+            m_zstd_dictionary.get()
+    );
+
+    // Open non-dictionary variable segment index
+    m_non_dict_var_segment_index.open(
+            archive_path_string + '/' + cNonDictVarSegmentIndexFilename
+    );
 
 #if FLUSH_TO_DISK_ENABLED
     // fsync archive directory now that everything in the archive directory has been created
@@ -204,22 +245,28 @@ void Archive::close() {
     if (m_segment_for_files_with_timestamps.is_open()) {
         close_segment_and_persist_file_metadata(
                 m_segment_for_files_with_timestamps,
+                m_logtype_index_for_files_with_timestamps,
                 m_files_with_timestamps_in_segment,
                 m_logtype_ids_in_segment_for_files_with_timestamps,
-                m_var_ids_in_segment_for_files_with_timestamps
+                m_var_ids_in_segment_for_files_with_timestamps,
+                m_non_dict_vars_in_segment_for_files_with_timestamps
         );
         m_logtype_ids_in_segment_for_files_with_timestamps.clear();
         m_var_ids_in_segment_for_files_with_timestamps.clear();
+        m_non_dict_vars_in_segment_for_files_with_timestamps.clear();
     }
     if (m_segment_for_files_without_timestamps.is_open()) {
         close_segment_and_persist_file_metadata(
                 m_segment_for_files_without_timestamps,
+                m_logtype_index_for_files_without_timestamps,
                 m_files_without_timestamps_in_segment,
                 m_logtype_ids_in_segment_for_files_without_timestamps,
-                m_var_ids_in_segment_for_files_without_timestamps
+                m_var_ids_in_segment_for_files_without_timestamps,
+                m_non_dict_vars_in_segment_for_files_without_timestamps
         );
         m_logtype_ids_in_segment_for_files_without_timestamps.clear();
         m_var_ids_in_segment_for_files_without_timestamps.clear();
+        m_non_dict_vars_in_segment_for_files_without_timestamps.clear();
     }
 
     // Persist all metadata including dictionaries
@@ -228,6 +275,7 @@ void Archive::close() {
     m_logtype_dict.close();
     m_logtype_dict_entry.clear();
     m_var_dict.close();
+    m_non_dict_var_segment_index.close();
 
     if (::close(m_segments_dir_fd) != 0) {
         // We've already fsynced, so this error shouldn't affect us. Therefore, just log it.
@@ -242,6 +290,8 @@ void Archive::close() {
 
     m_metadata_db.close();
 
+    m_zstd_dictionary.reset();
+
     m_creator_id_as_string.clear();
     m_id_as_string.clear();
     m_path.clear();
@@ -309,7 +359,7 @@ void Archive::write_msg(
 
     m_file->write_encoded_msg(timestamp, logtype_id, encoded_vars, var_ids, num_uncompressed_bytes);
 
-    update_segment_indices(logtype_id, var_ids);
+    update_segment_indices(logtype_id, var_ids, encoded_vars);
 }
 
 void Archive::write_msg_using_schema(LogEventView const& log_view) {
@@ -321,6 +371,7 @@ void Archive::write_msg_using_schema(LogEventView const& log_view) {
         size_t end;
         timestamp_pattern = (TimestampPattern*)TimestampPattern::search_known_ts_patterns(
                 log_output_buffer->get_mutable_token(0).to_string(),
+                m_old_ts_pattern,
                 timestamp,
                 start,
                 end
@@ -436,7 +487,7 @@ void Archive::write_msg_using_schema(LogEventView const& log_view) {
                 num_uncompressed_bytes
         );
 
-        update_segment_indices(logtype_id, m_var_ids);
+        update_segment_indices(logtype_id, m_var_ids, m_encoded_vars);
     }
 }
 
@@ -465,39 +516,59 @@ void Archive::write_log_event_ir(ir::LogEvent<encoded_variable_t> const& log_eve
             original_num_bytes
     );
 
-    update_segment_indices(logtype_id, var_ids);
+    update_segment_indices(logtype_id, var_ids, encoded_vars);
 }
 
 void Archive::write_dir_snapshot() {
     // Flush dictionaries
     m_logtype_dict.write_header_and_flush_to_disk();
     m_var_dict.write_header_and_flush_to_disk();
+    m_non_dict_var_segment_index.write_header_and_flush_to_disk();
 }
 
 void Archive::update_segment_indices(
         logtype_dictionary_id_t logtype_id,
-        vector<variable_dictionary_id_t> const& var_ids
+        vector<variable_dictionary_id_t> const& var_ids,
+        vector<encoded_variable_t> const& encoded_vars
 ) {
     if (m_file->has_ts_pattern()) {
         m_logtype_ids_in_segment_for_files_with_timestamps.insert(logtype_id);
         m_var_ids_in_segment_for_files_with_timestamps.insert_all(var_ids);
+        m_non_dict_vars_in_segment_for_files_with_timestamps
+                .insert_msg_vars(m_logtype_dict_entry, encoded_vars);
     } else {
         m_logtype_ids_for_file_with_unassigned_segment.insert(logtype_id);
         m_var_ids_for_file_with_unassigned_segment.insert(var_ids.cbegin(), var_ids.cend());
+        m_non_dict_vars_for_file_with_unassigned_segment
+                .insert_msg_vars(m_logtype_dict_entry, encoded_vars);
     }
 }
 
 void Archive::append_file_contents_to_segment(
         Segment& segment,
+        SegmentLogtypeIndex& segment_logtype_index,
         ArrayBackedPosIntSet<logtype_dictionary_id_t>& logtype_ids_in_segment,
         ArrayBackedPosIntSet<variable_dictionary_id_t>& var_ids_in_segment,
+        NonDictVarSegmentIndexWriter::SegmentVars& non_dict_vars_in_segment,
         vector<File*>& files_in_segment
 ) {
     if (!segment.is_open()) {
-        segment.open(m_segments_dir_path, m_next_segment_id++, m_compression_level);
+        segment.open(
+                m_segments_dir_path,
+                m_next_segment_id++,
+                m_compression_level,
+                m_zstd_dictionary.get()
+        );
+        if (m_index_segment_logtypes) {
+            segment_logtype_index.open(
+                    m_segments_dir_path,
+                    segment.get_id(),
+                    m_compression_level
+            );
+        }
     }
 
-    m_file->append_to_segment(m_logtype_dict, segment);
+    m_file->append_to_segment(m_logtype_dict, segment, segment_logtype_index);
     files_in_segment.emplace_back(m_file);
     m_local_metadata->increment_static_uncompressed_size(m_file->get_num_uncompressed_bytes());
     m_local_metadata->expand_time_range(m_file->get_begin_ts(), m_file->get_end_ts());
@@ -506,12 +577,15 @@ void Archive::append_file_contents_to_segment(
     if (segment.get_uncompressed_size() >= m_target_segment_uncompressed_size) {
         close_segment_and_persist_file_metadata(
                 segment,
+                segment_logtype_index,
                 files_in_segment,
                 logtype_ids_in_segment,
-                var_ids_in_segment
+                var_ids_in_segment,
+                non_dict_vars_in_segment
         );
         logtype_ids_in_segment.clear();
         var_ids_in_segment.clear();
+        non_dict_vars_in_segment.clear();
     }
 }
 
@@ -527,10 +601,15 @@ void Archive::append_file_to_segment() {
         m_var_ids_in_segment_for_files_with_timestamps.insert_all(
                 m_var_ids_for_file_with_unassigned_segment
         );
+        m_non_dict_vars_in_segment_for_files_with_timestamps.insert_all(
+                m_non_dict_vars_for_file_with_unassigned_segment
+        );
         append_file_contents_to_segment(
                 m_segment_for_files_with_timestamps,
+                m_logtype_index_for_files_with_timestamps,
                 m_logtype_ids_in_segment_for_files_with_timestamps,
                 m_var_ids_in_segment_for_files_with_timestamps,
+                m_non_dict_vars_in_segment_for_files_with_timestamps,
                 m_files_with_timestamps_in_segment
         );
     } else {
@@ -540,15 +619,21 @@ void Archive::append_file_to_segment() {
         m_var_ids_in_segment_for_files_without_timestamps.insert_all(
                 m_var_ids_for_file_with_unassigned_segment
         );
+        m_non_dict_vars_in_segment_for_files_without_timestamps.insert_all(
+                m_non_dict_vars_for_file_with_unassigned_segment
+        );
         append_file_contents_to_segment(
                 m_segment_for_files_without_timestamps,
+                m_logtype_index_for_files_without_timestamps,
                 m_logtype_ids_in_segment_for_files_without_timestamps,
                 m_var_ids_in_segment_for_files_without_timestamps,
+                m_non_dict_vars_in_segment_for_files_without_timestamps,
                 m_files_without_timestamps_in_segment
         );
     }
     m_logtype_ids_for_file_with_unassigned_segment.clear();
     m_var_ids_for_file_with_unassigned_segment.clear();
+    m_non_dict_vars_for_file_with_unassigned_segment.clear();
     // Make sure file pointer is nulled and cannot be accessed outside
     m_file = nullptr;
 }
@@ -570,17 +655,25 @@ void Archive::persist_file_metadata(vector<File*> const& files) {
 
 void Archive::close_segment_and_persist_file_metadata(
         Segment& segment,
+        SegmentLogtypeIndex& segment_logtype_index,
         std::vector<File*>& files,
         ArrayBackedPosIntSet<logtype_dictionary_id_t>& segment_logtype_ids,
-        ArrayBackedPosIntSet<variable_dictionary_id_t>& segment_var_ids
+        ArrayBackedPosIntSet<variable_dictionary_id_t>& segment_var_ids,
+        NonDictVarSegmentIndexWriter::SegmentVars& segment_non_dict_vars
 ) {
     auto segment_id = segment.get_id();
     m_logtype_dict.index_segment(segment_id, segment_logtype_ids);
     m_var_dict.index_segment(segment_id, segment_var_ids);
+    m_non_dict_var_segment_index.index_segment(segment_id, segment_non_dict_vars);
 
     segment.close();
-
     m_local_metadata->increment_static_compressed_size(segment.get_compressed_size());
+    if (segment_logtype_index.is_open()) {
+        segment_logtype_index.close();
+        m_local_metadata->increment_static_compressed_size(
+                segment_logtype_index.get_compressed_size()
+        );
+    }
 
 #if FLUSH_TO_DISK_ENABLED
     // fsync segments directory to flush segment's directory entry
@@ -593,6 +686,7 @@ void Archive::close_segment_and_persist_file_metadata(
     // Flush dictionaries
     m_logtype_dict.write_header_and_flush_to_disk();
     m_var_dict.write_header_and_flush_to_disk();
+    m_non_dict_var_segment_index.write_header_and_flush_to_disk();
 
     for (auto file : files) {
         file->mark_as_in_committed_segment();
@@ -618,7 +712,8 @@ void Archive::add_empty_directories(vector<string> const& empty_directory_paths)
 }
 
 uint64_t Archive::get_dynamic_compressed_size() {
-    uint64_t on_disk_size = m_logtype_dict.get_on_disk_size() + m_var_dict.get_on_disk_size();
+    uint64_t on_disk_size = m_logtype_dict.get_on_disk_size() + m_var_dict.get_on_disk_size()
+                            + m_non_dict_var_segment_index.get_on_disk_size();
 
     // Add size of unclosed segments
     if (m_segment_for_files_with_timestamps.is_open()) {
@@ -645,8 +740,10 @@ void Archive::update_metadata() {
         json_msg["id"] = m_id_as_string;
         json_msg["uncompressed_size"] = m_local_metadata->get_uncompressed_size_bytes();
         json_msg["size"] = m_local_metadata->get_compressed_size_bytes();
-        std::cout << json_msg.dump(-1, ' ', true, nlohmann::json::error_handler_t::ignore)
-                  << std::endl;
+        auto const json_line
+                = json_msg.dump(-1, ' ', true, nlohmann::json::error_handler_t::ignore) + '\n';
+        std::lock_guard<std::mutex> const lock(archive_stats_output_mutex);
+        std::cout << json_line << std::flush;
     }
 }
 
@@ -19,6 +19,8 @@
 #include "../../GlobalMetadataDB.hpp"
 #include "../../ir/LogEvent.hpp"
 #include "../../LogTypeDictionaryWriter.hpp"
+#include "../../NonDictVarSegmentIndexWriter.hpp"
+#include "../../streaming_compression/zstd/Dictionary.hpp"
 #include "../../VariableDictionaryWriter.hpp"
 #include "../ArchiveMetadata.hpp"
 #include "../MetadataDB.hpp"
@@ -38,6 +40,8 @@ public:
      * @param global_metadata_db
      * @param print_archive_stats_progress Enable printing statistics about the archive as it's
      * compressed
+     * @param zstd_dictionary zstd dictionary to compress the archive's dictionaries and segments
+     * with, or nullptr to compress them without one
      */
     struct UserConfig {
         boost::uuids::uuid id;
@@ -48,6 +52,8 @@ public:
         std::string output_dir;
         GlobalMetadataDB* global_metadata_db;
         bool print_archive_stats_progress;
+        std::shared_ptr<streaming_compression::zstd::Dictionary const> zstd_dictionary;
+        bool index_segment_logtypes{false};
     };
 
     class OperationFailed : public TraceableException {
@@ -226,22 +232,34 @@ private:
     };
 
     // Methods
+    /**
+     * Adds the last encoded message's logtype and variables to the indices of the segment the
+     * current file will be appended to
+     * @param logtype_id
+     * @param var_ids
+     * @param encoded_vars
+     */
     void update_segment_indices(
             logtype_dictionary_id_t logtype_id,
-            std::vector<variable_dictionary_id_t> const& var_ids
+            std::vector<variable_dictionary_id_t> const& var_ids,
+            std::vector<encoded_variable_t> const& encoded_vars
     );
 
     /**
      * Appends the content of the current encoded file to the given segment
      * @param segment
+     * @param segment_logtype_index
      * @param logtype_ids_in_segment
      * @param var_ids_in_segment
+     * @param non_dict_vars_in_segment
      * @param files_in_segment
      */
     void append_file_contents_to_segment(
             Segment& segment,
+            SegmentLogtypeIndex& segment_logtype_index,
             ArrayBackedPosIntSet<logtype_dictionary_id_t>& logtype_ids_in_segment,
             ArrayBackedPosIntSet<variable_dictionary_id_t>& var_ids_in_segment,
+            NonDictVarSegmentIndexWriter::SegmentVars& non_dict_vars_in_segment,
             std::vector<File*>& files_in_segment
     );
     /**
@@ -256,17 +274,22 @@ private:
      * Closes a given segment, persists the metadata of the files in the segment, and cleans up
      * any data remaining outside the segment
      * @param segment
+     * @param segment_logtype_index
      * @param files
      * @param segment_logtype_ids
      * @param segment_var_ids
+     * @param segment_non_dict_vars
      * @throw Same as streaming_archive::writer::Segment::close
+     * @throw Same as streaming_archive::writer::SegmentLogtypeIndex::close
      * @throw Same as streaming_archive::writer::Archive::persist_file_metadata
      */
     void close_segment_and_persist_file_metadata(
             Segment& segment,
+            SegmentLogtypeIndex& segment_logtype_index,
             std::vector<File*>& files,
             ArrayBackedPosIntSet<logtype_dictionary_id_t>& segment_logtype_ids,
-            ArrayBackedPosIntSet<variable_dictionary_id_t>& segment_var_ids
+            ArrayBackedPosIntSet<variable_dictionary_id_t>& segment_var_ids,
+            NonDictVarSegmentIndexWriter::SegmentVars& segment_non_dict_vars
     );
 
     /**
@@ -303,6 +326,7 @@ private:
     std::vector<encoded_variable_t> m_encoded_vars;
     std::vector<variable_dictionary_id_t> m_var_ids;
     VariableDictionaryWriter m_var_dict;
+    NonDictVarSegmentIndexWriter m_non_dict_var_segment_index;
 
     boost::uuids::random_generator m_uuid_generator;
 
@@ -318,20 +342,28 @@ private:
 
     size_t m_target_segment_uncompressed_size;
     Segment m_segment_for_files_with_timestamps;
+    SegmentLogtypeIndex m_logtype_index_for_files_with_timestamps;
     ArrayBackedPosIntSet<logtype_dictionary_id_t>
             m_logtype_ids_in_segment_for_files_with_timestamps;
     ArrayBackedPosIntSet<variable_dictionary_id_t> m_var_ids_in_segment_for_files_with_timestamps;
+    NonDictVarSegmentIndexWriter::SegmentVars m_non_dict_vars_in_segment_for_files_with_timestamps;
     // Logtype and variable IDs for a file that hasn't yet been assigned to the timestamp or
     // timestamp-less segment
     std::unordered_set<logtype_dictionary_id_t> m_logtype_ids_for_file_with_unassigned_segment;
     std::unordered_set<variable_dictionary_id_t> m_var_ids_for_file_with_unassigned_segment;
+    NonDictVarSegmentIndexWriter::SegmentVars m_non_dict_vars_for_file_with_unassigned_segment;
     Segment m_segment_for_files_without_timestamps;
+    SegmentLogtypeIndex m_logtype_index_for_files_without_timestamps;
     ArrayBackedPosIntSet<logtype_dictionary_id_t>
             m_logtype_ids_in_segment_for_files_without_timestamps;
     ArrayBackedPosIntSet<variable_dictionary_id_t>
             m_var_ids_in_segment_for_files_without_timestamps;
+    NonDictVarSegmentIndexWriter::SegmentVars
+            m_non_dict_vars_in_segment_for_files_without_timestamps;
 
     int m_compression_level;
+    std::shared_ptr<streaming_compression::zstd::Dictionary const> m_zstd_dictionary;
+    bool m_index_segment_logtypes{false};
 
     MetadataDB m_metadata_db;
 
@@ -18,7 +18,11 @@ void File::open() {
     m_is_open = true;
 }
 
-void File::append_to_segment(LogTypeDictionaryWriter const& logtype_dict, Segment& segment) {
+void File::append_to_segment(
+        LogTypeDictionaryWriter const& logtype_dict,
+        Segment& segment,
+        SegmentLogtypeIndex& segment_logtype_index
+) {
     if (m_is_open) {
         throw OperationFailed(ErrorCode_Unsupported, __FILENAME__, __LINE__);
     }
@@ -36,6 +40,13 @@ void File::append_to_segment(LogTypeDictionaryWriter const& logtype_dict, Segmen
             m_logtypes->size_in_bytes(),
             segment_logtypes_uncompressed_pos
     );
+    if (segment_logtype_index.is_open()) {
+        segment_logtype_index.add_file(
+                segment_logtypes_uncompressed_pos,
+                m_logtypes->data(),
+                m_logtypes->size()
+        );
+    }
     uint64_t segment_variables_uncompressed_pos;
     segment.append(
             reinterpret_cast<char const*>(m_variables->data()),
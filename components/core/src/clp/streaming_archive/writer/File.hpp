@@ -13,6 +13,7 @@
 #include "../../PageAllocatedVector.hpp"
 #include "../../TimestampPattern.hpp"
 #include "Segment.hpp"
+#include "SegmentLogtypeIndex.hpp"
 
 namespace clp::streaming_archive::writer {
 /**
@@ -73,11 +74,17 @@ public:
     void close() { m_is_open = false; }
 
     /**
-     * Appends the file's columns to the given segment
+     * Appends the file's columns to the given segment and, if the segment's logtype index is open,
+     * indexes the file's logtypes in it
      * @param logtype_dict
      * @param segment
+     * @param segment_logtype_index
      */
-    void append_to_segment(LogTypeDictionaryWriter const& logtype_dict, Segment& segment);
+    void append_to_segment(
+            LogTypeDictionaryWriter const& logtype_dict,
+            Segment& segment,
+            SegmentLogtypeIndex& segment_logtype_index
+    );
     /**
      * Writes an encoded message to the respective columns and updates the metadata of the file
      * @param timestamp
@@ -6,6 +6,8 @@
 #include <cmath>
 #include <cstring>
 
+#include <zstd.h>
+
 #include "../../ErrorCode.hpp"
 #include "../../FileWriter.hpp"
 #include "../../spdlog_with_specializations.hpp"
@@ -26,7 +28,12 @@ Segment::~Segment() {
     }
 }
 
-void Segment::open(string const& segments_dir_path, segment_id_t id, int compression_level) {
+void Segment::open(
+        string const& segments_dir_path,
+        segment_id_t id,
+        int compression_level,
+        [[maybe_unused]] streaming_compression::zstd::Dictionary const* zstd_dictionary
+) {
     if (!m_segment_path.empty()) {
         throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
     }
@@ -44,14 +51,29 @@ void Segment::open(string const& segments_dir_path, segment_id_t id, int compres
 #if USE_PASSTHROUGH_COMPRESSION
     m_compressor.open(m_file_writer);
 #elif USE_ZSTD_COMPRESSION
-    m_compressor.open(m_file_writer, compression_level);
+    if (nullptr == zstd_dictionary) {
+        m_compressor.open(m_file_writer, compression_level);
+    } else {
+        m_compressor.open(m_file_writer, *zstd_dictionary);
+    }
+    m_frame_begin_offset = 0;
+    m_frame_begin_compressed_pos = 0;
+    m_frames.clear();
 #else
     static_assert(false, "Unsupported compression mode.");
 #endif
 }
 
 void Segment::close() {
+#if USE_ZSTD_COMPRESSION
+    if (m_offset > m_frame_begin_offset) {
+        end_frame();
+    }
+    m_compressor.close();
+    write_seek_table();
+#else
     m_compressor.close();
+#endif
     m_compressed_size = m_file_writer.get_pos();
 
     m_file_writer.flush();
@@ -62,6 +84,14 @@ void Segment::close() {
 }
 
 void Segment::append(char const* buf, uint64_t const buf_len, uint64_t& offset) {
+#if USE_ZSTD_COMPRESSION
+    // Start a new frame once the current one is large enough. Buffers aren't split across frames
+    // since readers usually read a buffer in its entirety.
+    if (m_offset - m_frame_begin_offset >= cSegmentFrameTargetUncompressedSize) {
+        end_frame();
+    }
+#endif
+
     // Compress
     m_compressor.write(buf, buf_len);
 
@@ -86,4 +116,30 @@ size_t Segment::get_compressed_size() {
 bool Segment::is_open() const {
     return !m_segment_path.empty();
 }
+
+#if USE_ZSTD_COMPRESSION
+void Segment::end_frame() {
+    m_compressor.flush();
+
+    auto const compressed_pos = m_file_writer.get_pos();
+    m_frames.push_back(
+            {compressed_pos - m_frame_begin_compressed_pos, m_offset - m_frame_begin_offset}
+    );
+    m_frame_begin_compressed_pos = compressed_pos;
+    m_frame_begin_offset = m_offset;
+}
+
+void Segment::write_seek_table() {
+    uint32_t const seek_table_size
+            = m_frames.size() * sizeof(Frame) + sizeof(uint64_t) + sizeof(uint32_t);
+    m_file_writer.write_numeric_value<uint32_t>(ZSTD_MAGIC_SKIPPABLE_START);
+    m_file_writer.write_numeric_value<uint32_t>(seek_table_size);
+    for (auto const& frame : m_frames) {
+        m_file_writer.write_numeric_value<uint64_t>(frame.compressed_size);
+        m_file_writer.write_numeric_value<uint64_t>(frame.uncompressed_size);
+    }
+    m_file_writer.write_numeric_value<uint64_t>(m_frames.size());
+    m_file_writer.write_numeric_value<uint32_t>(cSegmentSeekTableMagicNumber);
+}
+#endif
 }  // namespace clp::streaming_archive::writer
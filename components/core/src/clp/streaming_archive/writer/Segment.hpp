@@ -3,11 +3,13 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "../../Defs.h"
 #include "../../ErrorCode.hpp"
 #include "../../streaming_compression/passthrough/Compressor.hpp"
 #include "../../streaming_compression/zstd/Compressor.hpp"
+#include "../../streaming_compression/zstd/Dictionary.hpp"
 #include "../../TraceableException.hpp"
 #include "../Constants.hpp"
 
@@ -15,6 +17,13 @@ namespace clp::streaming_archive::writer {
 /**
  * Class for writing segments. A segment is a container for multiple compressed buffers that
  * itself may be further compressed and then stored on disk.
+ *
+ * With zstd compression, the segment is written as a sequence of independently decompressible
+ * frames so that readers can start decompressing at any frame. The frames are followed by a seek
+ * table, stored in a zstd skippable frame so that it's ignored by plain zstd decompression:
+ * - for each frame: its compressed size and uncompressed size (uint64_t each)
+ * - the number of frames (uint64_t)
+ * - cSegmentSeekTableMagicNumber (uint32_t)
  */
 class Segment {
 public:
@@ -43,10 +52,17 @@ public:
      * @param segments_dir_path
      * @param id
      * @param compression_level
+     * @param zstd_dictionary zstd dictionary to compress the segment with, or nullptr to compress
+     * without one. When a dictionary is given, its compression level is used instead.
      * @throw streaming_archive::writer::Segment::OperationFailed if segment wasn't closed
      * before this call
      */
-    void open(std::string const& segments_dir_path, segment_id_t id, int compression_level);
+    void open(
+            std::string const& segments_dir_path,
+            segment_id_t id,
+            int compression_level,
+            streaming_compression::zstd::Dictionary const* zstd_dictionary = nullptr
+    );
     /**
      * Closes the segment
      * @throw streaming_archive::writer::Segment::OperationFailed if compression fails
@@ -78,6 +94,28 @@ public:
     size_t get_compressed_size();
 
 private:
+#if USE_ZSTD_COMPRESSION
+    // Types
+    struct Frame {
+        uint64_t compressed_size;
+        uint64_t uncompressed_size;
+    };
+
+    // Methods
+    /**
+     * Ends the current frame and adds it to the seek table
+     * @throw streaming_archive::writer::Segment::OperationFailed if compression fails
+     * @throw FileWriter::OperationFailed on write failure
+     */
+    void end_frame();
+
+    /**
+     * Writes the seek table to the end of the segment
+     * @throw FileWriter::OperationFailed on write failure
+     */
+    void write_seek_table();
+#endif
+
     // Variables
     std::string m_segment_path;
     segment_id_t m_id;
@@ -90,6 +128,11 @@ private:
     streaming_compression::passthrough::Compressor m_compressor;
 #elif USE_ZSTD_COMPRESSION
     streaming_compression::zstd::Compressor m_compressor;
+
+    // Uncompressed and compressed offsets of the current frame
+    uint64_t m_frame_begin_offset;
+    size_t m_frame_begin_compressed_pos;
+    std::vector<Frame> m_frames;
 #else
     static_assert(false, "Unsupported compression mode.");
 #endif
@@ -0,0 +1,100 @@
+#include "SegmentLogtypeIndex.hpp"
+
+#include <map>
+#include <vector>
+
+#include "../Constants.hpp"
+
+namespace clp::streaming_archive::writer {
+namespace {
+/**
+ * Appends the given value to the given buffer as a LEB128 varint
+ * @param value
+ * @param buf
+ */
+void append_varint(uint64_t value, std::vector<char>& buf) {
+    constexpr uint64_t cPayloadMask{0x7F};
+    constexpr char cContinuationBit{static_cast<char>(0x80)};
+    while (value > cPayloadMask) {
+        buf.push_back(static_cast<char>(value & cPayloadMask) | cContinuationBit);
+        value >>= 7;
+    }
+    buf.push_back(static_cast<char>(value));
+}
+}  // namespace
+
+void SegmentLogtypeIndex::open(
+        std::string const& segments_dir_path,
+        segment_id_t segment_id,
+        int compression_level
+) {
+    if (is_open()) {
+        throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
+    }
+
+    m_path = segments_dir_path;
+    m_path += std::to_string(segment_id);
+    m_path += cSegmentLogtypeIndexFileExtension;
+
+    m_num_files = 0;
+    m_compressed_size = 0;
+
+    m_file_writer.open(m_path, FileWriter::OpenMode::CREATE_FOR_WRITING);
+    // Write header
+    m_file_writer.write_numeric_value(m_num_files);
+#if USE_PASSTHROUGH_COMPRESSION
+    m_compressor.open(m_file_writer);
+#elif USE_ZSTD_COMPRESSION
+    m_compressor.open(m_file_writer, compression_level);
+#else
+    static_assert(false, "Unsupported compression mode.");
+#endif
+}
+
+void SegmentLogtypeIndex::close() {
+    m_compressor.close();
+
+    // Update header
+    m_compressed_size = m_file_writer.get_pos();
+    m_file_writer.seek_from_begin(0);
+    m_file_writer.write_numeric_value(m_num_files);
+
+    m_file_writer.flush();
+    m_file_writer.close();
+
+    m_path.clear();
+}
+
+void SegmentLogtypeIndex::add_file(
+        uint64_t segment_logtypes_pos,
+        logtype_dictionary_id_t const* logtypes,
+        size_t num_messages
+) {
+    if (0 == num_messages) {
+        // Empty files don't occupy any space in the segment, so they can't be uniquely identified
+        // by their position
+        return;
+    }
+
+    std::map<logtype_dictionary_id_t, std::vector<uint64_t>> logtype_to_msg_ixs;
+    for (size_t msg_ix = 0; msg_ix < num_messages; ++msg_ix) {
+        logtype_to_msg_ixs[logtypes[msg_ix]].push_back(msg_ix);
+    }
+
+    m_file_index_buf.clear();
+    append_varint(segment_logtypes_pos, m_file_index_buf);
+    append_varint(logtype_to_msg_ixs.size(), m_file_index_buf);
+    for (auto const& [logtype_id, msg_ixs] : logtype_to_msg_ixs) {
+        append_varint(logtype_id, m_file_index_buf);
+        append_varint(msg_ixs.size(), m_file_index_buf);
+        uint64_t prev_msg_ix{0};
+        for (auto const msg_ix : msg_ixs) {
+            append_varint(msg_ix - prev_msg_ix, m_file_index_buf);
+            prev_msg_ix = msg_ix;
+        }
+    }
+    m_compressor.write(m_file_index_buf.data(), m_file_index_buf.size());
+
+    ++m_num_files;
+}
+}  // namespace clp::streaming_archive::writer
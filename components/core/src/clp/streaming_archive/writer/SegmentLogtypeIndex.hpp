@@ -0,0 +1,101 @@
+#ifndef CLP_STREAMING_ARCHIVE_WRITER_SEGMENTLOGTYPEINDEX_HPP
+#define CLP_STREAMING_ARCHIVE_WRITER_SEGMENTLOGTYPEINDEX_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "../../Defs.h"
+#include "../../ErrorCode.hpp"
+#include "../../FileWriter.hpp"
+#include "../../streaming_compression/passthrough/Compressor.hpp"
+#include "../../streaming_compression/zstd/Compressor.hpp"
+#include "../../TraceableException.hpp"
+
+namespace clp::streaming_archive::writer {
+/**
+ * Class for writing a segment's logtype index. For each file in the segment, the index maps each
+ * logtype in the file to the indices of the file's messages with that logtype, so that searches
+ * can skip files without matching logtypes and jump straight to candidate messages.
+ *
+ * The index is stored as the number of files (uint64_t) followed by a compressed stream containing,
+ * for each file:
+ * - the position of the file's logtypes in the segment
+ * - the number of logtypes in the file
+ * - for each logtype: its ID, the number of messages with the logtype, and the index of each of
+ *   those messages in the file, stored as the difference from the previous index (or from 0 for
+ *   the first message)
+ * Each value in the stream is stored as a LEB128 varint, so that the postings of dense logtypes
+ * mostly take a byte per message.
+ */
+class SegmentLogtypeIndex {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        // Methods
+        char const* what() const noexcept override {
+            return "streaming_archive::writer::SegmentLogtypeIndex operation failed";
+        }
+    };
+
+    // Methods
+    /**
+     * Creates the logtype index for the given segment in the given directory
+     * @param segments_dir_path
+     * @param segment_id
+     * @param compression_level
+     * @throw streaming_archive::writer::SegmentLogtypeIndex::OperationFailed if the index wasn't
+     * closed before this call
+     * @throw FileWriter::OperationFailed on open or write failure
+     */
+    void open(std::string const& segments_dir_path, segment_id_t segment_id, int compression_level);
+    /**
+     * Closes the index
+     * @throw FileWriter::OperationFailed on write or close failure
+     */
+    void close();
+
+    /**
+     * Indexes the messages of a file that was appended to the segment. Files without any messages
+     * aren't indexed.
+     * @param segment_logtypes_pos Position of the file's logtypes in the segment
+     * @param logtypes The file's logtypes column
+     * @param num_messages
+     */
+    void add_file(
+            uint64_t segment_logtypes_pos,
+            logtype_dictionary_id_t const* logtypes,
+            size_t num_messages
+    );
+
+    bool is_open() const { return false == m_path.empty(); }
+
+    /**
+     * @return The on-disk size (in bytes) of the index once it's been closed
+     */
+    size_t get_compressed_size() const { return m_compressed_size; }
+
+private:
+    // Variables
+    std::string m_path;
+    std::vector<char> m_file_index_buf;
+    uint64_t m_num_files{0};
+    size_t m_compressed_size{0};
+
+    FileWriter m_file_writer;
+#if USE_PASSTHROUGH_COMPRESSION
+    streaming_compression::passthrough::Compressor m_compressor;
+#elif USE_ZSTD_COMPRESSION
+    streaming_compression::zstd::Compressor m_compressor;
+#else
+    static_assert(false, "Unsupported compression mode.");
+#endif
+};
+}  // namespace clp::streaming_archive::writer
+
+#endif  // CLP_STREAMING_ARCHIVE_WRITER_SEGMENTLOGTYPEINDEX_HPP
@@ -7,7 +7,7 @@ namespace clp::streaming_compression::zstd {
 Compressor::Compressor()
         : ::clp::streaming_compression::Compressor(CompressorType::ZSTD),
           m_compression_stream_contains_data(false),
-          m_compressed_stream_file_writer(nullptr) {
+          m_compressed_stream_writer(nullptr) {
     m_compression_stream = ZSTD_createCStream();
     if (nullptr == m_compression_stream) {
         SPDLOG_ERROR("streaming_compression::zstd::Compressor: ZSTD_createCStream() error");
@@ -19,8 +19,8 @@ Compressor::~Compressor() {
     ZSTD_freeCStream(m_compression_stream);
 }
 
-void Compressor::open(FileWriter& file_writer, int const compression_level) {
-    if (nullptr != m_compressed_stream_file_writer) {
+void Compressor::open(WriterInterface& writer, int const compression_level) {
+    if (nullptr != m_compressed_stream_writer) {
         throw OperationFailed(ErrorCode_NotReady, __FILENAME__, __LINE__);
     }
 
@@ -40,22 +40,37 @@ void Compressor::open(FileWriter& file_writer, int const compression_level) {
         throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
     }
 
-    m_compressed_stream_file_writer = &file_writer;
+    m_compressed_stream_writer = &writer;
 
     m_uncompressed_stream_pos = 0;
 }
 
+void Compressor::open(WriterInterface& writer, Dictionary const& dictionary) {
+    open(writer);
+
+    auto const result
+            = ZSTD_CCtx_refCDict(m_compression_stream, dictionary.get_compression_dictionary());
+    if (ZSTD_isError(result)) {
+        SPDLOG_ERROR(
+                "streaming_compression::zstd::Compressor: ZSTD_CCtx_refCDict() error: {}",
+                ZSTD_getErrorName(result)
+        );
+        m_compressed_stream_writer = nullptr;
+        throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
+    }
+}
+
 void Compressor::close() {
-    if (nullptr == m_compressed_stream_file_writer) {
+    if (nullptr == m_compressed_stream_writer) {
         throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
     }
 
     flush();
-    m_compressed_stream_file_writer = nullptr;
+    m_compressed_stream_writer = nullptr;
 }
 
 void Compressor::write(char const* data, size_t data_length) {
-    if (nullptr == m_compressed_stream_file_writer) {
+    if (nullptr == m_compressed_stream_writer) {
         throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
     }
 
@@ -85,7 +100,7 @@ void Compressor::write(char const* data, size_t data_length) {
         if (m_compressed_stream_block.pos) {
             // Write to disk only if there is data in the compressed stream
             // block buffer
-            m_compressed_stream_file_writer->write(
+            m_compressed_stream_writer->write(
                     reinterpret_cast<char const*>(m_compressed_stream_block.dst),
                     m_compressed_stream_block.pos
             );
@@ -112,7 +127,7 @@ void Compressor::flush() {
         );
         throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
     }
-    m_compressed_stream_file_writer->write(
+    m_compressed_stream_writer->write(
             reinterpret_cast<char const*>(m_compressed_stream_block.dst),
             m_compressed_stream_block.pos
     );
@@ -121,7 +136,7 @@ void Compressor::flush() {
 }
 
 ErrorCode Compressor::try_get_pos(size_t& pos) const {
-    if (nullptr == m_compressed_stream_file_writer) {
+    if (nullptr == m_compressed_stream_writer) {
         return ErrorCode_NotInit;
     }
 
@@ -145,7 +160,7 @@ void Compressor::flush_without_ending_frame() {
             throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
         }
         if (m_compressed_stream_block.pos) {
-            m_compressed_stream_file_writer->write(
+            m_compressed_stream_writer->write(
                     reinterpret_cast<char const*>(m_compressed_stream_block.dst),
                     m_compressed_stream_block.pos
             );
@@ -7,10 +7,11 @@
 #include <zstd.h>
 #include <zstd_errors.h>
 
-#include "../../FileWriter.hpp"
 #include "../../TraceableException.hpp"
+#include "../../WriterInterface.hpp"
 #include "../Compressor.hpp"
 #include "Constants.hpp"
+#include "Dictionary.hpp"
 
 namespace clp::streaming_compression::zstd {
 class Compressor : public ::clp::streaming_compression::Compressor {
@@ -67,10 +68,21 @@ public:
     // Methods
     /**
      * Initialize streaming compressor
-     * @param file_writer
+     * @param writer
      * @param compression_level
      */
-    void open(FileWriter& file_writer, int compression_level = cDefaultCompressionLevel);
+    void open(WriterInterface& writer, int compression_level = cDefaultCompressionLevel);
+
+    /**
+     * Initialize streaming compressor to compress using the given dictionary, at the dictionary's
+     * compression level
+     * @param writer
+     * @param dictionary A dictionary constructed for compression, which must outlive the
+     * compressor's use of it
+     * @throw streaming_compression::zstd::Compressor::OperationFailed if the dictionary can't be
+     * used
+     */
+    void open(WriterInterface& writer, Dictionary const& dictionary);
 
     /**
      * Flushes the stream without ending the current frame
@@ -79,7 +91,7 @@ public:
 
 private:
     // Variables
-    FileWriter* m_compressed_stream_file_writer;
+    WriterInterface* m_compressed_stream_writer;
 
     // Compressed stream variables
     ZSTD_CStream* m_compression_stream;
@@ -238,7 +238,12 @@ void Decompressor::reset_stream() {
         m_compressed_stream_block.size = m_file_read_buffer_length;
     }
 
-    ZSTD_initDStream(m_decompression_stream);
+    if (nullptr == m_dictionary) {
+        ZSTD_initDStream(m_decompression_stream);
+    } else {
+        ZSTD_DCtx_reset(m_decompression_stream, ZSTD_reset_session_only);
+        ZSTD_DCtx_refDDict(m_decompression_stream, m_dictionary->get_decompression_dictionary());
+    }
     m_decompressed_stream_pos = 0;
 
     m_compressed_stream_block.pos = 0;
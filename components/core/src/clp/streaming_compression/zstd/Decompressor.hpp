@@ -10,6 +10,7 @@
 #include "../../ReadOnlyMemoryMappedFile.hpp"
 #include "../../TraceableException.hpp"
 #include "../Decompressor.hpp"
+#include "Dictionary.hpp"
 
 namespace clp::streaming_compression::zstd {
 class Decompressor : public ::clp::streaming_compression::Decompressor {
@@ -101,6 +102,14 @@ public:
      */
     ErrorCode open(std::string const& compressed_file_path);
 
+    /**
+     * Sets the dictionary to decompress with, taking effect the next time the decompressor is
+     * opened
+     * @param dictionary The dictionary, which must outlive the decompressor's use of it, or nullptr
+     * to decompress without a dictionary
+     */
+    void set_dictionary(Dictionary const* dictionary) { m_dictionary = dictionary; }
+
 private:
     // Enum class
     enum class InputType {
@@ -124,6 +133,7 @@ private:
 
     // Compressed stream variables
     ZSTD_DStream* m_decompression_stream;
+    Dictionary const* m_dictionary{nullptr};
 
     std::unique_ptr<ReadOnlyMemoryMappedFile> m_memory_mapped_file;
     FileReader* m_file_reader;
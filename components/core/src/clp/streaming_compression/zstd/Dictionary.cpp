@@ -0,0 +1,85 @@
+#include "Dictionary.hpp"
+
+#include <filesystem>
+#include <utility>
+
+#include <zdict.h>
+
+#include "../../Defs.h"
+#include "../../FileReader.hpp"
+#include "../../spdlog_with_specializations.hpp"
+
+namespace clp::streaming_compression::zstd {
+Dictionary::Dictionary(std::string content)
+        : m_content(std::move(content)),
+          m_id(ZDICT_getDictID(m_content.data(), m_content.size())) {
+    if (0 == m_id) {
+        SPDLOG_ERROR("streaming_compression::zstd::Dictionary: Content isn't a zstd dictionary");
+        throw OperationFailed(ErrorCode_BadParam, __FILENAME__, __LINE__);
+    }
+
+    m_decompression_dictionary = ZSTD_createDDict(m_content.data(), m_content.size());
+    if (nullptr == m_decompression_dictionary) {
+        SPDLOG_ERROR("streaming_compression::zstd::Dictionary: ZSTD_createDDict() error");
+        throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
+    }
+}
+
+Dictionary::Dictionary(std::string content, int compression_level)
+        : Dictionary(std::move(content)) {
+    m_compression_dictionary
+            = ZSTD_createCDict(m_content.data(), m_content.size(), compression_level);
+    if (nullptr == m_compression_dictionary) {
+        SPDLOG_ERROR("streaming_compression::zstd::Dictionary: ZSTD_createCDict() error");
+        throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
+    }
+}
+
+Dictionary::~Dictionary() {
+    ZSTD_freeCDict(m_compression_dictionary);
+    ZSTD_freeDDict(m_decompression_dictionary);
+}
+
+std::string Dictionary::train(std::vector<std::string> const& samples, size_t max_size) {
+    std::string concatenated_samples;
+    std::vector<size_t> sample_sizes;
+    sample_sizes.reserve(samples.size());
+    for (auto const& sample : samples) {
+        concatenated_samples += sample;
+        sample_sizes.push_back(sample.size());
+    }
+
+    std::string content(max_size, '\0');
+    auto const result = ZDICT_trainFromBuffer(
+            content.data(),
+            content.size(),
+            concatenated_samples.data(),
+            sample_sizes.data(),
+            static_cast<unsigned>(sample_sizes.size())
+    );
+    if (ZDICT_isError(result)) {
+        SPDLOG_ERROR(
+                "streaming_compression::zstd::Dictionary: ZDICT_trainFromBuffer() error: {}",
+                ZDICT_getErrorName(result)
+        );
+        throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
+    }
+    content.resize(result);
+    return content;
+}
+
+std::string Dictionary::read_content_from_file(std::string const& path) {
+    auto const file_size = std::filesystem::file_size(path);
+    FileReader file_reader{path};
+    std::string content;
+    file_reader.read_string(file_size, content, false);
+    return content;
+}
+
+ZSTD_CDict const* Dictionary::get_compression_dictionary() const {
+    if (nullptr == m_compression_dictionary) {
+        throw OperationFailed(ErrorCode_Unsupported, __FILENAME__, __LINE__);
+    }
+    return m_compression_dictionary;
+}
+}  // namespace clp::streaming_compression::zstd
@@ -0,0 +1,102 @@
+#ifndef CLP_STREAMING_COMPRESSION_ZSTD_DICTIONARY_HPP
+#define CLP_STREAMING_COMPRESSION_ZSTD_DICTIONARY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <zstd.h>
+
+#include "../../ErrorCode.hpp"
+#include "../../TraceableException.hpp"
+
+namespace clp::streaming_compression::zstd {
+/**
+ * A zstd dictionary, which improves the compression ratio and speed of small streams that are
+ * similar to the samples the dictionary was trained on. The dictionary is digested once when it's
+ * constructed, so it can be shared by many compressors and decompressors, including ones in
+ * different threads.
+ */
+class Dictionary {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        // Methods
+        char const* what() const noexcept override {
+            return "streaming_compression::zstd::Dictionary operation failed";
+        }
+    };
+
+    // Constructors
+    /**
+     * Constructs a dictionary that can only be used for decompression
+     * @param content The dictionary's content, as created by `train` or `zstd --train`
+     * @throw streaming_compression::zstd::Dictionary::OperationFailed if the content isn't a valid
+     * zstd dictionary or it couldn't be digested
+     */
+    explicit Dictionary(std::string content);
+
+    /**
+     * Constructs a dictionary that can be used for both compression and decompression
+     * @param content The dictionary's content, as created by `train` or `zstd --train`
+     * @param compression_level Compression level to use when compressing with the dictionary
+     * @throw streaming_compression::zstd::Dictionary::OperationFailed if the content isn't a valid
+     * zstd dictionary or it couldn't be digested
+     */
+    Dictionary(std::string content, int compression_level);
+
+    // Destructor
+    ~Dictionary();
+
+    // Explicitly disable copy and move constructor/assignment
+    Dictionary(Dictionary const&) = delete;
+    Dictionary& operator=(Dictionary const&) = delete;
+
+    // Methods
+    /**
+     * Trains a dictionary on the given samples
+     * @param samples
+     * @param max_size Maximum size of the dictionary
+     * @return The dictionary's content
+     * @throw streaming_compression::zstd::Dictionary::OperationFailed if training fails (e.g., if
+     * there aren't enough samples)
+     */
+    static std::string train(std::vector<std::string> const& samples, size_t max_size);
+
+    /**
+     * Reads a dictionary's content from the given file
+     * @param path
+     * @return The dictionary's content
+     * @throw FileReader::OperationFailed on open or read failure
+     */
+    static std::string read_content_from_file(std::string const& path);
+
+    uint32_t get_id() const { return m_id; }
+
+    std::string const& get_content() const { return m_content; }
+
+    /**
+     * @return The digested dictionary for compression
+     * @throw streaming_compression::zstd::Dictionary::OperationFailed if the dictionary was
+     * constructed for decompression only
+     */
+    ZSTD_CDict const* get_compression_dictionary() const;
+
+    ZSTD_DDict const* get_decompression_dictionary() const { return m_decompression_dictionary; }
+
+private:
+    // Variables
+    std::string m_content;
+    uint32_t m_id;
+    ZSTD_CDict* m_compression_dictionary{nullptr};
+    ZSTD_DDict* m_decompression_dictionary{nullptr};
+};
+}  // namespace clp::streaming_compression::zstd
+
+#endif  // CLP_STREAMING_COMPRESSION_ZSTD_DICTIONARY_HPP
@@ -0,0 +1,113 @@
+#include "string_utils/WildcardMatcher.hpp"
+
+#include <cstddef>
+#include <string_view>
+
+#include "string_utils/string_utils.hpp"
+
+using std::string_view;
+
+namespace {
+constexpr char cMatchAllBits = static_cast<char>(0xFF);
+constexpr char cMatchAllBitsExceptCase = static_cast<char>(~0x20);
+constexpr char cMatchNoBits = 0;
+}  // namespace
+
+namespace clp::string_utils {
+WildcardMatcher::WildcardMatcher(string_view wild, bool case_sensitive_match) {
+    auto const wild_length = wild.length();
+    for (size_t i = 0; i < wild_length; ++i) {
+        auto c = wild[i];
+        if ('*' == c) {
+            m_groups.emplace_back();
+            continue;
+        }
+
+        auto& group = m_groups.back();
+        if ('?' == c) {
+            group.chars += c;
+            group.masks += cMatchNoBits;
+            group.is_literal = false;
+            continue;
+        }
+        if ('\\' == c && i + 1 < wild_length) {
+            ++i;
+            c = wild[i];
+        }
+        if (false == case_sensitive_match && is_alphabet(c)) {
+            group.chars += static_cast<char>(c | 0x20);
+            group.masks += cMatchAllBitsExceptCase;
+            group.is_literal = false;
+        } else {
+            group.chars += c;
+            group.masks += cMatchAllBits;
+        }
+    }
+
+    for (auto const& group : m_groups) {
+        m_min_tame_length += group.length();
+    }
+}
+
+bool WildcardMatcher::matches(string_view tame) const {
+    auto const tame_length = tame.length();
+    if (tame_length < m_min_tame_length) {
+        return false;
+    }
+
+    auto const& first_group = m_groups.front();
+    if (1 == m_groups.size()) {
+        // No '*', so the group must match the entire string
+        return tame_length == first_group.length() && first_group.matches_at(tame, 0);
+    }
+
+    // The first and last groups are anchored to the beginning and end of the string
+    if (false == first_group.matches_at(tame, 0)) {
+        return false;
+    }
+    auto const& last_group = m_groups.back();
+    auto const last_group_pos = tame_length - last_group.length();
+    if (false == last_group.matches_at(tame, last_group_pos)) {
+        return false;
+    }
+
+    // Every other group must match, in order, between the first and last groups
+    auto const unanchored_tame = tame.substr(0, last_group_pos);
+    size_t pos = first_group.length();
+    for (size_t i = 1; i < m_groups.size() - 1; ++i) {
+        auto const& group = m_groups[i];
+        pos = group.find(unanchored_tame, pos);
+        if (string_view::npos == pos) {
+            return false;
+        }
+        pos += group.length();
+    }
+    return true;
+}
+
+bool WildcardMatcher::Group::matches_at(string_view tame, size_t pos) const {
+    auto const group_length = length();
+    if (is_literal) {
+        return tame.substr(pos, group_length) == chars;
+    }
+    for (size_t i = 0; i < group_length; ++i) {
+        if (0 != ((tame[pos + i] ^ chars[i]) & masks[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t WildcardMatcher::Group::find(string_view tame, size_t pos) const {
+    if (is_literal) {
+        return tame.find(chars, pos);
+    }
+    auto const group_length = length();
+    for (; pos + group_length <= tame.length(); ++pos) {
+        if (matches_at(tame, pos)) {
+            return pos;
+        }
+    }
+    return string_view::npos;
+}
+}  // namespace clp::string_utils
@@ -0,0 +1,82 @@
+#ifndef CLP_STRING_UTILS_WILDCARDMATCHER_HPP
+#define CLP_STRING_UTILS_WILDCARDMATCHER_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clp::string_utils {
+/**
+ * A wildcard string compiled once so that many strings can be matched against it cheaply. The
+ * supported wildcards, escaping, and requirements on the wildcard string are the same as for
+ * ``wildcard_match_unsafe_case_sensitive``.
+ * <br/>
+ * The wildcard string is split at each '*' into groups of characters which must appear in the
+ * string in order. The first group must be a prefix of the string, the last group must be a suffix,
+ * and every other group is searched for left-to-right, taking the earliest occurrence. Since each
+ * group has a fixed length, taking the earliest occurrence never prevents a later group from
+ * matching, so no backtracking is needed. Groups without '?' or case-insensitive characters are
+ * searched with ``std::string_view::find``.
+ */
+class WildcardMatcher {
+public:
+    // Constructors
+    /**
+     * Constructs a matcher which only matches the empty string
+     */
+    WildcardMatcher() = default;
+
+    /**
+     * @param wild The wildcard string
+     * @param case_sensitive_match Whether to consider case when matching
+     */
+    explicit WildcardMatcher(std::string_view wild, bool case_sensitive_match = true);
+
+    // Methods
+    /**
+     * @param tame
+     * @return Whether the given string matches the wildcard string
+     */
+    [[nodiscard]] bool matches(std::string_view tame) const;
+
+private:
+    // Types
+    /**
+     * A group of characters between '*' in the wildcard string. A character in the string matches
+     * the group's character at the same position if the bits selected by the position's mask are
+     * equal. '?' is represented by an empty mask, and case-insensitive letters by a mask that
+     * ignores ASCII's case bit.
+     */
+    struct Group {
+        std::string chars;
+        std::string masks;
+        // Whether every mask selects all bits
+        bool is_literal{true};
+
+        [[nodiscard]] size_t length() const { return chars.length(); }
+
+        /**
+         * @param tame
+         * @param pos
+         * @return Whether the group matches `tame` starting at `pos`
+         */
+        [[nodiscard]] bool matches_at(std::string_view tame, size_t pos) const;
+
+        /**
+         * @param tame
+         * @param pos
+         * @return The position of the group's first match in `tame` at or after `pos`, or
+         * `std::string_view::npos` if there's no match
+         */
+        [[nodiscard]] size_t find(std::string_view tame, size_t pos) const;
+    };
+
+    // Variables
+    // The groups in the wildcard string; there's only one if the string doesn't contain '*'
+    std::vector<Group> m_groups{Group{}};
+    size_t m_min_tame_length{0};
+};
+}  // namespace clp::string_utils
+
+#endif  // CLP_STRING_UTILS_WILDCARDMATCHER_HPP
@@ -243,7 +243,9 @@ bool wildcard_match_unsafe_case_sensitive(string_view tame, string_view wild) {
 
             // Handle a mismatch
             t = *tame_current;
-            if (!((false == is_escaped && '?' == w) || t == w)) {
+            bool const is_match{(false == is_escaped && '?' == w) || t == w};
+            is_escaped = false;
+            if (false == is_match) {
                 if (nullptr == wild_bookmark) {
                     // No bookmark to return to
                     return false;
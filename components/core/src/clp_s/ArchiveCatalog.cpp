@@ -0,0 +1,433 @@
+#include "ArchiveCatalog.hpp"
+
+#include <sys/file.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "../clp/FileDescriptor.hpp"
+#include "archive_constants.hpp"
+#include "FileWriter.hpp"
+#include "TimestampDictionaryWriter.hpp"
+#include "Utils.hpp"
+#include "ZstdCompressor.hpp"
+#include "ZstdDecompressor.hpp"
+
+namespace clp_s {
+namespace {
+// Size of the buffer used to copy entries when compacting the catalog
+constexpr size_t cCopyBufferSize = 64 * 1024;  // 64 KB
+
+struct EntryHeader {
+    std::string archive_id;
+    // Position of the entry's header
+    size_t begin_pos;
+    // Position and size of the entry's compressed summary
+    size_t summary_pos;
+    size_t summary_size;
+};
+
+/**
+ * Reads the header of the next catalog entry and skips over the entry's summary
+ * @param catalog_reader
+ * @param catalog_size
+ * @param header Returns the entry's header
+ * @return ErrorCodeSuccess on success
+ * @return ErrorCodeEndOfFile if there are no more entries
+ * @return ErrorCodeTruncated if the entry extends past the end of the catalog or wasn't completely
+ * written
+ * @return Same as FileReader::try_read_numeric_value, FileReader::try_read_exact_length, or
+ * FileReader::try_seek_from_begin on failure
+ */
+ErrorCode
+try_read_entry_header(FileReader& catalog_reader, size_t catalog_size, EntryHeader& header) {
+    auto error_code = catalog_reader.try_get_pos(header.begin_pos);
+    if (ErrorCodeSuccess != error_code) {
+        return error_code;
+    }
+    if (header.begin_pos == catalog_size) {
+        return ErrorCodeEndOfFile;
+    }
+
+    uint64_t archive_id_length;
+    error_code = catalog_reader.try_read_numeric_value(archive_id_length);
+    if (ErrorCodeSuccess != error_code) {
+        return ErrorCodeEndOfFile == error_code ? ErrorCodeTruncated : error_code;
+    }
+    if (archive_id_length > catalog_size - header.begin_pos) {
+        return ErrorCodeTruncated;
+    }
+    header.archive_id.resize(archive_id_length);
+    error_code = catalog_reader.try_read_exact_length(header.archive_id.data(), archive_id_length);
+    if (ErrorCodeSuccess != error_code) {
+        return ErrorCodeEndOfFile == error_code ? ErrorCodeTruncated : error_code;
+    }
+
+    uint64_t summary_size;
+    error_code = catalog_reader.try_read_numeric_value(summary_size);
+    if (ErrorCodeSuccess != error_code) {
+        return ErrorCodeEndOfFile == error_code ? ErrorCodeTruncated : error_code;
+    }
+    error_code = catalog_reader.try_get_pos(header.summary_pos);
+    if (ErrorCodeSuccess != error_code) {
+        return error_code;
+    }
+    // A size of zero means the appender didn't finish writing the entry
+    if (0 == summary_size || summary_size > catalog_size - header.summary_pos) {
+        return ErrorCodeTruncated;
+    }
+    header.summary_size = summary_size;
+
+    return catalog_reader.try_seek_from_begin(header.summary_pos + header.summary_size);
+}
+
+/**
+ * Reads an archive's summary from the catalog
+ * @param decompressor
+ * @param entry Returns the archive's summary
+ * @return ErrorCodeSuccess on success
+ * @return ErrorCodeCorrupt if a node's parent doesn't precede it
+ * @return Same as ZstdDecompressor::try_read_numeric_value, ZstdDecompressor::try_read_string, or
+ * TimestampEntry::try_read_from_file on failure
+ */
+ErrorCode try_read_summary(ZstdDecompressor& decompressor, ArchiveCatalog::Entry& entry) {
+    uint64_t num_timestamp_ranges;
+    auto error_code = decompressor.try_read_numeric_value(num_timestamp_ranges);
+    if (ErrorCodeSuccess != error_code) {
+        return error_code;
+    }
+    for (uint64_t i = 0; i < num_timestamp_ranges; ++i) {
+        TimestampEntry timestamp_entry;
+        error_code = timestamp_entry.try_read_from_file(decompressor);
+        if (ErrorCodeSuccess != error_code) {
+            return error_code;
+        }
+        std::vector<std::string> tokens;
+        StringUtils::tokenize_column_descriptor(timestamp_entry.get_key_name(), tokens);
+        entry.timestamp_ranges.emplace_back(std::move(tokens), std::move(timestamp_entry));
+    }
+
+    uint64_t num_nodes;
+    error_code = decompressor.try_read_numeric_value(num_nodes);
+    if (ErrorCodeSuccess != error_code) {
+        return error_code;
+    }
+    // Nodes are stored in ID order and a node's parent always precedes it
+    std::vector<std::vector<std::string>> node_paths;
+    node_paths.reserve(num_nodes);
+    for (uint64_t i = 0; i < num_nodes; ++i) {
+        int32_t parent_id;
+        error_code = decompressor.try_read_numeric_value(parent_id);
+        if (ErrorCodeSuccess != error_code) {
+            return error_code;
+        }
+        uint64_t key_length;
+        error_code = decompressor.try_read_numeric_value(key_length);
+        if (ErrorCodeSuccess != error_code) {
+            return error_code;
+        }
+        std::string key;
+        error_code = decompressor.try_read_string(key_length, key);
+        if (ErrorCodeSuccess != error_code) {
+            return error_code;
+        }
+        NodeType type;
+        error_code = decompressor.try_read_numeric_value(type);
+        if (ErrorCodeSuccess != error_code) {
+            return error_code;
+        }
+
+        // The root has no key, so paths start at the root's children, like the column descriptors
+        // in a query
+        if (parent_id < 0) {
+            node_paths.emplace_back();
+            continue;
+        }
+        if (static_cast<uint64_t>(parent_id) >= i) {
+            return ErrorCodeCorrupt;
+        }
+        auto path = node_paths[parent_id];
+        path.emplace_back(std::move(key));
+        if (NodeType::UnstructuredArray == type || NodeType::StructuredArray == type) {
+            entry.array_key_paths.emplace(path);
+        }
+        entry.key_paths.emplace(path);
+        node_paths.emplace_back(std::move(path));
+    }
+
+    return ErrorCodeSuccess;
+}
+
+/**
+ * Opens and exclusively locks the catalog at the given path, creating it if it doesn't exist.
+ * @param catalog_path
+ * @return A descriptor for the catalog which holds the lock until it's closed
+ * @throw OperationFailed if the catalog couldn't be created or locked
+ */
+std::unique_ptr<clp::FileDescriptor> lock_catalog(std::string const& catalog_path) {
+    while (true) {
+        FileWriter catalog_creator;
+        catalog_creator.open(catalog_path, FileWriter::OpenMode::CreateIfNonexistentForAppending);
+        catalog_creator.close();
+
+        auto lock_fd = std::make_unique<clp::FileDescriptor>(
+                catalog_path,
+                clp::FileDescriptor::OpenMode::ReadOnly
+        );
+        if (0 != flock(lock_fd->get_raw_fd(), LOCK_EX)) {
+            SPDLOG_ERROR("Failed to lock archive catalog {}, errno={}", catalog_path, errno);
+            throw ArchiveCatalog::OperationFailed(ErrorCodeErrno, __FILENAME__, __LINE__);
+        }
+
+        // Compaction replaces the catalog while holding the lock, so if the catalog was replaced
+        // while we waited, the file we locked is no longer the catalog
+        struct stat locked_stat = {};
+        struct stat current_stat = {};
+        if (0 != fstat(lock_fd->get_raw_fd(), &locked_stat)) {
+            throw ArchiveCatalog::OperationFailed(ErrorCodeErrno, __FILENAME__, __LINE__);
+        }
+        if (0 == stat(catalog_path.c_str(), &current_stat)
+            && locked_stat.st_dev == current_stat.st_dev
+            && locked_stat.st_ino == current_stat.st_ino)
+        {
+            return lock_fd;
+        }
+    }
+}
+
+/**
+ * Compacts the catalog if most of its entries are stale or if it ends with an entry that wasn't
+ * completely written. Compaction copies the live entries to a new file and then replaces the
+ * catalog with it, so concurrent readers continue to see a consistent catalog.
+ *
+ * NOTE: The caller must hold the catalog's lock, and must re-lock the catalog if it was compacted.
+ * @param archives_dir
+ * @param catalog_path
+ * @return Whether the catalog was compacted
+ * @throw OperationFailed if the catalog couldn't be read or replaced
+ */
+bool compact_catalog_if_necessary(
+        std::string const& archives_dir,
+        std::string const& catalog_path
+) {
+    FileReader catalog_reader;
+    catalog_reader.open(catalog_path);
+    auto const catalog_size = std::filesystem::file_size(catalog_path);
+
+    std::vector<EntryHeader> headers;
+    std::unordered_map<std::string, size_t> archive_id_to_last_entry_ix;
+    ErrorCode error_code{ErrorCodeSuccess};
+    while (true) {
+        EntryHeader header;
+        error_code = try_read_entry_header(catalog_reader, catalog_size, header);
+        if (ErrorCodeSuccess != error_code) {
+            break;
+        }
+        archive_id_to_last_entry_ix.insert_or_assign(header.archive_id, headers.size());
+        headers.emplace_back(std::move(header));
+    }
+    bool const is_complete = ErrorCodeEndOfFile == error_code;
+
+    std::vector<EntryHeader const*> live_headers;
+    for (auto const& [archive_id, entry_ix] : archive_id_to_last_entry_ix) {
+        if (std::filesystem::is_directory(std::filesystem::path(archives_dir) / archive_id)) {
+            live_headers.push_back(&headers[entry_ix]);
+        }
+    }
+    auto const num_stale_entries = headers.size() - live_headers.size();
+    if (is_complete && num_stale_entries <= live_headers.size()) {
+        return false;
+    }
+
+    // Copy the live entries in their original order
+    std::sort(live_headers.begin(), live_headers.end(), [](auto const* lhs, auto const* rhs) {
+        return lhs->begin_pos < rhs->begin_pos;
+    });
+    auto const compacted_catalog_path = catalog_path + ".compacted";
+    FileWriter compacted_catalog_writer;
+    compacted_catalog_writer.open(compacted_catalog_path, FileWriter::OpenMode::CreateForWriting);
+    std::vector<char> buf(cCopyBufferSize);
+    for (auto const* header : live_headers) {
+        catalog_reader.seek_from_begin(header->begin_pos);
+        auto num_bytes_remaining = header->summary_pos + header->summary_size - header->begin_pos;
+        while (num_bytes_remaining > 0) {
+            auto const num_bytes_to_copy = std::min(num_bytes_remaining, buf.size());
+            error_code = catalog_reader.try_read_exact_length(buf.data(), num_bytes_to_copy);
+            if (ErrorCodeSuccess != error_code) {
+                compacted_catalog_writer.close();
+                std::filesystem::remove(compacted_catalog_path);
+                throw ArchiveCatalog::OperationFailed(error_code, __FILENAME__, __LINE__);
+            }
+            compacted_catalog_writer.write(buf.data(), num_bytes_to_copy);
+            num_bytes_remaining -= num_bytes_to_copy;
+        }
+    }
+    compacted_catalog_writer.close();
+    catalog_reader.close();
+
+    std::error_code fs_error_code;
+    std::filesystem::rename(compacted_catalog_path, catalog_path, fs_error_code);
+    if (fs_error_code) {
+        SPDLOG_ERROR(
+                "Failed to replace archive catalog {} - {}",
+                catalog_path,
+                fs_error_code.message()
+        );
+        std::filesystem::remove(compacted_catalog_path, fs_error_code);
+        throw ArchiveCatalog::OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+    }
+    SPDLOG_INFO(
+            "Compacted archive catalog {} from {} to {} entries.",
+            catalog_path,
+            headers.size(),
+            live_headers.size()
+    );
+    return true;
+}
+}  // namespace
+
+void ArchiveCatalog::append_archive(
+        std::string const& archives_dir,
+        std::string const& archive_id,
+        std::map<std::string, TimestampEntry> const& timestamp_ranges,
+        SchemaTree const& schema_tree,
+        int compression_level
+) {
+    auto const catalog_path = archives_dir + constants::cArchivesCatalogFile;
+
+    // Serialize appends from concurrent compressions. The lock is released when the descriptor is
+    // closed, after the entry has been flushed by closing the writer. If the catalog is compacted,
+    // it's replaced by a new file, so we need to lock the new file instead.
+    auto lock_fd = lock_catalog(catalog_path);
+    while (compact_catalog_if_necessary(archives_dir, catalog_path)) {
+        lock_fd.reset();
+        lock_fd = lock_catalog(catalog_path);
+    }
+
+    // Entries are appended with a placeholder summary size which is filled in once the summary has
+    // been compressed, so an entry which was never completed can be detected
+    FileWriter catalog_writer;
+    catalog_writer.open(catalog_path, FileWriter::OpenMode::CreateIfNonexistentForSeekableWriting);
+    catalog_writer.write_numeric_value<uint64_t>(archive_id.size());
+    catalog_writer.write(archive_id.data(), archive_id.size());
+    auto const summary_size_pos = catalog_writer.get_pos();
+    catalog_writer.write_numeric_value<uint64_t>(0);
+    auto const summary_pos = catalog_writer.get_pos();
+
+    ZstdCompressor catalog_compressor;
+    catalog_compressor.open(catalog_writer, compression_level);
+
+    TimestampDictionaryWriter::write_timestamp_entries(timestamp_ranges, catalog_compressor);
+
+    auto const& nodes = schema_tree.get_nodes();
+    catalog_compressor.write_numeric_value<uint64_t>(nodes.size());
+    for (auto const& node : nodes) {
+        catalog_compressor.write_numeric_value(node.get_parent_id());
+
+        std::string const& key = node.get_key_name();
+        catalog_compressor.write_numeric_value<uint64_t>(key.size());
+        catalog_compressor.write_string(key);
+        catalog_compressor.write_numeric_value(node.get_type());
+    }
+
+    catalog_compressor.close();
+    auto const summary_end_pos = catalog_writer.get_pos();
+    catalog_writer.seek_from_begin(summary_size_pos);
+    catalog_writer.write_numeric_value<uint64_t>(summary_end_pos - summary_pos);
+    catalog_writer.close();
+}
+
+bool ArchiveCatalog::read(std::string const& archives_dir) {
+    m_entry_locations.clear();
+    m_current_archive_id.clear();
+    m_current_entry.reset();
+
+    auto const catalog_path = archives_dir + constants::cArchivesCatalogFile;
+    auto error_code = m_catalog_reader.try_open(catalog_path);
+    if (ErrorCodeFileNotFound == error_code) {
+        return false;
+    }
+    if (ErrorCodeSuccess != error_code) {
+        throw OperationFailed(error_code, __FILENAME__, __LINE__);
+    }
+    // NOTE: If the catalog is compacted after we open it, we continue reading the old file
+    std::error_code fs_error_code;
+    auto const catalog_size = std::filesystem::file_size(catalog_path, fs_error_code);
+    if (fs_error_code) {
+        throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+    }
+
+    // Only the headers are read here; summaries are decompressed on demand by `get_entry`
+    while (true) {
+        EntryHeader header;
+        error_code = try_read_entry_header(m_catalog_reader, catalog_size, header);
+        if (ErrorCodeSuccess != error_code) {
+            if (ErrorCodeEndOfFile != error_code) {
+                SPDLOG_WARN(
+                        "Stopped reading archive catalog after {} entries, error={}.",
+                        m_entry_locations.size(),
+                        static_cast<int>(error_code)
+                );
+            }
+            break;
+        }
+        m_entry_locations.insert_or_assign(
+                std::move(header.archive_id),
+                EntryLocation{header.summary_pos, header.summary_size}
+        );
+    }
+
+    return true;
+}
+
+ArchiveCatalog::Entry* ArchiveCatalog::get_entry(std::string const& archive_id) {
+    if (m_current_entry.has_value() && m_current_archive_id == archive_id) {
+        return &m_current_entry.value();
+    }
+    m_current_entry.reset();
+
+    auto it = m_entry_locations.find(archive_id);
+    if (m_entry_locations.end() == it) {
+        return nullptr;
+    }
+    auto const& location = it->second;
+
+    std::vector<char> compressed_summary(location.summary_size);
+    auto error_code = m_catalog_reader.try_seek_from_begin(location.summary_pos);
+    if (ErrorCodeSuccess == error_code) {
+        error_code = m_catalog_reader.try_read_exact_length(
+                compressed_summary.data(),
+                compressed_summary.size()
+        );
+    }
+    Entry entry;
+    if (ErrorCodeSuccess == error_code) {
+        ZstdDecompressor summary_decompressor;
+        summary_decompressor.open(compressed_summary.data(), compressed_summary.size());
+        error_code = try_read_summary(summary_decompressor, entry);
+        summary_decompressor.close();
+    }
+    if (ErrorCodeSuccess != error_code) {
+        SPDLOG_WARN(
+                "Failed to read archive catalog entry for {}, error={}.",
+                archive_id,
+                static_cast<int>(error_code)
+        );
+        return nullptr;
+    }
+
+    m_current_archive_id = archive_id;
+    m_current_entry.emplace(std::move(entry));
+    return &m_current_entry.value();
+}
+}  // namespace clp_s
@@ -0,0 +1,103 @@
+#ifndef CLP_S_ARCHIVECATALOG_HPP
+#define CLP_S_ARCHIVECATALOG_HPP
+
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "FileReader.hpp"
+#include "SchemaTree.hpp"
+#include "TimestampEntry.hpp"
+#include "TraceableException.hpp"
+
+namespace clp_s {
+/**
+ * A catalog of per-archive summaries stored in the archives directory, letting search decide which
+ * archives can't match a query without opening them.
+ *
+ * Each archive appends one entry to a single file, under a file lock so that compressors running
+ * concurrently can append to it. An entry consists of an uncompressed header (the archive's ID and
+ * the size of its summary) followed by the summary as a zstd frame, so that readers can index the
+ * catalog without decompressing it and only decompress the summaries of archives they consider.
+ * The summary contains the archive's timestamp ranges and the key paths in its schema tree.
+ *
+ * Appending compacts the catalog when most of its entries are stale (superseded, or for archives
+ * that no longer exist) or when it ends with a partially written entry. Archives without an entry
+ * (e.g., those compressed before the catalog existed) must be searched as usual.
+ */
+class ArchiveCatalog {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    struct Entry {
+        // Tokenized timestamp column and its range; the first range is the authoritative one
+        std::vector<std::pair<std::vector<std::string>, TimestampEntry>> timestamp_ranges;
+        // Tokenized paths of every key in the archive's schema tree, relative to the root
+        std::set<std::vector<std::string>> key_paths;
+        // Tokenized paths of the archive's array keys, whose contents aren't in the schema tree
+        std::set<std::vector<std::string>> array_key_paths;
+    };
+
+    // Methods
+    /**
+     * Appends a summary of an archive to the catalog in the given archives directory, creating the
+     * catalog if it doesn't exist and compacting it if necessary
+     * @param archives_dir
+     * @param archive_id
+     * @param timestamp_ranges
+     * @param schema_tree
+     * @param compression_level
+     * @throw OperationFailed if the catalog couldn't be locked or compacted
+     */
+    static void append_archive(
+            std::string const& archives_dir,
+            std::string const& archive_id,
+            std::map<std::string, TimestampEntry> const& timestamp_ranges,
+            SchemaTree const& schema_tree,
+            int compression_level
+    );
+
+    /**
+     * Opens the catalog in the given archives directory and indexes its entries. A truncated
+     * trailing entry (e.g., one that's still being appended) is ignored.
+     * @param archives_dir
+     * @return Whether the catalog exists
+     * @throw OperationFailed if the catalog couldn't be opened
+     */
+    bool read(std::string const& archives_dir);
+
+    /**
+     * Decompresses the catalog entry for the given archive.
+     * @param archive_id
+     * @return The catalog entry for the given archive, which remains valid until the next call to
+     * this method, or nullptr if the archive isn't cataloged or its entry couldn't be read
+     */
+    Entry* get_entry(std::string const& archive_id);
+
+private:
+    // Types
+    struct EntryLocation {
+        size_t summary_pos;
+        size_t summary_size;
+    };
+
+    // Variables
+    FileReader m_catalog_reader;
+    std::unordered_map<std::string, EntryLocation> m_entry_locations;
+    std::string m_current_archive_id;
+    std::optional<Entry> m_current_entry;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_ARCHIVECATALOG_HPP
@@ -1,14 +1,36 @@
 #include "ArchiveReader.hpp"
 
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <filesystem>
 #include <string_view>
 
+#include <spdlog/spdlog.h>
+
 #include "archive_constants.hpp"
 #include "ReaderUtils.hpp"
 
 using std::string_view;
 
 namespace clp_s {
+namespace {
+/**
+ * Advises the OS that a region of a memory mapping will be accessed soon. The region is extended to
+ * the preceding page boundary as required by `madvise`.
+ * @param mapping Page-aligned start of the memory mapping
+ * @param offset
+ * @param size
+ */
+void advise_will_need(char* mapping, size_t offset, size_t size) {
+    static auto const cPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    auto const aligned_offset = offset - (offset % cPageSize);
+    // We skip error checking since the advice is only a performance hint.
+    madvise(mapping + aligned_offset, size + (offset - aligned_offset), MADV_WILLNEED);
+}
+}  // namespace
+
 void ArchiveReader::open(string_view archives_dir, string_view archive_id) {
     if (m_is_open) {
         throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
@@ -27,7 +49,15 @@ void ArchiveReader::open(string_view archives_dir, string_view archive_id) {
     m_schema_tree = ReaderUtils::read_schema_tree(archive_path_str);
     m_schema_map = ReaderUtils::read_schemas(archive_path_str);
 
-    m_tables_file_reader.open(archive_path_str + constants::cArchiveTablesFile);
+    try {
+        m_tables_file = std::make_unique<clp::ReadOnlyMemoryMappedFile>(
+                archive_path_str + constants::cArchiveTablesFile
+        );
+    } catch (clp::TraceableException const& e) {
+        // Callers only handle clp_s exceptions, so convert the exception after logging its details
+        SPDLOG_ERROR("Failed to map archive tables file - {}", e.what());
+        throw OperationFailed(ErrorCodeErrno, __FILENAME__, __LINE__);
+    }
     m_table_metadata_file_reader.open(archive_path_str + constants::cArchiveTableMetadataFile);
 }
 
@@ -79,6 +109,74 @@ void ArchiveReader::read_metadata() {
         m_schema_ids.push_back(schema_id);
     }
     m_table_metadata_decompressor.close();
+
+    // Tables are stored back to back, so each table's compressed bytes extend to the start of the
+    // next table or the end of the tables file
+    std::vector<SchemaReader::TableMetadata*> tables_by_offset;
+    tables_by_offset.reserve(m_id_to_table_metadata.size());
+    for (auto& [schema_id, table_metadata] : m_id_to_table_metadata) {
+        tables_by_offset.push_back(&table_metadata);
+    }
+    std::sort(tables_by_offset.begin(), tables_by_offset.end(), [](auto const* a, auto const* b) {
+        return a->offset < b->offset;
+    });
+    auto const tables_file_size = m_tables_file->get_view().size();
+    for (size_t i = 0; i < tables_by_offset.size(); ++i) {
+        auto const end_offset = (i + 1 < tables_by_offset.size()) ? tables_by_offset[i + 1]->offset
+                                                                  : tables_file_size;
+        if (end_offset < tables_by_offset[i]->offset) {
+            throw OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
+        }
+        tables_by_offset[i]->compressed_size = end_offset - tables_by_offset[i]->offset;
+    }
+}
+
+void ArchiveReader::advise_tables_will_be_read(std::vector<int32_t> const& schema_ids) const {
+    auto tables_file_view = m_tables_file->get_view();
+    for (auto schema_id : schema_ids) {
+        auto it = m_id_to_table_metadata.find(schema_id);
+        if (m_id_to_table_metadata.end() == it || 0 == it->second.compressed_size) {
+            continue;
+        }
+        advise_will_need(tables_file_view.data(), it->second.offset, it->second.compressed_size);
+    }
+}
+
+void ArchiveReader::prefetch_tables(
+        std::vector<int32_t> const& schema_ids,
+        size_t max_num_buffered_tables
+) {
+    advise_tables_will_be_read(schema_ids);
+
+    auto tables_file_view = m_tables_file->get_view();
+    std::vector<TablePrefetcher::Table> tables;
+    tables.reserve(schema_ids.size());
+    for (auto schema_id : schema_ids) {
+        auto it = m_id_to_table_metadata.find(schema_id);
+        if (m_id_to_table_metadata.end() == it) {
+            throw OperationFailed(ErrorCodeFileNotFound, __FILENAME__, __LINE__);
+        }
+        auto const& table_metadata = it->second;
+        tables.push_back(
+                {schema_id,
+                 tables_file_view.data() + table_metadata.offset,
+                 table_metadata.compressed_size,
+                 table_metadata.uncompressed_size}
+        );
+    }
+
+    // Stop any previous prefetching before starting again
+    m_table_prefetcher.reset();
+    m_table_prefetcher
+            = std::make_unique<TablePrefetcher>(std::move(tables), max_num_buffered_tables);
+}
+
+void ArchiveReader::open_tables_decompressor(SchemaReader::TableMetadata const& table_metadata) {
+    auto tables_file_view = m_tables_file->get_view();
+    m_tables_decompressor.open(
+            tables_file_view.data() + table_metadata.offset,
+            table_metadata.compressed_size
+    );
 }
 
 void ArchiveReader::read_dictionaries_and_metadata() {
@@ -94,8 +192,6 @@ SchemaReader& ArchiveReader::read_table(
         bool should_extract_timestamp,
         bool should_marshal_records
 ) {
-    constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KB
-
     if (m_id_to_table_metadata.count(schema_id) == 0) {
         throw OperationFailed(ErrorCodeFileNotFound, __FILENAME__, __LINE__);
     }
@@ -107,27 +203,29 @@ SchemaReader& ArchiveReader::read_table(
             should_marshal_records
     );
 
-    m_tables_file_reader.try_seek_from_begin(m_id_to_table_metadata[schema_id].offset);
-    m_tables_decompressor.open(m_tables_file_reader, cDecompressorFileReadBufferCapacity);
-    m_schema_reader.load(
-            m_tables_decompressor,
-            m_id_to_table_metadata[schema_id].uncompressed_size
-    );
+    auto const& table_metadata = m_id_to_table_metadata[schema_id];
+    if (nullptr != m_table_prefetcher) {
+        auto table = m_table_prefetcher->take_table(schema_id);
+        if (table.has_value()) {
+            m_schema_reader.load(std::move(table->buffer), table->size);
+            return m_schema_reader;
+        }
+    }
+
+    open_tables_decompressor(table_metadata);
+    m_schema_reader.load(m_tables_decompressor, table_metadata.uncompressed_size);
     m_tables_decompressor.close_for_reuse();
     return m_schema_reader;
 }
 
 std::vector<std::shared_ptr<SchemaReader>> ArchiveReader::read_all_tables() {
-    constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KB
-
     std::vector<std::shared_ptr<SchemaReader>> readers;
     readers.reserve(m_id_to_table_metadata.size());
     for (auto const& [id, table_metadata] : m_id_to_table_metadata) {
         auto schema_reader = std::make_shared<SchemaReader>();
         initialize_schema_reader(*schema_reader, id, true, true);
 
-        m_tables_file_reader.try_seek_from_begin(table_metadata.offset);
-        m_tables_decompressor.open(m_tables_file_reader, cDecompressorFileReadBufferCapacity);
+        open_tables_decompressor(table_metadata);
         schema_reader->load(m_tables_decompressor, table_metadata.uncompressed_size);
         m_tables_decompressor.close_for_reuse();
 
@@ -304,7 +402,8 @@ void ArchiveReader::close() {
     m_array_dict->close();
     m_timestamp_dict->close();
 
-    m_tables_file_reader.close();
+    m_table_prefetcher.reset();
+    m_tables_file.reset();
     m_table_metadata_file_reader.close();
 
     m_id_to_table_metadata.clear();
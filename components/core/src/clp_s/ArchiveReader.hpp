@@ -2,16 +2,20 @@
 #define CLP_S_ARCHIVEREADER_HPP
 
 #include <map>
+#include <memory>
 #include <set>
 #include <span>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 
+#include "../clp/ReadOnlyMemoryMappedFile.hpp"
 #include "DictionaryReader.hpp"
 #include "ReaderUtils.hpp"
 #include "SchemaReader.hpp"
+#include "TablePrefetcher.hpp"
 #include "TimestampDictionaryReader.hpp"
 #include "Utils.hpp"
 
@@ -32,9 +36,26 @@ public:
      * Opens an archive for reading.
      * @param archives_dir
      * @param archive_id
+     * @throw ArchiveReader::OperationFailed if the archive's tables file can't be mapped
      */
     void open(std::string_view archives_dir, std::string_view archive_id);
 
+    /**
+     * Hints to the OS that the given tables will be read soon so that their compressed bytes can
+     * be paged in ahead of decompression.
+     * @param schema_ids
+     */
+    void advise_tables_will_be_read(std::vector<int32_t> const& schema_ids) const;
+
+    /**
+     * Starts decompressing the given tables on a background thread, in order, so that they're ready
+     * by the time they're read with `read_table`. Tables must then be read in the same order, but
+     * any of them may be skipped.
+     * @param schema_ids
+     * @param max_num_buffered_tables The maximum number of decompressed tables to buffer at once
+     */
+    void prefetch_tables(std::vector<int32_t> const& schema_ids, size_t max_num_buffered_tables);
+
     /**
      * Reads the dictionaries and metadata.
      */
@@ -157,6 +178,13 @@ private:
      */
     BaseColumnReader* append_reader_column(SchemaReader& reader, int32_t column_id);
 
+    /**
+     * Opens the tables decompressor directly on a table's compressed bytes in the memory-mapped
+     * tables file.
+     * @param table_metadata
+     */
+    void open_tables_decompressor(SchemaReader::TableMetadata const& table_metadata);
+
     /**
      * Appends columns for the entire schema of an unordered object.
      * @param reader
@@ -183,7 +211,8 @@ private:
     std::vector<int32_t> m_schema_ids;
     std::map<int32_t, SchemaReader::TableMetadata> m_id_to_table_metadata;
 
-    FileReader m_tables_file_reader;
+    std::unique_ptr<clp::ReadOnlyMemoryMappedFile> m_tables_file;
+    std::unique_ptr<TablePrefetcher> m_table_prefetcher;
     FileReader m_table_metadata_file_reader;
     ZstdDecompressor m_tables_decompressor;
     ZstdDecompressor m_table_metadata_decompressor;
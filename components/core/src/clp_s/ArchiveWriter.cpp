@@ -2,6 +2,7 @@
 
 #include <json/single_include/nlohmann/json.hpp>
 
+#include "ArchiveCatalog.hpp"
 #include "archive_constants.hpp"
 #include "Defs.hpp"
 #include "SchemaTree.hpp"
@@ -11,6 +12,7 @@ void ArchiveWriter::open(ArchiveWriterOption const& option) {
     m_id = boost::uuids::to_string(option.id);
     m_compression_level = option.compression_level;
     m_print_archive_stats = option.print_archive_stats;
+    m_archives_dir = option.archives_dir;
     auto archive_path = boost::filesystem::path(option.archives_dir) / m_id;
 
     boost::system::error_code boost_error_code;
@@ -51,6 +53,14 @@ void ArchiveWriter::close() {
     m_compressed_size += m_schema_map.store(m_archive_path, m_compression_level);
     m_compressed_size += store_tables();
 
+    ArchiveCatalog::append_archive(
+            m_archives_dir,
+            m_id,
+            m_timestamp_dict->get_column_key_to_range(),
+            m_schema_tree,
+            m_compression_level
+    );
+
     if (m_metadata_db) {
         update_metadata_db();
     }
@@ -1,6 +1,7 @@
 #include "CommandLineArguments.hpp"
 
 #include <iostream>
+#include <string_view>
 
 #include <boost/program_options.hpp>
 #include <spdlog/spdlog.h>
@@ -148,6 +149,9 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
             po::options_description compression_options("Compression options");
             std::string metadata_db_config_file_path;
             std::string input_path_list_file_path;
+            constexpr std::string_view cJsonFileType{"json"};
+            constexpr std::string_view cKeyValueIrFileType{"kv-ir"};
+            std::string file_type{cJsonFileType};
             // clang-format off
             compression_options.add_options()(
                     "compression-level",
@@ -189,6 +193,12 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     "structurize-arrays",
                     po::bool_switch(&m_structurize_arrays),
                     "Structurize arrays instead of compressing them as clp strings."
+            )(
+                    "file-type",
+                    po::value<std::string>(&file_type)->value_name("FILE_TYPE")->
+                        default_value(file_type),
+                    "The type of the input files: json, or kv-ir for zstd-compressed key-value "
+                    "pair IR streams."
             );
             // clang-format on
 
@@ -219,6 +229,10 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 std::cerr << "  # Compress file1.json and dir1 into archives-dir" << std::endl;
                 std::cerr << "  " << m_program_name << " c archives-dir file1.json dir1"
                           << std::endl;
+                std::cerr << "  # Compress the kv-pair IR stream file1.clp.zst into archives-dir"
+                          << std::endl;
+                std::cerr << "  " << m_program_name
+                          << " c --file-type kv-ir archives-dir file1.clp.zst" << std::endl;
 
                 po::options_description visible_options;
                 visible_options.add(general_options);
@@ -242,6 +256,19 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 throw std::invalid_argument("No input paths specified.");
             }
 
+            if (cJsonFileType == file_type) {
+                m_file_type = FileType::Json;
+            } else if (cKeyValueIrFileType == file_type) {
+                m_file_type = FileType::KeyValueIr;
+                if (m_structurize_arrays) {
+                    throw std::invalid_argument(
+                            "--structurize-arrays isn't supported for kv-ir input files."
+                    );
+                }
+            } else {
+                throw std::invalid_argument("Unknown file type: " + file_type);
+            }
+
             // Parse and validate global metadata DB config
             if (false == metadata_db_config_file_path.empty()) {
                 clp::GlobalMetadataDBConfig metadata_db_config;
@@ -443,6 +470,18 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
             // clang-format on
             search_options.add(aggregation_options);
 
+            po::options_description performance_options("Performance Options");
+            // clang-format off
+            performance_options.add_options()(
+                    "prefetch-tables",
+                    po::value<size_t>(&m_num_prefetched_tables)->value_name("N")->
+                            default_value(m_num_prefetched_tables),
+                    "Decompress up to N upcoming tables in the background while searching"
+                    " (0 disables prefetching)"
+            );
+            // clang-format on
+            search_options.add(performance_options);
+
             po::options_description network_output_handler_options("Network Output Handler Options"
             );
             // clang-format off
@@ -569,6 +608,7 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 visible_options.add(general_options);
                 visible_options.add(match_options);
                 visible_options.add(aggregation_options);
+                visible_options.add(performance_options);
                 visible_options.add(network_output_handler_options);
                 visible_options.add(results_cache_output_handler_options);
                 visible_options.add(reducer_output_handler_options);
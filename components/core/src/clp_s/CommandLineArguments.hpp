@@ -36,6 +36,11 @@ public:
         Stdout,
     };
 
+    enum class FileType : uint8_t {
+        Json = 0,
+        KeyValueIr
+    };
+
     // Constructors
     explicit CommandLineArguments(std::string const& program_name) : m_program_name(program_name) {}
 
@@ -82,6 +87,8 @@ public:
 
     bool get_ignore_case() const { return m_ignore_case; }
 
+    size_t get_num_prefetched_tables() const { return m_num_prefetched_tables; }
+
     std::string const& get_archive_id() const { return m_archive_id; }
 
     std::optional<clp::GlobalMetadataDBConfig> const& get_metadata_db_config() const {
@@ -104,6 +111,8 @@ public:
 
     bool get_structurize_arrays() const { return m_structurize_arrays; }
 
+    FileType get_file_type() const { return m_file_type; }
+
     bool get_ordered_decompression() const { return m_ordered_decompression; }
 
     size_t get_ordered_chunk_size() const { return m_ordered_chunk_size; }
@@ -171,6 +180,7 @@ private:
     bool m_print_archive_stats{false};
     size_t m_max_document_size{512ULL * 1024 * 1024};  // 512 MB
     bool m_structurize_arrays{false};
+    FileType m_file_type{FileType::Json};
     bool m_ordered_decompression{false};
     size_t m_ordered_chunk_size{0};
 
@@ -192,6 +202,7 @@ private:
     std::optional<epochtime_t> m_search_begin_ts;
     std::optional<epochtime_t> m_search_end_ts;
     bool m_ignore_case{false};
+    size_t m_num_prefetched_tables{0};
 
     // Decompression and search variables
     std::string m_archive_id;
@@ -3,9 +3,17 @@
 #ifndef CLP_S_DICTIONARYREADER_HPP
 #define CLP_S_DICTIONARYREADER_HPP
 
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
-#include <boost/algorithm/string/case_conv.hpp>
+#include <string_utils/WildcardMatcher.hpp>
 
 #include "DictionaryEntry.hpp"
 #include "Utils.hpp"
@@ -81,10 +89,26 @@ public:
     ) const;
 
 protected:
+    /**
+     * Extends the case-insensitive index to cover any entries read since it was last updated. The
+     * index is built lazily on the first case-insensitive exact-match lookup.
+     */
+    void update_case_insensitive_index() const;
+
+    /**
+     * @param value
+     * @return The hash of the lowercase form of the given value
+     */
+    static size_t hash_case_folded(std::string_view value);
+
     bool m_is_open;
     FileReader m_dictionary_file_reader;
     ZstdDecompressor m_dictionary_decompressor;
     std::vector<EntryType> m_entries;
+
+    // Sorted (hash of lowercase value, entry ID) pairs for every entry. Only hashes are stored,
+    // rather than lowercase copies of the values, so the index is small relative to the dictionary.
+    mutable std::vector<std::pair<size_t, DictionaryIdType>> m_case_insensitive_index;
 };
 
 class VariableDictionaryReader : public DictionaryReader<uint64_t, VariableDictionaryEntry> {};
@@ -182,9 +206,22 @@ EntryType const* DictionaryReader<DictionaryIdType, EntryType>::get_entry_matchi
             }
         }
     } else {
-        auto const& search_string_uppercase = boost::algorithm::to_upper_copy(search_string);
-        for (auto const& entry : m_entries) {
-            if (boost::algorithm::to_upper_copy(entry.get_value()) == search_string_uppercase) {
+        auto const chars_equal_ignoring_case = [](unsigned char lhs, unsigned char rhs) {
+            return std::tolower(lhs) == std::tolower(rhs);
+        };
+        update_case_insensitive_index();
+        auto const search_string_hash = hash_case_folded(search_string);
+        // Entries with the same hash are ordered by ID, so the first match is the first entry
+        for (auto it = std::lower_bound(
+                     m_case_insensitive_index.cbegin(),
+                     m_case_insensitive_index.cend(),
+                     std::pair<size_t, DictionaryIdType>{search_string_hash, 0}
+             );
+             m_case_insensitive_index.cend() != it && it->first == search_string_hash;
+             ++it)
+        {
+            auto const& entry = m_entries[it->second];
+            if (std::ranges::equal(entry.get_value(), search_string, chars_equal_ignoring_case)) {
                 return &entry;
             }
         }
@@ -199,12 +236,44 @@ void DictionaryReader<DictionaryIdType, EntryType>::get_entries_matching_wildcar
         bool ignore_case,
         std::unordered_set<EntryType const*>& entries
 ) const {
+    // The matcher ignores case itself, so wildcard lookups don't need a case-folded index
+    clp::string_utils::WildcardMatcher const matcher{wildcard_string, false == ignore_case};
     for (auto const& entry : m_entries) {
-        if (StringUtils::wildcard_match_unsafe(entry.get_value(), wildcard_string, !ignore_case)) {
+        if (matcher.matches(entry.get_value())) {
             entries.insert(&entry);
         }
     }
 }
+
+template <typename DictionaryIdType, typename EntryType>
+void DictionaryReader<DictionaryIdType, EntryType>::update_case_insensitive_index() const {
+    auto const num_indexed_entries = m_case_insensitive_index.size();
+    if (num_indexed_entries == m_entries.size()) {
+        return;
+    }
+
+    m_case_insensitive_index.reserve(m_entries.size());
+    for (size_t i = num_indexed_entries; i < m_entries.size(); ++i) {
+        m_case_insensitive_index.emplace_back(
+                hash_case_folded(m_entries[i].get_value()),
+                static_cast<DictionaryIdType>(i)
+        );
+    }
+    auto const new_entries_begin = m_case_insensitive_index.begin() + num_indexed_entries;
+    std::sort(new_entries_begin, m_case_insensitive_index.end());
+    std::inplace_merge(
+            m_case_insensitive_index.begin(),
+            new_entries_begin,
+            m_case_insensitive_index.end()
+    );
+}
+
+template <typename DictionaryIdType, typename EntryType>
+size_t DictionaryReader<DictionaryIdType, EntryType>::hash_case_folded(std::string_view value) {
+    std::string value_lowercase{value};
+    StringUtils::to_lower(value_lowercase);
+    return std::hash<std::string>{}(value_lowercase);
+}
 }  // namespace clp_s
 
 #endif  // CLP_S_DICTIONARYREADER_HPP
@@ -1,15 +1,41 @@
 #include "JsonParser.hpp"
 
 #include <iostream>
+#include <optional>
 #include <stack>
+#include <string>
+#include <system_error>
 
 #include <simdjson.h>
 #include <spdlog/spdlog.h>
 
+#include "../clp/ErrorCode.hpp"
+#include "../clp/ffi/ir_stream/Deserializer.hpp"
+#include "../clp/ffi/KeyValuePairLogEvent.hpp"
+#include "../clp/ffi/SchemaTree.hpp"
+#include "../clp/ffi/SchemaTreeNode.hpp"
+#include "../clp/ffi/utils.hpp"
+#include "../clp/ffi/Value.hpp"
+#include "../clp/ir/EncodedTextAst.hpp"
+#include "../clp/streaming_compression/zstd/Decompressor.hpp"
 #include "archive_constants.hpp"
 #include "JsonFileIterator.hpp"
 
 namespace clp_s {
+namespace {
+/**
+ * Decodes an IR value that's an encoded text AST
+ * @param ir_value
+ * @return the decoded text, or std::nullopt if the value can't be decoded
+ */
+std::optional<std::string> decode_encoded_text_ast(clp::ffi::Value const& ir_value) {
+    if (ir_value.is<clp::ir::FourByteEncodedTextAst>()) {
+        return ir_value.get_immutable_view<clp::ir::FourByteEncodedTextAst>().decode_and_unparse();
+    }
+    return ir_value.get_immutable_view<clp::ir::EightByteEncodedTextAst>().decode_and_unparse();
+}
+}  // namespace
+
 JsonParser::JsonParser(JsonParserOption const& option)
         : m_num_messages(0),
           m_target_encoded_size(option.target_encoded_size),
@@ -520,12 +546,315 @@ bool JsonParser::parse() {
     return true;
 }
 
+bool JsonParser::parse_from_ir() {
+    for (auto& file_path : m_file_paths) {
+        clp::streaming_compression::zstd::Decompressor decompressor;
+        if (clp::ErrorCode_Success != decompressor.open(file_path)) {
+            SPDLOG_ERROR("Failed to open {}", file_path);
+            m_archive_writer->close();
+            return false;
+        }
+
+        auto deserializer_result = clp::ffi::ir_stream::Deserializer::create(decompressor);
+        if (deserializer_result.has_error()) {
+            SPDLOG_ERROR(
+                    "Encountered error - {} - while trying to read the IR stream preamble of {}",
+                    deserializer_result.error().message(),
+                    file_path
+            );
+            decompressor.close();
+            m_archive_writer->close();
+            return false;
+        }
+        auto& deserializer = deserializer_result.value();
+
+        // IR schema tree node IDs are only unique within a single stream
+        m_ir_node_to_archive_node_id.clear();
+        m_ir_node_is_timestamp.clear();
+
+        m_num_messages = 0;
+        size_t bytes_consumed_up_to_prev_archive = 0;
+        size_t bytes_consumed_up_to_prev_record = 0;
+        while (true) {
+            auto kv_log_event_result = deserializer.deserialize_to_next_log_event(decompressor);
+            if (kv_log_event_result.has_error()) {
+                auto const error = kv_log_event_result.error();
+                if (std::errc::no_message_available == error) {
+                    break;
+                }
+                if (std::errc::result_out_of_range == error) {
+                    // Like truncated JSON, don't treat a truncated IR stream as an error
+                    SPDLOG_WARN(
+                            "Truncated IR stream after parsing {} bytes of {}",
+                            bytes_consumed_up_to_prev_record,
+                            file_path
+                    );
+                    break;
+                }
+                SPDLOG_ERROR(
+                        "Encountered error - {} - while trying to parse {} after parsing {} bytes",
+                        error.message(),
+                        file_path,
+                        bytes_consumed_up_to_prev_record
+                );
+                decompressor.close();
+                m_archive_writer->close();
+                return false;
+            }
+
+            m_current_schema.clear();
+            if (false == parse_kv_log_event(kv_log_event_result.value())) {
+                SPDLOG_ERROR(
+                        "Encountered invalid log event while trying to parse {} after parsing {} "
+                        "bytes",
+                        file_path,
+                        bytes_consumed_up_to_prev_record
+                );
+                decompressor.close();
+                m_archive_writer->close();
+                return false;
+            }
+            m_num_messages++;
+
+            int32_t current_schema_id = m_archive_writer->add_schema(m_current_schema);
+            m_current_parsed_message.set_id(current_schema_id);
+            m_archive_writer
+                    ->append_message(current_schema_id, m_current_schema, m_current_parsed_message);
+
+            bytes_consumed_up_to_prev_record = decompressor.get_pos();
+            if (m_archive_writer->get_data_size() >= m_target_encoded_size) {
+                m_archive_writer->increment_uncompressed_size(
+                        bytes_consumed_up_to_prev_record - bytes_consumed_up_to_prev_archive
+                );
+                bytes_consumed_up_to_prev_archive = bytes_consumed_up_to_prev_record;
+                split_archive();
+            }
+
+            m_current_parsed_message.clear();
+        }
+
+        m_archive_writer->increment_uncompressed_size(
+                decompressor.get_pos() - bytes_consumed_up_to_prev_archive
+        );
+        decompressor.close();
+    }
+    return true;
+}
+
+bool JsonParser::parse_kv_log_event(clp::ffi::KeyValuePairLogEvent const& kv_log_event) {
+    auto const& ir_tree = kv_log_event.get_schema_tree();
+    auto const& node_id_value_pairs = kv_log_event.get_node_id_value_pairs();
+    if (node_id_value_pairs.empty()) {
+        // The log event is an empty object
+        m_current_schema.insert_ordered(
+                get_archive_node_id(clp::ffi::SchemaTree::cRootId, NodeType::Object, ir_tree)
+        );
+        return true;
+    }
+
+    bool can_match_timestamp = false == m_timestamp_column.empty();
+    std::string value;
+    for (auto const& [ir_node_id, optional_ir_value] : node_id_value_pairs) {
+        int32_t node_id;
+        if (false == optional_ir_value.has_value()) {
+            // The value is an empty object
+            node_id = get_archive_node_id(ir_node_id, NodeType::Object, ir_tree);
+            m_current_schema.insert_ordered(node_id);
+            continue;
+        }
+
+        auto const& ir_value = optional_ir_value.value();
+        bool const matches_timestamp
+                = can_match_timestamp && is_ir_timestamp_node(ir_node_id, ir_tree);
+        try {
+            switch (ir_tree.get_node(ir_node_id).get_type()) {
+                case clp::ffi::SchemaTreeNode::Type::Int: {
+                    auto const i64_value = ir_value.get_immutable_view<clp::ffi::value_int_t>();
+                    node_id = get_archive_node_id(ir_node_id, NodeType::Integer, ir_tree);
+                    m_current_parsed_message.add_value(node_id, i64_value);
+                    if (matches_timestamp) {
+                        m_archive_writer
+                                ->ingest_timestamp_entry(m_timestamp_key, node_id, i64_value);
+                        can_match_timestamp = false;
+                    }
+                    break;
+                }
+                case clp::ffi::SchemaTreeNode::Type::Float: {
+                    auto const double_value
+                            = ir_value.get_immutable_view<clp::ffi::value_float_t>();
+                    node_id = get_archive_node_id(ir_node_id, NodeType::Float, ir_tree);
+                    m_current_parsed_message.add_value(node_id, double_value);
+                    if (matches_timestamp) {
+                        m_archive_writer
+                                ->ingest_timestamp_entry(m_timestamp_key, node_id, double_value);
+                        can_match_timestamp = false;
+                    }
+                    break;
+                }
+                case clp::ffi::SchemaTreeNode::Type::Bool: {
+                    node_id = get_archive_node_id(ir_node_id, NodeType::Boolean, ir_tree);
+                    m_current_parsed_message.add_value(
+                            node_id,
+                            ir_value.get_immutable_view<clp::ffi::value_bool_t>()
+                    );
+                    break;
+                }
+                case clp::ffi::SchemaTreeNode::Type::Str: {
+                    // Strings are stored escaped, the same way they appear in JSON
+                    value.clear();
+                    if (ir_value.is<std::string>()) {
+                        if (false
+                            == clp::ffi::validate_and_append_escaped_utf8_string(
+                                    ir_value.get_immutable_view<std::string>(),
+                                    value
+                            ))
+                        {
+                            return false;
+                        }
+                    } else {
+                        auto const decoded_value = decode_encoded_text_ast(ir_value);
+                        if (false == decoded_value.has_value()
+                            || false
+                                       == clp::ffi::validate_and_append_escaped_utf8_string(
+                                               decoded_value.value(),
+                                               value
+                                       ))
+                        {
+                            return false;
+                        }
+                    }
+
+                    if (matches_timestamp) {
+                        node_id = get_archive_node_id(ir_node_id, NodeType::DateString, ir_tree);
+                        uint64_t encoding_id{0};
+                        epochtime_t timestamp = m_archive_writer->ingest_timestamp_entry(
+                                m_timestamp_key,
+                                node_id,
+                                value,
+                                encoding_id
+                        );
+                        m_current_parsed_message.add_value(node_id, encoding_id, timestamp);
+                        can_match_timestamp = false;
+                    } else if (value.find(' ') != std::string::npos) {
+                        node_id = get_archive_node_id(ir_node_id, NodeType::ClpString, ir_tree);
+                        m_current_parsed_message.add_value(node_id, value);
+                    } else {
+                        node_id = get_archive_node_id(ir_node_id, NodeType::VarString, ir_tree);
+                        m_current_parsed_message.add_value(node_id, value);
+                    }
+                    break;
+                }
+                case clp::ffi::SchemaTreeNode::Type::UnstructuredArray: {
+                    // Arrays are stored as their JSON text
+                    auto const decoded_value = decode_encoded_text_ast(ir_value);
+                    if (false == decoded_value.has_value()) {
+                        return false;
+                    }
+                    node_id = get_archive_node_id(
+                            ir_node_id,
+                            NodeType::UnstructuredArray,
+                            ir_tree
+                    );
+                    m_current_parsed_message.add_value(node_id, decoded_value.value());
+                    break;
+                }
+                case clp::ffi::SchemaTreeNode::Type::Obj: {
+                    if (false == ir_value.is_null()) {
+                        return false;
+                    }
+                    node_id = get_archive_node_id(ir_node_id, NodeType::NullValue, ir_tree);
+                    break;
+                }
+                default:
+                    return false;
+            }
+        } catch (clp::ffi::Value::OperationFailed const& ex) {
+            return false;
+        }
+        m_current_schema.insert_ordered(node_id);
+    }
+    return true;
+}
+
+int32_t JsonParser::get_archive_node_id(
+        clp::ffi::SchemaTreeNode::id_t ir_node_id,
+        NodeType archive_node_type,
+        clp::ffi::SchemaTree const& ir_tree
+) {
+    if (auto it = m_ir_node_to_archive_node_id.find({ir_node_id, archive_node_type});
+        m_ir_node_to_archive_node_id.end() != it)
+    {
+        return it->second;
+    }
+
+    // Find the closest ancestor that's already in the archive, and then add every node below it.
+    // Every ancestor in the archive is an object.
+    std::vector<clp::ffi::SchemaTreeNode::id_t> ir_node_ids_to_add{ir_node_id};
+    int32_t parent_node_id{-1};
+    while (clp::ffi::SchemaTree::cRootId != ir_node_ids_to_add.back()) {
+        auto const ir_parent_id = ir_tree.get_node(ir_node_ids_to_add.back()).get_parent_id();
+        if (auto it = m_ir_node_to_archive_node_id.find({ir_parent_id, NodeType::Object});
+            m_ir_node_to_archive_node_id.end() != it)
+        {
+            parent_node_id = it->second;
+            break;
+        }
+        ir_node_ids_to_add.push_back(ir_parent_id);
+    }
+
+    int32_t node_id{-1};
+    while (false == ir_node_ids_to_add.empty()) {
+        auto const curr_ir_node_id = ir_node_ids_to_add.back();
+        ir_node_ids_to_add.pop_back();
+        auto const curr_node_type
+                = ir_node_ids_to_add.empty() ? archive_node_type : NodeType::Object;
+        std::string const key{ir_tree.get_node(curr_ir_node_id).get_key_name()};
+        node_id = m_archive_writer->add_node(parent_node_id, curr_node_type, key);
+        m_ir_node_to_archive_node_id.emplace(
+                std::make_pair(curr_ir_node_id, curr_node_type),
+                node_id
+        );
+        parent_node_id = node_id;
+    }
+    return node_id;
+}
+
+bool JsonParser::is_ir_timestamp_node(
+        clp::ffi::SchemaTreeNode::id_t ir_node_id,
+        clp::ffi::SchemaTree const& ir_tree
+) {
+    if (auto it = m_ir_node_is_timestamp.find(ir_node_id); m_ir_node_is_timestamp.end() != it) {
+        return it->second;
+    }
+
+    // Compare the node's path, from the leaf up, with the timestamp column
+    bool is_timestamp{true};
+    auto curr_ir_node_id = ir_node_id;
+    for (auto it = m_timestamp_column.rbegin(); m_timestamp_column.rend() != it; ++it) {
+        if (clp::ffi::SchemaTree::cRootId == curr_ir_node_id) {
+            is_timestamp = false;
+            break;
+        }
+        auto const& ir_node = ir_tree.get_node(curr_ir_node_id);
+        if (ir_node.get_key_name() != *it) {
+            is_timestamp = false;
+            break;
+        }
+        curr_ir_node_id = ir_node.get_parent_id();
+    }
+    is_timestamp = is_timestamp && clp::ffi::SchemaTree::cRootId == curr_ir_node_id;
+    m_ir_node_is_timestamp.emplace(ir_node_id, is_timestamp);
+    return is_timestamp;
+}
+
 void JsonParser::store() {
     m_archive_writer->close();
 }
 
 void JsonParser::split_archive() {
     m_archive_writer->close();
+    // The new archive's schema tree starts out empty
+    m_ir_node_to_archive_node_id.clear();
     m_archive_options.id = m_generator();
     m_archive_writer->open(m_archive_options);
 }
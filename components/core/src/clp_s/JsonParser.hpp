@@ -3,12 +3,17 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include <variant>
 #include <vector>
 
+#include <absl/container/flat_hash_map.h>
 #include <boost/uuid/random_generator.hpp>
 #include <simdjson.h>
 
+#include "../clp/ffi/KeyValuePairLogEvent.hpp"
+#include "../clp/ffi/SchemaTree.hpp"
+#include "../clp/ffi/SchemaTreeNode.hpp"
 #include "../clp/GlobalMySQLMetadataDB.hpp"
 #include "ArchiveWriter.hpp"
 #include "DictionaryWriter.hpp"
@@ -59,6 +64,13 @@ public:
      */
     [[nodiscard]] bool parse();
 
+    /**
+     * Parses the log events in the key-value pair IR streams and stores the parsed data in the
+     * archive. Each IR stream is expected to be zstd-compressed.
+     * @return whether the IR streams were parsed succesfully
+     */
+    [[nodiscard]] bool parse_from_ir();
+
     /**
      * Writes the metadata and archive data to disk.
      */
@@ -88,6 +100,37 @@ private:
      */
     void parse_obj_in_array(ondemand::object line, int32_t parent_node_id);
 
+    /**
+     * Parses a key-value pair log event from an IR stream
+     * @param kv_log_event
+     * @return whether the log event was parsed successfully
+     */
+    [[nodiscard]] bool parse_kv_log_event(clp::ffi::KeyValuePairLogEvent const& kv_log_event);
+
+    /**
+     * Gets the ID of the archive's schema tree node that corresponds to the given IR schema tree
+     * node, adding the node and any of its missing ancestors to the archive's schema tree.
+     * @param ir_node_id
+     * @param archive_node_type The type of the archive node, which depends on the IR node's value
+     * @param ir_tree
+     * @return the archive node ID
+     */
+    int32_t get_archive_node_id(
+            clp::ffi::SchemaTreeNode::id_t ir_node_id,
+            NodeType archive_node_type,
+            clp::ffi::SchemaTree const& ir_tree
+    );
+
+    /**
+     * @param ir_node_id
+     * @param ir_tree
+     * @return whether the given IR schema tree node is the timestamp column
+     */
+    bool is_ir_timestamp_node(
+            clp::ffi::SchemaTreeNode::id_t ir_node_id,
+            clp::ffi::SchemaTree const& ir_tree
+    );
+
     /**
      * Splits the archive if the size of the archive exceeds the maximum size
      */
@@ -108,6 +151,13 @@ private:
     size_t m_target_encoded_size;
     size_t m_max_document_size;
     bool m_structurize_arrays{false};
+
+    // Archive schema tree nodes corresponding to the current IR stream's schema tree nodes, keyed
+    // by IR node ID and archive node type. Only valid for the current IR stream and archive.
+    absl::flat_hash_map<std::pair<clp::ffi::SchemaTreeNode::id_t, NodeType>, int32_t>
+            m_ir_node_to_archive_node_id;
+    // Whether each of the current IR stream's schema tree nodes is the timestamp column
+    absl::flat_hash_map<clp::ffi::SchemaTreeNode::id_t, bool> m_ir_node_is_timestamp;
 };
 }  // namespace clp_s
 
@@ -47,6 +47,16 @@ void SchemaReader::load(ZstdDecompressor& decompressor, size_t uncompressed_size
         throw OperationFailed(error, __FILENAME__, __LINE__);
     }
 
+    load_columns(uncompressed_size);
+}
+
+void SchemaReader::load(std::unique_ptr<char[]> table_buffer, size_t uncompressed_size) {
+    m_table_buffer = std::move(table_buffer);
+    m_table_buffer_size = uncompressed_size;
+    load_columns(uncompressed_size);
+}
+
+void SchemaReader::load_columns(size_t uncompressed_size) {
     BufferViewReader buffer_reader{m_table_buffer.get(), uncompressed_size};
     for (auto& reader : m_columns) {
         reader->load(buffer_reader, m_num_messages);
@@ -51,6 +51,8 @@ public:
         uint64_t num_messages;
         size_t offset;
         size_t uncompressed_size;
+        // Derived from the offsets of neighbouring tables rather than stored in the archive
+        size_t compressed_size{0};
     };
 
     // Constructor
@@ -136,6 +138,13 @@ public:
      */
     void load(ZstdDecompressor& decompressor, size_t uncompressed_size);
 
+    /**
+     * Loads the encoded messages from an already decompressed table, taking ownership of its buffer
+     * @param table_buffer
+     * @param uncompressed_size
+     */
+    void load(std::unique_ptr<char[]> table_buffer, size_t uncompressed_size);
+
     /**
      * Gets next message
      * @param message
@@ -259,6 +268,12 @@ private:
             std::vector<int32_t>& path_to_intersection
     );
 
+    /**
+     * Loads the column readers from the decompressed table in m_table_buffer
+     * @param uncompressed_size
+     */
+    void load_columns(size_t uncompressed_size);
+
     /**
      * Generates a json string from the extracted values
      */
@@ -0,0 +1,111 @@
+#include "TablePrefetcher.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include "ZstdDecompressor.hpp"
+
+namespace clp_s {
+TablePrefetcher::TablePrefetcher(std::vector<Table> tables, size_t max_num_buffered_tables)
+        : m_tables(std::move(tables)),
+          m_max_num_buffered_tables(max_num_buffered_tables) {
+    if (0 == m_max_num_buffered_tables) {
+        throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
+    }
+    m_thread = std::thread(&TablePrefetcher::prefetch, this);
+}
+
+TablePrefetcher::~TablePrefetcher() {
+    {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        m_should_stop = true;
+    }
+    m_prefetcher_cv.notify_one();
+    m_thread.join();
+}
+
+std::optional<TablePrefetcher::DecompressedTable> TablePrefetcher::take_table(int32_t schema_id) {
+    auto const remaining_tables_begin
+            = m_tables.cbegin() + static_cast<std::ptrdiff_t>(m_next_table_to_take_idx);
+    auto const it = std::find_if(
+            remaining_tables_begin,
+            m_tables.cend(),
+            [schema_id](Table const& table) { return table.schema_id == schema_id; }
+    );
+    if (m_tables.cend() == it) {
+        return std::nullopt;
+    }
+    auto const table_idx = static_cast<size_t>(it - m_tables.cbegin());
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_reader_cv.wait(lock, [this] {
+            return false == m_buffered_tables.empty() || m_is_prefetching_done;
+        });
+        if (m_buffered_tables.empty()) {
+            // Prefetching stopped before reaching the table
+            m_next_table_to_take_idx = table_idx + 1;
+            return std::nullopt;
+        }
+
+        // Tables are buffered in order, so the front of the buffer is always the next table
+        auto table = std::move(m_buffered_tables.front());
+        m_buffered_tables.pop_front();
+        auto const taken_table_idx = m_next_table_to_take_idx++;
+        m_prefetcher_cv.notify_one();
+        if (taken_table_idx == table_idx) {
+            return table;
+        }
+    }
+}
+
+void TablePrefetcher::prefetch() {
+    try {
+        ZstdDecompressor decompressor;
+        for (auto const& table : m_tables) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_prefetcher_cv.wait(lock, [this] {
+                    return m_should_stop || m_buffered_tables.size() < m_max_num_buffered_tables;
+                });
+                if (m_should_stop) {
+                    break;
+                }
+            }
+
+            auto buffer = std::make_unique<char[]>(table.uncompressed_size);
+            decompressor.open(table.compressed_data, table.compressed_size);
+            auto const error
+                    = decompressor.try_read_exact_length(buffer.get(), table.uncompressed_size);
+            decompressor.close();
+            if (ErrorCodeSuccess != error) {
+                SPDLOG_ERROR(
+                        "Failed to prefetch table for schema {}, error={}.",
+                        table.schema_id,
+                        static_cast<int>(error)
+                );
+                break;
+            }
+
+            {
+                std::lock_guard<std::mutex> const lock(m_mutex);
+                m_buffered_tables.push_back(
+                        {table.schema_id, std::move(buffer), table.uncompressed_size}
+                );
+            }
+            m_reader_cv.notify_one();
+        }
+    } catch (std::exception const& e) {
+        SPDLOG_ERROR("Table prefetching failed - {}", e.what());
+    }
+
+    {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        m_is_prefetching_done = true;
+    }
+    m_reader_cv.notify_one();
+}
+}  // namespace clp_s
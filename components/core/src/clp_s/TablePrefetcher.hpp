@@ -0,0 +1,98 @@
+#ifndef CLP_S_TABLEPREFETCHER_HPP
+#define CLP_S_TABLEPREFETCHER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "TraceableException.hpp"
+
+namespace clp_s {
+/**
+ * Decompresses a sequence of tables on a background thread so that each table is ready by the time
+ * the caller reads it. At most a fixed number of decompressed tables are buffered at once, bounding
+ * the memory used by prefetching.
+ *
+ * The compressed tables must remain mapped in memory for the lifetime of the prefetcher.
+ */
+class TablePrefetcher {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    struct Table {
+        int32_t schema_id;
+        char const* compressed_data;
+        size_t compressed_size;
+        size_t uncompressed_size;
+    };
+
+    struct DecompressedTable {
+        int32_t schema_id;
+        std::unique_ptr<char[]> buffer;
+        size_t size;
+    };
+
+    // Constructors
+    /**
+     * Starts prefetching the given tables in order
+     * @param tables
+     * @param max_num_buffered_tables
+     * @throw OperationFailed if max_num_buffered_tables is 0
+     */
+    TablePrefetcher(std::vector<Table> tables, size_t max_num_buffered_tables);
+
+    // Destructor
+    ~TablePrefetcher();
+
+    // Explicitly disable copy and move constructor/assignment
+    TablePrefetcher(TablePrefetcher const&) = delete;
+
+    TablePrefetcher& operator=(TablePrefetcher const&) = delete;
+
+    // Methods
+    /**
+     * Waits for and takes the decompressed table with the given schema ID. Any tables prefetched
+     * before it are discarded since tables are read in order.
+     * @param schema_id
+     * @return The decompressed table, or std::nullopt if the table isn't among the remaining tables
+     * or couldn't be decompressed, in which case the caller should read the table itself
+     */
+    std::optional<DecompressedTable> take_table(int32_t schema_id);
+
+private:
+    // Methods
+    /**
+     * Decompresses each table in m_tables, blocking whenever the buffer is full
+     */
+    void prefetch();
+
+    // Variables
+    std::vector<Table> m_tables;
+    size_t m_max_num_buffered_tables;
+    // Index in m_tables of the next table to be taken by the caller
+    size_t m_next_table_to_take_idx{0};
+
+    std::mutex m_mutex;
+    std::condition_variable m_prefetcher_cv;
+    std::condition_variable m_reader_cv;
+    std::deque<DecompressedTable> m_buffered_tables;
+    bool m_is_prefetching_done{false};
+    bool m_should_stop{false};
+
+    std::thread m_thread;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_TABLEPREFETCHER_HPP
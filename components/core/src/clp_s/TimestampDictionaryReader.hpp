@@ -21,6 +21,9 @@ public:
                 : TraceableException(error_code, filename, line_number) {}
     };
 
+    using tokenized_column_to_range_t
+            = std::vector<std::pair<std::vector<std::string>, TimestampEntry*>>;
+
     // Constructors
     TimestampDictionaryReader() : m_is_open(false) {}
 
@@ -64,6 +67,10 @@ public:
 
     auto tokenized_column_to_range_end() const { return m_tokenized_column_to_range.end(); }
 
+    tokenized_column_to_range_t const& get_tokenized_column_to_range() const {
+        return m_tokenized_column_to_range;
+    }
+
     std::optional<std::vector<std::string>>& get_authoritative_timestamp_tokenized_column() {
         return m_authoritative_timestamp_tokenized_column;
     }
@@ -74,8 +81,6 @@ public:
 
 private:
     using id_to_pattern_t = std::map<uint64_t, TimestampPattern>;
-    using tokenized_column_to_range_t
-            = std::vector<std::pair<std::vector<std::string>, TimestampEntry*>>;
 
     // Variables
     bool m_is_open;
@@ -91,11 +91,12 @@ public:
      */
     epochtime_t get_end_timestamp() const;
 
-private:
     /**
-     * Merges timestamp ranges with the same key name
+     * @return the timestamp ranges ingested so far, keyed by column name
      */
-    void merge_range();
+    std::map<std::string, TimestampEntry> const& get_column_key_to_range() const {
+        return m_column_key_to_range;
+    }
 
     /**
      * Writes timestamp entries to the disk
@@ -107,6 +108,12 @@ private:
             ZstdCompressor& compressor
     );
 
+private:
+    /**
+     * Merges timestamp ranges with the same key name
+     */
+    void merge_range();
+
     using pattern_to_id_t = std::unordered_map<TimestampPattern const*, uint64_t>;
 
     // Variables
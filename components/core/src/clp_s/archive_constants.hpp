@@ -2,6 +2,9 @@
 #define CLP_S_ARCHIVE_CONSTANTS_HPP
 
 namespace clp_s::constants {
+// Archives directory files
+constexpr char cArchivesCatalogFile[] = "/archive_catalog";
+
 // Schema files
 constexpr char cArchiveSchemaMapFile[] = "/schema_ids";
 constexpr char cArchiveSchemaTreeFile[] = "/schema_tree";
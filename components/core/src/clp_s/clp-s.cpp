@@ -14,6 +14,7 @@
 #include "../clp/GlobalMySQLMetadataDB.hpp"
 #include "../clp/streaming_archive/ArchiveMetadata.hpp"
 #include "../reducer/network_utils.hpp"
+#include "ArchiveCatalog.hpp"
 #include "CommandLineArguments.hpp"
 #include "Defs.hpp"
 #include "JsonConstructor.hpp"
@@ -22,6 +23,7 @@
 #include "search/AddTimestampConditions.hpp"
 #include "search/ConvertToExists.hpp"
 #include "search/EmptyExpr.hpp"
+#include "search/EvaluateKeyPathIndex.hpp"
 #include "search/EvaluateTimestampIndex.hpp"
 #include "search/Expression.hpp"
 #include "search/kql/kql.hpp"
@@ -69,6 +71,30 @@ bool search_archive(
         int reducer_socket_fd
 );
 
+/**
+ * Prepares the search AST for evaluation against the archive catalog by running the
+ * archive-independent passes that `search_archive` runs.
+ * @param expr A copy of the search AST which may be modified
+ * @return The prepared AST, or nullptr if the query is logically false
+ */
+std::shared_ptr<Expression> prepare_catalog_expression(std::shared_ptr<Expression> expr);
+
+/**
+ * Checks whether the archive catalog proves that the given archive can't contain any results, in
+ * which case the archive needn't be opened.
+ * @param command_line_arguments
+ * @param archive_catalog
+ * @param expr The search AST returned by `prepare_catalog_expression`
+ * @param archive_id
+ * @return Whether the archive can be skipped
+ */
+bool can_skip_archive(
+        CommandLineArguments const& command_line_arguments,
+        clp_s::ArchiveCatalog& archive_catalog,
+        std::shared_ptr<Expression> const& expr,
+        std::string const& archive_id
+);
+
 bool compress(CommandLineArguments const& command_line_arguments) {
     auto archives_dir = std::filesystem::path(command_line_arguments.get_archives_dir());
 
@@ -108,7 +134,13 @@ bool compress(CommandLineArguments const& command_line_arguments) {
     }
 
     clp_s::JsonParser parser(option);
-    if (false == parser.parse()) {
+    bool parsed{false};
+    if (CommandLineArguments::FileType::KeyValueIr == command_line_arguments.get_file_type()) {
+        parsed = parser.parse_from_ir();
+    } else {
+        parsed = parser.parse();
+    }
+    if (false == parsed) {
         SPDLOG_ERROR("Encountered error while parsing input");
         return false;
     }
@@ -228,10 +260,83 @@ bool search_archive(
             archive_reader,
             timestamp_dict,
             std::move(output_handler),
-            command_line_arguments.get_ignore_case()
+            command_line_arguments.get_ignore_case(),
+            command_line_arguments.get_num_prefetched_tables()
     );
     return output.filter();
 }
+
+std::shared_ptr<Expression> prepare_catalog_expression(std::shared_ptr<Expression> expr) {
+    OrOfAndForm standardize_pass;
+    if (expr = standardize_pass.run(expr); std::dynamic_pointer_cast<EmptyExpr>(expr)) {
+        return nullptr;
+    }
+
+    NarrowTypes narrow_pass;
+    if (expr = narrow_pass.run(expr); std::dynamic_pointer_cast<EmptyExpr>(expr)) {
+        return nullptr;
+    }
+
+    ConvertToExists convert_pass;
+    if (expr = convert_pass.run(expr); std::dynamic_pointer_cast<EmptyExpr>(expr)) {
+        return nullptr;
+    }
+    return expr;
+}
+
+bool can_skip_archive(
+        CommandLineArguments const& command_line_arguments,
+        clp_s::ArchiveCatalog& archive_catalog,
+        std::shared_ptr<Expression> const& expr,
+        std::string const& archive_id
+) {
+    if (nullptr == expr) {
+        return false;
+    }
+    auto* catalog_entry = archive_catalog.get_entry(archive_id);
+    if (nullptr == catalog_entry) {
+        return false;
+    }
+
+    auto& timestamp_ranges = catalog_entry->timestamp_ranges;
+    if (false == timestamp_ranges.empty()) {
+        // The timestamp filters are applied to the authoritative timestamp column
+        auto& authoritative_range = timestamp_ranges.front().second;
+        auto const search_begin_ts = command_line_arguments.get_search_begin_ts();
+        if (search_begin_ts.has_value()
+            && clp_s::EvaluatedValue::False
+                       == authoritative_range.evaluate_filter(
+                               FilterOperation::GTE,
+                               search_begin_ts.value()
+                       ))
+        {
+            return true;
+        }
+        auto const search_end_ts = command_line_arguments.get_search_end_ts();
+        if (search_end_ts.has_value()
+            && clp_s::EvaluatedValue::False
+                       == authoritative_range.evaluate_filter(
+                               FilterOperation::LTE,
+                               search_end_ts.value()
+                       ))
+        {
+            return true;
+        }
+    }
+
+    clp_s::TimestampDictionaryReader::tokenized_column_to_range_t tokenized_column_to_range;
+    tokenized_column_to_range.reserve(timestamp_ranges.size());
+    for (auto& [tokens, range] : timestamp_ranges) {
+        tokenized_column_to_range.emplace_back(tokens, &range);
+    }
+    EvaluateTimestampIndex timestamp_index(tokenized_column_to_range);
+    if (clp_s::EvaluatedValue::False == timestamp_index.run(expr)) {
+        return true;
+    }
+
+    EvaluateKeyPathIndex key_path_index(catalog_entry->key_paths, catalog_entry->array_key_paths);
+    return clp_s::EvaluatedValue::False == key_path_index.run(expr);
+}
 }  // namespace
 
 int main(int argc, char const* argv[]) {
@@ -334,9 +439,25 @@ int main(int argc, char const* argv[]) {
             }
         }
 
+        // Use the archive catalog, if any, to skip archives that can't match without opening them
+        clp_s::ArchiveCatalog archive_catalog;
+        std::shared_ptr<Expression> catalog_expr;
+        try {
+            if (archive_catalog.read(archives_dir)) {
+                catalog_expr = prepare_catalog_expression(expr->copy());
+            }
+        } catch (clp_s::TraceableException& e) {
+            SPDLOG_WARN("Failed to read archive catalog, searching all archives - {}", e.what());
+        }
+
         auto const& archive_id = command_line_arguments.get_archive_id();
         auto archive_reader = std::make_shared<clp_s::ArchiveReader>();
         if (false == archive_id.empty()) {
+            if (can_skip_archive(command_line_arguments, archive_catalog, catalog_expr, archive_id))
+            {
+                SPDLOG_INFO("Archive {} can't match query '{}'", archive_id, query);
+                return 0;
+            }
             archive_reader->open(archives_dir, archive_id);
             if (false
                 == search_archive(command_line_arguments, archive_reader, expr, reducer_socket_fd))
@@ -352,6 +473,15 @@ int main(int argc, char const* argv[]) {
                 }
 
                 auto const archive_id = entry.path().filename().string();
+                if (can_skip_archive(
+                            command_line_arguments,
+                            archive_catalog,
+                            catalog_expr,
+                            archive_id
+                    ))
+                {
+                    continue;
+                }
                 archive_reader->open(archives_dir, archive_id);
                 if (false
                     == search_archive(
@@ -0,0 +1,70 @@
+#include "EvaluateKeyPathIndex.hpp"
+
+#include "AndExpr.hpp"
+#include "FilterExpr.hpp"
+#include "OrExpr.hpp"
+
+namespace clp_s::search {
+EvaluatedValue EvaluateKeyPathIndex::run(std::shared_ptr<Expression> const& expr) {
+    if (std::dynamic_pointer_cast<OrExpr>(expr)) {
+        bool any_unknown = false;
+        for (auto it = expr->op_begin(); it != expr->op_end(); it++) {
+            auto sub_expr = std::static_pointer_cast<Expression>(*it);
+            EvaluatedValue ret = run(sub_expr);
+            if (ret == EvaluatedValue::True) {
+                return expr->is_inverted() ? EvaluatedValue::False : EvaluatedValue::True;
+            } else if (ret == EvaluatedValue::Unknown) {
+                any_unknown = true;
+            }
+        }
+
+        if (any_unknown) {
+            return EvaluatedValue::Unknown;
+        }
+        // must have been all false
+        return expr->is_inverted() ? EvaluatedValue::True : EvaluatedValue::False;
+    } else if (std::dynamic_pointer_cast<AndExpr>(expr)) {
+        bool any_unknown = false;
+        for (auto it = expr->op_begin(); it != expr->op_end(); it++) {
+            auto sub_expr = std::static_pointer_cast<Expression>(*it);
+            EvaluatedValue ret = run(sub_expr);
+            if (ret == EvaluatedValue::False) {
+                return expr->is_inverted() ? EvaluatedValue::True : EvaluatedValue::False;
+            } else if (ret == EvaluatedValue::Unknown) {
+                any_unknown = true;
+            }
+        }
+
+        if (any_unknown) {
+            return EvaluatedValue::Unknown;
+        }
+        // must have been all true
+        return expr->is_inverted() ? EvaluatedValue::False : EvaluatedValue::True;
+    } else if (auto filter = std::dynamic_pointer_cast<FilterExpr>(expr)) {
+        // An inverted filter or a NEXISTS filter can match records that lack the column
+        if (filter->is_inverted() || FilterOperation::NEXISTS == filter->get_operation()) {
+            return EvaluatedValue::Unknown;
+        }
+
+        auto column = filter->get_column();
+        if (column->is_unresolved_descriptor()) {
+            return EvaluatedValue::Unknown;
+        }
+
+        auto const& descriptors = column->get_descriptor_list();
+        std::vector<std::string> path;
+        path.reserve(descriptors.size());
+        for (auto const& descriptor : descriptors) {
+            path.push_back(descriptor.get_token());
+            // Keys nested within arrays aren't part of the schema tree
+            if (path.size() < descriptors.size() && m_array_key_paths.count(path) > 0) {
+                return EvaluatedValue::Unknown;
+            }
+        }
+
+        return m_key_paths.count(path) > 0 ? EvaluatedValue::Unknown : EvaluatedValue::False;
+    } else {
+        return EvaluatedValue::Unknown;
+    }
+}
+}  // namespace clp_s::search
@@ -0,0 +1,45 @@
+#ifndef CLP_S_SEARCH_EVALUATEKEYPATHINDEX_HPP
+#define CLP_S_SEARCH_EVALUATEKEYPATHINDEX_HPP
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../Utils.hpp"
+#include "Expression.hpp"
+
+namespace clp_s::search {
+class EvaluateKeyPathIndex {
+public:
+    // Constructors
+    /**
+     * @param key_paths Tokenized paths of every key in an archive
+     * @param array_key_paths Tokenized paths of the archive's array keys, below which any path may
+     * exist
+     */
+    EvaluateKeyPathIndex(
+            std::set<std::vector<std::string>> const& key_paths,
+            std::set<std::vector<std::string>> const& array_key_paths
+    )
+            : m_key_paths(key_paths),
+              m_array_key_paths(array_key_paths) {}
+
+    /**
+     * Takes an expression and attempts to prove that it can't match an archive based on the key
+     * paths the archive contains, without reading the archive's schema tree. Only filters on fully
+     * resolved columns that require the column to exist are considered.
+     *
+     * Should only be run after type narrowing.
+     *
+     * @param expr the expression to evaluate against the key path index
+     * @return The evaluated value of the expression given the index (False, Unknown)
+     */
+    EvaluatedValue run(std::shared_ptr<Expression> const& expr);
+
+private:
+    std::set<std::vector<std::string>> const& m_key_paths;
+    std::set<std::vector<std::string>> const& m_array_key_paths;
+};
+}  // namespace clp_s::search
+
+#endif  // CLP_S_SEARCH_EVALUATEKEYPATHINDEX_HPP
@@ -10,7 +10,17 @@ class EvaluateTimestampIndex {
 public:
     // Constructors
     EvaluateTimestampIndex(std::shared_ptr<TimestampDictionaryReader> const& timestamp_dict)
-            : m_timestamp_dict(timestamp_dict) {}
+            : m_timestamp_dict(timestamp_dict),
+              m_tokenized_column_to_range(&timestamp_dict->get_tokenized_column_to_range()) {}
+
+    /**
+     * @param tokenized_column_to_range Timestamp ranges to evaluate against, which must outlive
+     * this object
+     */
+    explicit EvaluateTimestampIndex(
+            TimestampDictionaryReader::tokenized_column_to_range_t const& tokenized_column_to_range
+    )
+            : m_tokenized_column_to_range(&tokenized_column_to_range) {}
 
     /**
      * Takes an expression and attempts to prove its output (true/false/unknown) based on
@@ -25,6 +35,7 @@ public:
 
 private:
     std::shared_ptr<TimestampDictionaryReader> m_timestamp_dict;
+    TimestampDictionaryReader::tokenized_column_to_range_t const* m_tokenized_column_to_range;
 };
 }  // namespace clp_s::search
 
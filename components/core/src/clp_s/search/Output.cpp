@@ -51,6 +51,13 @@ bool Output::filter() {
         return true;
     }
 
+    // Start reading the matched tables before the dictionaries so that the I/O overlaps
+    if (m_num_prefetched_tables > 0) {
+        m_archive_reader->prefetch_tables(matched_schemas, m_num_prefetched_tables);
+    } else {
+        m_archive_reader->advise_tables_will_be_read(matched_schemas);
+    }
+
     m_var_dict = m_archive_reader->read_variable_dictionary();
     m_log_dict = m_archive_reader->read_log_type_dictionary();
 
@@ -158,6 +165,13 @@ void Output::init(
             }
         }
     }
+
+    m_filter_program.clear();
+    if (EvaluatedValue::True == m_expression_value) {
+        m_filter_program_result = true;
+    } else {
+        m_filter_program_result = compile_filter_program(m_expr.get());
+    }
 }
 
 std::string& Output::get_cached_decompressed_unstructured_array(int32_t column_id) {
@@ -176,85 +190,278 @@ std::string& Output::get_cached_decompressed_unstructured_array(int32_t column_i
 }
 
 bool Output::filter(uint64_t cur_message) {
+    if (m_filter_program_result.has_value()) {
+        return m_filter_program_result.value();
+    }
+
     m_cur_message = cur_message;
     m_extracted_unstructured_arrays.clear();
-    return evaluate(m_expr.get(), m_schema);
+    return run_filter_program();
 }
 
-bool Output::evaluate(Expression* expr, int32_t schema) {
-    if (m_expression_value == EvaluatedValue::True) {
-        return true;
+std::optional<bool> Output::compile_filter_program(Expression* expr) {
+    if (auto* filter = dynamic_cast<FilterExpr*>(expr)) {
+        auto const result = compile_filter(filter);
+        if (result.has_value()) {
+            return result.value() != filter->is_inverted();
+        }
+        if (filter->is_inverted()) {
+            m_filter_program.emplace_back().type = FilterInstructionType::Invert;
+        }
+        return std::nullopt;
     }
 
-    Expression* cur = expr;
-    ExpressionType cur_type = ExpressionType::Filter;
-    bool ret = false;
+    bool const is_and = nullptr != dynamic_cast<AndExpr*>(expr);
+    if (false == is_and && nullptr == dynamic_cast<OrExpr*>(expr)) {
+        return false;
+    }
 
-    if (dynamic_cast<AndExpr*>(cur)) {
-        cur_type = ExpressionType::And;
-        m_expression_state.emplace(cur_type, cur->op_begin());
-        ret = true;
-    } else if (dynamic_cast<OrExpr*>(cur)) {
-        cur_type = ExpressionType::Or;
-        m_expression_state.emplace(cur_type, cur->op_begin());
-        ret = false;
+    // An AND short-circuits on the first false operand and an OR on the first true operand. Each
+    // operand is followed by a jump to the end of the expression taken on its short-circuit value.
+    auto const start = m_filter_program.size();
+    std::vector<size_t> jumps;
+    for (auto const& op : expr->get_op_list()) {
+        auto const result = compile_filter_program(static_cast<Expression*>(op.get()));
+        if (result.has_value()) {
+            if (result.value() == is_and) {
+                // Operand can't affect the result
+                continue;
+            }
+            // Operand short-circuits the whole expression
+            m_filter_program.resize(start);
+            return is_and == expr->is_inverted();
+        }
+        jumps.push_back(m_filter_program.size());
+        m_filter_program.emplace_back().type
+                = is_and ? FilterInstructionType::JumpIfFalse : FilterInstructionType::JumpIfTrue;
     }
 
-    do {
-        switch (cur_type) {
-            case ExpressionType::And:
-                if (false == ret || m_expression_state.top().second == cur->op_end()) {
-                    m_expression_state.pop();
-                    break;
-                } else {
-                    cur = static_cast<Expression*>((m_expression_state.top().second++)->get());
-                    if (dynamic_cast<FilterExpr*>(cur)) {
-                        cur_type = ExpressionType::Filter;
-                    } else {
-                        // must be an OR-expr because AST would have been simplified
-                        // to eliminate nested AND
-                        cur_type = ExpressionType::Or;
-                        m_expression_state.emplace(cur_type, cur->op_begin());
-                        ret = false;
-                    }
-                    continue;
-                }
-            case ExpressionType::Filter:
-                if (static_cast<FilterExpr*>(cur)->get_column()->is_pure_wildcard()) {
-                    ret = evaluate_wildcard_filter(static_cast<FilterExpr*>(cur), schema);
-                } else {
-                    ret = evaluate_filter(static_cast<FilterExpr*>(cur), schema);
+    if (jumps.empty()) {
+        return is_and != expr->is_inverted();
+    }
+
+    // The last operand's jump would target the next instruction anyway
+    m_filter_program.pop_back();
+    jumps.pop_back();
+    for (auto const jump : jumps) {
+        m_filter_program[jump].jump_target = m_filter_program.size();
+    }
+
+    if (expr->is_inverted()) {
+        m_filter_program.emplace_back().type = FilterInstructionType::Invert;
+    }
+    return std::nullopt;
+}
+
+std::optional<bool> Output::compile_filter(FilterExpr* expr) {
+    auto* column = expr->get_column().get();
+    auto const& operand = expr->get_operand();
+    FilterInstruction instruction;
+    instruction.op = expr->get_operation();
+    instruction.expr = expr;
+    instruction.column_id = column->get_column_id();
+
+    if (column->is_pure_wildcard()) {
+        instruction.type = FilterInstructionType::WildcardFilter;
+        m_filter_program.push_back(instruction);
+        return std::nullopt;
+    }
+
+    auto const op = instruction.op;
+    bool const is_existence_check = FilterOperation::EXISTS == op || FilterOperation::NEXISTS == op;
+    bool const is_equality_check = FilterOperation::EQ == op || FilterOperation::NEQ == op;
+    switch (column->get_literal_type()) {
+        case LiteralType::IntegerT:
+            if (is_existence_check) {
+                return true;
+            }
+            if (false == operand->as_int(instruction.int_operand, op)) {
+                return false;
+            }
+            instruction.type = FilterInstructionType::IntFilter;
+            instruction.basic_readers = &m_basic_readers[instruction.column_id];
+            if (instruction.basic_readers->empty()) {
+                return false;
+            }
+            break;
+        case LiteralType::FloatT:
+            if (is_existence_check) {
+                return true;
+            }
+            if (false == operand->as_float(instruction.float_operand, op)) {
+                return false;
+            }
+            instruction.type = FilterInstructionType::FloatFilter;
+            instruction.basic_readers = &m_basic_readers[instruction.column_id];
+            if (instruction.basic_readers->empty()) {
+                return false;
+            }
+            break;
+        case LiteralType::BooleanT:
+            if (is_existence_check) {
+                return true;
+            }
+            if (false == is_equality_check
+                || false == operand->as_bool(instruction.bool_operand, op))
+            {
+                return false;
+            }
+            instruction.type = FilterInstructionType::BoolFilter;
+            instruction.basic_readers = &m_basic_readers[instruction.column_id];
+            if (instruction.basic_readers->empty()) {
+                return false;
+            }
+            break;
+        case LiteralType::ClpStringT:
+            if (is_existence_check) {
+                return true;
+            }
+            if (false == is_equality_check) {
+                return false;
+            }
+            instruction.clp_query = m_expr_clp_query[expr];
+            if (nullptr == instruction.clp_query) {
+                return FilterOperation::NEQ == op;
+            }
+            if (instruction.clp_query->search_string_matches_all()) {
+                return FilterOperation::EQ == op;
+            }
+            instruction.type = FilterInstructionType::ClpStringFilter;
+            instruction.clp_string_readers = &m_clp_string_readers[instruction.column_id];
+            if (instruction.clp_string_readers->empty()) {
+                return false;
+            }
+            break;
+        case LiteralType::VarStringT:
+            if (is_existence_check) {
+                return true;
+            }
+            if (false == is_equality_check) {
+                return false;
+            }
+            instruction.type = FilterInstructionType::VarStringFilter;
+            instruction.matching_vars = m_expr_var_match_map.at(expr);
+            instruction.var_string_readers = &m_var_string_readers[instruction.column_id];
+            if (instruction.var_string_readers->empty()) {
+                return false;
+            }
+            break;
+        case LiteralType::ArrayT:
+            instruction.type = FilterInstructionType::ArrayFilter;
+            break;
+        case LiteralType::EpochDateT: {
+            if (is_existence_check) {
+                return true;
+            }
+            if (false == operand->as_int(instruction.int_operand, op)) {
+                return false;
+            }
+            auto it = m_datestring_readers.find(instruction.column_id);
+            if (m_datestring_readers.end() == it) {
+                return false;
+            }
+            instruction.type = FilterInstructionType::EpochDateFilter;
+            instruction.date_reader = it->second;
+            break;
+        }
+            // case LiteralType::NullT:
+            //  null checks are always turned into existence operators --
+            //  no need to evaluate here
+        default:
+            return false;
+    }
+
+    m_filter_program.push_back(instruction);
+    return std::nullopt;
+}
+
+bool Output::run_filter_program() {
+    bool ret = false;
+    size_t pc = 0;
+    size_t const program_size = m_filter_program.size();
+    while (pc < program_size) {
+        auto const& instruction = m_filter_program[pc++];
+        switch (instruction.type) {
+            case FilterInstructionType::JumpIfFalse:
+                if (false == ret) {
+                    pc = instruction.jump_target;
                 }
                 break;
-            case ExpressionType::Or:
-                if (ret || m_expression_state.top().second == cur->op_end()) {
-                    m_expression_state.pop();
-                    break;
-                } else {
-                    cur = static_cast<Expression*>((m_expression_state.top().second++)->get());
-                    if (dynamic_cast<FilterExpr*>(cur)) {
-                        cur_type = ExpressionType::Filter;
-                    } else {
-                        // must be an AND-expr because AST would have been simplified
-                        // to eliminate nested OR
-                        cur_type = ExpressionType::And;
-                        m_expression_state.emplace(cur_type, cur->op_begin());
-                        ret = true;
-                    }
-                    continue;
+            case FilterInstructionType::JumpIfTrue:
+                if (ret) {
+                    pc = instruction.jump_target;
                 }
+                break;
+            case FilterInstructionType::Invert:
+                ret = !ret;
+                break;
+            default:
+                ret = evaluate_filter_instruction(instruction);
+                break;
         }
-
-        ret = cur->is_inverted() ? !ret : ret;
-        if (false == m_expression_state.empty()) {
-            cur_type = m_expression_state.top().first;
-        }
-        cur = cur->get_parent();
-    } while (cur != nullptr);
-
+    }
     return ret;
 }
 
+bool Output::evaluate_filter_instruction(FilterInstruction const& instruction) {
+    auto const op = instruction.op;
+    switch (instruction.type) {
+        case FilterInstructionType::IntFilter:
+            for (BaseColumnReader* reader : *instruction.basic_readers) {
+                int64_t value = std::get<int64_t>(reader->extract_value(m_cur_message));
+                if (evaluate_int_filter_core(op, value, instruction.int_operand)) {
+                    return true;
+                }
+            }
+            return false;
+        case FilterInstructionType::FloatFilter:
+            for (BaseColumnReader* reader : *instruction.basic_readers) {
+                double value = std::get<double>(reader->extract_value(m_cur_message));
+                if (evaluate_float_filter_core(op, value, instruction.float_operand)) {
+                    return true;
+                }
+            }
+            return false;
+        case FilterInstructionType::BoolFilter:
+            for (BaseColumnReader* reader : *instruction.basic_readers) {
+                bool value = std::get<uint8_t>(reader->extract_value(m_cur_message));
+                if (eval(op, value, instruction.bool_operand)) {
+                    return true;
+                }
+            }
+            return false;
+        case FilterInstructionType::ClpStringFilter:
+            return evaluate_clp_string_filter(
+                    op,
+                    instruction.clp_query,
+                    *instruction.clp_string_readers
+            );
+        case FilterInstructionType::VarStringFilter:
+            return evaluate_var_string_filter(
+                    op,
+                    *instruction.var_string_readers,
+                    instruction.matching_vars
+            );
+        case FilterInstructionType::EpochDateFilter:
+            return evaluate_int_filter_core(
+                    op,
+                    instruction.date_reader->get_encoded_time(m_cur_message),
+                    instruction.int_operand
+            );
+        case FilterInstructionType::ArrayFilter:
+            return evaluate_array_filter(
+                    op,
+                    instruction.expr->get_column()->get_unresolved_tokens(),
+                    get_cached_decompressed_unstructured_array(instruction.column_id),
+                    instruction.expr->get_operand()
+            );
+        case FilterInstructionType::WildcardFilter:
+            return evaluate_wildcard_filter(instruction.expr, m_schema);
+        default:
+            return false;
+    }
+}
+
 bool Output::evaluate_wildcard_filter(FilterExpr* expr, int32_t schema) {
     auto literal = expr->get_operand();
     auto* column = expr->get_column().get();
@@ -317,54 +524,6 @@ bool Output::evaluate_wildcard_filter(FilterExpr* expr, int32_t schema) {
     return false;
 }
 
-bool Output::evaluate_filter(FilterExpr* expr, int32_t schema) {
-    auto* column = expr->get_column().get();
-    int32_t column_id = column->get_column_id();
-    auto literal = expr->get_operand();
-    Query* q = nullptr;
-    std::unordered_set<int64_t>* matching_vars = nullptr;
-    switch (column->get_literal_type()) {
-        case LiteralType::IntegerT:
-            return evaluate_int_filter(expr->get_operation(), column_id, literal);
-        case LiteralType::FloatT:
-            return evaluate_float_filter(expr->get_operation(), column_id, literal);
-        case LiteralType::ClpStringT:
-            q = m_expr_clp_query[expr];
-            return evaluate_clp_string_filter(
-                    expr->get_operation(),
-                    q,
-                    m_clp_string_readers[column_id]
-            );
-        case LiteralType::VarStringT:
-            matching_vars = m_expr_var_match_map.at(expr);
-            return evaluate_var_string_filter(
-                    expr->get_operation(),
-                    m_var_string_readers[column_id],
-                    matching_vars
-            );
-        case LiteralType::BooleanT:
-            return evaluate_bool_filter(expr->get_operation(), column_id, literal);
-        case LiteralType::ArrayT:
-            return evaluate_array_filter(
-                    expr->get_operation(),
-                    column->get_unresolved_tokens(),
-                    get_cached_decompressed_unstructured_array(column_id),
-                    literal
-            );
-        case LiteralType::EpochDateT:
-            return evaluate_epoch_date_filter(
-                    expr->get_operation(),
-                    m_datestring_readers[column_id],
-                    literal
-            );
-            // case LiteralType::NullT:
-            //  null checks are always turned into existence operators --
-            //  no need to evaluate here
-        default:
-            return false;
-    }
-}
-
 bool Output::evaluate_int_filter(
         FilterOperation op,
         int32_t column_id,
@@ -478,10 +637,8 @@ bool Output::evaluate_clp_string_filter(
             for (auto const& subquery : q->get_sub_queries()) {
                 if (subquery.matches_logtype(id) && subquery.matches_vars(vars)) {
                     if (subquery.wildcard_match_required()) {
-                        matched = StringUtils::wildcard_match_unsafe(
-                                std::get<std::string>(reader->extract_value(m_cur_message)),
-                                q->get_search_string(),
-                                !q->get_ignore_case()
+                        matched = q->search_string_matches(
+                                std::get<std::string>(reader->extract_value(m_cur_message))
                         );
                     } else {
                         matched = true;
@@ -490,10 +647,8 @@ bool Output::evaluate_clp_string_filter(
                 }
             }
         } else {
-            matched = StringUtils::wildcard_match_unsafe(
-                    std::get<std::string>(reader->extract_value(m_cur_message)),
-                    q->get_search_string(),
-                    !q->get_ignore_case()
+            matched = q->search_string_matches(
+                    std::get<std::string>(reader->extract_value(m_cur_message))
             );
         }
 
@@ -2,8 +2,8 @@
 #define CLP_S_SEARCH_OUTPUT_HPP
 
 #include <map>
+#include <optional>
 #include <set>
-#include <stack>
 #include <string>
 #include <unordered_set>
 #include <utility>
@@ -30,7 +30,8 @@ public:
            std::shared_ptr<ArchiveReader> archive_reader,
            std::shared_ptr<TimestampDictionaryReader> timestamp_dict,
            std::unique_ptr<OutputHandler> output_handler,
-           bool ignore_case)
+           bool ignore_case,
+           size_t num_prefetched_tables = 0)
             : m_archive_reader(std::move(archive_reader)),
               m_schema_tree(m_archive_reader->get_schema_tree()),
               m_schemas(m_archive_reader->get_schema_map()),
@@ -39,6 +40,7 @@ public:
               m_timestamp_dict(std::move(timestamp_dict)),
               m_output_handler(std::move(output_handler)),
               m_ignore_case(ignore_case),
+              m_num_prefetched_tables(num_prefetched_tables),
               m_should_marshal_records(m_output_handler->should_marshal_records()) {}
 
     /**
@@ -48,10 +50,40 @@ public:
     bool filter();
 
 private:
-    enum class ExpressionType {
-        And,
-        Or,
-        Filter
+    enum class FilterInstructionType : uint8_t {
+        IntFilter,
+        FloatFilter,
+        BoolFilter,
+        ClpStringFilter,
+        VarStringFilter,
+        EpochDateFilter,
+        ArrayFilter,
+        WildcardFilter,
+        JumpIfFalse,
+        JumpIfTrue,
+        Invert
+    };
+
+    /**
+     * A single instruction of a compiled filter program. Filter instructions are bound directly to
+     * the column readers and pre-converted operands they need so that evaluating them doesn't
+     * require inspecting the expression tree.
+     */
+    struct FilterInstruction {
+        FilterInstructionType type{FilterInstructionType::Invert};
+        FilterOperation op{FilterOperation::EQ};
+        FilterExpr* expr{nullptr};
+        int32_t column_id{-1};
+        int64_t int_operand{0};
+        double float_operand{0.0};
+        bool bool_operand{false};
+        std::vector<BaseColumnReader*> const* basic_readers{nullptr};
+        std::vector<ClpStringColumnReader*> const* clp_string_readers{nullptr};
+        std::vector<VariableStringColumnReader*> const* var_string_readers{nullptr};
+        DateStringColumnReader* date_reader{nullptr};
+        Query* clp_query{nullptr};
+        std::unordered_set<int64_t>* matching_vars{nullptr};
+        size_t jump_target{0};
     };
 
     std::shared_ptr<ArchiveReader> m_archive_reader;
@@ -59,6 +91,7 @@ private:
     SchemaMatch& m_match;
     std::unique_ptr<OutputHandler> m_output_handler;
     bool m_ignore_case;
+    size_t m_num_prefetched_tables;
     bool m_should_marshal_records{true};
 
     // variables for the current schema being filtered
@@ -89,10 +122,10 @@ private:
     std::map<ColumnDescriptor*, std::set<int32_t>> m_wildcard_to_searched_basic_columns;
     LiteralTypeBitmask m_wildcard_type_mask{0};
 
-    std::stack<
-            std::pair<ExpressionType, OpList::iterator>,
-            std::vector<std::pair<ExpressionType, OpList::iterator>>>
-            m_expression_state;
+    // Flattened form of m_expr for the current schema. If the expression was folded into a constant
+    // at compile time, m_filter_program_result holds it and the program is empty.
+    std::vector<FilterInstruction> m_filter_program;
+    std::optional<bool> m_filter_program_result;
 
     simdjson::ondemand::parser m_array_parser;
     std::string m_array_search_string;
@@ -112,20 +145,35 @@ private:
     ) override;
 
     /**
-     * Evaluates an expression
+     * Compiles an expression into m_filter_program. Filters whose result is known for the current
+     * schema are folded away along with any branches they short-circuit.
      * @param expr
-     * @param schema
-     * @return true if the expression evaluates to true, false otherwise
+     * @return The constant value of the expression if it could be folded (in which case nothing is
+     * added to the program), or std::nullopt otherwise
      */
-    bool evaluate(Expression* expr, int32_t schema);
+    std::optional<bool> compile_filter_program(Expression* expr);
 
     /**
-     * Evaluates a filter expression
+     * Compiles a filter expression into a single instruction appended to m_filter_program,
+     * resolving its column readers and operand.
      * @param expr
-     * @param schema
-     * @return true if the expression evaluates to true, false otherwise
+     * @return The constant value of the filter (ignoring inversion) if it could be folded, or
+     * std::nullopt otherwise
+     */
+    std::optional<bool> compile_filter(FilterExpr* expr);
+
+    /**
+     * Runs m_filter_program against the current message
+     * @return true if the program evaluates to true, false otherwise
+     */
+    bool run_filter_program();
+
+    /**
+     * Evaluates a compiled filter instruction against the current message
+     * @param instruction
+     * @return true if the filter matches, false otherwise
      */
-    bool evaluate_filter(FilterExpr* expr, int32_t schema);
+    bool evaluate_filter_instruction(FilterInstruction const& instruction);
 
     /**
      * Evaluates a wildcard filter expression
@@ -135,9 +135,17 @@ bool SubQuery::matches_vars(UnalignedMemSpan<int64_t> vars) const {
     return (num_possible_vars == possible_vars_ix);
 }
 
+void Query::set_ignore_case(bool ignore_case) {
+    m_ignore_case = ignore_case;
+    m_search_string_matcher
+            = clp::string_utils::WildcardMatcher{m_search_string, false == m_ignore_case};
+}
+
 void Query::set_search_string(string const& search_string) {
     m_search_string = search_string;
     m_search_string_matches_all = (m_search_string.empty() || "*" == m_search_string);
+    m_search_string_matcher
+            = clp::string_utils::WildcardMatcher{m_search_string, false == m_ignore_case};
 }
 
 void Query::add_sub_query(SubQuery const& sub_query) {
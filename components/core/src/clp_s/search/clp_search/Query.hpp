@@ -5,10 +5,13 @@
 
 #include <set>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include <string_utils/WildcardMatcher.hpp>
+
 #include "../../Defs.hpp"
 #include "../../DictionaryEntry.hpp"
 #include "../../Utils.hpp"
@@ -161,7 +164,7 @@ public:
         set_search_string(search_string);
     }
 
-    void set_ignore_case(bool ignore_case) { m_ignore_case = ignore_case; }
+    void set_ignore_case(bool ignore_case);
 
     void set_search_string(std::string const& search_string);
 
@@ -180,6 +183,15 @@ public:
      */
     bool search_string_matches_all() const { return m_search_string_matches_all; }
 
+    /**
+     * @param msg
+     * @return Whether the given message matches the search string (considering the query's case
+     * sensitivity)
+     */
+    bool search_string_matches(std::string_view msg) const {
+        return m_search_string_matcher.matches(msg);
+    }
+
     std::vector<SubQuery> const& get_sub_queries() const { return m_sub_queries; }
 
     bool contains_sub_queries() const { return m_sub_queries.empty() == false; }
@@ -188,6 +200,7 @@ private:
     // Variables
     bool m_ignore_case;
     std::string m_search_string;
+    clp::string_utils::WildcardMatcher m_search_string_matcher;
     std::vector<SubQuery> m_sub_queries;
     std::vector<SubQuery const*> m_relevant_sub_queries;
     bool m_search_string_matches_all;
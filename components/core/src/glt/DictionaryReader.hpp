@@ -6,6 +6,7 @@
 
 #include <boost/algorithm/string.hpp>
 #include <string_utils/string_utils.hpp>
+#include <string_utils/WildcardMatcher.hpp>
 
 #include "dictionary_utils.hpp"
 #include "DictionaryEntry.hpp"
@@ -256,13 +257,9 @@ void DictionaryReader<DictionaryIdType, EntryType>::get_entries_matching_wildcar
         bool ignore_case,
         std::unordered_set<EntryType const*>& entries
 ) const {
+    clp::string_utils::WildcardMatcher const matcher{wildcard_string, false == ignore_case};
     for (auto const& entry : m_entries) {
-        if (clp::string_utils::wildcard_match_unsafe(
-                    entry.get_value(),
-                    wildcard_string,
-                    false == ignore_case
-            ))
-        {
+        if (matcher.matches(entry.get_value())) {
             entries.insert(&entry);
         }
     }
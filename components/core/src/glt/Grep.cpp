@@ -13,7 +13,6 @@
 using clp::string_utils::clean_up_wildcard_search_string;
 using clp::string_utils::is_alphabet;
 using clp::string_utils::is_wildcard;
-using clp::string_utils::wildcard_match_unsafe;
 using glt::ir::is_delim;
 using glt::streaming_archive::reader::Archive;
 using glt::streaming_archive::reader::File;
@@ -768,11 +767,7 @@ size_t Grep::search_and_output(
             || (query.contains_sub_queries() == false && query.search_string_matches_all() == false
             ))
         {
-            bool matched = wildcard_match_unsafe(
-                    decompressed_msg,
-                    query.get_search_string(),
-                    query.get_ignore_case() == false
-            );
+            bool matched = query.search_string_matches(decompressed_msg);
             if (!matched) {
                 continue;
             }
@@ -825,11 +820,7 @@ bool Grep::search_and_decompress(
             || (query.contains_sub_queries() == false && query.search_string_matches_all() == false
             ))
         {
-            matched = wildcard_match_unsafe(
-                    decompressed_msg,
-                    query.get_search_string(),
-                    query.get_ignore_case() == false
-            );
+            matched = query.search_string_matches(decompressed_msg);
         } else {
             matched = true;
         }
@@ -874,11 +865,7 @@ size_t Grep::search(Query const& query, size_t limit, Archive& archive, File& co
                 break;
             }
 
-            bool matched = wildcard_match_unsafe(
-                    decompressed_msg,
-                    query.get_search_string(),
-                    query.get_ignore_case() == false
-            );
+            bool matched = query.search_string_matches(decompressed_msg);
             if (!matched) {
                 continue;
             }
@@ -965,11 +952,7 @@ size_t Grep::output_message_in_segment_within_time_range(
             // In this branch, subqueries should not exist
             // So just check if the search string is not a match-all
             if (query.search_string_matches_all() == false) {
-                bool matched = wildcard_match_unsafe(
-                        decompressed_msg,
-                        query.get_search_string(),
-                        query.get_ignore_case() == false
-                );
+                bool matched = query.search_string_matches(decompressed_msg);
                 if (!matched) {
                     continue;
                 }
@@ -1032,11 +1015,7 @@ size_t Grep::output_message_in_combined_segment_within_time_range(
                 // In this execution branch, subqueries should not exist
                 // So just check if the search string is not a match-all
                 if (query.search_string_matches_all() == false) {
-                    bool matched = wildcard_match_unsafe(
-                            decompressed_msg,
-                            query.get_search_string(),
-                            query.get_ignore_case() == false
-                    );
+                    bool matched = query.search_string_matches(decompressed_msg);
                     if (!matched) {
                         continue;
                     }
@@ -1108,11 +1087,7 @@ size_t Grep::search_segment_and_output(
                 || (query.contains_sub_queries() == false
                     && query.search_string_matches_all() == false))
             {
-                bool matched = wildcard_match_unsafe(
-                        decompressed_msg,
-                        query.get_search_string(),
-                        query.get_ignore_case() == false
-                );
+                bool matched = query.search_string_matches(decompressed_msg);
                 if (!matched) {
                     continue;
                 }
@@ -1189,11 +1164,7 @@ size_t Grep::search_combined_table_and_output(
                 || (query.contains_sub_queries() == false
                     && query.search_string_matches_all() == false))
             {
-                bool matched = wildcard_match_unsafe(
-                        decompressed_msg,
-                        query.get_search_string(),
-                        query.get_ignore_case() == false
-                );
+                bool matched = query.search_string_matches(decompressed_msg);
                 if (!matched) {
                     continue;
                 }
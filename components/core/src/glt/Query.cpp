@@ -197,6 +197,7 @@ Query::Query(
           m_search_end_timestamp{search_end_timestamp},
           m_ignore_case{ignore_case},
           m_search_string{std::move(search_string)},
+          m_search_string_matcher{m_search_string, false == ignore_case},
           m_sub_queries{std::move(sub_queries)} {
     m_search_string_matches_all = (m_search_string.empty() || "*" == m_search_string);
 }
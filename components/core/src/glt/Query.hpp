@@ -3,9 +3,12 @@
 
 #include <set>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 
+#include <string_utils/WildcardMatcher.hpp>
+
 #include "Defs.h"
 #include "LogTypeDictionaryEntry.hpp"
 #include "VariableDictionaryEntry.hpp"
@@ -200,6 +203,15 @@ public:
      */
     bool search_string_matches_all() const { return m_search_string_matches_all; }
 
+    /**
+     * @param msg
+     * @return Whether the given message matches the search string (considering the query's case
+     * sensitivity)
+     */
+    bool search_string_matches(std::string_view msg) const {
+        return m_search_string_matcher.matches(msg);
+    }
+
     std::vector<SubQuery> const& get_sub_queries() const { return m_sub_queries; }
 
     bool contains_sub_queries() const { return m_sub_queries.empty() == false; }
@@ -217,6 +229,7 @@ private:
     bool m_ignore_case{false};
     std::string m_search_string;
     bool m_search_string_matches_all{true};
+    clp::string_utils::WildcardMatcher m_search_string_matcher;
     std::vector<SubQuery> m_sub_queries;
     std::vector<SubQuery const*> m_relevant_sub_queries;
     segment_id_t m_prev_segment_id{cInvalidSegmentId};
@@ -17,7 +17,6 @@
 #include "../ArchiveMetadata.hpp"
 #include "../Constants.hpp"
 
-using clp::string_utils::wildcard_match_unsafe;
 using std::string;
 using std::unordered_set;
 using std::vector;
@@ -471,11 +470,7 @@ size_t Archive::decompress_messages_and_output(
             || (query.contains_sub_queries() == false && query.search_string_matches_all() == false
             ))
         {
-            bool matched = wildcard_match_unsafe(
-                    decompressed_msg,
-                    query.get_search_string(),
-                    query.get_ignore_case() == false
-            );
+            bool matched = query.search_string_matches(decompressed_msg);
             if (!matched) {
                 continue;
             }
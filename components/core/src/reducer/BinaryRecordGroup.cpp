@@ -0,0 +1,315 @@
+#include "BinaryRecordGroup.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../clp/ErrorCode.hpp"
+
+namespace reducer {
+namespace {
+/**
+ * A cursor over serialized data which throws if a read would go past the end of the data.
+ */
+class BinaryReader {
+public:
+    BinaryReader(char const* buf, size_t len) : m_pos{buf}, m_end{buf + len} {}
+
+    /**
+     * @tparam T
+     * @return The next value.
+     * @throw BinaryRecordGroup::OperationFailed if the data is truncated.
+     */
+    template <typename T>
+    T read_value() {
+        T value;
+        memcpy(&value, read_bytes(sizeof(value)), sizeof(value));
+        return value;
+    }
+
+    /**
+     * @param num_bytes
+     * @return A pointer to the next `num_bytes` bytes.
+     * @throw BinaryRecordGroup::OperationFailed if the data is truncated.
+     */
+    char const* read_bytes(size_t num_bytes) {
+        if (static_cast<size_t>(m_end - m_pos) < num_bytes) {
+            throw BinaryRecordGroup::OperationFailed(
+                    clp::ErrorCode_Truncated,
+                    __FILENAME__,
+                    __LINE__
+            );
+        }
+        auto const* bytes = m_pos;
+        m_pos += num_bytes;
+        return bytes;
+    }
+
+    [[nodiscard]] bool done() const { return m_pos == m_end; }
+
+private:
+    char const* m_pos;
+    char const* m_end;
+};
+
+/**
+ * Appends the bytes of the given value to the given buffer.
+ * @tparam T
+ * @param value
+ * @param buf
+ */
+template <typename T>
+void append_value(T value, std::vector<uint8_t>& buf) {
+    auto const* bytes = reinterpret_cast<uint8_t const*>(&value);
+    buf.insert(buf.end(), bytes, bytes + sizeof(value));
+}
+
+/**
+ * Appends the given string, prefixed with its length, to the given buffer.
+ * @tparam LengthType
+ * @param value
+ * @param buf
+ * @return Whether the string's length fits in `LengthType`.
+ */
+template <typename LengthType>
+bool append_string(std::string_view value, std::vector<uint8_t>& buf) {
+    if (value.size() > std::numeric_limits<LengthType>::max()) {
+        return false;
+    }
+    append_value(static_cast<LengthType>(value.size()), buf);
+    buf.insert(buf.end(), value.begin(), value.end());
+    return true;
+}
+}  // namespace
+
+class BinaryRecordGroup::BinaryRecord::ColumnTypedKeyIterator : public RecordTypedKeyIterator {
+public:
+    explicit ColumnTypedKeyIterator(std::vector<Column> const& columns)
+            : m_it{columns.cbegin()},
+              m_end{columns.cend()} {}
+
+    TypedRecordKey get() override { return {m_it->key, m_it->type}; }
+
+    void next() override { ++m_it; }
+
+    bool done() override { return m_end == m_it; }
+
+private:
+    std::vector<Column>::const_iterator m_it;
+    std::vector<Column>::const_iterator m_end;
+};
+
+BinaryRecordGroup::BinaryRecordGroup(char const* buf, size_t len) {
+    BinaryReader reader{buf, len};
+
+    auto const num_tags = reader.read_value<uint8_t>();
+    for (size_t i = 0; i < num_tags; ++i) {
+        switch (static_cast<GroupTag::Type>(reader.read_value<uint8_t>())) {
+            case GroupTag::Type::Int64:
+                m_tags.push_back(GroupTag::from_int64(reader.read_value<int64_t>()));
+                break;
+            case GroupTag::Type::String: {
+                auto const length = reader.read_value<uint32_t>();
+                m_tags.push_back(GroupTag::from_string({reader.read_bytes(length), length}));
+                break;
+            }
+            default:
+                throw OperationFailed(clp::ErrorCode_Corrupt, __FILENAME__, __LINE__);
+        }
+    }
+
+    auto const num_records = reader.read_value<uint32_t>();
+    auto const num_columns = reader.read_value<uint8_t>();
+    m_columns.reserve(num_columns);
+    for (size_t i = 0; i < num_columns; ++i) {
+        auto const type = static_cast<ValueType>(reader.read_value<uint8_t>());
+        if (ValueType::String != type && ValueType::Int64 != type && ValueType::Double != type) {
+            throw OperationFailed(clp::ErrorCode_Corrupt, __FILENAME__, __LINE__);
+        }
+        auto const key_length = reader.read_value<uint16_t>();
+        m_columns.push_back({{reader.read_bytes(key_length), key_length}, type, nullptr, nullptr});
+    }
+
+    for (auto& column : m_columns) {
+        if (ValueType::String != column.type) {
+            column.values = reader.read_bytes(num_records * sizeof(int64_t));
+            continue;
+        }
+
+        column.values = reader.read_bytes(num_records * sizeof(uint32_t));
+        // The end offsets must be non-decreasing for every string to be within the string data
+        uint32_t string_data_length{0};
+        for (size_t record_ix = 0; record_ix < num_records; ++record_ix) {
+            uint32_t end_offset{0};
+            memcpy(&end_offset, column.values + record_ix * sizeof(end_offset), sizeof(end_offset));
+            if (end_offset < string_data_length) {
+                throw OperationFailed(clp::ErrorCode_Corrupt, __FILENAME__, __LINE__);
+            }
+            string_data_length = end_offset;
+        }
+        column.string_data = reader.read_bytes(string_data_length);
+    }
+    if (false == reader.done()) {
+        throw OperationFailed(clp::ErrorCode_Corrupt, __FILENAME__, __LINE__);
+    }
+
+    m_record_it.reset(num_records);
+}
+
+std::string_view BinaryRecordGroup::BinaryRecord::get_string_view(std::string_view key) const {
+    auto const* column = find_column(key, ValueType::String);
+    if (nullptr == column) {
+        return {};
+    }
+
+    uint32_t begin_offset{0};
+    if (m_record_ix > 0) {
+        memcpy(
+                &begin_offset,
+                column->values + (m_record_ix - 1) * sizeof(begin_offset),
+                sizeof(begin_offset)
+        );
+    }
+    uint32_t end_offset{0};
+    memcpy(&end_offset, column->values + m_record_ix * sizeof(end_offset), sizeof(end_offset));
+    return {column->string_data + begin_offset, end_offset - begin_offset};
+}
+
+int64_t BinaryRecordGroup::BinaryRecord::get_int64_value(std::string_view key) const {
+    auto const* column = find_column(key, ValueType::Int64);
+    if (nullptr == column) {
+        return 0;
+    }
+
+    int64_t value{0};
+    memcpy(&value, column->values + m_record_ix * sizeof(value), sizeof(value));
+    return value;
+}
+
+double BinaryRecordGroup::BinaryRecord::get_double_value(std::string_view key) const {
+    auto const* column = find_column(key, ValueType::Double);
+    if (nullptr == column) {
+        return 0.0;
+    }
+
+    double value{0.0};
+    memcpy(&value, column->values + m_record_ix * sizeof(value), sizeof(value));
+    return value;
+}
+
+std::unique_ptr<RecordTypedKeyIterator> BinaryRecordGroup::BinaryRecord::typed_key_iter() const {
+    return std::make_unique<ColumnTypedKeyIterator>(m_columns);
+}
+
+BinaryRecordGroup::Column const*
+BinaryRecordGroup::BinaryRecord::find_column(std::string_view key, ValueType type) const {
+    // Records only have a handful of elements, so a linear scan is faster than a hash lookup
+    for (auto const& column : m_columns) {
+        if (column.key == key) {
+            return type == column.type ? &column : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+std::optional<std::vector<uint8_t>>
+serialize_to_binary(GroupTags const& tags, ConstRecordIterator& record_it) {
+    if (tags.size() > std::numeric_limits<uint8_t>::max()) {
+        return std::nullopt;
+    }
+
+    std::vector<uint8_t> serialized_group;
+    serialized_group.push_back(static_cast<uint8_t>(tags.size()));
+    for (auto const& tag : tags) {
+        serialized_group.push_back(static_cast<uint8_t>(tag.get_type()));
+        if (GroupTag::Type::Int64 == tag.get_type()) {
+            append_value(tag.get_int64_value(), serialized_group);
+        } else if (false == append_string<uint32_t>(tag.get_string_value(), serialized_group)) {
+            return std::nullopt;
+        }
+    }
+
+    // Every record must have the same schema as the first. The keys are copied since they may
+    // not outlive the first record.
+    std::vector<std::pair<std::string, ValueType>> schema;
+    if (false == record_it.done()) {
+        for (auto typed_key_it = record_it.get().typed_key_iter(); false == typed_key_it->done();
+             typed_key_it->next())
+        {
+            auto const typed_key = typed_key_it->get();
+            schema.emplace_back(typed_key.get_key(), typed_key.get_type());
+        }
+    }
+    if (schema.size() > std::numeric_limits<uint8_t>::max()) {
+        return std::nullopt;
+    }
+
+    // Gather each column's values (and each string column's concatenated strings) separately
+    std::vector<std::vector<uint8_t>> column_values(schema.size());
+    std::vector<std::string> column_string_data(schema.size());
+    uint32_t num_records{0};
+    for (; false == record_it.done(); record_it.next()) {
+        auto const& record = record_it.get();
+        size_t column_ix{0};
+        for (auto typed_key_it = record.typed_key_iter(); false == typed_key_it->done();
+             typed_key_it->next(), ++column_ix)
+        {
+            auto const typed_key = typed_key_it->get();
+            if (column_ix >= schema.size() || typed_key.get_key() != schema[column_ix].first
+                || typed_key.get_type() != schema[column_ix].second)
+            {
+                return std::nullopt;
+            }
+
+            auto const key = typed_key.get_key();
+            auto& values = column_values[column_ix];
+            switch (typed_key.get_type()) {
+                case ValueType::Int64:
+                    append_value(record.get_int64_value(key), values);
+                    break;
+                case ValueType::Double:
+                    append_value(record.get_double_value(key), values);
+                    break;
+                case ValueType::String: {
+                    auto& string_data = column_string_data[column_ix];
+                    string_data.append(record.get_string_view(key));
+                    if (string_data.size() > std::numeric_limits<uint32_t>::max()) {
+                        return std::nullopt;
+                    }
+                    append_value(static_cast<uint32_t>(string_data.size()), values);
+                    break;
+                }
+            }
+        }
+        if (schema.size() != column_ix) {
+            return std::nullopt;
+        }
+        ++num_records;
+    }
+
+    append_value(num_records, serialized_group);
+    serialized_group.push_back(static_cast<uint8_t>(schema.size()));
+    for (auto const& [key, type] : schema) {
+        serialized_group.push_back(static_cast<uint8_t>(type));
+        if (false == append_string<uint16_t>(key, serialized_group)) {
+            return std::nullopt;
+        }
+    }
+
+    for (size_t column_ix = 0; column_ix < schema.size(); ++column_ix) {
+        auto const& values = column_values[column_ix];
+        serialized_group.insert(serialized_group.end(), values.begin(), values.end());
+        auto const& string_data = column_string_data[column_ix];
+        serialized_group.insert(serialized_group.end(), string_data.begin(), string_data.end());
+    }
+
+    return serialized_group;
+}
+}  // namespace reducer
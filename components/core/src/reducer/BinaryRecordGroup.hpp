@@ -0,0 +1,171 @@
+#ifndef REDUCER_BINARYRECORDGROUP_HPP
+#define REDUCER_BINARYRECORDGROUP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "../clp/ErrorCode.hpp"
+#include "../clp/TraceableException.hpp"
+#include "ConstRecordIterator.hpp"
+#include "GroupTags.hpp"
+#include "Record.hpp"
+#include "RecordGroup.hpp"
+#include "RecordTypedKeyIterator.hpp"
+
+namespace reducer {
+/**
+ * Class which exposes a record group serialized by `serialize_to_binary` directly from the
+ * serialized data, without first decoding it into a DOM. Only the group's tags and the record
+ * schema are decoded; record values are read from the serialized data as they're accessed, so the
+ * data must outlive this object.
+ *
+ * All records in a group have the same elements (columns), so the format stores the schema once
+ * and then each column's values contiguously. All integers are in host byte order, like the size
+ * that prefixes each serialized record group.
+ * - Header:
+ *   - uint8_t: Number of tags
+ *   - For each tag: uint8_t GroupTag::Type, followed by either an int64_t value or a uint32_t
+ *     length and the string's bytes
+ *   - uint32_t: Number of records
+ *   - uint8_t: Number of columns
+ *   - For each column: uint8_t ValueType, uint16_t key length, and the key's bytes
+ * - Payload, for each column:
+ *   - Int64 or Double: One 8-byte value per record
+ *   - String: One uint32_t end offset per record, followed by the concatenated strings
+ */
+class BinaryRecordGroup : public RecordGroup {
+public:
+    // Types
+    class OperationFailed : public clp::TraceableException {
+    public:
+        // Constructors
+        OperationFailed(clp::ErrorCode error_code, char const* filename, int line_number)
+                : clp::TraceableException{error_code, filename, line_number} {}
+
+        // Methods
+        [[nodiscard]] char const* what() const noexcept override {
+            return "reducer::BinaryRecordGroup operation failed";
+        }
+    };
+
+    // Constructors
+    /**
+     * @param buf
+     * @param len
+     * @throw BinaryRecordGroup::OperationFailed if the data is truncated or malformed
+     */
+    BinaryRecordGroup(char const* buf, size_t len);
+
+    // Disable copy and move since the record and iterator point into this object
+    BinaryRecordGroup(BinaryRecordGroup const&) = delete;
+    BinaryRecordGroup(BinaryRecordGroup&&) = delete;
+    BinaryRecordGroup& operator=(BinaryRecordGroup const&) = delete;
+    BinaryRecordGroup& operator=(BinaryRecordGroup&&) = delete;
+
+    // Destructor
+    ~BinaryRecordGroup() override = default;
+
+    // Methods
+    [[nodiscard]] ConstRecordIterator& record_iter() override { return m_record_it; }
+
+    [[nodiscard]] GroupTags const& get_tags() const override { return m_tags; }
+
+private:
+    // Types
+    struct Column {
+        std::string_view key;
+        ValueType type;
+        // One 8-byte value or one 4-byte end offset per record
+        char const* values;
+        // Only used by string columns
+        char const* string_data;
+    };
+
+    /**
+     * A Record that reads one record's values from the group's columns.
+     */
+    class BinaryRecord : public Record {
+    public:
+        explicit BinaryRecord(std::vector<Column> const& columns) : m_columns{columns} {}
+
+        void set_record_ix(size_t record_ix) { m_record_ix = record_ix; }
+
+        [[nodiscard]] std::string_view get_string_view(std::string_view key) const override;
+
+        [[nodiscard]] int64_t get_int64_value(std::string_view key) const override;
+
+        [[nodiscard]] double get_double_value(std::string_view key) const override;
+
+        [[nodiscard]] std::unique_ptr<RecordTypedKeyIterator> typed_key_iter() const override;
+
+    private:
+        // Types
+        class ColumnTypedKeyIterator;
+
+        // Methods
+        /**
+         * @param key
+         * @param type
+         * @return The column with the given key and type, or nullptr if there's no such column.
+         */
+        [[nodiscard]] Column const* find_column(std::string_view key, ValueType type) const;
+
+        // Variables
+        std::vector<Column> const& m_columns;
+        size_t m_record_ix{0};
+    };
+
+    /**
+     * A ConstRecordIterator over the records in the group.
+     */
+    class BinaryRecordIterator : public ConstRecordIterator {
+    public:
+        explicit BinaryRecordIterator(BinaryRecord& record) : m_record{record} {}
+
+        /**
+         * Resets the iterator to the first of the given number of records.
+         * @param num_records
+         */
+        void reset(size_t num_records) {
+            m_num_records = num_records;
+            m_record_ix = 0;
+            m_record.set_record_ix(0);
+        }
+
+        [[nodiscard]] Record const& get() const override { return m_record; }
+
+        void next() override { m_record.set_record_ix(++m_record_ix); }
+
+        bool done() override { return m_record_ix >= m_num_records; }
+
+        void reset() override { reset(m_num_records); }
+
+    private:
+        BinaryRecord& m_record;
+        size_t m_num_records{0};
+        size_t m_record_ix{0};
+    };
+
+    // Variables
+    GroupTags m_tags;
+    std::vector<Column> m_columns;
+    BinaryRecord m_record{m_columns};
+    BinaryRecordIterator m_record_it{m_record};
+};
+
+/**
+ * Serializes a record group into the format read by BinaryRecordGroup.
+ * @param tags The tags in the record group.
+ * @param record_it An iterator for the records in the record group.
+ * @return The serialized data, or std::nullopt if the records don't all have the same elements
+ * (keys and value types, in the same order).
+ */
+std::optional<std::vector<uint8_t>>
+serialize_to_binary(GroupTags const& tags, ConstRecordIterator& record_it);
+}  // namespace reducer
+
+#endif  // REDUCER_BINARYRECORDGROUP_HPP
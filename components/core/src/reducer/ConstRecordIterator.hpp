@@ -33,6 +33,11 @@ public:
      * @return Whether the iterator has been exhausted.
      */
     virtual bool done() = 0;
+
+    /**
+     * Rewinds the iterator to the first record.
+     */
+    virtual void reset() = 0;
 };
 
 /**
@@ -48,7 +53,7 @@ public:
 
     bool done() override { return m_done; }
 
-    void reset() { m_done = false; }
+    void reset() override { m_done = false; }
 
 private:
     Record const* m_record;
@@ -61,7 +66,8 @@ private:
 class MultiRecordIterator : public ConstRecordIterator {
 public:
     explicit MultiRecordIterator(std::vector<Record> const& records)
-            : m_cur{records.cbegin()},
+            : m_begin{records.cbegin()},
+              m_cur{records.cbegin()},
               m_end{records.cend()} {}
 
     [[nodiscard]] Record const& get() const override { return *m_cur; }
@@ -70,7 +76,10 @@ public:
 
     bool done() override { return m_cur == m_end; }
 
+    void reset() override { m_cur = m_begin; }
+
 private:
+    std::vector<Record>::const_iterator m_begin;
     std::vector<Record>::const_iterator m_cur;
     std::vector<Record>::const_iterator m_end;
 };
@@ -86,6 +95,8 @@ public:
 
     bool done() override { return true; }
 
+    void reset() override {}
+
 private:
     EmptyRecord m_record;
 };
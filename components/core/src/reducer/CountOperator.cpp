@@ -31,7 +31,7 @@ std::unique_ptr<RecordGroupIterator> CountOperator::get_stored_result_iterator()
 }
 
 std::unique_ptr<RecordGroupIterator> CountOperator::get_stored_result_iterator(
-        std::set<GroupTags> const& filtered_tags
+        GroupTagsSet const& filtered_tags
 ) {
     return std::make_unique<FilteredInt64MapRecordGroupIterator>(
             m_group_count,
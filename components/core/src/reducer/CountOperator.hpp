@@ -1,8 +1,7 @@
 #ifndef REDUCER_COUNTOPERATOR_HPP
 #define REDUCER_COUNTOPERATOR_HPP
 
-#include <map>
-#include <string>
+#include <cstdint>
 
 #include "GroupTags.hpp"
 #include "Operator.hpp"
@@ -23,11 +22,11 @@ public:
 
     std::unique_ptr<RecordGroupIterator> get_stored_result_iterator() override;
     std::unique_ptr<RecordGroupIterator> get_stored_result_iterator(
-            std::set<GroupTags> const& filtered_tags
+            GroupTagsSet const& filtered_tags
     ) override;
 
 private:
-    std::map<GroupTags, int64_t> m_group_count;
+    GroupTagsMap<int64_t> m_group_count;
 };
 }  // namespace reducer
 
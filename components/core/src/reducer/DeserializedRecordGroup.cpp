@@ -1,6 +1,8 @@
 #include "DeserializedRecordGroup.hpp"
 
+#include <cstdint>
 #include <string>
+#include <utility>
 
 #include <json/single_include/nlohmann/json.hpp>
 
@@ -20,10 +22,13 @@ DeserializedRecordGroup::DeserializedRecordGroup(char* buf, size_t len)
 }
 
 void DeserializedRecordGroup::init_tags_from_json() {
-    auto tags = m_record_group[static_cast<char const*>(cGroupTagsKey)]
-                        .template get<nlohmann::json::array_t>();
-    for (auto& tag : tags) {
-        m_tags.emplace_back(tag.template get<std::string>());
+    auto const& tags = m_record_group[static_cast<char const*>(cGroupTagsKey)];
+    for (auto const& tag : tags) {
+        if (tag.is_number_integer()) {
+            m_tags.push_back(GroupTag::from_int64(tag.template get<int64_t>()));
+        } else {
+            m_tags.push_back(GroupTag::from_string(tag.template get_ref<std::string const&>()));
+        }
     }
 }
 
@@ -33,7 +38,16 @@ std::vector<uint8_t> serialize(
         std::vector<uint8_t>(serializer)(nlohmann::json const& j)
 ) {
     nlohmann::json json;
-    json[static_cast<char const*>(DeserializedRecordGroup::cGroupTagsKey)] = tags;
+    auto serialized_tags = nlohmann::json::array();
+    for (auto const& tag : tags) {
+        if (GroupTag::Type::Int64 == tag.get_type()) {
+            serialized_tags.emplace_back(tag.get_int64_value());
+        } else {
+            serialized_tags.emplace_back(tag.get_string_value());
+        }
+    }
+    json[static_cast<char const*>(DeserializedRecordGroup::cGroupTagsKey)]
+            = std::move(serialized_tags);
     auto records = nlohmann::json::array();
 
     for (; false == record_it.done(); record_it.next()) {
@@ -8,6 +8,7 @@
 #include <json/single_include/nlohmann/json.hpp>
 
 #include "ConstRecordIterator.hpp"
+#include "GroupTags.hpp"
 #include "JsonArrayRecordIterator.hpp"
 #include "JsonRecord.hpp"
 #include "Record.hpp"
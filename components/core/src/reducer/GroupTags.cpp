@@ -0,0 +1,92 @@
+#include "GroupTags.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+
+#include <absl/container/flat_hash_map.h>
+
+namespace reducer {
+namespace {
+/**
+ * A thread-safe dictionary of interned strings, indexed by sequential IDs.
+ */
+class InternedStringDictionary {
+public:
+    /**
+     * @param value
+     * @return The ID of the given string, interning it if necessary.
+     */
+    int64_t intern(std::string_view value);
+
+    /**
+     * @param id
+     * @return The string with the given ID.
+     */
+    std::string_view get(int64_t id);
+
+    void clear();
+
+private:
+    std::shared_mutex m_mutex;
+    // A deque so that existing strings (and views of them) aren't moved when a string is added
+    std::deque<std::string> m_strings;
+    absl::flat_hash_map<std::string_view, int64_t> m_string_to_id;
+};
+
+/**
+ * @return The process-wide dictionary of interned group tag strings.
+ */
+InternedStringDictionary& get_interned_string_dictionary();
+
+int64_t InternedStringDictionary::intern(std::string_view value) {
+    {
+        std::shared_lock<std::shared_mutex> const lock{m_mutex};
+        if (auto const it = m_string_to_id.find(value); m_string_to_id.end() != it) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> const lock{m_mutex};
+    // Another thread may have interned the string since we released the shared lock
+    if (auto const it = m_string_to_id.find(value); m_string_to_id.end() != it) {
+        return it->second;
+    }
+    auto const id = static_cast<int64_t>(m_strings.size());
+    auto const& interned_value = m_strings.emplace_back(value);
+    m_string_to_id.emplace(interned_value, id);
+    return id;
+}
+
+std::string_view InternedStringDictionary::get(int64_t id) {
+    std::shared_lock<std::shared_mutex> const lock{m_mutex};
+    return m_strings[id];
+}
+
+void InternedStringDictionary::clear() {
+    std::unique_lock<std::shared_mutex> const lock{m_mutex};
+    m_string_to_id.clear();
+    m_strings.clear();
+}
+
+InternedStringDictionary& get_interned_string_dictionary() {
+    static InternedStringDictionary dictionary;
+    return dictionary;
+}
+}  // namespace
+
+GroupTag GroupTag::from_string(std::string_view value) {
+    return GroupTag{Type::String, get_interned_string_dictionary().intern(value)};
+}
+
+void GroupTag::clear_interned_strings() {
+    get_interned_string_dictionary().clear();
+}
+
+std::string_view GroupTag::get_string_value() const {
+    return get_interned_string_dictionary().get(m_value);
+}
+}  // namespace reducer
@@ -1,12 +1,152 @@
 #ifndef REDUCER_GROUPTAGS_HPP
 #define REDUCER_GROUPTAGS_HPP
 
-#include <string>
-#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string_view>
+#include <utility>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+#include <absl/container/inlined_vector.h>
 
 namespace reducer {
-// We will do something fancier for GroupTags in the future, but this is good enough to get started
-using GroupTags = std::vector<std::string>;
+/**
+ * A single tag in a group's key, which is either an int64 (e.g., a timeline bucket's timestamp) or
+ * a string. String tags are interned in a process-wide dictionary, so every tag is a fixed-size
+ * value that can be compared and hashed without touching the string.
+ */
+class GroupTag {
+public:
+    // Types
+    enum class Type : uint8_t {
+        Int64,
+        String
+    };
+
+    // Factory functions
+    static GroupTag from_int64(int64_t value) { return GroupTag{Type::Int64, value}; }
+
+    /**
+     * Creates a string tag, interning the string if it hasn't been interned yet. This method is
+     * thread-safe.
+     * @param value
+     * @return The tag.
+     */
+    static GroupTag from_string(std::string_view value);
+
+    /**
+     * Clears the dictionary of interned strings.
+     * NOTE: This must only be called when no string tags are in use, since their strings will no
+     * longer be resolvable.
+     */
+    static void clear_interned_strings();
+
+    // Methods
+    [[nodiscard]] Type get_type() const { return m_type; }
+
+    /**
+     * NOTE: It's the caller's responsibility to ensure this is an int64 tag.
+     * @return The tag's value.
+     */
+    [[nodiscard]] int64_t get_int64_value() const { return m_value; }
+
+    /**
+     * NOTE: It's the caller's responsibility to ensure this is a string tag.
+     * @return The tag's interned string, which stays valid until `clear_interned_strings` is
+     * called.
+     */
+    [[nodiscard]] std::string_view get_string_value() const;
+
+    /**
+     * @return A well-mixed hash of the tag.
+     */
+    [[nodiscard]] size_t hash() const {
+        // Finalizer of MurmurHash3's 64-bit variant, so that sequential values (interned string IDs
+        // or timestamps that are multiples of a bucket size) spread across all bits of the hash
+        auto hash = static_cast<uint64_t>(m_value) ^ (static_cast<uint64_t>(m_type) << 63);
+        hash ^= hash >> 33;
+        hash *= 0xff51'afd7'ed55'8ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ce'b9fe'1a85'ec53ULL;
+        hash ^= hash >> 33;
+        return static_cast<size_t>(hash);
+    }
+
+    bool operator==(GroupTag const& rhs) const = default;
+
+private:
+    // Constructors
+    GroupTag(Type type, int64_t value) : m_value{value}, m_type{type} {}
+
+    // Variables
+    // The interned string's ID for string tags
+    int64_t m_value;
+    Type m_type;
+};
+
+/**
+ * The key of a group of records: a short list of tags with a hash that's computed as tags are
+ * added, so that looking the group up in a hash map never rehashes the tags.
+ */
+class GroupTags {
+public:
+    // Types
+    using const_iterator = absl::InlinedVector<GroupTag, 2>::const_iterator;
+
+    // Constructors
+    GroupTags() = default;
+
+    GroupTags(std::initializer_list<GroupTag> tags) {
+        for (auto const& tag : tags) {
+            push_back(tag);
+        }
+    }
+
+    // Methods
+    void push_back(GroupTag const& tag) {
+        m_tags.push_back(tag);
+        m_hash ^= tag.hash() + 0x9e37'79b9'7f4a'7c15ULL + (m_hash << 6) + (m_hash >> 2);
+    }
+
+    [[nodiscard]] bool empty() const { return m_tags.empty(); }
+
+    [[nodiscard]] size_t size() const { return m_tags.size(); }
+
+    [[nodiscard]] GroupTag const& front() const { return m_tags.front(); }
+
+    [[nodiscard]] GroupTag const& operator[](size_t i) const { return m_tags[i]; }
+
+    [[nodiscard]] const_iterator begin() const { return m_tags.begin(); }
+
+    [[nodiscard]] const_iterator end() const { return m_tags.end(); }
+
+    /**
+     * @return The precomputed hash of the tags.
+     */
+    [[nodiscard]] size_t hash() const { return m_hash; }
+
+    bool operator==(GroupTags const& rhs) const {
+        return m_hash == rhs.m_hash && m_tags == rhs.m_tags;
+    }
+
+    template <typename H>
+    friend H AbslHashValue(H h, GroupTags const& tags) {
+        return H::combine(std::move(h), tags.m_hash);
+    }
+
+private:
+    // Variables
+    // Most group-bys have one or two tags, so they don't need to allocate
+    absl::InlinedVector<GroupTag, 2> m_tags;
+    size_t m_hash{0};
+};
+
+template <typename Value>
+using GroupTagsMap = absl::flat_hash_map<GroupTags, Value>;
+
+using GroupTagsSet = absl::flat_hash_set<GroupTags>;
 }  // namespace reducer
 
 #endif  // REDUCER_GROUPTAGS_HPP
@@ -14,11 +14,8 @@ class JsonArrayRecordIterator : public ConstRecordIterator {
 public:
     explicit JsonArrayRecordIterator(nlohmann::json::array_t json_records)
             : m_json_records(std::move(json_records)),
-              m_record{m_cur_json_record},
-              m_json_records_it{m_json_records.begin()} {
-        if (m_json_records_it != m_json_records.end()) {
-            m_cur_json_record = *m_json_records_it;
-        }
+              m_record{m_cur_json_record} {
+        reset();
     }
 
     [[nodiscard]] Record const& get() const override { return m_record; }
@@ -32,6 +29,13 @@ public:
 
     bool done() override { return m_json_records_it == m_json_records.end(); }
 
+    void reset() override {
+        m_json_records_it = m_json_records.begin();
+        if (m_json_records_it != m_json_records.end()) {
+            m_cur_json_record = *m_json_records_it;
+        }
+    }
+
 private:
     nlohmann::json::array_t m_json_records;
     nlohmann::json::array_t::iterator m_json_records_it;
@@ -2,9 +2,9 @@
 #define REDUCER_OPERATOR_HPP
 
 #include <memory>
-#include <set>
 #include <utility>
 
+#include "GroupTags.hpp"
 #include "RecordGroup.hpp"
 #include "RecordGroupIterator.hpp"
 
@@ -38,7 +38,7 @@ public:
     virtual std::unique_ptr<RecordGroupIterator> get_stored_result_iterator() = 0;
 
     virtual std::unique_ptr<RecordGroupIterator> get_stored_result_iterator(
-            [[maybe_unused]] std::set<GroupTags> const& filtered_tags
+            [[maybe_unused]] GroupTagsSet const& filtered_tags
     ) {
         // TODO: By default operators don't have to support filtering their output. We should
         // implement an iterator that wraps RecordGroupIterators and performs the filtering when the
@@ -40,7 +40,7 @@ std::unique_ptr<RecordGroupIterator> Pipeline::finish() {
     return m_stages.back()->get_stored_result_iterator();
 }
 
-std::unique_ptr<RecordGroupIterator> Pipeline::finish(std::set<GroupTags> const& filtered_tags) {
+std::unique_ptr<RecordGroupIterator> Pipeline::finish(GroupTagsSet const& filtered_tags) {
     if (m_stages.empty()) {
         return std::make_unique<EmptyRecordGroupIterator>();
     }
@@ -2,7 +2,6 @@
 #define REDUCER_PIPELINE_HPP
 
 #include <memory>
-#include <set>
 #include <vector>
 
 #include "GroupTags.hpp"
@@ -29,7 +28,7 @@ public:
     void add_pipeline_stage(std::shared_ptr<Operator> const& op);
 
     std::unique_ptr<RecordGroupIterator> finish();
-    std::unique_ptr<RecordGroupIterator> finish(std::set<GroupTags> const& filtered_tags);
+    std::unique_ptr<RecordGroupIterator> finish(GroupTagsSet const& filtered_tags);
 
 private:
     std::vector<std::shared_ptr<Operator>> m_stages;
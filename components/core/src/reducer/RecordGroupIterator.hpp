@@ -2,9 +2,10 @@
 #define REDUCER_RECORDGROUPITERATOR_HPP
 
 #include <map>
-#include <set>
+#include <string>
 #include <utility>
 
+#include "GroupTags.hpp"
 #include "RecordGroup.hpp"
 
 namespace reducer {
@@ -40,7 +41,7 @@ public:
  */
 class Int64MapRecordGroupIterator : public RecordGroupIterator {
 public:
-    Int64MapRecordGroupIterator(std::map<GroupTags, int64_t> const& map, std::string key)
+    Int64MapRecordGroupIterator(GroupTagsMap<int64_t> const& map, std::string key)
             : m_map_it{map.cbegin()},
               m_map_end_it{map.cend()},
               m_record{std::move(key)},
@@ -60,8 +61,8 @@ public:
 private:
     SingleInt64RecordAdapter m_record;
     SingleRecordGroup m_group;
-    std::map<GroupTags, int64_t>::const_iterator m_map_it;
-    std::map<GroupTags, int64_t>::const_iterator m_map_end_it;
+    GroupTagsMap<int64_t>::const_iterator m_map_it;
+    GroupTagsMap<int64_t>::const_iterator m_map_end_it;
 };
 
 /**
@@ -76,7 +77,7 @@ public:
               m_group(nullptr, m_record) {}
 
     RecordGroup& get() override {
-        m_tags = {std::to_string(m_map_it->first)};
+        m_tags = {GroupTag::from_int64(m_map_it->first)};
         m_record.set_record_value(m_map_it->second);
         m_group.set_tags(&m_tags);
         m_group.reset_record_iterator();
@@ -102,8 +103,8 @@ private:
 class FilteredInt64MapRecordGroupIterator : public RecordGroupIterator {
 public:
     FilteredInt64MapRecordGroupIterator(
-            std::map<GroupTags, int64_t> const& map,
-            std::set<GroupTags> const& filter,
+            GroupTagsMap<int64_t> const& map,
+            GroupTagsSet const& filter,
             std::string key
     )
             : m_map{map},
@@ -151,11 +152,11 @@ private:
 
     SingleInt64RecordAdapter m_record;
     SingleRecordGroup m_group;
-    std::map<GroupTags, int64_t> const& m_map;
-    std::map<GroupTags, int64_t>::const_iterator m_map_end_it;
-    std::map<GroupTags, int64_t>::const_iterator m_map_it;
-    std::set<GroupTags>::const_iterator m_filter_it;
-    std::set<GroupTags>::const_iterator m_filter_end_it;
+    GroupTagsMap<int64_t> const& m_map;
+    GroupTagsMap<int64_t>::const_iterator m_map_end_it;
+    GroupTagsMap<int64_t>::const_iterator m_map_it;
+    GroupTagsSet::const_iterator m_filter_it;
+    GroupTagsSet::const_iterator m_filter_end_it;
 };
 
 /**
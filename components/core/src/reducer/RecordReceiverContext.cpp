@@ -1,14 +1,20 @@
 #include "RecordReceiverContext.hpp"
 
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
 #include "../clp/spdlog_with_specializations.hpp"
-#include "DeserializedRecordGroup.hpp"
 #include "types.hpp"
 
 namespace reducer {
 bool RecordReceiverContext::read_connection_init_packet() {
     job_id_t job_id{0};
 
-    if (m_buf_num_bytes_occupied != sizeof(job_id)) {
+    if (m_buf_num_bytes_occupied != sizeof(job_id)
+        && m_buf_num_bytes_occupied != sizeof(job_id) + sizeof(m_record_group_format))
+    {
         SPDLOG_ERROR("Rejecting connection due to invalid negotiation");
         return false;
     }
@@ -23,6 +29,18 @@ bool RecordReceiverContext::read_connection_init_packet() {
         );
         return false;
     }
+
+    // Senders which don't specify a format use msgpack
+    m_record_group_format = RecordGroupFormat::Msgpack;
+    if (m_buf_num_bytes_occupied > sizeof(job_id)) {
+        uint8_t format{0};
+        memcpy(&format, m_buf.data() + sizeof(job_id), sizeof(format));
+        if (format > static_cast<uint8_t>(RecordGroupFormat::Binary)) {
+            SPDLOG_ERROR("Rejecting connection with unknown record group format {}", format);
+            return false;
+        }
+        m_record_group_format = static_cast<RecordGroupFormat>(format);
+    }
     m_buf_num_bytes_occupied = 0;
 
     return true;
@@ -44,6 +62,7 @@ bool RecordReceiverContext::send_connection_accept_packet() {
 bool RecordReceiverContext::read_record_groups_packet() {
     size_t record_size{0};
     auto* read_head = m_buf.data();
+    bool is_record_too_large{false};
     while (m_buf_num_bytes_occupied > 0) {
         if (m_buf_num_bytes_occupied < sizeof(record_size)) {
             break;
@@ -53,18 +72,27 @@ bool RecordReceiverContext::read_record_groups_packet() {
         // terminate if record group size is over 16MB
         if (record_size >= cMaxRecordSize) {
             SPDLOG_ERROR("Record too large: {}B", record_size);
-            return false;
+            is_record_too_large = true;
+            break;
         }
 
         if (m_buf_num_bytes_occupied < record_size + sizeof(record_size)) {
             break;
         }
-        read_head += sizeof(record_size);
-
-        auto record_group = DeserializedRecordGroup{read_head, record_size};
-        m_server_ctx->push_record_group(record_group.get_tags(), record_group.record_iter());
         m_buf_num_bytes_occupied -= (record_size + sizeof(record_size));
-        read_head += record_size;
+        read_head += sizeof(record_size) + record_size;
+    }
+
+    // Hand off all complete record groups at once so that they can be deserialized off the event
+    // loop's thread
+    if (read_head > m_buf.data()) {
+        m_server_ctx->push_serialized_record_groups(
+                {m_buf.data(), read_head},
+                m_record_group_format
+        );
+    }
+    if (is_record_too_large) {
+        return false;
     }
 
     if (m_buf_num_bytes_occupied > 0) {
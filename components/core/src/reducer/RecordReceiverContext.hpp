@@ -7,6 +7,7 @@
 #include <boost/asio/ip/tcp.hpp>
 
 #include "ServerContext.hpp"
+#include "types.hpp"
 
 namespace reducer {
 class RecordReceiverContext {
@@ -40,9 +41,10 @@ public:
     }
 
     /**
-     * Reads a connection initiation packet.
-     * @return false if there are an unexpected number of bytes in the buffer or the sender's job ID
-     * doesn't match the one currently being processed.
+     * Reads a connection initiation packet, which contains the sender's job ID optionally followed
+     * by the format of the record groups it will send.
+     * @return false if there are an unexpected number of bytes in the buffer, the sender's job ID
+     * doesn't match the one currently being processed, or the format is unknown.
      * @return true otherwise.
      */
     bool read_connection_init_packet();
@@ -86,6 +88,7 @@ private:
     boost::asio::ip::tcp::socket m_socket;
     std::vector<char> m_buf;
     size_t m_buf_num_bytes_occupied{0};
+    RecordGroupFormat m_record_group_format{RecordGroupFormat::Msgpack};
 };
 }  // namespace reducer
 #endif  // REDUCER_RECORDRECEIVERCONTEXT_HPP
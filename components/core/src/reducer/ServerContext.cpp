@@ -1,5 +1,11 @@
 #include "ServerContext.hpp"
 
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <utility>
+
 #include <bsoncxx/builder/stream/document.hpp>
 #include <json/single_include/nlohmann/json.hpp>
 #include <mongocxx/bulk_write.hpp>
@@ -12,9 +18,11 @@
 #include <msgpack.hpp>
 
 #include "../clp/spdlog_with_specializations.hpp"
+#include "BinaryRecordGroup.hpp"
 #include "CommandLineArguments.hpp"
 #include "CountOperator.hpp"
 #include "DeserializedRecordGroup.hpp"
+#include "Pipeline.hpp"
 
 using boost::asio::ip::tcp;
 using std::vector;
@@ -36,7 +44,7 @@ vector<uint8_t> serialize_timeline_result(GroupTags const& tags, ConstRecordIter
 
 vector<uint8_t> serialize_timeline_result(GroupTags const& tags, ConstRecordIterator& record_it) {
     nlohmann::json json;
-    json["timestamp"] = std::stoll(tags.front());
+    json["timestamp"] = tags.front().get_int64_value();
     auto records = nlohmann::json::array();
 
     int64_t count = 0;
@@ -57,7 +65,12 @@ ServerContext::ServerContext(CommandLineArguments& args)
           m_upsert_timer{m_ioctx},
           m_reducer_host{args.get_reducer_host()},
           m_reducer_port{args.get_reducer_port()},
-          m_upsert_interval{args.get_upsert_interval()} {
+          m_upsert_interval{args.get_upsert_interval()},
+          m_num_threads{static_cast<size_t>(args.get_num_threads())} {
+    if (m_num_threads > 1) {
+        m_thread_pool = std::make_unique<boost::asio::thread_pool>(m_num_threads);
+    }
+
     mongocxx::uri mongodb_uri = mongocxx::uri(args.get_mongodb_uri());
     try {
         m_mongodb_client = mongocxx::client(mongodb_uri);
@@ -76,6 +89,8 @@ void ServerContext::reset() {
     m_is_timeline_aggregation = false;
     m_updated_tags.clear();
     m_num_active_receiver_tasks = 0;
+    // No tags from the previous job are left, so free the strings they interned
+    GroupTag::clear_interned_strings();
 }
 
 void ServerContext::stop_event_loop() {
@@ -149,8 +164,9 @@ void ServerContext::set_up_pipeline(nlohmann::json const& query_config) {
     // timeline aggregation.
     // TODO: We'll need to implement more general pipeline initialization once more operators are
     // needed.
-    m_pipeline = std::make_unique<Pipeline>(PipelineInputMode::IntraStage);
-    m_pipeline->add_pipeline_stage(std::make_shared<CountOperator>());
+    auto const num_shards = m_num_threads > 1 ? m_num_threads * cNumShardsPerThread : 1;
+    m_pipeline = std::make_unique<ShardedPipeline>(num_shards, PipelineInputMode::IntraStage);
+    m_pipeline->add_pipeline_stage([] { return std::make_shared<CountOperator>(); });
 
     if (query_config.count(cJobAttributes::TimeBucketSize) > 0
         && false == query_config[cJobAttributes::TimeBucketSize].is_null())
@@ -163,24 +179,108 @@ void ServerContext::set_up_pipeline(nlohmann::json const& query_config) {
 }
 
 void ServerContext::push_record_group(GroupTags const& tags, ConstRecordIterator& record_it) {
+    m_pipeline->push_record_group(tags, record_it);
+    // NOTE: The tags must be marked as updated after they've been pushed so that a concurrent
+    // upsert can't take them before the update is visible in the pipeline.
     if (m_is_timeline_aggregation) {
+        std::lock_guard<std::mutex> const lock{m_updated_tags_mutex};
         m_updated_tags.insert(tags);
     }
-    m_pipeline->push_record_group(tags, record_it);
+}
+
+void ServerContext::push_serialized_record_groups(
+        std::span<char> serialized_record_groups,
+        RecordGroupFormat format
+) {
+    if (nullptr == m_thread_pool) {
+        deserialize_and_push_record_groups(serialized_record_groups, format);
+        return;
+    }
+
+    // The work guard keeps the event loop running until the record groups have been pushed, and
+    // the active receiver task is decremented on the event loop's thread, like every other update
+    // to the server's state.
+    increment_num_active_receiver_tasks();
+    boost::asio::post(
+            *m_thread_pool,
+            [this,
+             format,
+             serialized_record_groups = vector<char>(
+                     serialized_record_groups.begin(),
+                     serialized_record_groups.end()
+             ),
+             work_guard = boost::asio::make_work_guard(m_ioctx)]() mutable {
+                bool succeeded{true};
+                try {
+                    deserialize_and_push_record_groups(serialized_record_groups, format);
+                } catch (std::exception const& e) {
+                    SPDLOG_ERROR("Failed to push record groups - {}", e.what());
+                    succeeded = false;
+                }
+                boost::asio::post(m_ioctx, [this, succeeded] {
+                    if (false == succeeded) {
+                        m_status = ServerStatus::RecoverableFailure;
+                        stop_event_loop();
+                    }
+                    decrement_num_active_receiver_tasks();
+                });
+            }
+    );
+}
+
+void ServerContext::deserialize_and_push_record_groups(
+        std::span<char> serialized_record_groups,
+        RecordGroupFormat format
+) {
+    auto* read_head = serialized_record_groups.data();
+    auto const* const buf_end = read_head + serialized_record_groups.size();
+    while (read_head < buf_end) {
+        size_t record_size{0};
+        memcpy(&record_size, read_head, sizeof(record_size));
+        read_head += sizeof(record_size);
+
+        // On binary connections, each group is prefixed with the format it's serialized in
+        auto group_format{RecordGroupFormat::Msgpack};
+        if (RecordGroupFormat::Binary == format) {
+            if (0 == record_size) {
+                throw OperationFailed(clp::ErrorCode_Corrupt, __FILENAME__, __LINE__);
+            }
+            memcpy(&group_format, read_head, sizeof(group_format));
+            read_head += sizeof(group_format);
+            record_size -= sizeof(group_format);
+        }
+
+        if (RecordGroupFormat::Binary == group_format) {
+            BinaryRecordGroup record_group{read_head, record_size};
+            push_record_group(record_group.get_tags(), record_group.record_iter());
+        } else if (RecordGroupFormat::Msgpack == group_format) {
+            auto record_group = DeserializedRecordGroup{read_head, record_size};
+            push_record_group(record_group.get_tags(), record_group.record_iter());
+        } else {
+            throw OperationFailed(clp::ErrorCode_Corrupt, __FILENAME__, __LINE__);
+        }
+        read_head += record_size;
+    }
 }
 
 bool ServerContext::upsert_timeline_results() {
-    if (m_updated_tags.empty()) {
-        return true;
+    // Take the updated tags so that tags updated while we upsert are kept for the next upsert
+    GroupTagsSet updated_tags;
+    {
+        std::lock_guard<std::mutex> const lock{m_updated_tags_mutex};
+        if (m_updated_tags.empty()) {
+            return true;
+        }
+        updated_tags.swap(m_updated_tags);
     }
 
     bool any_updates = false;
     auto bulk_write = m_mongodb_results_collection.create_bulk_write();
     vector<vector<uint8_t>> results;
-    for (auto group_it = m_pipeline->finish(m_updated_tags); false == group_it->done();
+    for (auto group_it = m_pipeline->finish(updated_tags); false == group_it->done();
          group_it->next())
     {
-        int64_t timestamp{std::stoll(group_it->get().get_tags().front())};
+        int64_t timestamp{group_it->get().get_tags().front().get_int64_value()};
 
         auto& group = group_it->get();
         results.emplace_back(serialize_timeline_result(group.get_tags(), group.record_iter()));
@@ -200,10 +300,11 @@ bool ServerContext::upsert_timeline_results() {
     try {
         if (any_updates) {
             bulk_write.execute();
-            m_updated_tags.clear();
         }
     } catch (mongocxx::bulk_write_exception const& e) {
         SPDLOG_ERROR("Failed to upsert timeline results - {}", e.what());
+        std::lock_guard<std::mutex> const lock{m_updated_tags_mutex};
+        m_updated_tags.insert(updated_tags.begin(), updated_tags.end());
         return false;
     }
 
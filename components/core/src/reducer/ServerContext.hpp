@@ -1,17 +1,24 @@
 #ifndef REDUCER_SERVERCONTEXT_HPP
 #define REDUCER_SERVERCONTEXT_HPP
 
+#include <cstddef>
+#include <memory>
+#include <mutex>
 #include <optional>
-#include <set>
+#include <span>
+#include <vector>
 
 #include <boost/asio.hpp>
+#include <boost/asio/thread_pool.hpp>
 #include <json/single_include/nlohmann/json.hpp>
 #include <mongocxx/client.hpp>
 #include <mongocxx/collection.hpp>
 
 #include "../clp/TraceableException.hpp"
 #include "CommandLineArguments.hpp"
-#include "Pipeline.hpp"
+#include "ConstRecordIterator.hpp"
+#include "GroupTags.hpp"
+#include "ShardedPipeline.hpp"
 #include "types.hpp"
 
 namespace reducer {
@@ -102,12 +109,25 @@ public:
     void set_up_pipeline(nlohmann::json const& query_config);
 
     /**
-     * Pushes a record group into the reducer pipeline.
+     * Pushes a record group into the reducer pipeline. This method is thread-safe.
      * @param group_tags The tags in the record group.
      * @param record_it An iterator for the records in the record group.
      */
     void push_record_group(GroupTags const& tags, ConstRecordIterator& record_it);
 
+    /**
+     * Deserializes the given record groups and pushes them into the reducer pipeline. If the server
+     * has more than one thread, this is done asynchronously on the server's thread pool, and the
+     * record groups count as an active receiver task until they've all been pushed.
+     * @param serialized_record_groups A sequence of record groups, each serialized in the given
+     * format and prefixed with its size. The buffer is copied if it's pushed asynchronously.
+     * @param format
+     */
+    void push_serialized_record_groups(
+            std::span<char> serialized_record_groups,
+            RecordGroupFormat format
+    );
+
     /**
      * Upserts the current set of timeline entries from the reducer pipeline to MongoDB and clears
      * the tags that were updated in the last period. This method is executed repeatedly in the main
@@ -156,6 +176,24 @@ public:
     [[nodiscard]] int get_upsert_interval() const { return m_upsert_interval; }
 
 private:
+    // Constants
+    // Using more shards than threads reduces the chance of threads contending for the same shard
+    static constexpr size_t cNumShardsPerThread = 4;
+
+    // Methods
+    /**
+     * Deserializes the given record groups and pushes them into the reducer pipeline.
+     * @param serialized_record_groups
+     * @param format
+     * @throw ServerContext::OperationFailed if a record group's format is unknown
+     * @throw BinaryRecordGroup::OperationFailed if a binary record group is malformed
+     */
+    void deserialize_and_push_record_groups(
+            std::span<char> serialized_record_groups,
+            RecordGroupFormat format
+    );
+
+    // Variables
     boost::asio::io_context m_ioctx;
     boost::asio::ip::tcp::acceptor m_tcp_acceptor;
     boost::asio::ip::tcp::socket m_scheduler_socket;
@@ -168,9 +206,10 @@ private:
     ServerStatus m_status{ServerStatus::Idle};
     job_id_t m_job_id{-1};
 
-    std::unique_ptr<Pipeline> m_pipeline;
+    std::unique_ptr<ShardedPipeline> m_pipeline;
     bool m_is_timeline_aggregation{false};
-    std::set<GroupTags> m_updated_tags;
+    std::mutex m_updated_tags_mutex;
+    GroupTagsSet m_updated_tags;
 
     boost::asio::steady_timer m_upsert_timer;
     int m_upsert_interval;
@@ -178,6 +217,11 @@ private:
     mongocxx::client m_mongodb_client;
     mongocxx::database m_mongodb_results_database;
     mongocxx::collection m_mongodb_results_collection;
+
+    size_t m_num_threads;
+    // Only set if m_num_threads > 1. Declared last so that its threads are joined before any state
+    // they use is destroyed.
+    std::unique_ptr<boost::asio::thread_pool> m_thread_pool;
 };
 
 }  // namespace reducer
@@ -0,0 +1,97 @@
+#include "ShardedPipeline.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace reducer {
+ShardedPipeline::ShardedPipeline(size_t num_shards, PipelineInputMode input_mode) {
+    if (0 == num_shards) {
+        num_shards = 1;
+    }
+    m_shards.reserve(num_shards);
+    for (size_t i = 0; i < num_shards; ++i) {
+        m_shards.emplace_back(std::make_unique<Shard>(input_mode));
+    }
+}
+
+void ShardedPipeline::add_pipeline_stage(OperatorFactory const& create_operator) {
+    for (auto& shard : m_shards) {
+        std::lock_guard<std::mutex> const lock{shard->mutex};
+        shard->pipeline.add_pipeline_stage(create_operator());
+    }
+}
+
+void ShardedPipeline::push_record_group(GroupTags const& tags, ConstRecordIterator& record_it) {
+    auto& shard = *m_shards[get_shard_ix(tags)];
+    std::lock_guard<std::mutex> const lock{shard.mutex};
+    shard.pipeline.push_record_group(tags, record_it);
+}
+
+std::unique_ptr<RecordGroupIterator> ShardedPipeline::finish() {
+    return std::make_unique<ShardedRecordGroupIterator>(
+            m_shards,
+            []([[maybe_unused]] size_t shard_ix, Pipeline& pipeline) { return pipeline.finish(); }
+    );
+}
+
+std::unique_ptr<RecordGroupIterator>
+ShardedPipeline::finish(GroupTagsSet const& filtered_tags) {
+    // Split the filter by shard so that each shard only looks up the tags it owns
+    std::vector<GroupTagsSet> filtered_tags_by_shard(m_shards.size());
+    for (auto const& tags : filtered_tags) {
+        filtered_tags_by_shard[get_shard_ix(tags)].insert(tags);
+    }
+
+    return std::make_unique<ShardedRecordGroupIterator>(
+            m_shards,
+            [filtered_tags_by_shard = std::move(filtered_tags_by_shard)](
+                    size_t shard_ix,
+                    Pipeline& pipeline
+            ) { return pipeline.finish(filtered_tags_by_shard[shard_ix]); }
+    );
+}
+
+size_t ShardedPipeline::get_shard_ix(GroupTags const& tags) const {
+    return tags.hash() % m_shards.size();
+}
+
+ShardedPipeline::ShardedRecordGroupIterator::ShardedRecordGroupIterator(
+        std::vector<std::unique_ptr<Shard>>& shards,
+        ShardIteratorFactory create_shard_iterator
+)
+        : m_shards{shards},
+          m_create_shard_iterator{std::move(create_shard_iterator)} {
+    advance_to_next_shard();
+}
+
+void ShardedPipeline::ShardedRecordGroupIterator::next() {
+    m_shard_it->next();
+    if (m_shard_it->done()) {
+        advance_to_next_shard();
+    }
+}
+
+void ShardedPipeline::ShardedRecordGroupIterator::advance_to_next_shard() {
+    // Release the current shard before locking the next one
+    m_shard_it.reset();
+    if (m_shard_lock.owns_lock()) {
+        m_shard_lock.unlock();
+    }
+
+    while (m_next_shard_ix < m_shards.size()) {
+        auto const shard_ix = m_next_shard_ix++;
+        auto& shard = *m_shards[shard_ix];
+        std::unique_lock<std::mutex> lock{shard.mutex};
+        auto shard_it = m_create_shard_iterator(shard_ix, shard.pipeline);
+        if (false == shard_it->done()) {
+            m_shard_lock = std::move(lock);
+            m_shard_it = std::move(shard_it);
+            return;
+        }
+    }
+}
+}  // namespace reducer
@@ -0,0 +1,131 @@
+#ifndef REDUCER_SHARDEDPIPELINE_HPP
+#define REDUCER_SHARDEDPIPELINE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "GroupTags.hpp"
+#include "Operator.hpp"
+#include "Pipeline.hpp"
+#include "RecordGroup.hpp"
+#include "RecordGroupIterator.hpp"
+
+namespace reducer {
+/**
+ * An in-memory aggregation pipeline split into shards that can be pushed to concurrently. Each
+ * shard is an independent Pipeline with its own operators, and each record group is routed to a
+ * shard by the hash of its tags. Since all record groups with the same tags end up in the same
+ * shard, the shards' results are disjoint and are merged at finish() by concatenating them.
+ *
+ * NOTE: This assumes that the pipeline's stages don't change the tags of the record groups that
+ * flow through them.
+ */
+class ShardedPipeline {
+public:
+    // Types
+    using OperatorFactory = std::function<std::shared_ptr<Operator>()>;
+
+    // Constructors
+    /**
+     * @param num_shards
+     * @param input_mode
+     */
+    ShardedPipeline(size_t num_shards, PipelineInputMode input_mode);
+
+    // Methods
+    /**
+     * Adds a stage to every shard of the pipeline.
+     * @param create_operator Function that creates a new instance of the stage's operator for
+     * each shard.
+     */
+    void add_pipeline_stage(OperatorFactory const& create_operator);
+
+    /**
+     * Pushes a record group into the shard owning its tags. This method is thread-safe.
+     * @param tags
+     * @param record_it
+     */
+    void push_record_group(GroupTags const& tags, ConstRecordIterator& record_it);
+
+    /**
+     * Finishes every shard and returns an iterator over the merged results. Each shard is locked
+     * while the iterator is over its results, so pushes to that shard block until the iterator
+     * moves on or is destroyed.
+     * @return The iterator.
+     */
+    std::unique_ptr<RecordGroupIterator> finish();
+
+    /**
+     * Returns an iterator over the merged results whose tags are in `filtered_tags`. Like
+     * `finish()`, each shard is locked while the iterator is over its results.
+     * @param filtered_tags
+     * @return The iterator.
+     */
+    std::unique_ptr<RecordGroupIterator> finish(GroupTagsSet const& filtered_tags);
+
+    [[nodiscard]] size_t get_num_shards() const { return m_shards.size(); }
+
+private:
+    // Types
+    struct Shard {
+        explicit Shard(PipelineInputMode input_mode) : pipeline{input_mode} {}
+
+        std::mutex mutex;
+        Pipeline pipeline;
+    };
+
+    /**
+     * A RecordGroupIterator that chains the result iterators of every shard, holding the lock of
+     * the shard it's currently iterating over.
+     */
+    class ShardedRecordGroupIterator : public RecordGroupIterator {
+    public:
+        // Types
+        using ShardIteratorFactory
+                = std::function<std::unique_ptr<RecordGroupIterator>(size_t, Pipeline&)>;
+
+        // Constructors
+        ShardedRecordGroupIterator(
+                std::vector<std::unique_ptr<Shard>>& shards,
+                ShardIteratorFactory create_shard_iterator
+        );
+
+        // Methods
+        RecordGroup& get() override { return m_shard_it->get(); }
+
+        void next() override;
+
+        bool done() override { return nullptr == m_shard_it; }
+
+    private:
+        // Methods
+        /**
+         * Moves to the next shard with a non-empty result, or exhausts the iterator if there's
+         * none.
+         */
+        void advance_to_next_shard();
+
+        // Variables
+        std::vector<std::unique_ptr<Shard>>& m_shards;
+        ShardIteratorFactory m_create_shard_iterator;
+        size_t m_next_shard_ix{0};
+        std::unique_lock<std::mutex> m_shard_lock;
+        std::unique_ptr<RecordGroupIterator> m_shard_it;
+    };
+
+    // Methods
+    /**
+     * @param tags
+     * @return The index of the shard which owns the given tags.
+     */
+    [[nodiscard]] size_t get_shard_ix(GroupTags const& tags) const;
+
+    // Variables
+    std::vector<std::unique_ptr<Shard>> m_shards;
+};
+}  // namespace reducer
+
+#endif  // REDUCER_SHARDEDPIPELINE_HPP
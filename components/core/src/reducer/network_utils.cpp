@@ -3,29 +3,45 @@
 #include <unistd.h>
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "../clp/ErrorCode.hpp"
 #include "../clp/networking/socket_utils.hpp"
+#include "BinaryRecordGroup.hpp"
 #include "BufferedSocketWriter.hpp"
 #include "DeserializedRecordGroup.hpp"
 #include "RecordGroupIterator.hpp"
 #include "types.hpp"
 
 namespace reducer {
-int connect_to_reducer(std::string const& host, int port, job_id_t job_id) {
+int connect_to_reducer(
+        std::string const& host,
+        int port,
+        job_id_t job_id,
+        RecordGroupFormat format
+) {
     constexpr char cConnectionAcceptedResponse = 'y';
     auto reducer_socket_fd = clp::networking::connect_to_server(host, std::to_string(port));
     if (-1 == reducer_socket_fd) {
         return -1;
     }
 
-    auto ecode = clp::networking::try_send(
-            reducer_socket_fd,
-            reinterpret_cast<char const*>(&job_id),
-            sizeof(job_id)
-    );
+    // Only send the format if it isn't the default so that reducers which predate the binary
+    // format still accept msgpack connections
+    char init_packet[sizeof(job_id) + sizeof(format)];
+    memcpy(init_packet, &job_id, sizeof(job_id));
+    auto init_packet_size = sizeof(job_id);
+    if (RecordGroupFormat::Msgpack != format) {
+        memcpy(init_packet + sizeof(job_id), &format, sizeof(format));
+        init_packet_size += sizeof(format);
+    }
+    auto ecode = clp::networking::try_send(reducer_socket_fd, init_packet, init_packet_size);
     if (clp::ErrorCode::ErrorCode_Success != ecode) {
         close(reducer_socket_fd);
         return -1;
@@ -44,14 +60,36 @@ int connect_to_reducer(std::string const& host, int port, job_id_t job_id) {
     return reducer_socket_fd;
 }
 
-bool send_pipeline_results(int reducer_socket_fd, std::unique_ptr<RecordGroupIterator> results) {
+bool send_pipeline_results(
+        int reducer_socket_fd,
+        std::unique_ptr<RecordGroupIterator> results,
+        RecordGroupFormat format
+) {
     constexpr int cBufSize = 1024;
     BufferedSocketWriter buffered_writer{reducer_socket_fd, cBufSize};
 
     for (; false == results->done(); results->next()) {
         auto& group = results->get();
-        auto serialized_result = serialize(group.get_tags(), group.record_iter());
-        auto serialized_result_size = serialized_result.size();
+        std::vector<uint8_t> serialized_result;
+        std::optional<RecordGroupFormat> group_format;
+        if (RecordGroupFormat::Binary == format) {
+            auto binary_result = serialize_to_binary(group.get_tags(), group.record_iter());
+            if (binary_result.has_value()) {
+                serialized_result = std::move(binary_result.value());
+                group_format = RecordGroupFormat::Binary;
+            } else {
+                // Fall back to msgpack for groups the binary format can't represent
+                group.record_iter().reset();
+                serialized_result = serialize(group.get_tags(), group.record_iter());
+                group_format = RecordGroupFormat::Msgpack;
+            }
+        } else {
+            serialized_result = serialize(group.get_tags(), group.record_iter());
+        }
+        size_t serialized_result_size = serialized_result.size();
+        if (group_format.has_value()) {
+            serialized_result_size += sizeof(group_format.value());
+        }
 
         // Send size
         if (false
@@ -63,6 +101,17 @@ bool send_pipeline_results(int reducer_socket_fd, std::unique_ptr<RecordGroupIte
             return false;
         }
 
+        // Send the group's format, if the connection's format requires it
+        if (group_format.has_value()
+            && false
+                       == buffered_writer.write(
+                               reinterpret_cast<char const*>(&group_format.value()),
+                               sizeof(group_format.value())
+                       ))
+        {
+            return false;
+        }
+
         // Send data
         if (false == buffered_writer.write(serialized_result)) {
             return false;
@@ -13,18 +13,32 @@ namespace reducer {
  * @param host
  * @param port
  * @param job_id
+ * @param format The format in which record groups will be sent on the connection. Only reducers
+ * which support the binary format accept connections using it.
  * @return Socket file descriptor for the reducer on success
  * @return -1 on any error
  */
-int connect_to_reducer(std::string const& host, int port, job_id_t job_id);
+int connect_to_reducer(
+        std::string const& host,
+        int port,
+        job_id_t job_id,
+        RecordGroupFormat format = RecordGroupFormat::Msgpack
+);
 
 /**
  * Sends results to the reducer.
  * @param reducer_socket_fd
  * @param results
- * @return Whether the results were sent successfully.
+ * @param format The format negotiated when connecting to the reducer. With the binary format,
+ * groups that can't be serialized in it (e.g., those whose records don't all have the same
+ * elements) are sent in msgpack instead.
+ * @return Whether the results were serialized and sent successfully.
  */
-bool send_pipeline_results(int reducer_socket_fd, std::unique_ptr<RecordGroupIterator> results);
+bool send_pipeline_results(
+        int reducer_socket_fd,
+        std::unique_ptr<RecordGroupIterator> results,
+        RecordGroupFormat format = RecordGroupFormat::Msgpack
+);
 }  // namespace reducer
 
 #endif  // REDUCER_NETWORK_UTILS_HPP
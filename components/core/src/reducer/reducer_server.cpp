@@ -288,12 +288,14 @@ void queue_scheduler_update_listener_task(
 
 void queue_validate_sender_task(std::shared_ptr<RecordReceiverContext> const& ctx) {
     ctx->get_server_ctx()->increment_num_active_receiver_tasks();
-    static_assert(sizeof(job_id_t) <= RecordReceiverContext::cMinBufSize);
+    // The connection init packet is the job ID, optionally followed by the record group format
+    constexpr size_t cMaxInitPacketSize = sizeof(job_id_t) + sizeof(RecordGroupFormat);
+    static_assert(cMaxInitPacketSize <= RecordReceiverContext::cMinBufSize);
     boost::asio::async_read(
             ctx->get_socket(),
-            boost::asio::buffer(ctx->get_buf_write_head(), sizeof(job_id_t)),
-            // transfer_at_least(1) helps us avoid hanging when a broken client sends fewer than
-            // sizeof(job_id_t) bytes
+            boost::asio::buffer(ctx->get_buf_write_head(), cMaxInitPacketSize),
+            // transfer_at_least(1) helps us avoid hanging when a client sends fewer than
+            // cMaxInitPacketSize bytes (e.g., a client that only sends its job ID)
             boost::asio::transfer_at_least(1),
             ValidateSenderTask(ctx)
     );
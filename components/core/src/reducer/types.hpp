@@ -5,6 +5,20 @@
 
 namespace reducer {
 using job_id_t = int64_t;
+
+/**
+ * The format in which a client serializes the record groups it sends to the reducer. A client
+ * selects the format when it connects, by sending it after its job ID; clients which only send
+ * their job ID use the msgpack format.
+ */
+enum class RecordGroupFormat : uint8_t {
+    // Serialized by `serialize`
+    Msgpack = 0,
+    // Each record group is prefixed with the RecordGroupFormat it's serialized in: Binary (by
+    // `serialize_to_binary`), or Msgpack for groups that can't be serialized in the binary format
+    // (e.g., those whose records don't all have the same elements)
+    Binary
+};
 }  // namespace reducer
 
 #endif  // REDUCER_TYPES_HPP
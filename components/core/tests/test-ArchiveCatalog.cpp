@@ -0,0 +1,134 @@
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/clp_s/ArchiveCatalog.hpp"
+#include "../src/clp_s/archive_constants.hpp"
+#include "../src/clp_s/SchemaTree.hpp"
+#include "../src/clp_s/search/ConvertToExists.hpp"
+#include "../src/clp_s/search/EvaluateKeyPathIndex.hpp"
+#include "../src/clp_s/search/kql/kql.hpp"
+#include "../src/clp_s/search/NarrowTypes.hpp"
+#include "../src/clp_s/search/OrOfAndForm.hpp"
+#include "../src/clp_s/TimestampEntry.hpp"
+#include "LogSuppressor.hpp"
+
+using clp_s::ArchiveCatalog;
+using clp_s::EvaluatedValue;
+using clp_s::NodeType;
+using clp_s::SchemaTree;
+using clp_s::search::ConvertToExists;
+using clp_s::search::EvaluateKeyPathIndex;
+using clp_s::search::NarrowTypes;
+using clp_s::search::OrOfAndForm;
+using clp_s::search::kql::parse_kql_expression;
+
+namespace {
+/**
+ * Evaluates a query against an archive's catalog entry the same way clp-s does before opening the
+ * archive.
+ * @param entry
+ * @param query
+ * @return EvaluatedValue::False if the entry proves the archive can't match the query, or
+ * EvaluatedValue::Unknown otherwise.
+ */
+EvaluatedValue evaluate_query(ArchiveCatalog::Entry const& entry, std::string const& query) {
+    std::istringstream query_stream{query};
+    auto expr = parse_kql_expression(query_stream);
+    REQUIRE(nullptr != expr);
+    expr = OrOfAndForm{}.run(expr);
+    expr = NarrowTypes{}.run(expr);
+    expr = ConvertToExists{}.run(expr);
+    return EvaluateKeyPathIndex{entry.key_paths, entry.array_key_paths}.run(expr);
+}
+
+/**
+ * Appends an archive with the given schema tree to the catalog, creating the archive's directory
+ * so that it isn't considered stale.
+ * @param archives_dir
+ * @param archive_id
+ * @param schema_tree
+ */
+void append_archive(
+        std::filesystem::path const& archives_dir,
+        std::string const& archive_id,
+        SchemaTree const& schema_tree
+) {
+    std::filesystem::create_directory(archives_dir / archive_id);
+    ArchiveCatalog::append_archive(
+            archives_dir.string(),
+            archive_id,
+            std::map<std::string, clp_s::TimestampEntry>{},
+            schema_tree,
+            1
+    );
+}
+}  // namespace
+
+TEST_CASE("Test pruning archives with the archive catalog", "[clp-s][ArchiveCatalog]") {
+    // Suppress logging
+    LogSuppressor suppressor{};
+
+    auto const archives_dir = std::filesystem::temp_directory_path() / "clp-s-archive-catalog-test";
+    std::filesystem::remove_all(archives_dir);
+    std::filesystem::create_directory(archives_dir);
+
+    // The schema tree of an archive containing {"a": 1, "b": {"c": "x"}, "d": [1]}, built the same
+    // way as the JSON parser builds it
+    SchemaTree schema_tree;
+    auto const root_id = schema_tree.add_node(-1, NodeType::Object, "");
+    schema_tree.add_node(root_id, NodeType::Integer, "a");
+    auto const b_id = schema_tree.add_node(root_id, NodeType::Object, "b");
+    schema_tree.add_node(b_id, NodeType::VarString, "c");
+    schema_tree.add_node(root_id, NodeType::UnstructuredArray, "d");
+    append_archive(archives_dir, "archive", schema_tree);
+
+    ArchiveCatalog catalog;
+    REQUIRE(catalog.read(archives_dir.string()));
+    REQUIRE(nullptr == catalog.get_entry("uncataloged"));
+    auto const* entry = catalog.get_entry("archive");
+    REQUIRE(nullptr != entry);
+
+    SECTION("Queries on keys in the archive aren't pruned") {
+        REQUIRE(EvaluatedValue::Unknown == evaluate_query(*entry, "a: 1"));
+        REQUIRE(EvaluatedValue::Unknown == evaluate_query(*entry, "b.c: x"));
+        REQUIRE(EvaluatedValue::Unknown == evaluate_query(*entry, "a: 1 AND b.c: x"));
+        REQUIRE(EvaluatedValue::Unknown == evaluate_query(*entry, "missing: 1 OR a: 1"));
+        // Keys within arrays aren't in the schema tree
+        REQUIRE(EvaluatedValue::Unknown == evaluate_query(*entry, "d.e: 1"));
+    }
+
+    SECTION("Queries on keys missing from the archive are pruned") {
+        REQUIRE(EvaluatedValue::False == evaluate_query(*entry, "missing: 1"));
+        REQUIRE(EvaluatedValue::False == evaluate_query(*entry, "b.missing: x"));
+        REQUIRE(EvaluatedValue::False == evaluate_query(*entry, "c: x"));
+        REQUIRE(EvaluatedValue::False == evaluate_query(*entry, "a: 1 AND missing: 1"));
+    }
+
+    SECTION("Stale entries are compacted") {
+        // Replace the archive's entry several times and remove the archive, so that most of the
+        // catalog's entries are stale
+        for (int i = 0; i < 4; ++i) {
+            append_archive(archives_dir, "archive", schema_tree);
+        }
+        std::filesystem::remove(archives_dir / "archive");
+        auto const catalog_path = archives_dir.string() + clp_s::constants::cArchivesCatalogFile;
+        auto const catalog_size_before_compaction = std::filesystem::file_size(catalog_path);
+
+        append_archive(archives_dir, "new-archive", schema_tree);
+        REQUIRE(std::filesystem::file_size(catalog_path) < catalog_size_before_compaction);
+
+        ArchiveCatalog compacted_catalog;
+        REQUIRE(compacted_catalog.read(archives_dir.string()));
+        REQUIRE(nullptr == compacted_catalog.get_entry("archive"));
+        auto const* new_entry = compacted_catalog.get_entry("new-archive");
+        REQUIRE(nullptr != new_entry);
+        REQUIRE(EvaluatedValue::Unknown == evaluate_query(*new_entry, "a: 1"));
+    }
+
+    std::filesystem::remove_all(archives_dir);
+}
@@ -0,0 +1,258 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/reducer/BinaryRecordGroup.hpp"
+#include "../src/reducer/ConstRecordIterator.hpp"
+#include "../src/reducer/GroupTags.hpp"
+#include "../src/reducer/Record.hpp"
+#include "../src/reducer/RecordTypedKeyIterator.hpp"
+
+using reducer::BinaryRecordGroup;
+using reducer::ConstRecordIterator;
+using reducer::GroupTag;
+using reducer::GroupTags;
+using reducer::Record;
+using reducer::RecordTypedKeyIterator;
+using reducer::serialize_to_binary;
+using reducer::TypedRecordKey;
+using reducer::ValueType;
+using std::string;
+using std::string_view;
+using std::vector;
+
+namespace {
+constexpr string_view cStringKey{"str"};
+constexpr string_view cInt64Key{"int"};
+constexpr string_view cDoubleKey{"dbl"};
+
+/**
+ * A record with a string, an int64, and a double element, optionally without the double element.
+ */
+class TestRecord : public Record {
+public:
+    TestRecord(string str_value, int64_t int64_value, double double_value, bool has_double = true)
+            : m_str_value{std::move(str_value)},
+              m_int64_value{int64_value},
+              m_double_value{double_value},
+              m_has_double{has_double} {}
+
+    [[nodiscard]] string_view get_string_view(string_view key) const override {
+        return cStringKey == key ? string_view{m_str_value} : string_view{};
+    }
+
+    [[nodiscard]] int64_t get_int64_value(string_view key) const override {
+        return cInt64Key == key ? m_int64_value : 0;
+    }
+
+    [[nodiscard]] double get_double_value(string_view key) const override {
+        return cDoubleKey == key ? m_double_value : 0.0;
+    }
+
+    [[nodiscard]] std::unique_ptr<RecordTypedKeyIterator> typed_key_iter() const override {
+        return std::make_unique<TypedKeyIterator>(m_has_double ? 3 : 2);
+    }
+
+private:
+    class TypedKeyIterator : public RecordTypedKeyIterator {
+    public:
+        explicit TypedKeyIterator(size_t num_keys) : m_num_keys{num_keys} {}
+
+        TypedRecordKey get() override {
+            switch (m_key_ix) {
+                case 0:
+                    return {cStringKey, ValueType::String};
+                case 1:
+                    return {cInt64Key, ValueType::Int64};
+                default:
+                    return {cDoubleKey, ValueType::Double};
+            }
+        }
+
+        void next() override { ++m_key_ix; }
+
+        bool done() override { return m_key_ix >= m_num_keys; }
+
+    private:
+        size_t m_num_keys;
+        size_t m_key_ix{0};
+    };
+
+    string m_str_value;
+    int64_t m_int64_value;
+    double m_double_value;
+    bool m_has_double;
+};
+
+/**
+ * A ConstRecordIterator over a vector of TestRecords.
+ */
+class TestRecordIterator : public ConstRecordIterator {
+public:
+    explicit TestRecordIterator(vector<TestRecord> const& records) : m_records{records} {}
+
+    [[nodiscard]] Record const& get() const override { return m_records[m_record_ix]; }
+
+    void next() override { ++m_record_ix; }
+
+    bool done() override { return m_record_ix >= m_records.size(); }
+
+    void reset() override { m_record_ix = 0; }
+
+private:
+    vector<TestRecord> const& m_records;
+    size_t m_record_ix{0};
+};
+
+/**
+ * @param tags
+ * @param records
+ * @return The given record group serialized in the binary format.
+ */
+auto serialize(GroupTags const& tags, vector<TestRecord> const& records) -> vector<uint8_t> {
+    TestRecordIterator record_it{records};
+    auto serialized_group = serialize_to_binary(tags, record_it);
+    REQUIRE(serialized_group.has_value());
+    return std::move(serialized_group.value());
+}
+
+/**
+ * @param serialized_group
+ * @return A BinaryRecordGroup over the given serialized data.
+ */
+auto deserialize(vector<uint8_t> const& serialized_group) -> BinaryRecordGroup {
+    return BinaryRecordGroup{
+            reinterpret_cast<char const*>(serialized_group.data()),
+            serialized_group.size()
+    };
+}
+}  // namespace
+
+TEST_CASE("Round-trip record groups through the binary format", "[reducer][BinaryRecordGroup]") {
+    GroupTags const tags{GroupTag::from_string("host-1"), GroupTag::from_int64(-42)};
+    vector<TestRecord> records;
+    records.emplace_back("", 0, 0.0);
+    records.emplace_back("a", INT64_MIN, -1.5);
+    records.emplace_back("bcd", INT64_MAX, 3.25e100);
+    records.emplace_back(string(1000, 'x'), 7, 0.1);
+
+    auto const serialized_group = serialize(tags, records);
+    auto record_group = deserialize(serialized_group);
+    REQUIRE(tags == record_group.get_tags());
+
+    auto& record_it = record_group.record_iter();
+    for (auto const& expected_record : records) {
+        REQUIRE(false == record_it.done());
+        auto const& record = record_it.get();
+        REQUIRE(expected_record.get_string_view(cStringKey) == record.get_string_view(cStringKey));
+        REQUIRE(expected_record.get_int64_value(cInt64Key) == record.get_int64_value(cInt64Key));
+        REQUIRE(expected_record.get_double_value(cDoubleKey)
+                == record.get_double_value(cDoubleKey));
+
+        // Elements are only accessible by their own type, and missing elements are defaulted
+        REQUIRE(record.get_string_view(cInt64Key).empty());
+        REQUIRE(0 == record.get_int64_value(cDoubleKey));
+        REQUIRE(0 == record.get_int64_value("missing"));
+
+        vector<std::pair<string, ValueType>> typed_keys;
+        for (auto typed_key_it = record.typed_key_iter(); false == typed_key_it->done();
+             typed_key_it->next())
+        {
+            auto const typed_key = typed_key_it->get();
+            typed_keys.emplace_back(typed_key.get_key(), typed_key.get_type());
+        }
+        REQUIRE(typed_keys
+                == vector<std::pair<string, ValueType>>{
+                        {string{cStringKey}, ValueType::String},
+                        {string{cInt64Key}, ValueType::Int64},
+                        {string{cDoubleKey}, ValueType::Double}
+                });
+
+        record_it.next();
+    }
+    REQUIRE(record_it.done());
+
+    record_it.reset();
+    REQUIRE(false == record_it.done());
+    REQUIRE(records.front().get_int64_value(cInt64Key)
+            == record_it.get().get_int64_value(cInt64Key));
+}
+
+TEST_CASE("Serialize edge-case record groups to the binary format", "[reducer][BinaryRecordGroup]") {
+    SECTION("Group without records or tags") {
+        auto record_group = deserialize(serialize({}, {}));
+        REQUIRE(record_group.get_tags().empty());
+        REQUIRE(record_group.record_iter().done());
+    }
+
+    SECTION("Group whose records don't all have the same elements") {
+        vector<TestRecord> records;
+        records.emplace_back("a", 1, 1.0);
+        records.emplace_back("b", 2, 0.0, false);
+        TestRecordIterator record_it{records};
+        REQUIRE(false == serialize_to_binary({}, record_it).has_value());
+    }
+}
+
+TEST_CASE("Reject malformed binary record groups", "[reducer][BinaryRecordGroup]") {
+    vector<TestRecord> records;
+    records.emplace_back("abc", 1, 1.0);
+    records.emplace_back("de", 2, 2.0);
+    auto serialized_group = serialize({}, records);
+
+    SECTION("Truncated groups") {
+        for (size_t length = 0; length < serialized_group.size(); ++length) {
+            REQUIRE_THROWS_AS(
+                    (BinaryRecordGroup{
+                            reinterpret_cast<char const*>(serialized_group.data()),
+                            length
+                    }),
+                    BinaryRecordGroup::OperationFailed
+            );
+        }
+    }
+
+    SECTION("Trailing data") {
+        serialized_group.push_back(0);
+        REQUIRE_THROWS_AS(deserialize(serialized_group), BinaryRecordGroup::OperationFailed);
+    }
+
+    // The header of a group without tags: the number of tags (uint8_t), the number of records
+    // (uint32_t), the number of columns (uint8_t), and then each column's type (uint8_t), key
+    // length (uint16_t), and key
+    constexpr size_t cFirstColumnTypePos{sizeof(uint8_t) + sizeof(uint32_t) + sizeof(uint8_t)};
+
+    SECTION("Unknown tag type") {
+        vector<uint8_t> serialized_tagged_group
+                = serialize(GroupTags{GroupTag::from_int64(1)}, records);
+        serialized_tagged_group[sizeof(uint8_t)] = UINT8_MAX;
+        REQUIRE_THROWS_AS(
+                deserialize(serialized_tagged_group),
+                BinaryRecordGroup::OperationFailed
+        );
+    }
+
+    SECTION("Unknown column type") {
+        serialized_group[cFirstColumnTypePos] = UINT8_MAX;
+        REQUIRE_THROWS_AS(deserialize(serialized_group), BinaryRecordGroup::OperationFailed);
+    }
+
+    SECTION("Decreasing string offsets") {
+        // The string column is first, so its end offsets directly follow the header
+        size_t offsets_pos{cFirstColumnTypePos};
+        for (auto const key : {cStringKey, cInt64Key, cDoubleKey}) {
+            offsets_pos += sizeof(uint8_t) + sizeof(uint16_t) + key.size();
+        }
+        uint32_t const first_end_offset{UINT32_MAX};
+        std::memcpy(&serialized_group[offsets_pos], &first_end_offset, sizeof(first_end_offset));
+        REQUIRE_THROWS_AS(deserialize(serialized_group), BinaryRecordGroup::OperationFailed);
+    }
+}
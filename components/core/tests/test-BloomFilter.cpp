@@ -0,0 +1,50 @@
+#include <cstddef>
+#include <cstdint>
+
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/clp/BloomFilter.hpp"
+
+using clp::BloomFilter;
+
+TEST_CASE("BloomFilter", "[BloomFilter]") {
+    constexpr size_t cNumValues = 10'000;
+    constexpr double cFalsePositiveRate = 0.01;
+
+    BloomFilter filter(cNumValues, cFalsePositiveRate);
+    for (uint64_t i = 0; i < cNumValues; ++i) {
+        filter.add(i * 3);
+    }
+
+    SECTION("No false negatives") {
+        for (uint64_t i = 0; i < cNumValues; ++i) {
+            REQUIRE(filter.may_contain(i * 3));
+        }
+    }
+
+    SECTION("Bounded false positive rate") {
+        size_t num_false_positives = 0;
+        for (uint64_t i = 0; i < cNumValues; ++i) {
+            if (filter.may_contain(i * 3 + 1)) {
+                ++num_false_positives;
+            }
+        }
+        // Allow some slack over the configured rate
+        REQUIRE(num_false_positives < static_cast<size_t>(cNumValues * cFalsePositiveRate * 3));
+    }
+
+    SECTION("Reconstruct from state") {
+        BloomFilter const reconstructed_filter(
+                filter.get_num_hash_functions(),
+                filter.get_bit_array()
+        );
+        for (uint64_t i = 0; i < 2 * cNumValues; ++i) {
+            REQUIRE(filter.may_contain(i) == reconstructed_filter.may_contain(i));
+        }
+    }
+
+    SECTION("Invalid parameters") {
+        REQUIRE_THROWS_AS(BloomFilter(cNumValues, 0.0), BloomFilter::OperationFailed);
+        REQUIRE_THROWS_AS(BloomFilter(cNumValues, 1.0), BloomFilter::OperationFailed);
+    }
+}
@@ -0,0 +1,138 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <absl/hash/hash.h>
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/reducer/GroupTags.hpp"
+
+using reducer::GroupTag;
+using reducer::GroupTags;
+using reducer::GroupTagsMap;
+using reducer::GroupTagsSet;
+using std::string;
+using std::vector;
+
+TEST_CASE("Compare and hash group tags", "[reducer][GroupTags]") {
+    SECTION("Equal tags") {
+        GroupTags const tags{GroupTag::from_string("host-1"), GroupTag::from_int64(60'000)};
+        GroupTags pushed_tags;
+        pushed_tags.push_back(GroupTag::from_string(string{"host-"} + "1"));
+        pushed_tags.push_back(GroupTag::from_int64(60'000));
+
+        REQUIRE(tags == pushed_tags);
+        REQUIRE(tags.hash() == pushed_tags.hash());
+        REQUIRE(absl::Hash<GroupTags>{}(tags) == absl::Hash<GroupTags>{}(pushed_tags));
+        REQUIRE(GroupTags{} == GroupTags{});
+
+        GroupTagsMap<int64_t> counts;
+        ++counts[tags];
+        ++counts[pushed_tags];
+        REQUIRE(1 == counts.size());
+        REQUIRE(2 == counts[tags]);
+    }
+
+    SECTION("Different tags") {
+        auto const host_tag = GroupTag::from_string("host-1");
+        auto const time_tag = GroupTag::from_int64(60'000);
+        vector<GroupTags> const all_tags{
+                GroupTags{},
+                GroupTags{host_tag},
+                GroupTags{time_tag},
+                GroupTags{host_tag, time_tag},
+                // Order matters
+                GroupTags{time_tag, host_tag},
+                GroupTags{host_tag, host_tag},
+                GroupTags{GroupTag::from_string("host-2")},
+                // Strings are case-sensitive
+                GroupTags{GroupTag::from_string("Host-1")},
+                GroupTags{GroupTag::from_string("")},
+                GroupTags{GroupTag::from_int64(-60'000)}
+        };
+        for (size_t i = 0; i < all_tags.size(); ++i) {
+            for (size_t j = 0; j < all_tags.size(); ++j) {
+                INFO("i: " << i << ", j: " << j);
+                REQUIRE((i == j) == (all_tags[i] == all_tags[j]));
+            }
+        }
+        GroupTagsSet const tags_set(all_tags.begin(), all_tags.end());
+        REQUIRE(all_tags.size() == tags_set.size());
+    }
+
+    SECTION("Int64 and string tags with the same value") {
+        auto const int_tag = GroupTag::from_int64(123);
+        auto const string_tag = GroupTag::from_string("123");
+        REQUIRE(GroupTag::Type::Int64 == int_tag.get_type());
+        REQUIRE(GroupTag::Type::String == string_tag.get_type());
+        REQUIRE(false == (int_tag == string_tag));
+        REQUIRE(GroupTags{int_tag} != GroupTags{string_tag});
+
+        // A string tag stores its interned ID, which mustn't collide with an int64 tag of the same
+        // value
+        auto const id_tag = GroupTag::from_int64(string_tag.get_int64_value());
+        REQUIRE(false == (id_tag == string_tag));
+        REQUIRE(id_tag.hash() != string_tag.hash());
+
+        GroupTagsSet const tags_set{GroupTags{int_tag}, GroupTags{string_tag}, GroupTags{id_tag}};
+        REQUIRE(3 == tags_set.size());
+    }
+}
+
+TEST_CASE("Intern group tag strings", "[reducer][GroupTags]") {
+    SECTION("Intern strings across threads") {
+        constexpr size_t cNumThreads{8};
+        constexpr size_t cNumStrings{1000};
+
+        // Each thread interns every string, in a different order
+        vector<vector<GroupTag>> tags_by_thread(cNumThreads);
+        vector<std::thread> threads;
+        for (size_t thread_ix = 0; thread_ix < cNumThreads; ++thread_ix) {
+            threads.emplace_back([&, thread_ix] {
+                auto& tags = tags_by_thread[thread_ix];
+                tags.resize(cNumStrings, GroupTag::from_int64(0));
+                for (size_t i = 0; i < cNumStrings; ++i) {
+                    // Rotate the strings, reversing them in every other thread
+                    auto const rotated_ix = (i + thread_ix * 131) % cNumStrings;
+                    auto const string_ix
+                            = (0 == thread_ix % 2) ? rotated_ix : cNumStrings - 1 - rotated_ix;
+                    tags[string_ix]
+                            = GroupTag::from_string("thread-str-" + std::to_string(string_ix));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        GroupTagsSet distinct_tags;
+        for (size_t string_ix = 0; string_ix < cNumStrings; ++string_ix) {
+            auto const& tag = tags_by_thread.front()[string_ix];
+            REQUIRE("thread-str-" + std::to_string(string_ix) == tag.get_string_value());
+            for (auto const& tags : tags_by_thread) {
+                REQUIRE(tag == tags[string_ix]);
+            }
+            distinct_tags.insert(GroupTags{tag});
+        }
+        REQUIRE(cNumStrings == distinct_tags.size());
+    }
+
+    SECTION("Clear interned strings") {
+        auto const tag = GroupTag::from_string("before-clear");
+        REQUIRE("before-clear" == tag.get_string_value());
+        REQUIRE(tag == GroupTag::from_string("before-clear"));
+
+        GroupTag::clear_interned_strings();
+
+        // Strings are interned again from scratch
+        auto const first_tag = GroupTag::from_string("after-clear");
+        auto const second_tag = GroupTag::from_string("before-clear");
+        REQUIRE(0 == first_tag.get_int64_value());
+        REQUIRE(1 == second_tag.get_int64_value());
+        REQUIRE("after-clear" == first_tag.get_string_value());
+        REQUIRE("before-clear" == second_tag.get_string_value());
+        REQUIRE(first_tag == GroupTag::from_string("after-clear"));
+    }
+}
@@ -0,0 +1,387 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <Catch2/single_include/catch2/catch.hpp>
+#include <spdlog/spdlog.h>
+
+#include "../src/clp/clo/IrChunkCache.hpp"
+#include "../src/clp/clp/FileDecompressor.hpp"
+#include "../src/clp/clp/run.hpp"
+#include "../src/clp/ir/constants.hpp"
+#include "../src/clp/ir/SeekIndex.hpp"
+#include "../src/clp/streaming_archive/reader/Archive.hpp"
+
+using clp::clo::IrChunkCache;
+using clp::ir::cIrFileExtension;
+using clp::ir::cSeekIndexFileExtension;
+using std::string;
+using std::vector;
+
+namespace {
+constexpr char cTestDirPath[] = "unit-test-ir-chunk-cache";
+
+/**
+ * @param dir
+ * @return The names of the files in the given directory, sorted
+ */
+auto list_files(std::filesystem::path const& dir) -> vector<string> {
+    vector<string> file_names;
+    for (auto const& entry : std::filesystem::directory_iterator{dir}) {
+        file_names.emplace_back(entry.path().filename().string());
+    }
+    std::sort(file_names.begin(), file_names.end());
+    return file_names;
+}
+
+/**
+ * Adds a chunk of the given size to the given cache
+ * @param cache
+ * @param orig_file_id
+ * @param begin_message_ix
+ * @param end_message_ix
+ * @param size
+ * @param has_seek_index
+ * @return The name of the chunk's file
+ */
+auto add_chunk(
+        IrChunkCache& cache,
+        string const& orig_file_id,
+        size_t begin_message_ix,
+        size_t end_message_ix,
+        size_t size,
+        bool has_seek_index = false
+) -> string {
+    string const ir_chunk(size, 'x');
+    std::optional<clp::ir::SeekIndex> seek_index;
+    if (has_seek_index) {
+        seek_index.emplace(true, 1);
+    }
+    return cache.add(
+            orig_file_id,
+            begin_message_ix,
+            end_message_ix,
+            std::span<char const>{ir_chunk.data(), ir_chunk.size()},
+            seek_index
+    );
+}
+}  // namespace
+
+TEST_CASE("Parse IR chunk file names", "[IrChunkCache]") {
+    string orig_file_id;
+    size_t begin_message_ix{};
+    size_t end_message_ix{};
+    auto const parse = [&](string const& file_name) {
+        return IrChunkCache::parse_chunk_file_name(
+                file_name,
+                orig_file_id,
+                begin_message_ix,
+                end_message_ix
+        );
+    };
+
+    REQUIRE(parse(IrChunkCache::get_chunk_file_name("abc", 0, 10)));
+    REQUIRE(std::make_tuple(string{"abc"}, size_t{0}, size_t{10})
+            == std::make_tuple(orig_file_id, begin_message_ix, end_message_ix));
+
+    // Original file IDs may contain underscores
+    REQUIRE(parse(IrChunkCache::get_chunk_file_name("a_b_1_2", 1000, 2000)));
+    REQUIRE(std::make_tuple(string{"a_b_1_2"}, size_t{1000}, size_t{2000})
+            == std::make_tuple(orig_file_id, begin_message_ix, end_message_ix));
+
+    string const extension{cIrFileExtension};
+    // Empty ranges
+    REQUIRE(false == parse("abc_10_10" + extension));
+    REQUIRE(false == parse("abc_10_5" + extension));
+    // Non-numeric or missing parts
+    REQUIRE(false == parse("abc_x_10" + extension));
+    REQUIRE(false == parse("abc_0_1x" + extension));
+    REQUIRE(false == parse("abc_-1_10" + extension));
+    REQUIRE(false == parse("abc__10" + extension));
+    REQUIRE(false == parse("abc_0_" + extension));
+    REQUIRE(false == parse("abc_10" + extension));
+    REQUIRE(false == parse("_0_10" + extension));
+    REQUIRE(false == parse(extension));
+    // Message indices that overflow
+    REQUIRE(false == parse("abc_0_99999999999999999999999" + extension));
+    // Other files in the cache directory
+    REQUIRE(false == parse("abc_0_10"));
+    REQUIRE(false == parse("abc_0_10" + extension + string{cSeekIndexFileExtension}));
+    REQUIRE(false == parse(".abc_0_10" + extension + ".1234.0.tmp"));
+    REQUIRE(false == parse(".ir_chunk_cache.lock"));
+}
+
+TEST_CASE("Find, add, and evict IR chunks", "[IrChunkCache]") {
+    std::filesystem::path const cache_dir{cTestDirPath};
+    std::filesystem::remove_all(cache_dir);
+    std::filesystem::create_directories(cache_dir);
+
+    string const orig_file_id{"file_1"};
+
+    SECTION("Find chunks by message index") {
+        IrChunkCache cache{cache_dir};
+        REQUIRE(0 == cache.get_size());
+        REQUIRE(false == cache.find(orig_file_id, 0).has_value());
+
+        auto const first_chunk_file_name = add_chunk(cache, orig_file_id, 0, 10, 100);
+        auto const second_chunk_file_name = add_chunk(cache, orig_file_id, 10, 25, 50);
+        add_chunk(cache, "file", 0, 100, 10);
+        add_chunk(cache, "file_1_2", 0, 100, 10);
+        REQUIRE(170 == cache.get_size());
+
+        for (size_t message_ix = 0; message_ix < 25; ++message_ix) {
+            INFO("message_ix: " << message_ix);
+            auto const chunk = cache.find(orig_file_id, message_ix);
+            REQUIRE(chunk.has_value());
+            REQUIRE(chunk->begin_message_ix <= message_ix);
+            REQUIRE(message_ix < chunk->end_message_ix);
+            REQUIRE((message_ix < 10 ? first_chunk_file_name : second_chunk_file_name)
+                    == chunk->file_name);
+        }
+        REQUIRE(false == cache.find(orig_file_id, 25).has_value());
+        REQUIRE(false == cache.find("file_2", 0).has_value());
+
+        // Another cache over the same directory loads the same chunks
+        IrChunkCache other_cache{cache_dir};
+        REQUIRE(cache.get_size() == other_cache.get_size());
+        auto const chunk = other_cache.find(orig_file_id, 24);
+        REQUIRE(chunk.has_value());
+        REQUIRE(second_chunk_file_name == chunk->file_name);
+        REQUIRE(50 == chunk->size);
+    }
+
+    SECTION("Add chunks atomically") {
+        {
+            IrChunkCache cache{cache_dir};
+            add_chunk(cache, orig_file_id, 0, 10, 100, true);
+        }
+        auto const chunk_file_name = IrChunkCache::get_chunk_file_name(orig_file_id, 0, 10);
+        auto const seek_index_file_name = chunk_file_name + string{cSeekIndexFileExtension};
+
+        // No temporary files are left behind
+        REQUIRE(vector<string>{".ir_chunk_cache.lock", chunk_file_name, seek_index_file_name}
+                == list_files(cache_dir));
+        REQUIRE(100 == std::filesystem::file_size(cache_dir / chunk_file_name));
+
+        // Leftover temporary files (e.g., from a crashed process) aren't loaded as chunks
+        std::ofstream{cache_dir / ("." + chunk_file_name + ".1234.0.tmp")} << "partial";
+        IrChunkCache cache{cache_dir};
+        REQUIRE(std::filesystem::file_size(cache_dir / chunk_file_name)
+                        + std::filesystem::file_size(cache_dir / seek_index_file_name)
+                == cache.get_size());
+    }
+
+    SECTION("Replace a chunk's stale seek index") {
+        IrChunkCache cache{cache_dir};
+        auto const chunk_file_name = add_chunk(cache, orig_file_id, 0, 10, 100, true);
+        auto const seek_index_path
+                = cache_dir / (chunk_file_name + string{cSeekIndexFileExtension});
+        REQUIRE(std::filesystem::exists(seek_index_path));
+        REQUIRE(100 + std::filesystem::file_size(seek_index_path) == cache.get_size());
+
+        // Re-adding the chunk without a seek index removes the old one
+        add_chunk(cache, orig_file_id, 0, 10, 80);
+        REQUIRE(false == std::filesystem::exists(seek_index_path));
+        REQUIRE(80 == cache.get_size());
+        REQUIRE(80 == IrChunkCache{cache_dir}.get_size());
+    }
+
+    SECTION("Evict the least recently used chunks") {
+        vector<string> chunk_file_names;
+        {
+            IrChunkCache cache{cache_dir};
+            for (size_t i = 0; i < 4; ++i) {
+                chunk_file_names.emplace_back(
+                        add_chunk(cache, orig_file_id, i * 10, (i + 1) * 10, 100, 0 == i % 2)
+                );
+            }
+        }
+        // Make the chunks' last uses (from least to most recent) 3, 0, 1, 2
+        auto const now = std::filesystem::file_time_type::clock::now();
+        vector<int> const num_hours_since_last_use{2, 1, 0, 3};
+        for (size_t i = 0; i < chunk_file_names.size(); ++i) {
+            std::filesystem::last_write_time(
+                    cache_dir / chunk_file_names[i],
+                    now - std::chrono::hours(num_hours_since_last_use[i])
+            );
+        }
+
+        IrChunkCache cache{cache_dir};
+        auto const seek_index_size = std::filesystem::file_size(
+                cache_dir / (chunk_file_names[0] + string{cSeekIndexFileExtension})
+        );
+        REQUIRE(400 + 2 * seek_index_size == cache.get_size());
+
+        // Nothing is evicted while the cache is within its limit
+        REQUIRE(cache.evict(cache.get_size()).empty());
+
+        REQUIRE(vector<string>{chunk_file_names[3]} == cache.evict(300 + 2 * seek_index_size));
+        REQUIRE(300 + 2 * seek_index_size == cache.get_size());
+
+        // Evicting a chunk removes its seek index too
+        REQUIRE(vector<string>{chunk_file_names[0], chunk_file_names[1]} == cache.evict(150));
+        REQUIRE(100 + seek_index_size == cache.get_size());
+        REQUIRE(vector<string>{".ir_chunk_cache.lock",
+                               chunk_file_names[2],
+                               chunk_file_names[2] + string{cSeekIndexFileExtension}}
+                == list_files(cache_dir));
+
+        // Finding a chunk marks it as used
+        {
+            IrChunkCache other_cache{cache_dir};
+            REQUIRE(other_cache.find(orig_file_id, 20).has_value());
+        }
+        REQUIRE(std::filesystem::last_write_time(cache_dir / chunk_file_names[2])
+                > now - std::chrono::minutes(1));
+        REQUIRE(vector<string>{chunk_file_names[2]} == cache.evict(0));
+        REQUIRE(0 == cache.get_size());
+    }
+
+    SECTION("Don't evict pinned chunks") {
+        vector<string> chunk_file_names;
+        {
+            IrChunkCache cache{cache_dir};
+            for (size_t i = 0; i < 3; ++i) {
+                chunk_file_names.emplace_back(
+                        add_chunk(cache, orig_file_id, i * 10, (i + 1) * 10, 100)
+                );
+            }
+        }
+
+        IrChunkCache cache{cache_dir};
+        {
+            // Chunks found by another instance (e.g., another process) are pinned until it's
+            // destroyed
+            IrChunkCache other_cache{cache_dir};
+            REQUIRE(other_cache.find(orig_file_id, 15).has_value());
+            auto evicted_chunk_file_names = cache.evict(0);
+            std::sort(evicted_chunk_file_names.begin(), evicted_chunk_file_names.end());
+            REQUIRE(vector<string>{chunk_file_names[0], chunk_file_names[2]}
+                    == evicted_chunk_file_names);
+            REQUIRE(100 == cache.get_size());
+        }
+
+        // So are chunks added by the instance itself
+        auto const new_chunk_file_name = add_chunk(cache, orig_file_id, 30, 40, 100);
+        REQUIRE(vector<string>{chunk_file_names[1]} == cache.evict(0));
+        REQUIRE(100 == cache.get_size());
+        REQUIRE(std::filesystem::exists(cache_dir / new_chunk_file_name));
+    }
+
+    SECTION("Handle chunks evicted by other instances") {
+        {
+            IrChunkCache other_cache{cache_dir};
+            add_chunk(other_cache, orig_file_id, 0, 10, 100);
+        }
+        IrChunkCache cache{cache_dir};
+        REQUIRE(100 == cache.get_size());
+        REQUIRE(1 == IrChunkCache{cache_dir}.evict(0).size());
+
+        // The chunk is still loaded by the first instance, but it's gone
+        REQUIRE(false == cache.find(orig_file_id, 0).has_value());
+        REQUIRE(0 == cache.get_size());
+    }
+
+    std::filesystem::remove_all(cache_dir);
+}
+
+TEST_CASE("Extract the IR chunk containing a message", "[IrChunkCache][decompress_to_ir]") {
+    std::filesystem::path const test_dir{cTestDirPath};
+    std::filesystem::remove_all(test_dir);
+    std::filesystem::create_directories(test_dir);
+
+    auto const log_path = (test_dir / "log.txt").string();
+    {
+        std::ofstream log_file{log_path};
+        for (int i = 0; i < 2000; ++i) {
+            log_file << "2024-01-01 00:" << (10 + i / 60 % 50) << ":" << (10 + i % 50)
+                     << ".000 INFO Request " << i << " took " << (i * 7 % 1000) << " ms"
+                     << string(i % 37, '.') << '\n';
+        }
+    }
+
+    auto const archives_dir = test_dir / "archives";
+    vector<char const*> argv{"clp", "c", archives_dir.c_str(), log_path.c_str(), nullptr};
+    // clp creates its own logger
+    spdlog::drop("stderr");
+    REQUIRE(0 == clp::clp::run(static_cast<int>(argv.size() - 1), argv.data()));
+
+    std::filesystem::path archive_path;
+    for (auto const& entry : std::filesystem::directory_iterator{archives_dir}) {
+        if (entry.is_directory()) {
+            archive_path = entry.path();
+        }
+    }
+    clp::streaming_archive::reader::Archive archive_reader;
+    archive_reader.open(archive_path.string());
+    archive_reader.refresh_dictionaries();
+    auto file_metadata_ix = archive_reader.get_file_iterator();
+    REQUIRE(file_metadata_ix->has_next());
+
+    struct IrChunk {
+        size_t begin_message_ix;
+        size_t end_message_ix;
+        vector<char> ir;
+    };
+
+    constexpr size_t cIrTargetSize{4096};
+    constexpr size_t cSeekIndexCheckpointInterval{100};
+    auto const decompress_to_ir = [&](std::optional<size_t> target_message_ix) {
+        vector<IrChunk> ir_chunks;
+        clp::clp::FileDecompressor file_decompressor;
+        REQUIRE(file_decompressor.decompress_to_ir(
+                archive_reader,
+                *file_metadata_ix,
+                cIrTargetSize,
+                cSeekIndexCheckpointInterval,
+                target_message_ix,
+                [&](std::span<char const> ir_chunk,
+                    [[maybe_unused]] std::optional<clp::ir::SeekIndex> const& seek_index,
+                    [[maybe_unused]] string const& orig_file_id,
+                    size_t begin_message_ix,
+                    size_t end_message_ix,
+                    [[maybe_unused]] bool is_last_ir_chunk) {
+                    ir_chunks.push_back(
+                            {begin_message_ix,
+                             end_message_ix,
+                             vector<char>(ir_chunk.begin(), ir_chunk.end())}
+                    );
+                    return true;
+                }
+        ));
+        return ir_chunks;
+    };
+
+    auto const all_ir_chunks = decompress_to_ir(std::nullopt);
+    REQUIRE(all_ir_chunks.size() > 2);
+    REQUIRE(0 == all_ir_chunks.front().begin_message_ix);
+    REQUIRE(2000 == all_ir_chunks.back().end_message_ix);
+
+    for (auto const& expected_ir_chunk : all_ir_chunks) {
+        auto const middle_message_ix
+                = (expected_ir_chunk.begin_message_ix + expected_ir_chunk.end_message_ix) / 2;
+        for (auto const target_message_ix :
+             {expected_ir_chunk.begin_message_ix,
+              middle_message_ix,
+              expected_ir_chunk.end_message_ix - 1})
+        {
+            INFO("target_message_ix: " << target_message_ix);
+            auto const ir_chunks = decompress_to_ir(target_message_ix);
+            REQUIRE(1 == ir_chunks.size());
+            REQUIRE(expected_ir_chunk.begin_message_ix == ir_chunks.front().begin_message_ix);
+            REQUIRE(expected_ir_chunk.end_message_ix == ir_chunks.front().end_message_ix);
+            REQUIRE(expected_ir_chunk.ir == ir_chunks.front().ir);
+        }
+    }
+
+    file_metadata_ix.reset();
+    archive_reader.close();
+    std::filesystem::remove_all(test_dir);
+}
@@ -0,0 +1,201 @@
+#include <cstdint>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/clp/Defs.h"
+#include "../src/clp/ErrorCode.hpp"
+#include "../src/clp/FileWriter.hpp"
+#include "../src/clp/ir/types.hpp"
+#include "../src/clp/NonDictVarSegmentIndexReader.hpp"
+#include "../src/clp/NonDictVarSegmentIndexWriter.hpp"
+#include "../src/clp/Query.hpp"
+#include "../src/clp/streaming_compression/passthrough/Compressor.hpp"
+#include "../src/clp/streaming_compression/zstd/Compressor.hpp"
+
+using clp::encoded_variable_t;
+using clp::ErrorCode_Corrupt;
+using clp::ir::VariablePlaceholder;
+using clp::NonDictVarSegmentIndexReader;
+using clp::NonDictVarSegmentIndexWriter;
+using clp::QueryVar;
+using clp::segment_id_t;
+using std::set;
+using std::string;
+using std::vector;
+
+namespace {
+constexpr char cTestDirPath[] = "unit-test-non-dict-var-segment-index";
+
+/**
+ * Writes an index containing a single segment whose integer variables are summarized by the given
+ * (uncompressed) content, bypassing the writer so that the content can be malformed.
+ * @param index_path
+ * @param content
+ */
+void write_raw_index(string const& index_path, vector<char> const& content) {
+    clp::FileWriter file_writer;
+    file_writer.open(index_path, clp::FileWriter::OpenMode::CREATE_FOR_WRITING);
+    file_writer.write_numeric_value<uint64_t>(1);
+#if USE_PASSTHROUGH_COMPRESSION
+    clp::streaming_compression::passthrough::Compressor compressor;
+    compressor.open(file_writer);
+#elif USE_ZSTD_COMPRESSION
+    clp::streaming_compression::zstd::Compressor compressor;
+    compressor.open(file_writer);
+#else
+    static_assert(false, "Unsupported compression mode.");
+#endif
+    compressor.write_numeric_value<segment_id_t>(0);
+    compressor.write(content.data(), content.size());
+    // Float variables
+    compressor.write_numeric_value<uint8_t>(0);
+    compressor.close();
+    file_writer.close();
+}
+
+/**
+ * Appends the given value's bytes to the given buffer
+ * @tparam ValueType
+ * @param value
+ * @param buf
+ */
+template <typename ValueType>
+void append_value(ValueType value, vector<char>& buf) {
+    auto const* value_begin = reinterpret_cast<char const*>(&value);
+    buf.insert(buf.end(), value_begin, value_begin + sizeof(value));
+}
+}  // namespace
+
+TEST_CASE("Write and read non-dictionary variable segment indexes", "[NonDictVarSegmentIndex]") {
+    std::filesystem::create_directories(cTestDirPath);
+    auto const index_path = (std::filesystem::path{cTestDirPath} / "var.segindex").string();
+
+    // Segment 0 has a few integers and floats, segment 1 has no variables, and segment 2 has too
+    // many distinct integers for a Bloom filter. Segment 3 isn't indexed.
+    vector<encoded_variable_t> segment_0_int_vars;
+    for (encoded_variable_t var = -500; var < 5000; var += 11) {
+        segment_0_int_vars.push_back(var);
+    }
+    vector<encoded_variable_t> const segment_0_float_vars{0x4000, 0x4100, 0x4200};
+    constexpr encoded_variable_t cSegment2NumIntVars{300 * 1024};
+
+    NonDictVarSegmentIndexWriter writer;
+    writer.open(index_path);
+    NonDictVarSegmentIndexWriter::SegmentVars segment_vars;
+    for (auto const var : segment_0_int_vars) {
+        segment_vars.int_vars.insert(var);
+    }
+    for (auto const var : segment_0_float_vars) {
+        segment_vars.float_vars.insert(var);
+    }
+    writer.index_segment(0, segment_vars);
+    segment_vars.clear();
+    writer.index_segment(1, segment_vars);
+    for (encoded_variable_t var = 0; var < cSegment2NumIntVars; ++var) {
+        segment_vars.int_vars.insert(var * 2);
+    }
+    writer.index_segment(2, segment_vars);
+    writer.close();
+
+    NonDictVarSegmentIndexReader reader;
+    reader.read(index_path);
+
+    SECTION("Round trip") {
+        // No false negatives
+        for (auto const var : segment_0_int_vars) {
+            REQUIRE(reader.segment_may_contain_var(0, VariablePlaceholder::Integer, var));
+        }
+        for (auto const var : segment_0_float_vars) {
+            REQUIRE(reader.segment_may_contain_var(0, VariablePlaceholder::Float, var));
+        }
+
+        // Values outside the segment's range
+        REQUIRE(false == reader.segment_may_contain_var(0, VariablePlaceholder::Integer, -501));
+        REQUIRE(false == reader.segment_may_contain_var(0, VariablePlaceholder::Integer, 5000));
+        REQUIRE(false == reader.segment_may_contain_var(0, VariablePlaceholder::Float, 0x3FFF));
+
+        // Values inside the range that the Bloom filter excludes (with a 1% false positive rate,
+        // nearly all of these)
+        size_t num_false_positives{0};
+        for (encoded_variable_t var = -499; var < 5000; var += 11) {
+            if (reader.segment_may_contain_var(0, VariablePlaceholder::Integer, var)) {
+                ++num_false_positives;
+            }
+        }
+        REQUIRE(num_false_positives < segment_0_int_vars.size() / 10);
+
+        // Segments without variables of a type can't contain any
+        REQUIRE(false == reader.segment_may_contain_var(1, VariablePlaceholder::Integer, 0));
+        REQUIRE(false == reader.segment_may_contain_var(1, VariablePlaceholder::Float, 0));
+
+        // Segments with too many distinct variables are only summarized by their range
+        REQUIRE(reader.segment_may_contain_var(2, VariablePlaceholder::Integer, 1));
+        REQUIRE(false
+                == reader.segment_may_contain_var(
+                        2,
+                        VariablePlaceholder::Integer,
+                        cSegment2NumIntVars * 2
+                ));
+
+        // Unindexed segments and dictionary variables may always match
+        REQUIRE(reader.segment_may_contain_var(3, VariablePlaceholder::Integer, 0));
+        REQUIRE(reader.segment_may_contain_var(0, VariablePlaceholder::Dictionary, 0));
+    }
+
+    SECTION("Prune segments for a query variable") {
+        set<segment_id_t> segment_ids{0, 1, 2, 3};
+        QueryVar{segment_0_int_vars[1], VariablePlaceholder::Integer}
+                .remove_segments_that_dont_contain_non_dict_var(reader, segment_ids);
+        REQUIRE(set<segment_id_t>{0, 3} == segment_ids);
+
+        // Segment 2 only contains even integers, so an odd value beyond segment 0's range only
+        // leaves segments that can't be pruned
+        segment_ids = {0, 1, 2, 3};
+        QueryVar{10'001, VariablePlaceholder::Integer}
+                .remove_segments_that_dont_contain_non_dict_var(reader, segment_ids);
+        REQUIRE(set<segment_id_t>{2, 3} == segment_ids);
+
+        segment_ids = {0, 1, 2, 3};
+        QueryVar{segment_0_float_vars[0], VariablePlaceholder::Float}
+                .remove_segments_that_dont_contain_non_dict_var(reader, segment_ids);
+        REQUIRE(set<segment_id_t>{0, 3} == segment_ids);
+    }
+
+    SECTION("Reject corrupt indexes") {
+        vector<char> content;
+        append_value<uint8_t>(1, content);
+        append_value<encoded_variable_t>(0, content);
+        append_value<encoded_variable_t>(10, content);
+        append_value<uint32_t>(3, content);
+
+        SECTION("Implausible number of words") {
+            // The index ends long before the claimed number of words, so this must fail without
+            // trying to allocate them all
+            append_value<uint64_t>(UINT64_MAX / sizeof(uint64_t), content);
+            append_value<uint64_t>(0, content);
+        }
+
+        SECTION("Truncated bit array") {
+            append_value<uint64_t>(2, content);
+            append_value<uint64_t>(0, content);
+        }
+
+        SECTION("Empty bit array") {
+            append_value<uint64_t>(0, content);
+        }
+
+        write_raw_index(index_path, content);
+        try {
+            reader.read(index_path);
+            FAIL("Corrupt index was read");
+        } catch (NonDictVarSegmentIndexReader::OperationFailed const& e) {
+            REQUIRE(ErrorCode_Corrupt == e.get_error_code());
+        }
+    }
+
+    std::filesystem::remove_all(cTestDirPath);
+}
@@ -1,14 +1,21 @@
 #include <unistd.h>
 
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
 #include <boost/filesystem.hpp>
 #include <Catch2/single_include/catch2/catch.hpp>
 
+#include "../src/clp/streaming_archive/Constants.hpp"
 #include "../src/clp/streaming_archive/reader/Segment.hpp"
 #include "../src/clp/streaming_archive/writer/Segment.hpp"
 #include "../src/clp/Utils.hpp"
 
 using clp::ErrorCode_Success;
 using std::string;
+using std::vector;
 
 TEST_CASE("Test writing and reading a segment", "[Segment]") {
     clp::ErrorCode error_code;
@@ -63,3 +70,81 @@ TEST_CASE("Test writing and reading a segment", "[Segment]") {
     boost::filesystem::remove_all(segments_dir_path, boost_error_code);
     REQUIRE(!boost_error_code);
 }
+
+TEST_CASE("Test reading a multi-frame segment out of order", "[Segment]") {
+    // Size the messages so that each frame holds a few of them and the segment spans several frames
+    constexpr size_t cNumMessages = 24;
+    constexpr size_t cMessageSize = clp::streaming_archive::cSegmentFrameTargetUncompressedSize / 3;
+
+    // Use random content so that reading the wrong part of the segment can't go unnoticed
+    std::mt19937_64 random_generator{0};
+    std::uniform_int_distribution<int> char_distribution{'a', 'z'};
+    vector<vector<char>> messages(cNumMessages);
+    vector<char> uncompressed_data;
+    for (size_t i = 0; i < cNumMessages; ++i) {
+        // Vary the sizes so that message boundaries don't line up with frame boundaries
+        messages[i].resize(cMessageSize + i * 1000);
+        for (auto& c : messages[i]) {
+            c = static_cast<char>(char_distribution(random_generator));
+        }
+        uncompressed_data.insert(uncompressed_data.end(), messages[i].cbegin(), messages[i].cend());
+    }
+
+    string segments_dir_path = "unit-test-segment/";
+    REQUIRE(ErrorCode_Success == clp::create_directory_structure(segments_dir_path, 0700));
+
+    clp::streaming_archive::writer::Segment writer_segment;
+    writer_segment.open(segments_dir_path, 0, 0);
+    auto const segment_id = writer_segment.get_id();
+    vector<uint64_t> offsets(cNumMessages);
+    for (size_t i = 0; i < cNumMessages; ++i) {
+        writer_segment.append(messages[i].data(), messages[i].size(), offsets[i]);
+    }
+    writer_segment.close();
+
+    clp::streaming_archive::reader::Segment reader_segment;
+    REQUIRE(ErrorCode_Success == reader_segment.try_open(segments_dir_path, segment_id));
+
+    vector<char> decompressed_data;
+    auto read_and_compare = [&](uint64_t pos, uint64_t len) {
+        decompressed_data.resize(len);
+        REQUIRE(ErrorCode_Success == reader_segment.try_read(pos, decompressed_data.data(), len));
+        REQUIRE(0 == memcmp(uncompressed_data.data() + pos, decompressed_data.data(), len));
+    };
+
+    SECTION("Messages in shuffled order") {
+        vector<size_t> message_ixs(cNumMessages);
+        for (size_t i = 0; i < cNumMessages; ++i) {
+            message_ixs[i] = i;
+        }
+        std::shuffle(message_ixs.begin(), message_ixs.end(), random_generator);
+        for (auto const i : message_ixs) {
+            read_and_compare(offsets[i], messages[i].size());
+        }
+    }
+
+    SECTION("Reads backwards across message and frame boundaries") {
+        constexpr uint64_t cReadLen = 4096;
+        for (size_t i = cNumMessages - 1; i > 0; --i) {
+            read_and_compare(offsets[i] - cReadLen / 2, cReadLen);
+        }
+    }
+
+    SECTION("Read spanning several frames") {
+        read_and_compare(offsets[1] + 1, offsets[cNumMessages - 2] - offsets[1]);
+    }
+
+    SECTION("Reads after a read past the end of the segment") {
+        decompressed_data.resize(2);
+        auto const pos = uncompressed_data.size() - 1;
+        REQUIRE(ErrorCode_Success != reader_segment.try_read(pos, decompressed_data.data(), 2));
+        read_and_compare(offsets[cNumMessages - 1], messages[cNumMessages - 1].size());
+        read_and_compare(offsets[0], messages[0].size());
+    }
+
+    reader_segment.close();
+
+    boost::system::error_code boost_error_code;
+    boost::filesystem::remove_all(segments_dir_path, boost_error_code);
+    REQUIRE(!boost_error_code);
+}
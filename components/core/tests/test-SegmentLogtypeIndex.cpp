@@ -0,0 +1,345 @@
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Catch2/single_include/catch2/catch.hpp>
+#include <log_surgeon/Lexer.hpp>
+#include <spdlog/spdlog.h>
+
+#include "../src/clp/clp/run.hpp"
+#include "../src/clp/Defs.h"
+#include "../src/clp/ErrorCode.hpp"
+#include "../src/clp/FileWriter.hpp"
+#include "../src/clp/Grep.hpp"
+#include "../src/clp/Query.hpp"
+#include "../src/clp/streaming_archive/Constants.hpp"
+#include "../src/clp/streaming_archive/reader/Archive.hpp"
+#include "../src/clp/streaming_archive/reader/File.hpp"
+#include "../src/clp/streaming_archive/reader/Message.hpp"
+#include "../src/clp/streaming_archive/reader/SegmentLogtypeIndex.hpp"
+#include "../src/clp/streaming_archive/writer/SegmentLogtypeIndex.hpp"
+#include "../src/clp/streaming_compression/passthrough/Compressor.hpp"
+#include "../src/clp/streaming_compression/zstd/Compressor.hpp"
+
+using clp::ErrorCode;
+using clp::ErrorCode_Corrupt;
+using clp::ErrorCode_FileNotFound;
+using clp::ErrorCode_Success;
+using clp::ErrorCode_Truncated;
+using clp::logtype_dictionary_id_t;
+using clp::segment_id_t;
+using std::string;
+using std::vector;
+
+namespace {
+constexpr char cTestDirPath[] = "unit-test-segment-logtype-index/";
+
+/**
+ * Writes a logtype index with the given header and (uncompressed) content, bypassing the writer so
+ * that the content can be malformed.
+ * @param segment_id
+ * @param num_files
+ * @param content
+ */
+void write_raw_index(segment_id_t segment_id, uint64_t num_files, vector<char> const& content) {
+    string path{cTestDirPath};
+    path += std::to_string(segment_id);
+    path += clp::streaming_archive::cSegmentLogtypeIndexFileExtension;
+
+    clp::FileWriter file_writer;
+    file_writer.open(path, clp::FileWriter::OpenMode::CREATE_FOR_WRITING);
+    file_writer.write_numeric_value(num_files);
+#if USE_PASSTHROUGH_COMPRESSION
+    clp::streaming_compression::passthrough::Compressor compressor;
+    compressor.open(file_writer);
+#elif USE_ZSTD_COMPRESSION
+    clp::streaming_compression::zstd::Compressor compressor;
+    compressor.open(file_writer, 3);
+#else
+    static_assert(false, "Unsupported compression mode.");
+#endif
+    compressor.write(content.data(), content.size());
+    compressor.close();
+    file_writer.close();
+}
+
+/**
+ * @param index
+ * @param segment_id
+ * @return The error code returned or thrown when loading the given segment's logtype index
+ */
+auto load_index(clp::streaming_archive::reader::SegmentLogtypeIndex& index, segment_id_t segment_id)
+        -> ErrorCode {
+    try {
+        return index.try_load(cTestDirPath, segment_id);
+    } catch (clp::streaming_archive::reader::SegmentLogtypeIndex::OperationFailed const& e) {
+        return e.get_error_code();
+    }
+}
+
+/**
+ * Compresses the given file into an archive in the given directory using clp
+ * @param output_dir
+ * @param file_path
+ * @param index_segment_logtypes
+ */
+void compress(string const& output_dir, string const& file_path, bool index_segment_logtypes) {
+    vector<string> arguments{"clp", "c", output_dir, file_path};
+    if (index_segment_logtypes) {
+        arguments.emplace_back("--index-segment-logtypes");
+    }
+    vector<char const*> argv;
+    for (auto const& argument : arguments) {
+        argv.push_back(argument.c_str());
+    }
+    argv.push_back(nullptr);
+    // clp creates its own logger
+    spdlog::drop("stderr");
+    REQUIRE(0 == clp::clp::run(static_cast<int>(argv.size() - 1), argv.data()));
+}
+
+/**
+ * Searches every archive in the given directory like clg does
+ * @param archives_dir
+ * @param search_string
+ * @return The matching messages, sorted
+ */
+auto search(std::filesystem::path const& archives_dir, string const& search_string)
+        -> vector<string> {
+    vector<string> results;
+    auto const collect_result = [](string const& orig_file_path,
+                                   clp::streaming_archive::reader::Message const&,
+                                   string const& decompressed_msg,
+                                   void* custom_arg) {
+        static_cast<vector<string>*>(custom_arg)
+                ->emplace_back(orig_file_path + ":" + decompressed_msg);
+    };
+
+    log_surgeon::lexers::ByteLexer forward_lexer;
+    log_surgeon::lexers::ByteLexer reverse_lexer;
+    for (auto const& entry : std::filesystem::directory_iterator{archives_dir}) {
+        if (false == entry.is_directory()) {
+            continue;
+        }
+        clp::streaming_archive::reader::Archive archive;
+        archive.open(entry.path().string());
+        archive.refresh_dictionaries();
+
+        auto query = clp::Grep::process_raw_query(
+                archive,
+                search_string,
+                clp::cEpochTimeMin,
+                clp::cEpochTimeMax,
+                false,
+                forward_lexer,
+                reverse_lexer,
+                true
+        );
+        if (false == query.has_value()) {
+            archive.close();
+            continue;
+        }
+
+        vector<clp::Query> queries{std::move(query.value())};
+        clp::streaming_archive::reader::File compressed_file;
+        auto file_metadata_ix = archive.get_file_iterator();
+        for (; file_metadata_ix->has_next(); file_metadata_ix->next()) {
+            if (false == archive.file_may_match_query(*file_metadata_ix, queries.front())) {
+                continue;
+            }
+            REQUIRE(ErrorCode_Success == archive.open_file(compressed_file, *file_metadata_ix));
+            clp::Grep::calculate_sub_queries_relevant_to_file(compressed_file, queries);
+            clp::Grep::search_and_output(
+                    queries.front(),
+                    SIZE_MAX,
+                    archive,
+                    compressed_file,
+                    collect_result,
+                    &results
+            );
+            archive.close_file(compressed_file);
+        }
+        archive.close();
+    }
+    std::sort(results.begin(), results.end());
+    return results;
+}
+}  // namespace
+
+TEST_CASE("Write and read segment logtype indexes", "[SegmentLogtypeIndex]") {
+    std::filesystem::create_directories(cTestDirPath);
+
+    // Postings are delta-encoded, so include message indices that need multi-byte varints
+    vector<logtype_dictionary_id_t> file1_logtypes;
+    for (size_t i = 0; i < 1000; ++i) {
+        file1_logtypes.push_back(0 == i % 300 ? 1'000'000 : i % 3);
+    }
+    vector<logtype_dictionary_id_t> const file2_logtypes{7};
+
+    clp::streaming_archive::writer::SegmentLogtypeIndex writer;
+    writer.open(cTestDirPath, 0, 3);
+    writer.add_file(0, file1_logtypes.data(), file1_logtypes.size());
+    // Empty files aren't indexed
+    writer.add_file(4000, nullptr, 0);
+    writer.add_file(4000, file2_logtypes.data(), file2_logtypes.size());
+    writer.close();
+
+    clp::streaming_archive::reader::SegmentLogtypeIndex reader;
+
+    SECTION("Round trip") {
+        REQUIRE(ErrorCode_Success == load_index(reader, 0));
+        REQUIRE(0 == reader.get_segment_id());
+
+        auto const* file1_index = reader.get_file_index(0);
+        REQUIRE(nullptr != file1_index);
+        vector<std::pair<logtype_dictionary_id_t, vector<uint64_t>>> expected_file1_index;
+        for (size_t msg_ix = 0; msg_ix < file1_logtypes.size(); ++msg_ix) {
+            auto const logtype_id = file1_logtypes[msg_ix];
+            auto it = std::find_if(
+                    expected_file1_index.begin(),
+                    expected_file1_index.end(),
+                    [&](auto const& entry) { return entry.first == logtype_id; }
+            );
+            if (expected_file1_index.end() == it) {
+                it = expected_file1_index.insert(it, {logtype_id, {}});
+            }
+            it->second.push_back(msg_ix);
+        }
+        std::sort(expected_file1_index.begin(), expected_file1_index.end());
+        REQUIRE(expected_file1_index == *file1_index);
+
+        auto const* file2_index = reader.get_file_index(4000);
+        REQUIRE(nullptr != file2_index);
+        REQUIRE(clp::streaming_archive::reader::SegmentLogtypeIndex::FileIndex{{7, {0}}}
+                == *file2_index);
+
+        REQUIRE(nullptr == reader.get_file_index(1));
+    }
+
+    SECTION("Missing index") {
+        REQUIRE(ErrorCode_FileNotFound == load_index(reader, 1));
+        REQUIRE(nullptr == reader.get_file_index(0));
+    }
+
+    SECTION("Truncated varint") {
+        // A file's position whose varint continues past the end of the index
+        write_raw_index(1, 1, {static_cast<char>(0x80)});
+        REQUIRE(ErrorCode_Truncated == load_index(reader, 1));
+    }
+
+    SECTION("Truncated postings") {
+        // Position 0, one logtype (ID 5) with two messages, but the first message index's varint
+        // is cut off
+        write_raw_index(1, 1, {0, 1, 5, 2, static_cast<char>(0x80), static_cast<char>(0x80)});
+        REQUIRE(ErrorCode_Truncated == load_index(reader, 1));
+    }
+
+    SECTION("Missing files") {
+        // The header claims there's a second file
+        write_raw_index(1, 2, {0, 1, 5, 1, 0});
+        REQUIRE(ErrorCode_Truncated == load_index(reader, 1));
+    }
+
+    SECTION("Varint longer than 64 bits") {
+        write_raw_index(1, 1, vector<char>(10, static_cast<char>(0xFF)));
+        REQUIRE(ErrorCode_Corrupt == load_index(reader, 1));
+    }
+
+    SECTION("Implausible number of logtypes") {
+        // Position 0 and 2^56 logtypes
+        vector<char> content{0};
+        content.insert(content.end(), 8, static_cast<char>(0x80));
+        content.push_back(1);
+        write_raw_index(1, 1, content);
+        REQUIRE(ErrorCode_Corrupt == load_index(reader, 1));
+    }
+
+    SECTION("Duplicate file") {
+        write_raw_index(1, 2, {0, 1, 5, 1, 0, 0, 1, 5, 1, 0});
+        REQUIRE(ErrorCode_Corrupt == load_index(reader, 1));
+    }
+
+    SECTION("A failed load doesn't leave a partial index") {
+        REQUIRE(ErrorCode_Success == load_index(reader, 0));
+        write_raw_index(1, 2, {0, 1, 5, 1, 0, 0, 1, 5, 1, 0});
+        REQUIRE(ErrorCode_Corrupt == load_index(reader, 1));
+        REQUIRE(nullptr == reader.get_file_index(0));
+    }
+
+    std::filesystem::remove_all(cTestDirPath);
+}
+
+TEST_CASE("Search with and without segment logtype indexes", "[SegmentLogtypeIndex][Search]") {
+    std::filesystem::path const test_dir{cTestDirPath};
+    std::filesystem::create_directories(test_dir);
+
+    // Create a log with a few common logtypes and a few rare ones
+    auto const log_path = (test_dir / "log.txt").string();
+    {
+        std::ofstream log_file{log_path};
+        for (int i = 0; i < 5000; ++i) {
+            log_file << "2024-01-01 00:00:" << (10 + i % 50) << ".000 ";
+            switch (i % 4) {
+                case 0:
+                    log_file << "INFO Request " << i << " served in " << (i % 97) << " ms\n";
+                    break;
+                case 1:
+                    log_file << "INFO Cache hit ratio " << (i % 100) / 100.0 << " for shard s"
+                             << (i % 7) << '\n';
+                    break;
+                case 2:
+                    log_file << "DEBUG Heartbeat from node-" << (i % 13) << '\n';
+                    break;
+                default:
+                    if (3 == i % 1000) {
+                        log_file << "ERROR Disk /dev/sd" << static_cast<char>('a' + i / 1000)
+                                 << " failed with code " << i << '\n';
+                    } else {
+                        log_file << "WARN Slow query took " << i << " ms\n";
+                    }
+                    break;
+            }
+        }
+    }
+    auto const unindexed_archives_dir = test_dir / "unindexed";
+    auto const indexed_archives_dir = test_dir / "indexed";
+    compress(unindexed_archives_dir.string(), log_path, false);
+    compress(indexed_archives_dir.string(), log_path, true);
+
+    // Ensure the indexed archive was actually indexed
+    bool has_logtype_index{false};
+    for (auto const& entry : std::filesystem::recursive_directory_iterator{indexed_archives_dir}) {
+        if (entry.path().extension()
+            == clp::streaming_archive::cSegmentLogtypeIndexFileExtension)
+        {
+            has_logtype_index = true;
+        }
+    }
+    REQUIRE(has_logtype_index);
+
+    vector<string> const search_strings{
+            "*ERROR*",
+            "*failed with code 3003*",
+            "*Heartbeat from node-12",
+            "*served in 5 ms*",
+            "*shard s3*",
+            "*Slow query took 1?7 ms*",
+            "*INFO*",
+            "*no such message*",
+            "*",
+    };
+    for (auto const& search_string : search_strings) {
+        INFO("search string: \"" << search_string << "\"");
+        auto const unindexed_results = search(unindexed_archives_dir, search_string);
+        REQUIRE(unindexed_results == search(indexed_archives_dir, search_string));
+        if ("*no such message*" != search_string) {
+            REQUIRE(false == unindexed_results.empty());
+        }
+    }
+
+    std::filesystem::remove_all(test_dir);
+}
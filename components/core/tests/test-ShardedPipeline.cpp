@@ -0,0 +1,201 @@
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/reducer/BinaryRecordGroup.hpp"
+#include "../src/reducer/ConstRecordIterator.hpp"
+#include "../src/reducer/CountOperator.hpp"
+#include "../src/reducer/GroupTags.hpp"
+#include "../src/reducer/Pipeline.hpp"
+#include "../src/reducer/Record.hpp"
+#include "../src/reducer/RecordGroupIterator.hpp"
+#include "../src/reducer/ShardedPipeline.hpp"
+
+using reducer::BinaryRecordGroup;
+using reducer::ConstRecordIterator;
+using reducer::CountOperator;
+using reducer::GroupTag;
+using reducer::GroupTags;
+using reducer::GroupTagsSet;
+using reducer::PipelineInputMode;
+using reducer::Record;
+using reducer::RecordGroupIterator;
+using reducer::ShardedPipeline;
+using reducer::SingleInt64RecordAdapter;
+using std::string;
+using std::vector;
+
+namespace {
+/**
+ * A ConstRecordIterator over a vector of count records.
+ */
+class CountRecordIterator : public ConstRecordIterator {
+public:
+    explicit CountRecordIterator(vector<SingleInt64RecordAdapter> const& records)
+            : m_records{records} {}
+
+    [[nodiscard]] Record const& get() const override { return m_records[m_record_ix]; }
+
+    void next() override { ++m_record_ix; }
+
+    bool done() override { return m_record_ix >= m_records.size(); }
+
+    void reset() override { m_record_ix = 0; }
+
+private:
+    vector<SingleInt64RecordAdapter> const& m_records;
+    size_t m_record_ix{0};
+};
+
+/**
+ * @param tags
+ * @return A printable representation of the given tags that distinguishes int64 and string tags.
+ */
+auto tags_to_string(GroupTags const& tags) -> string {
+    string str;
+    for (auto const& tag : tags) {
+        if (GroupTag::Type::Int64 == tag.get_type()) {
+            str += "i:" + std::to_string(tag.get_int64_value());
+        } else {
+            str += "s:" + string{tag.get_string_value()};
+        }
+        str += ';';
+    }
+    return str;
+}
+
+/**
+ * Collects the results of a pipeline, checking that each group appears once.
+ * @param group_it
+ * @return A map from each result group's tags to its count.
+ */
+auto collect_counts(std::unique_ptr<RecordGroupIterator> group_it) -> std::map<string, int64_t> {
+    std::map<string, int64_t> counts;
+    for (; false == group_it->done(); group_it->next()) {
+        auto& group = group_it->get();
+        auto& record_it = group.record_iter();
+        REQUIRE(false == record_it.done());
+        auto const [it, inserted] = counts.emplace(
+                tags_to_string(group.get_tags()),
+                record_it.get().get_int64_value(CountOperator::cRecordElementKey)
+        );
+        REQUIRE(inserted);
+    }
+    return counts;
+}
+
+/**
+ * @param num_shards
+ * @return A pipeline like the reducer server's for count queries.
+ */
+auto create_count_pipeline(size_t num_shards) -> ShardedPipeline {
+    ShardedPipeline pipeline{num_shards, PipelineInputMode::IntraStage};
+    pipeline.add_pipeline_stage([] { return std::make_shared<CountOperator>(); });
+    return pipeline;
+}
+}  // namespace
+
+TEST_CASE("Merge the results of sharded pipelines", "[reducer][ShardedPipeline]") {
+    // Groups keyed by strings (count queries grouped by a field), int64s (timeline buckets), and
+    // both, with several partial counts each, as if they were sent by several search workers
+    vector<GroupTags> all_tags;
+    for (int64_t i = 0; i < 100; ++i) {
+        all_tags.push_back(GroupTags{GroupTag::from_string("host-" + std::to_string(i))});
+        all_tags.push_back(GroupTags{GroupTag::from_int64(i * 60'000)});
+        all_tags.push_back(
+                GroupTags{GroupTag::from_int64(i * 60'000), GroupTag::from_string("host-0")}
+        );
+    }
+    // Tags whose values are equal but whose types differ are different groups
+    all_tags.push_back(GroupTags{GroupTag::from_string("60000")});
+    all_tags.push_back(GroupTags{});
+
+    constexpr size_t cNumPushesPerGroup{3};
+    vector<vector<uint8_t>> serialized_groups;
+    std::map<string, int64_t> expected_counts;
+    for (size_t push_ix = 0; push_ix < cNumPushesPerGroup; ++push_ix) {
+        for (size_t tags_ix = 0; tags_ix < all_tags.size(); ++tags_ix) {
+            auto const& tags = all_tags[tags_ix];
+            vector<SingleInt64RecordAdapter> records;
+            for (size_t record_ix = 0; record_ix <= push_ix; ++record_ix) {
+                records.emplace_back(CountOperator::cRecordElementKey);
+                records.back().set_record_value(static_cast<int64_t>(tags_ix + record_ix));
+                expected_counts[tags_to_string(tags)] += static_cast<int64_t>(tags_ix + record_ix);
+            }
+            CountRecordIterator record_it{records};
+            auto serialized_group = reducer::serialize_to_binary(tags, record_it);
+            REQUIRE(serialized_group.has_value());
+            serialized_groups.emplace_back(std::move(serialized_group.value()));
+        }
+    }
+
+    // Push every group into a single shard, and into several shards from several threads like the
+    // reducer server's thread pool does
+    auto single_shard_pipeline = create_count_pipeline(1);
+    for (auto const& serialized_group : serialized_groups) {
+        BinaryRecordGroup record_group{
+                reinterpret_cast<char const*>(serialized_group.data()),
+                serialized_group.size()
+        };
+        single_shard_pipeline.push_record_group(
+                record_group.get_tags(),
+                record_group.record_iter()
+        );
+    }
+
+    constexpr size_t cNumThreads{4};
+    auto sharded_pipeline = create_count_pipeline(cNumThreads * 4);
+    REQUIRE(cNumThreads * 4 == sharded_pipeline.get_num_shards());
+    vector<std::thread> threads;
+    for (size_t thread_ix = 0; thread_ix < cNumThreads; ++thread_ix) {
+        threads.emplace_back([&, thread_ix] {
+            for (size_t i = thread_ix; i < serialized_groups.size(); i += cNumThreads) {
+                auto const& serialized_group = serialized_groups[i];
+                BinaryRecordGroup record_group{
+                        reinterpret_cast<char const*>(serialized_group.data()),
+                        serialized_group.size()
+                };
+                sharded_pipeline.push_record_group(
+                        record_group.get_tags(),
+                        record_group.record_iter()
+                );
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    SECTION("All results") {
+        auto const single_shard_counts = collect_counts(single_shard_pipeline.finish());
+        REQUIRE(expected_counts == single_shard_counts);
+        REQUIRE(single_shard_counts == collect_counts(sharded_pipeline.finish()));
+    }
+
+    SECTION("Filtered results") {
+        GroupTagsSet filtered_tags;
+        std::map<string, int64_t> expected_filtered_counts;
+        for (size_t tags_ix = 0; tags_ix < all_tags.size(); tags_ix += 7) {
+            auto const& tags = all_tags[tags_ix];
+            filtered_tags.insert(tags);
+            expected_filtered_counts.emplace(
+                    tags_to_string(tags),
+                    expected_counts.at(tags_to_string(tags))
+            );
+        }
+        // Tags without any results are skipped
+        filtered_tags.insert(GroupTags{GroupTag::from_string("missing")});
+
+        auto const single_shard_counts
+                = collect_counts(single_shard_pipeline.finish(filtered_tags));
+        REQUIRE(expected_filtered_counts == single_shard_counts);
+        REQUIRE(single_shard_counts == collect_counts(sharded_pipeline.finish(filtered_tags)));
+    }
+}
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 #include <boost/iostreams/device/mapped_file.hpp>
@@ -9,6 +10,7 @@
 #include "../src/clp/streaming_compression/passthrough/Decompressor.hpp"
 #include "../src/clp/streaming_compression/zstd/Compressor.hpp"
 #include "../src/clp/streaming_compression/zstd/Decompressor.hpp"
+#include "../src/clp/streaming_compression/zstd/Dictionary.hpp"
 
 using clp::ErrorCode_Success;
 using clp::FileWriter;
@@ -239,3 +241,90 @@ TEST_CASE("StreamingCompression", "[StreamingCompression]") {
     delete[] uncompressed_data;
     delete[] decompressed_data;
 }
+
+TEST_CASE("StreamingCompressionWithDictionary", "[StreamingCompression]") {
+    constexpr size_t cNumSamples = 1000;
+    constexpr size_t cMaxDictionarySize = 16 * 1024;
+
+    // Train a dictionary on log-like samples
+    std::vector<std::string> samples;
+    for (size_t i = 0; i < cNumSamples; ++i) {
+        samples.emplace_back(
+                "2024-01-01 00:00:" + std::to_string(i % 60) + " INFO Task " + std::to_string(i)
+                + " finished on container_" + std::to_string(i * 7) + " in "
+                + std::to_string(i % 13) + " ms\n"
+        );
+    }
+    auto dictionary_content
+            = clp::streaming_compression::zstd::Dictionary::train(samples, cMaxDictionarySize);
+    REQUIRE(false == dictionary_content.empty());
+    REQUIRE(dictionary_content.size() <= cMaxDictionarySize);
+    clp::streaming_compression::zstd::Dictionary const dictionary(
+            dictionary_content,
+            clp::streaming_compression::zstd::cDefaultCompressionLevel
+    );
+    REQUIRE(0 != dictionary.get_id());
+
+    // Compress a sample in several frames, as dictionary files are
+    std::string const& uncompressed_data = samples.back();
+    std::string compressed_file_path = "compressed_file_with_dictionary.zstd.bin";
+    FileWriter file_writer;
+    file_writer.open(compressed_file_path, FileWriter::OpenMode::CREATE_FOR_WRITING);
+    clp::streaming_compression::zstd::Compressor compressor;
+    compressor.open(file_writer, dictionary);
+    compressor.write(uncompressed_data.data(), uncompressed_data.size());
+    compressor.flush();
+    compressor.write(uncompressed_data.data(), uncompressed_data.size());
+    compressor.close();
+    file_writer.close();
+
+    SECTION("Decompress with the dictionary") {
+        // Round-trip the dictionary through a file, as archives do
+        std::string dictionary_path = "zstd_dictionary.bin";
+        file_writer.open(dictionary_path, FileWriter::OpenMode::CREATE_FOR_WRITING);
+        file_writer.write_string(dictionary_content);
+        file_writer.close();
+        clp::streaming_compression::zstd::Dictionary const decompression_dictionary(
+                clp::streaming_compression::zstd::Dictionary::read_content_from_file(
+                        dictionary_path
+                )
+        );
+        boost::filesystem::remove(dictionary_path);
+        REQUIRE(dictionary.get_id() == decompression_dictionary.get_id());
+
+        clp::streaming_compression::zstd::Decompressor decompressor;
+        decompressor.set_dictionary(&decompression_dictionary);
+        REQUIRE(ErrorCode_Success == decompressor.open(compressed_file_path));
+        std::string decompressed_data(2 * uncompressed_data.size(), '\0');
+        REQUIRE(ErrorCode_Success
+                == decompressor.get_decompressed_stream_region(
+                        0,
+                        decompressed_data.data(),
+                        decompressed_data.size()
+                ));
+        REQUIRE(decompressed_data == uncompressed_data + uncompressed_data);
+        decompressor.close();
+    }
+
+    SECTION("Decompress without the dictionary") {
+        clp::streaming_compression::zstd::Decompressor decompressor;
+        REQUIRE(ErrorCode_Success == decompressor.open(compressed_file_path));
+        std::string decompressed_data(uncompressed_data.size(), '\0');
+        REQUIRE(ErrorCode_Success
+                != decompressor.get_decompressed_stream_region(
+                        0,
+                        decompressed_data.data(),
+                        decompressed_data.size()
+                ));
+        decompressor.close();
+    }
+
+    SECTION("Invalid dictionary content") {
+        REQUIRE_THROWS_AS(
+                clp::streaming_compression::zstd::Dictionary(std::string(1024, 'a')),
+                clp::streaming_compression::zstd::Dictionary::OperationFailed
+        );
+    }
+
+    boost::filesystem::remove(compressed_file_path);
+}
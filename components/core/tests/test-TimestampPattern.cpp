@@ -549,3 +549,71 @@ TEST_CASE("Test known timestamp patterns", "[KnownTimestampPatterns]") {
     specific_pattern.insert_formatted_timestamp(timestamp, content);
     REQUIRE(line == content);
 }
+
+TEST_CASE("Test searching known timestamp patterns with a prediction", "[KnownTimestampPatterns]") {
+    TimestampPattern::init();
+
+    epochtime_t timestamp;
+    size_t timestamp_begin_pos;
+    size_t timestamp_end_pos;
+
+    string line = "2015-02-01 01:02:03,004 content after";
+    auto const* pattern = TimestampPattern::search_known_ts_patterns(
+            line,
+            timestamp,
+            timestamp_begin_pos,
+            timestamp_end_pos
+    );
+    REQUIRE(nullptr != pattern);
+
+    // The predicted pattern is used if it can parse the line
+    auto const* predicted_pattern = TimestampPattern::search_known_ts_patterns(
+            line,
+            pattern,
+            timestamp,
+            timestamp_begin_pos,
+            timestamp_end_pos
+    );
+    REQUIRE(pattern == predicted_pattern);
+    REQUIRE(1'422'752'523'004 == timestamp);
+    REQUIRE(0 == timestamp_begin_pos);
+    REQUIRE(23 == timestamp_end_pos);
+
+    // Otherwise, the search falls back to the other known patterns
+    line = "[20170106-16:56:41] content after";
+    predicted_pattern = TimestampPattern::search_known_ts_patterns(
+            line,
+            pattern,
+            timestamp,
+            timestamp_begin_pos,
+            timestamp_end_pos
+    );
+    REQUIRE(nullptr != predicted_pattern);
+    REQUIRE(predicted_pattern->get_format() == "[%Y%m%d-%H:%M:%S]");
+    REQUIRE(0 == timestamp_begin_pos);
+    REQUIRE(19 == timestamp_end_pos);
+
+    // Custom patterns can be used as predictions too
+    TimestampPattern const custom_pattern{0, "%Y.%m.%d %H:%M:%S"};
+    line = "2015.02.01 01:02:03 content after";
+    predicted_pattern = TimestampPattern::search_known_ts_patterns(
+            line,
+            &custom_pattern,
+            timestamp,
+            timestamp_begin_pos,
+            timestamp_end_pos
+    );
+    REQUIRE(&custom_pattern == predicted_pattern);
+    REQUIRE(1'422'752'523'000 == timestamp);
+
+    line = "no timestamp";
+    predicted_pattern = TimestampPattern::search_known_ts_patterns(
+            line,
+            &custom_pattern,
+            timestamp,
+            timestamp_begin_pos,
+            timestamp_end_pos
+    );
+    REQUIRE(nullptr == predicted_pattern);
+    REQUIRE(string::npos == timestamp_begin_pos);
+}
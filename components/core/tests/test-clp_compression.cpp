@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/clp/clp/compression.hpp"
+#include "../src/clp/clp/FileToCompress.hpp"
+
+using clp::clp::FileToCompress;
+using clp::clp::partition_files_by_size;
+using std::string;
+using std::vector;
+
+namespace {
+constexpr char cTestDirPath[] = "unit-test-clp-compression";
+
+/**
+ * @param partition
+ * @return The total size of the files in the given partition
+ */
+auto get_partition_size(vector<FileToCompress> const& partition) -> size_t {
+    size_t size{0};
+    for (auto const& file : partition) {
+        size += std::filesystem::file_size(file.get_path());
+    }
+    return size;
+}
+}  // namespace
+
+TEST_CASE("Partition files by size", "[clp][compression]") {
+    std::filesystem::path const test_dir{cTestDirPath};
+    std::filesystem::create_directories(test_dir);
+
+    auto const create_files = [&](vector<size_t> const& file_sizes) {
+        vector<FileToCompress> files;
+        for (size_t i = 0; i < file_sizes.size(); ++i) {
+            auto const path = (test_dir / ("file" + std::to_string(i))).string();
+            std::ofstream{path} << string(file_sizes[i], 'x');
+            files.emplace_back(path, path, 0);
+        }
+        return files;
+    };
+    auto const get_paths = [](vector<FileToCompress> const& files) {
+        vector<string> paths;
+        for (auto const& file : files) {
+            paths.push_back(file.get_path());
+        }
+        return paths;
+    };
+
+    SECTION("Balance files by assigning the largest first") {
+        auto const files = create_files({10, 70, 20, 50, 40, 30, 60});
+        auto const partitions = partition_files_by_size(files, 3);
+        REQUIRE(3 == partitions.size());
+
+        // The three largest files start the partitions (70, 60, 50), then 40, 30, and 20 each go to
+        // the smallest partition (making them all 90), and 10 goes to the first of the tied
+        // partitions
+        vector<size_t> partition_sizes;
+        for (auto const& partition : partitions) {
+            partition_sizes.push_back(get_partition_size(partition));
+        }
+        REQUIRE(vector<size_t>{100, 90, 90} == partition_sizes);
+
+        // Each partition keeps the files' relative order
+        REQUIRE(vector<string>{files[0].get_path(), files[1].get_path(), files[2].get_path()}
+                == get_paths(partitions[0]));
+        REQUIRE(vector<string>{files[5].get_path(), files[6].get_path()}
+                == get_paths(partitions[1]));
+        REQUIRE(vector<string>{files[3].get_path(), files[4].get_path()}
+                == get_paths(partitions[2]));
+    }
+
+    SECTION("Assign every file exactly once") {
+        vector<size_t> file_sizes;
+        for (size_t i = 0; i < 50; ++i) {
+            file_sizes.push_back(i * 37 % 101);
+        }
+        auto const files = create_files(file_sizes);
+        for (size_t num_partitions : {1, 2, 7, 64}) {
+            INFO("num_partitions: " << num_partitions);
+            auto const partitions = partition_files_by_size(files, num_partitions);
+            REQUIRE(num_partitions == partitions.size());
+
+            vector<string> assigned_paths;
+            size_t max_partition_size{0};
+            size_t min_partition_size{SIZE_MAX};
+            for (auto const& partition : partitions) {
+                auto const paths = get_paths(partition);
+                vector<size_t> file_ixs;
+                for (auto const& path : paths) {
+                    file_ixs.push_back(std::stoul(path.substr(path.rfind("file") + 4)));
+                }
+                REQUIRE(std::is_sorted(file_ixs.begin(), file_ixs.end()));
+                assigned_paths.insert(assigned_paths.end(), paths.begin(), paths.end());
+                auto const partition_size = get_partition_size(partition);
+                max_partition_size = std::max(max_partition_size, partition_size);
+                min_partition_size = std::min(min_partition_size, partition_size);
+            }
+            auto expected_paths = get_paths(files);
+            std::sort(expected_paths.begin(), expected_paths.end());
+            std::sort(assigned_paths.begin(), assigned_paths.end());
+            REQUIRE(expected_paths == assigned_paths);
+
+            // With largest-first assignment, partitions differ by at most the largest file
+            REQUIRE(max_partition_size - min_partition_size
+                    <= *std::max_element(file_sizes.begin(), file_sizes.end()));
+        }
+    }
+
+    SECTION("Treat files that can't be read as empty") {
+        auto files = create_files({30, 20});
+        auto const missing_path = (test_dir / "missing").string();
+        files.emplace_back(missing_path, missing_path, 0);
+        auto const partitions = partition_files_by_size(files, 2);
+        REQUIRE(vector<string>{files[0].get_path()} == get_paths(partitions[0]));
+        REQUIRE(vector<string>{files[1].get_path(), missing_path} == get_paths(partitions[1]));
+    }
+
+    std::filesystem::remove_all(test_dir);
+}
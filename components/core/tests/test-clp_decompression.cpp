@@ -0,0 +1,206 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <Catch2/single_include/catch2/catch.hpp>
+#include <spdlog/spdlog.h>
+
+#include "../src/clp/clp/run.hpp"
+
+using std::string;
+using std::vector;
+
+namespace {
+constexpr char cTestDirPath[] = "unit-test-clp-decompression";
+
+/**
+ * Runs clp with the given arguments
+ * @param arguments
+ * @return clp's exit code
+ */
+auto run_clp(vector<string> const& arguments) -> int;
+
+/**
+ * Runs clp with the given arguments, redirecting its stdout to the given file
+ * @param arguments
+ * @param stdout_path
+ * @return clp's exit code
+ */
+auto run_clp_with_stdout(vector<string> const& arguments, string const& stdout_path) -> int;
+
+/**
+ * @param path
+ * @return The content of the given file
+ */
+auto read_file(std::filesystem::path const& path) -> string;
+
+/**
+ * @param dir
+ * @return A map from the path (relative to the given directory) of each file in the given
+ * directory to its content
+ */
+auto read_files(std::filesystem::path const& dir) -> std::map<string, string>;
+
+auto run_clp(vector<string> const& arguments) -> int {
+    vector<char const*> argv{"clp"};
+    for (auto const& argument : arguments) {
+        argv.push_back(argument.c_str());
+    }
+    argv.push_back(nullptr);
+    // clp creates its own logger
+    spdlog::drop("stderr");
+    return clp::clp::run(static_cast<int>(argv.size() - 1), argv.data());
+}
+
+auto run_clp_with_stdout(vector<string> const& arguments, string const& stdout_path) -> int {
+    std::fflush(stdout);
+    auto const stdout_fd = dup(STDOUT_FILENO);
+    REQUIRE(-1 != stdout_fd);
+    auto const output_fd = open(stdout_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    REQUIRE(-1 != output_fd);
+    REQUIRE(-1 != dup2(output_fd, STDOUT_FILENO));
+    close(output_fd);
+
+    auto const exit_code = run_clp(arguments);
+
+    std::fflush(stdout);
+    dup2(stdout_fd, STDOUT_FILENO);
+    close(stdout_fd);
+    return exit_code;
+}
+
+auto read_file(std::filesystem::path const& path) -> string {
+    std::ifstream file{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+auto read_files(std::filesystem::path const& dir) -> std::map<string, string> {
+    std::map<string, string> files;
+    for (auto const& entry : std::filesystem::recursive_directory_iterator{dir}) {
+        if (entry.is_regular_file()) {
+            files.emplace(
+                    std::filesystem::relative(entry.path(), dir).string(),
+                    read_file(entry.path())
+            );
+        }
+    }
+    return files;
+}
+}  // namespace
+
+TEST_CASE("Decompress in parallel and to stdout", "[clp][decompression]") {
+    std::filesystem::path const test_dir{cTestDirPath};
+    std::filesystem::remove_all(test_dir);
+    auto const input_dir = std::filesystem::absolute(test_dir / "input");
+    auto const archives_dir = test_dir / "archives";
+    std::filesystem::create_directories(input_dir / "nested");
+
+    // Files of varying sizes, so that with small targets, some are split across encoded files,
+    // segments, and archives, while others share a segment
+    vector<string> const file_names{"large.log", "medium.log", "small.log", "nested/small.log"};
+    vector<size_t> const file_num_lines{3000, 500, 20, 5};
+    for (size_t file_ix = 0; file_ix < file_names.size(); ++file_ix) {
+        std::ofstream file{input_dir / file_names[file_ix]};
+        for (size_t i = 0; i < file_num_lines[file_ix]; ++i) {
+            file << "2024-01-01 00:" << (i / 60 % 60) << ':' << (i % 60) << '.' << (i % 1000)
+                 << " INFO Task " << i * 7919 << " on host-" << (file_ix * 100 + i % 13)
+                 << " took " << (i % 17) << '.' << (i % 10) << " ms\n";
+        }
+        // A file that doesn't end with a newline
+        file << "Last line of " << file_names[file_ix];
+    }
+    auto const orig_files = read_files(input_dir);
+
+    REQUIRE(0
+            == run_clp(
+                    {"c",
+                     "--remove-path-prefix",
+                     input_dir.string(),
+                     "--target-encoded-file-size",
+                     "8192",
+                     "--target-segment-size",
+                     "32768",
+                     "--target-dictionaries-size",
+                     "16384",
+                     archives_dir.string(),
+                     input_dir.string()}
+            ));
+
+    auto const sequential_output_dir = test_dir / "sequential";
+    REQUIRE(0 == run_clp({"x", archives_dir.string(), sequential_output_dir.string()}));
+    auto const sequential_files = read_files(sequential_output_dir);
+    REQUIRE(orig_files == sequential_files);
+
+    SECTION("Parallel decompression") {
+        for (auto const num_threads : {"2", "3", "8"}) {
+            INFO("num_threads: " << num_threads);
+            auto const parallel_output_dir = test_dir / (string{"parallel-"} + num_threads);
+            REQUIRE(0
+                    == run_clp(
+                            {"x",
+                             "--num-threads",
+                             num_threads,
+                             archives_dir.string(),
+                             parallel_output_dir.string()}
+                    ));
+            REQUIRE(sequential_files == read_files(parallel_output_dir));
+        }
+
+        // A single file spanning several archives
+        auto const parallel_output_dir = test_dir / "parallel-single-file";
+        REQUIRE(0
+                == run_clp(
+                        {"x",
+                         "--num-threads",
+                         "4",
+                         archives_dir.string(),
+                         parallel_output_dir.string(),
+                         "/large.log"}
+                ));
+        REQUIRE(std::map<string, string>{{"large.log", sequential_files.at("large.log")}}
+                == read_files(parallel_output_dir));
+    }
+
+    SECTION("Decompression to stdout") {
+        auto const stdout_path = (test_dir / "stdout").string();
+        for (auto const& file_name : file_names) {
+            INFO("file_name: " << file_name);
+            REQUIRE(0
+                    == run_clp_with_stdout(
+                            {"x", archives_dir.string(), "-", "/" + file_name},
+                            stdout_path
+                    ));
+            REQUIRE(sequential_files.at(file_name) == read_file(stdout_path));
+        }
+
+        // Decompressing several files to stdout concatenates them
+        REQUIRE(0
+                == run_clp_with_stdout(
+                        {"x", archives_dir.string(), "-", "/small.log", "/nested/small.log"},
+                        stdout_path
+                ));
+        auto const stdout_content = read_file(stdout_path);
+        auto const& small_content = sequential_files.at("small.log");
+        auto const& nested_small_content = sequential_files.at("nested/small.log");
+        REQUIRE(small_content.size() + nested_small_content.size() == stdout_content.size());
+        REQUIRE((small_content + nested_small_content == stdout_content
+                 || nested_small_content + small_content == stdout_content));
+
+        // Only one thread can write to stdout
+        REQUIRE(0
+                != run_clp_with_stdout(
+                        {"x", "--num-threads", "2", archives_dir.string(), "-", "/small.log"},
+                        stdout_path
+                ));
+    }
+
+    std::filesystem::remove_all(test_dir);
+}
@@ -3,12 +3,14 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <utility>
 #include <vector>
 
 #include <Catch2/single_include/catch2/catch.hpp>
 #include <json/single_include/nlohmann/json.hpp>
 #include <msgpack.hpp>
+#include <simdjson.h>
 
 #include "../src/clp/BufferReader.hpp"
 #include "../src/clp/ErrorCode.hpp"
@@ -152,6 +154,19 @@ template <typename encoded_variable_t>
         Serializer<encoded_variable_t>& serializer
 ) -> bool;
 
+/**
+ * Parses and serializes the given JSON object string using kv serializer.
+ * @tparam encoded_variable_t
+ * @param json_str
+ * @param serializer
+ * @return Whether serialization succeeded.
+ */
+template <typename encoded_variable_t>
+[[nodiscard]] auto parse_and_serialize_json_str(
+        string_view json_str,
+        Serializer<encoded_variable_t>& serializer
+) -> bool;
+
 /**
  * Counts the number of leaves in a JSON tree. A node is considered as a leaf if it's a primitive
  * value, an empty map (`{}`), or an array.
@@ -286,6 +301,23 @@ auto unpack_and_serialize_msgpack_bytes(
     return serializer.serialize_msgpack_map(msgpack_obj.via.map);
 }
 
+template <typename encoded_variable_t>
+auto parse_and_serialize_json_str(
+        string_view json_str,
+        Serializer<encoded_variable_t>& serializer
+) -> bool {
+    simdjson::padded_string const padded_json_str{json_str};
+    simdjson::ondemand::parser parser;
+    simdjson::ondemand::document doc;
+    simdjson::ondemand::object json_obj;
+    if (simdjson::SUCCESS != parser.iterate(padded_json_str).get(doc)
+        || simdjson::SUCCESS != doc.get_object().get(json_obj))
+    {
+        return false;
+    }
+    return serializer.serialize_json_object(json_obj);
+}
+
 // NOLINTNEXTLINE(misc-no-recursion)
 auto count_num_leaves(nlohmann::json const& root) -> size_t {
     if (false == root.is_object()) {
@@ -1144,3 +1176,108 @@ TEMPLATE_TEST_CASE(
         REQUIRE((json_obj == serialized_json_result.value()));
     }
 }
+
+TEMPLATE_TEST_CASE(
+        "ffi_ir_stream_Serializer_serialize_json",
+        "[clp][ffi][ir_stream][Serializer]",
+        four_byte_encoded_variable_t,
+        eight_byte_encoded_variable_t
+) {
+    vector<int8_t> ir_buf;
+    vector<nlohmann::json> serialized_json_objects;
+
+    auto result{Serializer<TestType>::create()};
+    REQUIRE((false == result.has_error()));
+
+    auto& serializer{result.value()};
+    flush_and_clear_serializer_buffer(serializer, ir_buf);
+
+    auto const empty_obj = nlohmann::json::parse("{}");
+    REQUIRE(parse_and_serialize_json_str(empty_obj.dump(), serializer));
+    serialized_json_objects.emplace_back(empty_obj);
+
+    // Test encoding basic object
+    constexpr string_view cShortString{"short_string"};
+    constexpr string_view cClpString{"uid=0, CPU usage: 99.99%, \"user_name\"=YScope"};
+    auto const empty_array = nlohmann::json::parse("[]");
+    nlohmann::json const basic_obj
+            = {{"int8_max", INT8_MAX},
+               {"int8_min", INT8_MIN},
+               {"int16_max", INT16_MAX},
+               {"int16_min", INT16_MIN},
+               {"int32_max", INT32_MAX},
+               {"int32_min", INT32_MIN},
+               {"int64_max", INT64_MAX},
+               {"int64_min", INT64_MIN},
+               {"float_zero", 0.0},
+               {"float_pos", 1.01},
+               {"float_neg", -1.01},
+               {"true", true},
+               {"false", false},
+               {"string", cShortString},
+               {"clp_string", cClpString},
+               {"null", nullptr},
+               {"empty_object", empty_obj},
+               {"empty_array", empty_array}};
+
+    REQUIRE(parse_and_serialize_json_str(basic_obj.dump(), serializer));
+    serialized_json_objects.emplace_back(basic_obj);
+
+    // Integers that don't fit in an `int64_t` should not be serializable, and the failure shouldn't
+    // affect the serialization of later objects
+    auto uint64_obj = basic_obj;
+    uint64_obj.emplace("uint64_max", UINT64_MAX);
+    REQUIRE((false == parse_and_serialize_json_str(uint64_obj.dump(), serializer)));
+
+    auto basic_array = empty_array;
+    basic_array.emplace_back(1);
+    basic_array.emplace_back(1.0);
+    basic_array.emplace_back(true);
+    basic_array.emplace_back(cShortString);
+    basic_array.emplace_back(cClpString);
+    basic_array.emplace_back(nullptr);
+    basic_array.emplace_back(empty_array);
+    basic_array.emplace_back(empty_obj);
+
+    // Recursively construct an object containing inner objects and inner arrays, and serialize it
+    // both compactly and with whitespace between tokens.
+    auto recursive_obj = basic_obj;
+    auto recursive_array = basic_array;
+    constexpr size_t cRecursiveDepth{6};
+    constexpr int cIndent{4};
+    for (size_t i{0}; i < cRecursiveDepth; ++i) {
+        recursive_array.emplace_back(recursive_obj);
+        recursive_obj.emplace("obj_" + std::to_string(i), recursive_obj);
+        recursive_obj.emplace("array_" + std::to_string(i), recursive_array);
+        REQUIRE(parse_and_serialize_json_str(recursive_obj.dump(), serializer));
+        serialized_json_objects.emplace_back(recursive_obj);
+        REQUIRE(parse_and_serialize_json_str(recursive_obj.dump(cIndent), serializer));
+        serialized_json_objects.emplace_back(recursive_obj);
+    }
+
+    flush_and_clear_serializer_buffer(serializer, ir_buf);
+    ir_buf.push_back(clp::ffi::ir_stream::cProtocol::Eof);
+
+    // Deserialize the results
+    BufferReader reader{size_checked_pointer_cast<char>(ir_buf.data()), ir_buf.size()};
+    auto deserializer_result = Deserializer::create(reader);
+    REQUIRE_FALSE(deserializer_result.has_error());
+    auto& deserializer = deserializer_result.value();
+
+    for (auto const& json_obj : serialized_json_objects) {
+        auto const kv_log_event_result = deserializer.deserialize_to_next_log_event(reader);
+        REQUIRE_FALSE(kv_log_event_result.has_error());
+
+        auto const& kv_log_event = kv_log_event_result.value();
+        auto const num_leaves_in_json_obj = count_num_leaves(json_obj);
+        auto const num_kv_pairs = kv_log_event.get_node_id_value_pairs().size();
+        REQUIRE((num_leaves_in_json_obj == num_kv_pairs));
+
+        auto const serialized_json_result = kv_log_event.serialize_to_json();
+        REQUIRE_FALSE(serialized_json_result.has_error());
+        REQUIRE((json_obj == serialized_json_result.value()));
+    }
+
+    auto const eof_result = deserializer.deserialize_to_next_log_event(reader);
+    REQUIRE((eof_result.has_error() && std::errc::no_message_available == eof_result.error()));
+}
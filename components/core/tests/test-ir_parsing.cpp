@@ -100,3 +100,31 @@ TEST_CASE("ir::get_bounds_of_next_var", "[ir][get_bounds_of_next_var]") {
     REQUIRE(get_bounds_of_next_var(str, begin_pos, end_pos) == true);
     REQUIRE("var123" == str.substr(begin_pos, end_pos - begin_pos));
 }
+
+TEST_CASE(
+        "ir::get_bounds_of_next_var with tokens spanning multiple blocks",
+        "[ir][get_bounds_of_next_var]"
+) {
+    // Runs of delimiters and tokens longer than the tokenizer's (SIMD) block size
+    string const long_delims(70, ' ');
+    string const long_non_var(70, 'x');
+    string const long_var = long_non_var + "1" + long_non_var;
+    string const long_hex_var(70, 'f');
+    string const str = long_delims + long_non_var + long_delims + long_var + "=" + long_non_var
+                       + long_delims + long_hex_var + "\x80" + long_non_var;
+
+    size_t begin_pos = 0;
+    size_t end_pos = 0;
+
+    REQUIRE(get_bounds_of_next_var(str, begin_pos, end_pos) == true);
+    REQUIRE(long_var == str.substr(begin_pos, end_pos - begin_pos));
+
+    REQUIRE(get_bounds_of_next_var(str, begin_pos, end_pos) == true);
+    REQUIRE(long_non_var == str.substr(begin_pos, end_pos - begin_pos));
+
+    REQUIRE(get_bounds_of_next_var(str, begin_pos, end_pos) == true);
+    REQUIRE(long_hex_var == str.substr(begin_pos, end_pos - begin_pos));
+
+    REQUIRE(get_bounds_of_next_var(str, begin_pos, end_pos) == false);
+    REQUIRE(str.length() == begin_pos);
+}
@@ -1,30 +1,54 @@
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <numeric>
+#include <span>
 #include <string>
+#include <system_error>
 #include <vector>
 
 #include <Catch2/single_include/catch2/catch.hpp>
 
+#include "../src/clp/BufferWriter.hpp"
+#include "../src/clp/ErrorCode.hpp"
 #include "../src/clp/ffi/ir_stream/decoding_methods.hpp"
+#include "../src/clp/ffi/ir_stream/LogEventBatch.hpp"
+#include "../src/clp/ffi/ir_stream/LogEventBatchDeserializer.hpp"
+#include "../src/clp/FileReader.hpp"
 #include "../src/clp/ir/constants.hpp"
+#include "../src/clp/ir/EncodedTextAst.hpp"
 #include "../src/clp/ir/LogEventDeserializer.hpp"
+#include "../src/clp/ir/LogEventPrefetcher.hpp"
 #include "../src/clp/ir/LogEventSerializer.hpp"
+#include "../src/clp/ir/SeekIndex.hpp"
 #include "../src/clp/ir/types.hpp"
 #include "../src/clp/streaming_compression/zstd/Decompressor.hpp"
 
+using clp::BufferWriter;
+using clp::ErrorCode_Success;
+using clp::ffi::ir_stream::IRErrorCode::IRErrorCode_Eof;
+using clp::ffi::ir_stream::IRErrorCode::IRErrorCode_Incomplete_IR;
 using clp::ffi::ir_stream::IRErrorCode::IRErrorCode_Success;
+using clp::ffi::ir_stream::LogEventBatch;
+using clp::ffi::ir_stream::LogEventBatchDeserializer;
+using clp::FileReader;
 using clp::ir::cIrFileExtension;
+using clp::ir::cSeekIndexFileExtension;
 using clp::ir::eight_byte_encoded_variable_t;
+using clp::ir::EncodedTextAst;
 using clp::ir::epoch_time_ms_t;
 using clp::ir::four_byte_encoded_variable_t;
 using clp::ir::LogEventDeserializer;
+using clp::ir::LogEventPrefetcher;
 using clp::ir::LogEventSerializer;
+using clp::ir::SeekIndex;
 using clp::streaming_compression::zstd::Decompressor;
 using std::chrono::milliseconds;
 using std::chrono::system_clock;
 using std::is_same_v;
+using std::span;
 using std::string;
 using std::vector;
 
@@ -118,3 +142,390 @@ TEMPLATE_TEST_CASE(
 
     std::filesystem::remove(ir_test_file);
 }
+
+TEMPLATE_TEST_CASE(
+        "Resume deserialization from a seek index checkpoint",
+        "[ir][seek-index]",
+        four_byte_encoded_variable_t,
+        eight_byte_encoded_variable_t
+) {
+    constexpr size_t cNumLogEvents{1000};
+    constexpr size_t cCheckpointInterval{64};
+    constexpr epoch_time_ms_t cFirstTimestamp{1'700'000'000'000};
+    constexpr size_t cTargetLogEventIx{700};
+
+    vector<TestLogEvent> test_log_events;
+    for (size_t i = 0; i < cNumLogEvents; ++i) {
+        test_log_events.push_back(
+                {cFirstTimestamp + static_cast<epoch_time_ms_t>(i) * 10,
+                 "Log event " + std::to_string(i) + " with value " + std::to_string(i * 3) + "\n"}
+        );
+    }
+
+    string ir_test_file = "ir_seek_index_test";
+    ir_test_file += cIrFileExtension;
+    auto seek_index_file = ir_test_file;
+    seek_index_file += cSeekIndexFileExtension;
+
+    LogEventSerializer<TestType> serializer;
+    REQUIRE(serializer.open(ir_test_file, cCheckpointInterval));
+    for (auto const& test_log_event : test_log_events) {
+        REQUIRE(serializer.serialize_log_event(test_log_event.timestamp, test_log_event.msg));
+    }
+    serializer.close();
+
+    auto const seek_index = SeekIndex::read_from_file(seek_index_file);
+    REQUIRE((is_same_v<TestType, four_byte_encoded_variable_t>
+             == seek_index.uses_four_byte_encoding()));
+    REQUIRE((seek_index.get_checkpoints().size()
+             == (cNumLogEvents + cCheckpointInterval - 1) / cCheckpointInterval));
+
+    auto const checkpoint = seek_index.get_checkpoint_for_log_event_ix(cTargetLogEventIx);
+    REQUIRE(checkpoint.has_value());
+    REQUIRE((checkpoint->log_event_ix <= cTargetLogEventIx));
+    REQUIRE((cTargetLogEventIx < checkpoint->log_event_ix + cCheckpointInterval));
+
+    auto const checkpoint_for_timestamp = seek_index.get_checkpoint_for_timestamp(
+            test_log_events[cTargetLogEventIx].timestamp
+    );
+    REQUIRE(checkpoint_for_timestamp.has_value());
+    REQUIRE((checkpoint_for_timestamp->log_event_ix == checkpoint->log_event_ix));
+
+    // Start decompressing at the checkpoint without reading anything before it
+    FileReader file_reader{ir_test_file};
+    file_reader.seek_from_begin(checkpoint->compressed_pos);
+    Decompressor ir_reader;
+    ir_reader.open(file_reader, 4096);
+
+    auto result = LogEventDeserializer<TestType>::create_from_checkpoint(
+            ir_reader,
+            seek_index,
+            *checkpoint
+    );
+    REQUIRE((false == result.has_error()));
+    auto& deserializer = result.value();
+
+    for (size_t i = checkpoint->log_event_ix; i < cNumLogEvents; ++i) {
+        auto deserialized_result = deserializer.deserialize_log_event();
+        REQUIRE((false == deserialized_result.has_error()));
+
+        auto& log_event = deserialized_result.value();
+        auto const decoded_message = log_event.get_message().decode_and_unparse();
+        REQUIRE(decoded_message.has_value());
+        REQUIRE((decoded_message.value() == test_log_events[i].msg));
+        REQUIRE((log_event.get_timestamp() == test_log_events[i].timestamp));
+    }
+    REQUIRE(deserializer.deserialize_log_event().has_error());
+    ir_reader.close();
+
+    std::filesystem::remove(ir_test_file);
+    std::filesystem::remove(seek_index_file);
+}
+
+TEMPLATE_TEST_CASE(
+        "Deserialize log events in batches",
+        "[ir][deserialize-log-event-batch]",
+        four_byte_encoded_variable_t,
+        eight_byte_encoded_variable_t
+) {
+    constexpr size_t cNumLogEvents{1000};
+    constexpr size_t cBatchSize{7};
+    constexpr epoch_time_ms_t cFirstTimestamp{1'700'000'000'000};
+
+    vector<TestLogEvent> test_log_events;
+    for (size_t i = 0; i < cNumLogEvents; ++i) {
+        test_log_events.push_back(
+                {cFirstTimestamp + static_cast<epoch_time_ms_t>(i * i),
+                 "Log event " + std::to_string(i) + " from user" + std::to_string(i % 17)
+                         + " took " + std::to_string(i) + ".5 ms\n"}
+        );
+    }
+
+    string ir_test_file = "ir_batch_deserializer_test";
+    ir_test_file += cIrFileExtension;
+
+    LogEventSerializer<TestType> serializer;
+    REQUIRE(serializer.open(ir_test_file));
+    for (auto const& test_log_event : test_log_events) {
+        REQUIRE(serializer.serialize_log_event(test_log_event.timestamp, test_log_event.msg));
+    }
+    serializer.close();
+
+    // Decompress the entire stream into memory
+    Decompressor ir_reader;
+    REQUIRE((ErrorCode_Success == ir_reader.open(ir_test_file)));
+    string ir_buf;
+    char read_buf[4096];
+    size_t num_bytes_read{0};
+    while (ErrorCode_Success == ir_reader.try_read(read_buf, sizeof(read_buf), num_bytes_read)) {
+        ir_buf.append(read_buf, num_bytes_read);
+    }
+    ir_reader.close();
+    std::filesystem::remove(ir_test_file);
+
+    // Deserializes log events from the given deserializer until it returns an error, checking that
+    // they match the test log events starting at the given index
+    auto const deserialize_and_check = [&](LogEventBatchDeserializer<TestType>& deserializer,
+                                           size_t& log_event_ix) {
+        LogEventBatch<TestType> batch;
+        auto error_code = IRErrorCode_Success;
+        while (IRErrorCode_Success == error_code) {
+            error_code = deserializer.deserialize_log_events(cBatchSize, batch);
+            for (size_t i = 0; i < batch.size(); ++i, ++log_event_ix) {
+                REQUIRE((log_event_ix < cNumLogEvents));
+                REQUIRE((batch.get_timestamps()[i] == test_log_events[log_event_ix].timestamp));
+
+                auto const encoded_vars = batch.get_encoded_vars(i);
+                auto const dict_vars = batch.get_dict_vars(i);
+                EncodedTextAst<TestType> const encoded_text_ast{
+                        string{batch.get_logtypes()[i]},
+                        {dict_vars.begin(), dict_vars.end()},
+                        {encoded_vars.begin(), encoded_vars.end()}
+                };
+                auto const decoded_message = encoded_text_ast.decode_and_unparse();
+                REQUIRE(decoded_message.has_value());
+                REQUIRE((decoded_message.value() == test_log_events[log_event_ix].msg));
+            }
+        }
+        return error_code;
+    };
+
+    // The deserializer skips the preamble and reads the reference timestamp from it
+    span<char const> const ir_span{ir_buf};
+    auto result = LogEventBatchDeserializer<TestType>::create(ir_span);
+    REQUIRE((false == result.has_error()));
+    auto& deserializer = result.value();
+    auto const log_events_pos = deserializer.get_pos();
+    REQUIRE((log_events_pos > 0));
+
+    size_t log_event_ix{0};
+    REQUIRE((IRErrorCode_Eof == deserialize_and_check(deserializer, log_event_ix)));
+    REQUIRE((cNumLogEvents == log_event_ix));
+    REQUIRE((ir_span.size() == deserializer.get_pos()));
+
+    // Find where each log event starts
+    vector<size_t> log_event_positions;
+    auto positions_result = LogEventBatchDeserializer<TestType>::create(ir_span);
+    REQUIRE((false == positions_result.has_error()));
+    auto& positions_deserializer = positions_result.value();
+    LogEventBatch<TestType> batch;
+    do {
+        log_event_positions.push_back(positions_deserializer.get_pos());
+    } while (IRErrorCode_Success == positions_deserializer.deserialize_log_events(1, batch));
+    // The last position is the end-of-stream tag's
+    REQUIRE((cNumLogEvents + 1 == log_event_positions.size()));
+    REQUIRE((log_events_pos == log_event_positions.front()));
+
+    SECTION("Resume after a buffer ends in the middle of a log event") {
+        constexpr size_t cCutLogEventIx{cNumLogEvents / 2};
+        auto const log_event_pos = log_event_positions[cCutLogEventIx];
+        auto const next_log_event_pos = log_event_positions[cCutLogEventIx + 1];
+        for (auto const cut_pos :
+             {log_event_pos,
+              log_event_pos + 1,
+              (log_event_pos + next_log_event_pos) / 2,
+              next_log_event_pos - 1})
+        {
+            INFO("cut_pos: " << cut_pos - log_event_pos << " bytes into the log event");
+            auto cut_result = LogEventBatchDeserializer<TestType>::create(ir_span.first(cut_pos));
+            REQUIRE((false == cut_result.has_error()));
+            auto& cut_deserializer = cut_result.value();
+
+            // The deserializer should stop at the incomplete log event's tag
+            size_t cut_log_event_ix{0};
+            REQUIRE((IRErrorCode_Incomplete_IR
+                     == deserialize_and_check(cut_deserializer, cut_log_event_ix)));
+            REQUIRE((cCutLogEventIx == cut_log_event_ix));
+            REQUIRE((log_event_pos == cut_deserializer.get_pos()));
+
+            // Retrying without more data should fail the same way
+            REQUIRE((IRErrorCode_Incomplete_IR
+                     == cut_deserializer.deserialize_log_events(cBatchSize, batch)));
+            REQUIRE(batch.empty());
+            REQUIRE((log_event_pos == cut_deserializer.get_pos()));
+
+            // With the rest of the stream, the deserializer should resume from the incomplete log
+            // event
+            cut_deserializer.extend_buf(ir_span);
+            REQUIRE((IRErrorCode_Eof == deserialize_and_check(cut_deserializer, cut_log_event_ix)));
+            REQUIRE((cNumLogEvents == cut_log_event_ix));
+            REQUIRE((ir_span.size() == cut_deserializer.get_pos()));
+        }
+    }
+
+    SECTION("Reject incomplete or mismatched preambles") {
+        auto const incomplete_result
+                = LogEventBatchDeserializer<TestType>::create(ir_span.first(log_events_pos - 1));
+        REQUIRE(incomplete_result.has_error());
+        REQUIRE((std::errc::result_out_of_range == incomplete_result.error()));
+
+        if constexpr (is_same_v<TestType, four_byte_encoded_variable_t>) {
+            auto const mismatched_result
+                    = LogEventBatchDeserializer<eight_byte_encoded_variable_t>::create(ir_span);
+            REQUIRE(mismatched_result.has_error());
+            REQUIRE((std::errc::protocol_not_supported == mismatched_result.error()));
+        } else {
+            auto const mismatched_result
+                    = LogEventBatchDeserializer<four_byte_encoded_variable_t>::create(ir_span);
+            REQUIRE(mismatched_result.has_error());
+            REQUIRE((std::errc::protocol_not_supported == mismatched_result.error()));
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE(
+        "Prefetch log events in batches",
+        "[ir][prefetch-log-events]",
+        four_byte_encoded_variable_t,
+        eight_byte_encoded_variable_t
+) {
+    constexpr size_t cNumLogEvents{1000};
+    constexpr size_t cBatchSize{7};
+    constexpr size_t cMaxNumBufferedBatches{2};
+    constexpr epoch_time_ms_t cFirstTimestamp{1'700'000'000'000};
+
+    vector<TestLogEvent> test_log_events;
+    for (size_t i = 0; i < cNumLogEvents; ++i) {
+        test_log_events.push_back(
+                {cFirstTimestamp + static_cast<epoch_time_ms_t>(i) * 3,
+                 "Log event " + std::to_string(i) + " from user" + std::to_string(i % 17) + "\n"}
+        );
+    }
+
+    string ir_test_file = "ir_prefetcher_test";
+    ir_test_file += cIrFileExtension;
+
+    LogEventSerializer<TestType> serializer;
+    REQUIRE(serializer.open(ir_test_file));
+    for (auto const& test_log_event : test_log_events) {
+        REQUIRE(serializer.serialize_log_event(test_log_event.timestamp, test_log_event.msg));
+    }
+    serializer.close();
+
+    Decompressor ir_reader;
+    REQUIRE((ErrorCode_Success == ir_reader.open(ir_test_file)));
+    bool uses_four_byte_encoding{false};
+    REQUIRE(
+            (IRErrorCode_Success
+             == clp::ffi::ir_stream::get_encoding_type(ir_reader, uses_four_byte_encoding))
+    );
+    auto result = LogEventDeserializer<TestType>::create(ir_reader);
+    REQUIRE((false == result.has_error()));
+
+    size_t log_event_ix{0};
+    {
+        LogEventPrefetcher<TestType> prefetcher{
+                result.value(),
+                cBatchSize,
+                cMaxNumBufferedBatches
+        };
+        while (true) {
+            auto batch_result = prefetcher.take_batch();
+            if (batch_result.has_error()) {
+                REQUIRE((std::errc::no_message_available == batch_result.error()));
+                break;
+            }
+            auto const& batch = batch_result.value();
+            REQUIRE((false == batch.empty()));
+            REQUIRE((batch.size() <= cBatchSize));
+            for (auto const& log_event : batch) {
+                REQUIRE((log_event_ix < cNumLogEvents));
+                REQUIRE((log_event.get_timestamp() == test_log_events[log_event_ix].timestamp));
+                auto const decoded_message = log_event.get_message().decode_and_unparse();
+                REQUIRE(decoded_message.has_value());
+                REQUIRE((decoded_message.value() == test_log_events[log_event_ix].msg));
+                ++log_event_ix;
+            }
+        }
+    }
+    REQUIRE((cNumLogEvents == log_event_ix));
+
+    ir_reader.close();
+
+    // Destroying a prefetcher before taking every batch should stop it
+    {
+        Decompressor stopped_ir_reader;
+        REQUIRE((ErrorCode_Success == stopped_ir_reader.open(ir_test_file)));
+        REQUIRE(
+                (IRErrorCode_Success
+                 == clp::ffi::ir_stream::get_encoding_type(
+                         stopped_ir_reader,
+                         uses_four_byte_encoding
+                 ))
+        );
+        auto stopped_result = LogEventDeserializer<TestType>::create(stopped_ir_reader);
+        REQUIRE((false == stopped_result.has_error()));
+        LogEventPrefetcher<TestType> prefetcher{
+                stopped_result.value(),
+                cBatchSize,
+                cMaxNumBufferedBatches
+        };
+        REQUIRE((false == prefetcher.take_batch().has_error()));
+    }
+
+    std::filesystem::remove(ir_test_file);
+}
+
+TEMPLATE_TEST_CASE(
+        "Serialize log events into an in-memory buffer",
+        "[ir][serialize-log-event]",
+        four_byte_encoded_variable_t,
+        eight_byte_encoded_variable_t
+) {
+    constexpr size_t cNumLogEvents{300};
+    constexpr size_t cCheckpointInterval{64};
+    constexpr epoch_time_ms_t cFirstTimestamp{1'700'000'000'000};
+
+    vector<TestLogEvent> test_log_events;
+    for (size_t i = 0; i < cNumLogEvents; ++i) {
+        test_log_events.push_back(
+                {cFirstTimestamp + static_cast<epoch_time_ms_t>(i) * 5,
+                 "Log event " + std::to_string(i) + " took " + std::to_string(i) + ".25 ms\n"}
+        );
+    }
+
+    string ir_test_file = "ir_buffer_serializer_test";
+    ir_test_file += cIrFileExtension;
+    auto seek_index_file = ir_test_file;
+    seek_index_file += cSeekIndexFileExtension;
+
+    LogEventSerializer<TestType> file_serializer;
+    REQUIRE(file_serializer.open(ir_test_file, cCheckpointInterval));
+    BufferWriter buffer_writer;
+    LogEventSerializer<TestType> buffer_serializer;
+    REQUIRE(buffer_serializer.open(buffer_writer, cCheckpointInterval));
+    for (auto const& test_log_event : test_log_events) {
+        REQUIRE(file_serializer.serialize_log_event(test_log_event.timestamp, test_log_event.msg));
+        REQUIRE(buffer_serializer.serialize_log_event(test_log_event.timestamp, test_log_event.msg)
+        );
+    }
+    file_serializer.close();
+    buffer_serializer.close();
+
+    // The buffer should contain exactly what was written to the file
+    auto const ir_buf = buffer_writer.get_buffer();
+    REQUIRE((std::filesystem::file_size(ir_test_file) == ir_buf.size()));
+    FileReader file_reader{ir_test_file};
+    vector<char> file_content(ir_buf.size());
+    size_t num_bytes_read{0};
+    REQUIRE((ErrorCode_Success
+             == file_reader.try_read(file_content.data(), file_content.size(), num_bytes_read)));
+    REQUIRE((file_content.size() == num_bytes_read));
+    REQUIRE(std::equal(file_content.cbegin(), file_content.cend(), ir_buf.begin()));
+
+    // The seek index should be kept in memory rather than being written to a file
+    auto const& seek_index = buffer_serializer.get_seek_index();
+    REQUIRE(seek_index.has_value());
+    auto const file_seek_index = SeekIndex::read_from_file(seek_index_file);
+    REQUIRE((file_seek_index.get_checkpoints().size() == seek_index->get_checkpoints().size()));
+    for (size_t i = 0; i < seek_index->get_checkpoints().size(); ++i) {
+        auto const& checkpoint = seek_index->get_checkpoints()[i];
+        auto const& file_checkpoint = file_seek_index.get_checkpoints()[i];
+        REQUIRE((file_checkpoint.log_event_ix == checkpoint.log_event_ix));
+        REQUIRE((file_checkpoint.compressed_pos == checkpoint.compressed_pos));
+        REQUIRE((file_checkpoint.uncompressed_pos == checkpoint.uncompressed_pos));
+    }
+
+    std::filesystem::remove(ir_test_file);
+    std::filesystem::remove(seek_index_file);
+}
@@ -1,20 +1,28 @@
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
 #include <unordered_map>
 
 #include <Catch2/single_include/catch2/catch.hpp>
+#include <string_utils/string_utils.hpp>
 
 #include "../src/clp/ffi/encoding_methods.hpp"
+#include "../src/clp/ffi/search/EncodedTextAstMatcher.hpp"
 #include "../src/clp/ffi/search/ExactVariableToken.hpp"
 #include "../src/clp/ffi/search/query_methods.hpp"
 #include "../src/clp/ffi/search/QueryMethodFailed.hpp"
 #include "../src/clp/ffi/search/WildcardToken.hpp"
+#include "../src/clp/ir/EncodedTextAst.hpp"
 #include "../src/clp/ir/types.hpp"
 
 using clp::enum_to_underlying_type;
+using clp::ffi::search::EncodedTextAstMatcher;
 using clp::ffi::search::ExactVariableToken;
 using clp::ffi::search::generate_subqueries;
 using clp::ffi::search::Subquery;
 using clp::ffi::search::TokenType;
 using clp::ffi::search::WildcardToken;
+using clp::ir::EncodedTextAst;
 using clp::ir::eight_byte_encoded_variable_t;
 using clp::ir::four_byte_encoded_variable_t;
 using clp::ir::VariablePlaceholder;
@@ -931,3 +939,74 @@ TEMPLATE_TEST_CASE(
         test_generating_subqueries<TestType>(wildcard_query, logtype_query_to_expected_subquery);
     }
 }
+
+TEMPLATE_TEST_CASE(
+        "clp::ffi::search::EncodedTextAstMatcher",
+        "[ffi][search][EncodedTextAstMatcher]",
+        eight_byte_encoded_variable_t,
+        four_byte_encoded_variable_t
+) {
+    vector<string> const messages
+            = {"Task task_1234 completed in 0.25 seconds",
+               "Task task_1235 failed after 3 retries with error code -17",
+               "Connected to 10.0.0.1:8080 as user=admin",
+               "Connected to 10.0.0.2:8080 as user=guest",
+               "Disk usage at 97.5 percent on /dev/sda1",
+               "Static message without variables",
+               "Escaped \\ backslash and * star with value 42",
+               "a*b",
+               "a?b",
+               "a\\b"};
+    vector<string> const queries
+            = {"Task task_1234 completed in 0.25 seconds",
+               "Task task_1234 completed in 0.26 seconds",
+               "*task_123*",
+               "*failed*",
+               "* 3 retries*",
+               "*code -17",
+               "*user=admin",
+               "*user=*",
+               "Connected to 10.0.0.? *",
+               "*8080*",
+               "Disk usage at 9?.5 percent*",
+               "*percent on /dev/sd*",
+               "Static message without variables",
+               "Static message*",
+               "*\\\\ backslash and \\* star*",
+               "*value 4?",
+               "*",
+               "*0.25*",
+               "*1?34*",
+               "Escaped \\\\ backslash and \\* star with value 42",
+               "Escaped \\\\ backslash and \\* star with value 4?",
+               "a\\*b",
+               "a\\?b",
+               "a\\\\b",
+               "a?b"};
+
+    vector<EncodedTextAst<TestType>> encoded_messages;
+    for (auto const& message : messages) {
+        string logtype;
+        vector<TestType> encoded_vars;
+        vector<int32_t> dict_var_bounds;
+        REQUIRE(clp::ffi::encode_message(message, logtype, encoded_vars, dict_var_bounds));
+        vector<string> dict_vars;
+        for (size_t i = 0; i < dict_var_bounds.size(); i += 2) {
+            dict_vars.emplace_back(
+                    message,
+                    dict_var_bounds[i],
+                    dict_var_bounds[i + 1] - dict_var_bounds[i]
+            );
+        }
+        encoded_messages.emplace_back(logtype, dict_vars, encoded_vars);
+    }
+
+    for (auto const& query : queries) {
+        EncodedTextAstMatcher<TestType> const matcher{query};
+        for (size_t i = 0; i < messages.size(); ++i) {
+            INFO("query: \"" << query << "\", message: \"" << messages[i] << "\"");
+            REQUIRE((matcher.matches(encoded_messages[i])
+                     == clp::string_utils::wildcard_match_unsafe(messages[i], query)));
+        }
+    }
+}
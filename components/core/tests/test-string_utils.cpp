@@ -4,11 +4,13 @@
 #include <boost/range/combine.hpp>
 #include <Catch2/single_include/catch2/catch.hpp>
 #include <string_utils/string_utils.hpp>
+#include <string_utils/WildcardMatcher.hpp>
 
 using clp::string_utils::clean_up_wildcard_search_string;
 using clp::string_utils::convert_string_to_int;
 using clp::string_utils::wildcard_match_unsafe;
 using clp::string_utils::wildcard_match_unsafe_case_sensitive;
+using clp::string_utils::WildcardMatcher;
 using std::chrono::duration;
 using std::chrono::high_resolution_clock;
 using std::cout;
@@ -277,6 +279,11 @@ SCENARIO("Test case sensitive wild card match in all possible ways", "[wildcard]
             REQUIRE(wildcard_match_unsafe_case_sensitive(tameString, wildString) == true);
         }
 
+        GIVEN("Matching \"?\" after an escaped character") {
+            tameString = "a*cd", wildString = "a\\*c?";
+            REQUIRE(wildcard_match_unsafe_case_sensitive(tameString, wildString) == true);
+        }
+
         GIVEN("Silently ignore unsupported escape sequence \\a") {
             tameString = "ab?d", wildString = "\\ab?d";
             REQUIRE(wildcard_match_unsafe_case_sensitive(tameString, wildString) == true);
@@ -514,6 +521,61 @@ SCENARIO("Test wild card performance", "[wildcard performance]") {
     }
 }
 
+TEST_CASE("WildcardMatcher", "[wildcard]") {
+    vector<string> const tame_strings{
+            "",
+            "a",
+            "abcd",
+            "ABCD",
+            "abcdabcd",
+            "xabcabcdx",
+            "The quick brown fox jumps over the lazy dog",
+            "ERROR: task 1234 failed after 5.6s",
+    };
+    vector<string> const wild_strings{
+            "",
+            "*",
+            "a",
+            "?",
+            "abcd",
+            "a*",
+            "*d",
+            "*bc*",
+            "a?c?",
+            "*b?d*",
+            "*abcd",
+            "abcd*abcd",
+            "*abc*abcd*",
+            "*cd*ab*",
+            "*quick*fox*dog",
+            "*QUICK*lazy*",
+            "*task ???? failed*",
+            "ERROR*[0-9]*",
+    };
+
+    for (auto const& wild : wild_strings) {
+        WildcardMatcher const case_sensitive_matcher{wild};
+        WildcardMatcher const case_insensitive_matcher{wild, false};
+        for (auto const& tame : tame_strings) {
+            INFO("tame: \"" << tame << "\", wild: \"" << wild << "\"");
+            REQUIRE(case_sensitive_matcher.matches(tame) == wildcard_match_unsafe(tame, wild));
+            REQUIRE(case_insensitive_matcher.matches(tame)
+                    == wildcard_match_unsafe(tame, wild, false));
+        }
+    }
+
+    // Escaped wildcards
+    REQUIRE(WildcardMatcher{"a\\*c"}.matches("a*c"));
+    REQUIRE(false == WildcardMatcher{"a\\*c"}.matches("abc"));
+    REQUIRE(WildcardMatcher{"*\\?*"}.matches("why?"));
+    REQUIRE(false == WildcardMatcher{"*\\?*"}.matches("why"));
+    REQUIRE(WildcardMatcher{"*\\\\*"}.matches("a\\b"));
+
+    // Default-constructed matcher
+    REQUIRE(WildcardMatcher{}.matches(""));
+    REQUIRE(false == WildcardMatcher{}.matches("a"));
+}
+
 TEST_CASE("convert_string_to_int", "[convert_string_to_int]") {
     int64_t raw_as_int;
     string raw;